@@ -0,0 +1,255 @@
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Structs;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+
+namespace SoundFlow.Extensions.WebRtc.Apm.Components
+{
+    /// <summary>
+    /// Describes one input of a <see cref="NoiseSuppressionBatch"/> run.
+    /// </summary>
+    /// <remarks>
+    /// The source and output are opened through factories when a worker picks the job up, and disposed as soon as
+    /// it is finished, so a batch of thousands of files only holds as many open files as there are workers.
+    /// </remarks>
+    public sealed class NoiseSuppressionJob
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="NoiseSuppressionJob"/> class.
+        /// </summary>
+        /// <param name="name">A name identifying the job in its result, e.g. the input file path.</param>
+        /// <param name="format">The format of the audio from the source. Must be F32 at 8k, 16k, 32k or 48k Hz.</param>
+        /// <param name="openSource">Opens the audio to denoise.</param>
+        /// <param name="openOutput">Opens the encoder that receives the denoised audio.</param>
+        /// <exception cref="ArgumentNullException">Thrown if a factory is null.</exception>
+        public NoiseSuppressionJob(string name, AudioFormat format, Func<ISoundDataProvider> openSource,
+            Func<ISoundEncoder> openOutput)
+        {
+            Name = name ?? string.Empty;
+            Format = format;
+            OpenSource = openSource ?? throw new ArgumentNullException(nameof(openSource));
+            OpenOutput = openOutput ?? throw new ArgumentNullException(nameof(openOutput));
+        }
+
+        /// <summary>
+        /// Gets the name identifying the job.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets the format of the source audio.
+        /// </summary>
+        public AudioFormat Format { get; }
+
+        /// <summary>
+        /// Gets the factory that opens the source audio.
+        /// </summary>
+        public Func<ISoundDataProvider> OpenSource { get; }
+
+        /// <summary>
+        /// Gets the factory that opens the output encoder.
+        /// </summary>
+        public Func<ISoundEncoder> OpenOutput { get; }
+    }
+
+    /// <summary>
+    /// The outcome of one <see cref="NoiseSuppressionJob"/>.
+    /// </summary>
+    public sealed class NoiseSuppressionResult
+    {
+        internal NoiseSuppressionResult(NoiseSuppressionJob job, long samples, TimeSpan processingTime,
+            Exception? error)
+        {
+            Job = job;
+            Samples = samples;
+            ProcessingTime = processingTime;
+            Error = error;
+
+            var frames = job.Format.Channels > 0 ? samples / job.Format.Channels : 0;
+            AudioDuration = job.Format.SampleRate > 0
+                ? TimeSpan.FromSeconds((double)frames / job.Format.SampleRate)
+                : TimeSpan.Zero;
+        }
+
+        /// <summary>
+        /// Gets the job this result belongs to.
+        /// </summary>
+        public NoiseSuppressionJob Job { get; }
+
+        /// <summary>
+        /// Gets the number of interleaved samples processed.
+        /// </summary>
+        public long Samples { get; }
+
+        /// <summary>
+        /// Gets the duration of the audio processed.
+        /// </summary>
+        public TimeSpan AudioDuration { get; }
+
+        /// <summary>
+        /// Gets the wall-clock time spent on the job, including opening and closing the source and output.
+        /// </summary>
+        public TimeSpan ProcessingTime { get; }
+
+        /// <summary>
+        /// Gets the throughput as a multiple of realtime: seconds of audio processed per second of wall-clock time.
+        /// </summary>
+        public double RealtimeFactor => ProcessingTime.TotalSeconds > 0
+            ? AudioDuration.TotalSeconds / ProcessingTime.TotalSeconds
+            : 0;
+
+        /// <summary>
+        /// Gets the exception that stopped the job, or null if it completed.
+        /// </summary>
+        public Exception? Error { get; }
+
+        /// <summary>
+        /// Gets a value indicating whether the job completed without an error.
+        /// </summary>
+        public bool Succeeded => Error == null;
+    }
+
+    /// <summary>
+    /// Denoises many independent sources in parallel, each with its own WebRTC APM instance, streaming the results
+    /// straight into <see cref="ISoundEncoder"/> outputs.
+    /// </summary>
+    /// <remarks>
+    /// Jobs are handed out to a fixed set of worker threads (the calling thread included) in order. Each worker
+    /// holds one <see cref="NoiseSuppressor"/> frame of audio at a time, so memory use depends on the worker count,
+    /// not on the length or number of inputs. A failing job is reported in its result and does not stop the batch.
+    /// </remarks>
+    public static class NoiseSuppressionBatch
+    {
+        /// <summary>
+        /// Runs a batch of jobs and blocks until all of them have finished or the batch is cancelled.
+        /// </summary>
+        /// <param name="jobs">The jobs to run.</param>
+        /// <param name="suppressionLevel">The noise suppression level used for every job.</param>
+        /// <param name="useMultichannelProcessing">Whether multichannel sources are processed per channel.</param>
+        /// <param name="maxDegreeOfParallelism">
+        /// The number of workers, or zero or less to use <see cref="Environment.ProcessorCount"/>.
+        /// </param>
+        /// <param name="jobCompleted">
+        /// Called on the worker thread as each job finishes. Must be thread-safe. An exception it throws does not
+        /// stop the batch; it is rethrown on the calling thread once every worker has finished.
+        /// </param>
+        /// <param name="cancellationToken">Stops handing out new jobs; jobs already running are finished.</param>
+        /// <returns>One result per job, in job order. Jobs skipped by cancellation have a null entry.</returns>
+        /// <exception cref="ArgumentNullException">Thrown if jobs is null.</exception>
+        /// <exception cref="AggregateException">
+        /// Thrown after the batch has finished if <paramref name="jobCompleted"/> threw, holding every exception it threw.
+        /// </exception>
+        public static NoiseSuppressionResult?[] Run(
+            IReadOnlyList<NoiseSuppressionJob> jobs,
+            NoiseSuppressionLevel suppressionLevel = NoiseSuppressionLevel.High,
+            bool useMultichannelProcessing = false,
+            int maxDegreeOfParallelism = 0,
+            Action<NoiseSuppressionResult>? jobCompleted = null,
+            CancellationToken cancellationToken = default)
+        {
+            if (jobs == null) throw new ArgumentNullException(nameof(jobs));
+
+            var results = new NoiseSuppressionResult?[jobs.Count];
+            if (jobs.Count == 0) return results;
+
+            var workerCount = maxDegreeOfParallelism > 0 ? maxDegreeOfParallelism : Environment.ProcessorCount;
+            workerCount = Math.Max(1, Math.Min(workerCount, jobs.Count));
+
+            var nextJob = -1;
+            var callbackErrors = new List<Exception>();
+
+            void Work()
+            {
+                int index;
+                while (!cancellationToken.IsCancellationRequested &&
+                       (index = Interlocked.Increment(ref nextJob)) < jobs.Count)
+                {
+                    var result = RunJob(jobs[index], suppressionLevel, useMultichannelProcessing);
+                    results[index] = result;
+                    try
+                    {
+                        jobCompleted?.Invoke(result);
+                    }
+                    catch (Exception e)
+                    {
+                        // Escaping a background thread would bring down the process; report it to the caller instead.
+                        lock (callbackErrors)
+                            callbackErrors.Add(e);
+                    }
+                }
+            }
+
+            var workers = new Thread[workerCount - 1];
+            for (var i = 0; i < workers.Length; i++)
+            {
+                workers[i] = new Thread(Work)
+                {
+                    IsBackground = true,
+                    Name = $"SoundFlow NoiseSuppressionBatch Worker {i + 1}"
+                };
+                workers[i].Start();
+            }
+
+            Work();
+
+            foreach (var worker in workers)
+                worker.Join();
+
+            if (callbackErrors.Count > 0)
+                throw new AggregateException("The job completion callback threw.", callbackErrors);
+
+            return results;
+        }
+
+        private static NoiseSuppressionResult RunJob(NoiseSuppressionJob job, NoiseSuppressionLevel suppressionLevel,
+            bool useMultichannelProcessing)
+        {
+            var stopwatch = Stopwatch.StartNew();
+            var samples = 0L;
+            Exception? error = null;
+
+            ISoundDataProvider? source = null;
+            ISoundEncoder? output = null;
+            try
+            {
+                source = job.OpenSource();
+                output = job.OpenOutput();
+                using var suppressor = new NoiseSuppressor(source, job.Format, suppressionLevel,
+                    useMultichannelProcessing);
+                samples = suppressor.ProcessTo(output);
+            }
+            catch (Exception e)
+            {
+                error = e;
+            }
+            finally
+            {
+                // Disposing the encoder finalizes the output, so its failure fails the job too. Each is disposed on
+                // its own, so a failing output never leaves the source open.
+                try
+                {
+                    output?.Dispose();
+                }
+                catch (Exception e)
+                {
+                    error ??= e;
+                }
+
+                try
+                {
+                    source?.Dispose();
+                }
+                catch (Exception e)
+                {
+                    error ??= e;
+                }
+            }
+
+            stopwatch.Stop();
+            return new NoiseSuppressionResult(job, samples, stopwatch.Elapsed, error);
+        }
+    }
+}
@@ -3,8 +3,6 @@ using SoundFlow.Interfaces;
 using SoundFlow.Structs;
 using System;
 using System.Buffers;
-using System.Collections.Generic;
-using System.Runtime.InteropServices;
 
 
 namespace SoundFlow.Extensions.WebRtc.Apm.Components
@@ -30,17 +28,13 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
 
         private readonly AudioFormat _audioFormat;
         private readonly int _apmFrameSizePerChannel; // Samples per channel for a 10ms APM frame
-        private const int BytesPerSample = sizeof(float);
 
-        private readonly float[][] _deinterleavedInputApmFrame;
-        private readonly float[][] _deinterleavedOutputApmFrame;
-
-        private readonly nint[] _inputChannelPtrs;
-        private readonly nint[] _outputChannelPtrs;
+        // Planar native input and output frames handed to the APM.
+        private const int InputFrame = 0;
+        private const int OutputFrame = 1;
+        private readonly ApmFrameArena _frameArena;
         private readonly nint _inputChannelArrayPtr;
         private readonly nint _outputChannelArrayPtr;
-        private GCHandle _inputChannelArrayHandle;
-        private GCHandle _outputChannelArrayHandle;
 
         private bool _isDisposed;
 
@@ -83,8 +77,6 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
             if (_apmFrameSizePerChannel == 0)
                 throw new ArgumentException($"Could not determine APM frame size for sample rate {sampleRate} Hz.", nameof(audioFormat));
 
-            var apmFrameSizeBytesPerChannel = _apmFrameSizePerChannel * BytesPerSample;
-
             _apm = new AudioProcessingModule();
             _apmConfig = new ApmConfig();
 
@@ -121,32 +113,9 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
                 throw new InvalidOperationException($"Failed to initialize APM: {initError}");
             }
 
-            // Allocate managed and unmanaged buffers
-            _deinterleavedInputApmFrame = new float[numChannels][];
-            _deinterleavedOutputApmFrame = new float[numChannels][];
-            _inputChannelPtrs = new nint[numChannels];
-            _outputChannelPtrs = new nint[numChannels];
-
-            try
-            {
-                for (var i = 0; i < numChannels; i++)
-                {
-                    _deinterleavedInputApmFrame[i] = new float[_apmFrameSizePerChannel];
-                    _deinterleavedOutputApmFrame[i] = new float[_apmFrameSizePerChannel];
-                    _inputChannelPtrs[i] = Marshal.AllocHGlobal(apmFrameSizeBytesPerChannel);
-                    _outputChannelPtrs[i] = Marshal.AllocHGlobal(apmFrameSizeBytesPerChannel);
-                }
-
-                _inputChannelArrayHandle = GCHandle.Alloc(_inputChannelPtrs, GCHandleType.Pinned);
-                _inputChannelArrayPtr = _inputChannelArrayHandle.AddrOfPinnedObject();
-                _outputChannelArrayHandle = GCHandle.Alloc(_outputChannelPtrs, GCHandleType.Pinned);
-                _outputChannelArrayPtr = _outputChannelArrayHandle.AddrOfPinnedObject();
-            }
-            catch
-            {
-                Dispose();
-                throw;
-            }
+            _frameArena = new ApmFrameArena(numChannels, _apmFrameSizePerChannel, 2);
+            _inputChannelArrayPtr = _frameArena.GetChannelArray(InputFrame);
+            _outputChannelArrayPtr = _frameArena.GetChannelArray(OutputFrame);
         }
 
         /// <summary>
@@ -158,9 +127,20 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
         public float[] ProcessAll()
         {
             //ObjectDisposedException.ThrowIf(_isDisposed, this);
-            var processedAudioList = new List<float>();
-            ProcessChunks(chunk => { processedAudioList.AddRange(chunk.ToArray()); });
-            return processedAudioList.ToArray();
+            var capacity = _dataProvider.Length > 0 ? _dataProvider.Length : _apmFrameSizePerChannel * _audioFormat.Channels;
+            var processedAudio = new float[capacity];
+            var count = 0;
+            ProcessChunks(chunk =>
+            {
+                if (count + chunk.Length > processedAudio.Length)
+                    Array.Resize(ref processedAudio, Math.Max(count + chunk.Length, processedAudio.Length * 2));
+                chunk.Span.CopyTo(processedAudio.AsSpan(count));
+                count += chunk.Length;
+            });
+
+            if (count != processedAudio.Length)
+                Array.Resize(ref processedAudio, count);
+            return processedAudio;
         }
 
         /// <summary>
@@ -174,66 +154,77 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
         public void ProcessChunks(Action<ReadOnlyMemory<float>>? chunkHandler = null)
         {
             //ObjectDisposedException.ThrowIf(_isDisposed, this);
+            ProcessFrames(null, chunkHandler);
+        }
+
+        /// <summary>
+        /// Processes the audio stream from the data provider and writes the result straight into
+        /// <paramref name="encoder"/>, one 10 ms frame at a time. Memory use is bounded by a single frame regardless of
+        /// the length of the stream. The <see cref="OnAudioChunkProcessed"/> event is still raised for each frame.
+        /// </summary>
+        /// <param name="encoder">The encoder that receives the processed audio.</param>
+        /// <returns>The number of samples processed.</returns>
+        /// <exception cref="ArgumentNullException">Thrown if encoder is null.</exception>
+        public long ProcessTo(ISoundEncoder encoder)
+        {
+            //ObjectDisposedException.ThrowIf(_isDisposed, this);
+            if (encoder == null) throw new ArgumentNullException(nameof(encoder));
+            return ProcessFrames(encoder, null);
+        }
 
+        private long ProcessFrames(ISoundEncoder? encoder, Action<ReadOnlyMemory<float>>? chunkHandler)
+        {
             var samplesPerApmFrameInterleaved = _apmFrameSizePerChannel * _audioFormat.Channels;
             var providerReadBuffer = ArrayPool<float>.Shared.Rent(samplesPerApmFrameInterleaved);
             var processedFrameBuffer = ArrayPool<float>.Shared.Rent(samplesPerApmFrameInterleaved);
+            var totalSamples = 0L;
 
             try
             {
                 int samplesActuallyReadFromProvider;
                 do
                 {
-                    // Read a full APM frame's worth of interleaved samples from the provider
-                    Array.Clear(providerReadBuffer, 0, samplesPerApmFrameInterleaved);
-                    samplesActuallyReadFromProvider = _dataProvider.ReadBytes(
-                        providerReadBuffer.AsSpan(0, samplesPerApmFrameInterleaved));
+                    // Read a full APM frame's worth of interleaved samples from the provider. Providers may return
+                    // short reads before the end of the stream, so keep reading until the frame is full or empty.
+                    var currentFrameSpan = providerReadBuffer.AsSpan(0, samplesPerApmFrameInterleaved);
+                    samplesActuallyReadFromProvider = 0;
+                    while (samplesActuallyReadFromProvider < samplesPerApmFrameInterleaved)
+                    {
+                        var read = _dataProvider.ReadBytes(currentFrameSpan[samplesActuallyReadFromProvider..]);
+                        if (read <= 0) break;
+                        samplesActuallyReadFromProvider += read;
+                    }
 
                     if (samplesActuallyReadFromProvider > 0)
                     {
-                        var currentFrameSpan = providerReadBuffer.AsSpan(0, samplesPerApmFrameInterleaved);
-
                         // If last chunk is smaller than APM frame, pad with silence
-                        // Note: The input providerReadBuffer is already samplesPerApmFrameInterleaved long
-                        // so we just need to clear the part that wasn't filled by ReadBytes if it's a partial read.
                         if (samplesActuallyReadFromProvider < samplesPerApmFrameInterleaved)
-                        {
                             currentFrameSpan[samplesActuallyReadFromProvider..].Clear();
-                        }
 
-                        Deinterleave(currentFrameSpan, _audioFormat.Channels, _apmFrameSizePerChannel, _deinterleavedInputApmFrame);
+                        _frameArena.Write(InputFrame, currentFrameSpan);
 
-                        for (var ch = 0; ch < _audioFormat.Channels; ch++)
-                            Marshal.Copy(_deinterleavedInputApmFrame[ch], 0, _inputChannelPtrs[ch], _apmFrameSizePerChannel);
-
-                        var error = NativeMethods.ProcessStream(
-                            _apm.NativePtr,
-                            _inputChannelArrayPtr,
-                            _inputStreamConfig.NativePtr,
-                            _outputStreamConfig.NativePtr,
+                        var error = _apm.ProcessStream(_inputChannelArrayPtr, _inputStreamConfig, _outputStreamConfig,
                             _outputChannelArrayPtr);
 
+                        float[] result;
                         if (error == ApmError.NoError)
                         {
-                            for (var ch = 0; ch < _audioFormat.Channels; ch++)
-                                Marshal.Copy(_outputChannelPtrs[ch], _deinterleavedOutputApmFrame[ch], 0, _apmFrameSizePerChannel);
-
-                            Interleave(_deinterleavedOutputApmFrame, _audioFormat.Channels, _apmFrameSizePerChannel, processedFrameBuffer.AsSpan(0, samplesPerApmFrameInterleaved));
-
-                            // Raise event/handler with the valid portion of the processed chunk
-                            var validProcessedChunk = processedFrameBuffer.AsMemory(0, samplesActuallyReadFromProvider);
-                            OnAudioChunkProcessed?.Invoke(validProcessedChunk);
-                            chunkHandler?.Invoke(validProcessedChunk);
+                            _frameArena.Read(OutputFrame, processedFrameBuffer.AsSpan(0, samplesPerApmFrameInterleaved));
+                            result = processedFrameBuffer;
                         }
                         else
                         {
                             // On error, pass through the original chunk
-                            var originalValidChunk = providerReadBuffer.AsMemory(0, samplesActuallyReadFromProvider);
-                            OnAudioChunkProcessed?.Invoke(originalValidChunk);
-                            chunkHandler?.Invoke(originalValidChunk);
+                            result = providerReadBuffer;
                             UnityEngine.Debug.LogError($"Noise suppression process failed: {error}. Passing through chunk.");
-                            // Optionally throw or handle error differently
                         }
+
+                        // Raise event/handler with the valid portion of the processed chunk
+                        encoder?.Encode(result.AsSpan(0, samplesActuallyReadFromProvider));
+                        var validChunk = result.AsMemory(0, samplesActuallyReadFromProvider);
+                        OnAudioChunkProcessed?.Invoke(validChunk);
+                        chunkHandler?.Invoke(validChunk);
+                        totalSamples += samplesActuallyReadFromProvider;
                     }
                 } while (samplesActuallyReadFromProvider == samplesPerApmFrameInterleaved);
             }
@@ -242,31 +233,8 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
                 ArrayPool<float>.Shared.Return(providerReadBuffer);
                 ArrayPool<float>.Shared.Return(processedFrameBuffer);
             }
-        }
-
-
-        private static void Deinterleave(ReadOnlySpan<float> interleaved, int numChannels, int frameSizePerChannel, float[][] deinterleavedTarget)
-        {
-            for (var ch = 0; ch < numChannels; ch++)
-            {
-                for (var i = 0; i < frameSizePerChannel; i++)
-                {
-                    var idx = i * numChannels + ch;
-                    deinterleavedTarget[ch][i] = idx < interleaved.Length ? interleaved[idx] : 0f;
-                }
-            }
-        }
 
-        private static void Interleave(float[][] deinterleaved, int numChannels, int frameSizePerChannel, Span<float> interleavedTarget)
-        {
-            for (var ch = 0; ch < numChannels; ch++)
-            {
-                for (var i = 0; i < frameSizePerChannel; i++)
-                {
-                    var idx = i * numChannels + ch;
-                    if (idx < interleavedTarget.Length) interleavedTarget[idx] = deinterleaved[ch][i];
-                }
-            }
+            return totalSamples;
         }
 
         /// <summary>
@@ -276,13 +244,7 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Components
         {
             if (!_isDisposed)
             {
-                if (_inputChannelArrayHandle.IsAllocated) _inputChannelArrayHandle.Free();
-                if (_outputChannelArrayHandle.IsAllocated) _outputChannelArrayHandle.Free();
-
-                for (var i = 0; i < _audioFormat.Channels; i++)
-                    if (_inputChannelPtrs[i] != IntPtr.Zero) Marshal.FreeHGlobal(_inputChannelPtrs[i]);
-                for (var i = 0; i < _audioFormat.Channels; i++)
-                    if (_outputChannelPtrs[i] != IntPtr.Zero) Marshal.FreeHGlobal(_outputChannelPtrs[i]);
+                _frameArena?.Dispose();
 
                 _apm.Dispose();
                 _apmConfig.Dispose();
@@ -0,0 +1,240 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Extensions.WebRtc.Apm
+{
+    /// <summary>
+    /// A single native allocation holding one or more planar 10 ms APM frames together with their
+    /// <c>float**</c> channel pointer tables.
+    /// </summary>
+    /// <remarks>
+    /// Interleaved audio is deinterleaved straight into the native channel planes and interleaved straight back out
+    /// of them, so a frame crosses the managed/native boundary without intermediate managed arrays, per-channel
+    /// <see cref="Marshal.Copy(float[], int, IntPtr, int)"/> calls or pinned handles. The native APM only accepts
+    /// planar float input; for mono streams the two layouts coincide and each direction is a single block copy.
+    /// </remarks>
+    internal sealed unsafe class ApmFrameArena : IDisposable
+    {
+        // Channel planes start on cache-line boundaries (in floats).
+        private const int PlaneAlignment = 16;
+
+        private readonly int _planeStride;
+        private readonly int _frameStride;
+        private float** _tables;
+        private float* _samples;
+        private IntPtr _block;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="ApmFrameArena"/> class.
+        /// </summary>
+        /// <param name="channels">The number of channels per frame.</param>
+        /// <param name="frameSizePerChannel">The number of samples per channel in one frame.</param>
+        /// <param name="frameCount">The number of frames to allocate.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if any argument is not positive.</exception>
+        public ApmFrameArena(int channels, int frameSizePerChannel, int frameCount)
+        {
+            if (channels <= 0) throw new ArgumentOutOfRangeException(nameof(channels));
+            if (frameSizePerChannel <= 0) throw new ArgumentOutOfRangeException(nameof(frameSizePerChannel));
+            if (frameCount <= 0) throw new ArgumentOutOfRangeException(nameof(frameCount));
+
+            Channels = channels;
+            FrameSizePerChannel = frameSizePerChannel;
+            FrameCount = frameCount;
+            _planeStride = (frameSizePerChannel + PlaneAlignment - 1) / PlaneAlignment * PlaneAlignment;
+            _frameStride = _planeStride * channels;
+
+            var tableBytes = (long)frameCount * channels * sizeof(float*);
+            var sampleBytes = (long)frameCount * _frameStride * sizeof(float);
+            var alignBytes = PlaneAlignment * sizeof(float);
+            var samplesOffset = (tableBytes + alignBytes - 1) / alignBytes * alignBytes;
+
+            // Over-allocate by one alignment unit so the sample region can start on an aligned address.
+            _block = Marshal.AllocHGlobal((IntPtr)(samplesOffset + sampleBytes + alignBytes));
+            var aligned = ((long)_block + samplesOffset + alignBytes - 1) / alignBytes * alignBytes;
+            _tables = (float**)_block;
+            _samples = (float*)aligned;
+
+            new Span<float>(_samples, frameCount * _frameStride).Clear();
+            for (var f = 0; f < frameCount; f++)
+            for (var ch = 0; ch < channels; ch++)
+                _tables[f * channels + ch] = _samples + f * _frameStride + ch * _planeStride;
+        }
+
+        /// <summary>
+        /// Gets the number of channels per frame.
+        /// </summary>
+        public int Channels { get; }
+
+        /// <summary>
+        /// Gets the number of samples per channel in one frame.
+        /// </summary>
+        public int FrameSizePerChannel { get; }
+
+        /// <summary>
+        /// Gets the number of frames in the arena.
+        /// </summary>
+        public int FrameCount { get; }
+
+        /// <summary>
+        /// Gets the native <c>float**</c> channel table of a frame, as expected by the APM stream functions.
+        /// </summary>
+        /// <param name="frame">The frame index.</param>
+        public IntPtr GetChannelArray(int frame)
+        {
+            CheckFrame(frame);
+            return (IntPtr)(_tables + frame * Channels);
+        }
+
+        /// <summary>
+        /// Gets one channel plane of a frame.
+        /// </summary>
+        /// <param name="frame">The frame index.</param>
+        /// <param name="channel">The channel index.</param>
+        public Span<float> GetChannel(int frame, int channel)
+        {
+            CheckFrame(frame);
+            if ((uint)channel >= (uint)Channels) throw new ArgumentOutOfRangeException(nameof(channel));
+            return new Span<float>(_tables[frame * Channels + channel], FrameSizePerChannel);
+        }
+
+        /// <summary>
+        /// Deinterleaves <paramref name="interleaved"/> into the channel planes of a frame. Missing trailing samples
+        /// are filled with silence.
+        /// </summary>
+        /// <param name="frame">The frame index.</param>
+        /// <param name="interleaved">Interleaved samples, at most one frame long.</param>
+        public void Write(int frame, ReadOnlySpan<float> interleaved)
+        {
+            CheckFrame(frame);
+            var channels = Channels;
+            var frameSize = FrameSizePerChannel;
+            var total = frameSize * channels;
+            if (interleaved.Length > total) interleaved = interleaved[..total];
+            var planes = _samples + frame * _frameStride;
+
+            if (channels == 1)
+            {
+                var plane = new Span<float>(planes, frameSize);
+                interleaved.CopyTo(plane);
+                plane[interleaved.Length..].Clear();
+                return;
+            }
+
+            var frames = interleaved.Length / channels;
+            fixed (float* src = interleaved)
+            {
+                if (channels == 2)
+                {
+                    float* left = planes, right = planes + _planeStride;
+                    for (var i = 0; i < frames; i++)
+                    {
+                        left[i] = src[2 * i];
+                        right[i] = src[2 * i + 1];
+                    }
+                }
+                else
+                {
+                    var s = src;
+                    for (var i = 0; i < frames; i++)
+                    {
+                        var dst = planes + i;
+                        for (var ch = 0; ch < channels; ch++, dst += _planeStride)
+                            *dst = *s++;
+                    }
+                }
+
+                // A trailing partial frame keeps the channels it has; the rest is silence.
+                var partial = interleaved.Length - frames * channels;
+                for (var ch = 0; ch < channels; ch++)
+                {
+                    var plane = new Span<float>(planes + ch * _planeStride, frameSize);
+                    var start = frames;
+                    if (ch < partial) plane[start++] = src[frames * channels + ch];
+                    plane[start..].Clear();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Interleaves the channel planes of a frame into <paramref name="interleaved"/>. Only as many samples as the
+        /// destination holds (at most one frame) are written.
+        /// </summary>
+        /// <param name="frame">The frame index.</param>
+        /// <param name="interleaved">The destination for the interleaved samples.</param>
+        public void Read(int frame, Span<float> interleaved)
+        {
+            CheckFrame(frame);
+            var channels = Channels;
+            var total = FrameSizePerChannel * channels;
+            if (interleaved.Length > total) interleaved = interleaved[..total];
+            var planes = _samples + frame * _frameStride;
+
+            if (channels == 1)
+            {
+                new ReadOnlySpan<float>(planes, interleaved.Length).CopyTo(interleaved);
+                return;
+            }
+
+            var frames = interleaved.Length / channels;
+            fixed (float* dst = interleaved)
+            {
+                if (channels == 2)
+                {
+                    float* left = planes, right = planes + _planeStride;
+                    for (var i = 0; i < frames; i++)
+                    {
+                        dst[2 * i] = left[i];
+                        dst[2 * i + 1] = right[i];
+                    }
+                }
+                else
+                {
+                    var d = dst;
+                    for (var i = 0; i < frames; i++)
+                    {
+                        var src = planes + i;
+                        for (var ch = 0; ch < channels; ch++, src += _planeStride)
+                            *d++ = *src;
+                    }
+                }
+
+                var partial = interleaved.Length - frames * channels;
+                for (var ch = 0; ch < partial; ch++)
+                    dst[frames * channels + ch] = planes[ch * _planeStride + frames];
+            }
+        }
+
+        /// <summary>
+        /// Fills every frame with silence.
+        /// </summary>
+        public void Clear()
+        {
+            if (_block == IntPtr.Zero) return;
+            new Span<float>(_samples, FrameCount * _frameStride).Clear();
+        }
+
+        private void CheckFrame(int frame)
+        {
+            if (_block == IntPtr.Zero) throw new ObjectDisposedException(nameof(ApmFrameArena));
+            if ((uint)frame >= (uint)FrameCount) throw new ArgumentOutOfRangeException(nameof(frame));
+        }
+
+        /// <summary>
+        /// Frees the native memory of the arena.
+        /// </summary>
+        public void Dispose()
+        {
+            if (_block == IntPtr.Zero) return;
+            Marshal.FreeHGlobal(_block);
+            _block = IntPtr.Zero;
+            _tables = null;
+            _samples = null;
+            GC.SuppressFinalize(this);
+        }
+
+        ~ApmFrameArena()
+        {
+            Dispose();
+        }
+    }
+}
@@ -571,6 +571,35 @@ namespace SoundFlow.Extensions.WebRtc.Apm
             }
         }
 
+        /// <summary>
+        /// Processes one frame of capture audio that is already held in native memory, without any managed
+        /// allocation or copying. Intended for real-time callers that keep their own per-channel native buffers.
+        /// </summary>
+        /// <param name="src">Pointer to an array of per-channel pointers, each to one frame of float samples</param>
+        /// <param name="inputConfig">Input stream configuration</param>
+        /// <param name="outputConfig">Output stream configuration</param>
+        /// <param name="dest">Pointer to an array of per-channel pointers that receive the processed frame</param>
+        /// <returns>Error code</returns>
+        public ApmError ProcessStream(IntPtr src, StreamConfig inputConfig, StreamConfig outputConfig, IntPtr dest)
+        {
+            return NativeMethods.ProcessStream(NativePtr, src, inputConfig.NativePtr, outputConfig.NativePtr, dest);
+        }
+
+        /// <summary>
+        /// Processes one frame of far-end (render) audio that is already held in native memory, without any managed
+        /// allocation or copying. Intended for real-time callers that keep their own per-channel native buffers.
+        /// </summary>
+        /// <param name="src">Pointer to an array of per-channel pointers, each to one frame of float samples</param>
+        /// <param name="inputConfig">Input stream configuration</param>
+        /// <param name="outputConfig">Output stream configuration</param>
+        /// <param name="dest">Pointer to an array of per-channel pointers that receive the processed frame</param>
+        /// <returns>Error code</returns>
+        public ApmError ProcessReverseStream(IntPtr src, StreamConfig inputConfig, StreamConfig outputConfig, IntPtr dest)
+        {
+            return NativeMethods.ProcessReverseStream(NativePtr, src, inputConfig.NativePtr, outputConfig.NativePtr,
+                dest);
+        }
+
         /// <summary>
         /// Analyzes a reverse stream of audio data
         /// </summary>
@@ -1,10 +1,9 @@
 using SoundFlow.Abstracts;
 using SoundFlow.Abstracts.Devices;
 using SoundFlow.Enums;
+using SoundFlow.Utils;
 using System;
-using System.Buffers;
-using System.Collections.Generic;
-using System.Runtime.InteropServices;
+using System.Threading;
 
 namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
 {
@@ -28,30 +27,31 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
         private readonly int _apmFrameSizePerChannel;
         private readonly int _numChannels;
         private readonly int _sampleRate;
-        private const int BytesPerSample = sizeof(float);
-        private readonly int _apmFrameSizeBytesPerChannel;
 
-        private float[][]? _deinterleavedInputApmFrame;
-        private float[][]? _deinterleavedOutputApmFrame;
-        private float[][]? _deinterleavedFarendApmFrame;
-
-        private nint[]? _inputChannelPtrs;
-        private nint[]? _outputChannelPtrs;
+        // Planar native frames handed to the APM: near-end input/output, far-end input and the unused reverse output.
+        private const int InputFrame = 0;
+        private const int OutputFrame = 1;
+        private const int FarendFrame = 2;
+        private const int ReverseOutputFrame = 3;
+        private ApmFrameArena? _frameArena;
         private nint _inputChannelArrayPtr = IntPtr.Zero;
         private nint _outputChannelArrayPtr = IntPtr.Zero;
-        private GCHandle _inputChannelArrayHandle;
-        private GCHandle _outputChannelArrayHandle;
-
-        private nint[]? _farendChannelPtrs;
         private nint _farendChannelArrayPtr = IntPtr.Zero;
-        private GCHandle _farendChannelArrayHandle;
-        private nint[]? _dummyReverseOutputChannelPtrs; // For AEC farend processing
         private nint _dummyReverseOutputChannelArrayPtr = IntPtr.Zero;
-        private GCHandle _dummyReverseOutputChannelArrayHandle;
 
-        private readonly Queue<float> _inputRingBuffer = new();
-        private readonly Queue<float> _outputRingBuffer = new();
-        private readonly Queue<float> _farendInputRingBuffer = new();
+        private const int RingBufferFrames = 4;
+        private readonly SpscRingBuffer _inputRingBuffer;
+        private readonly SpscRingBuffer _outputRingBuffer;
+        private readonly SpscRingBuffer _farendInputRingBuffer;
+        private readonly float[] _interleavedApmFrame;
+        private readonly float[] _interleavedFarendApmFrame;
+
+        // Far-end reference submitted through EnqueueFarend. Filled by the caller's thread, drained on the near-end
+        // thread one APM frame at a time.
+        private const int FarendReferenceFrames = 32;
+        private readonly SpscRingBuffer _farendReferenceRingBuffer;
+        private readonly float[] _interleavedFarendReferenceFrame;
+        private long _farendDroppedSamples;
 
         private bool _isApmSuccessfullyInitialized;
         private bool _isDisposed;
@@ -467,6 +467,16 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
         /// </summary>
         public float PostProcessGain { get; set; } = 1f;
 
+        /// <summary>
+        /// Gets the number of far-end reference samples queued by <see cref="EnqueueFarend"/> and not yet consumed.
+        /// </summary>
+        public int FarendQueuedSamples => _farendReferenceRingBuffer.Count;
+
+        /// <summary>
+        /// Gets the total number of far-end reference samples dropped because the reference queue was full.
+        /// </summary>
+        public long FarendDroppedSamples => Interlocked.Read(ref _farendDroppedSamples);
+
         #endregion
 
         /// <summary>
@@ -512,7 +522,16 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
                     $"Unsupported sample rate for WebRTC Audio Processing Module: {_sampleRate} Hz. Must be 8k, 16k, 32k, or 48k.");
 
             _apmFrameSizePerChannel = AudioProcessingModule.GetFrameSize(_sampleRate);
-            _apmFrameSizeBytesPerChannel = _apmFrameSizePerChannel * BytesPerSample;
+
+            var totalSamplesInApmFrame = _apmFrameSizePerChannel * Math.Max(0, _numChannels);
+            var ringBufferCapacity = Math.Max(1, totalSamplesInApmFrame * RingBufferFrames);
+            _inputRingBuffer = new SpscRingBuffer(ringBufferCapacity);
+            _outputRingBuffer = new SpscRingBuffer(ringBufferCapacity);
+            _farendInputRingBuffer = new SpscRingBuffer(ringBufferCapacity);
+            _interleavedApmFrame = new float[totalSamplesInApmFrame];
+            _interleavedFarendApmFrame = new float[totalSamplesInApmFrame];
+            _farendReferenceRingBuffer = new SpscRingBuffer(Math.Max(1, totalSamplesInApmFrame * FarendReferenceFrames));
+            _interleavedFarendReferenceFrame = new float[totalSamplesInApmFrame];
 
             if (_apmFrameSizePerChannel == 0 || _numChannels <= 0)
             {
@@ -574,35 +593,11 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
                     if (initError != ApmError.NoError)
                         throw new InvalidOperationException($"Failed to initialize APM: {initError}");
 
-                    _deinterleavedInputApmFrame = new float[_numChannels][];
-                    _deinterleavedOutputApmFrame = new float[_numChannels][];
-                    _deinterleavedFarendApmFrame = new float[_numChannels][];
-
-                    _inputChannelPtrs = new nint[_numChannels];
-                    _outputChannelPtrs = new nint[_numChannels];
-                    _farendChannelPtrs = new nint[_numChannels];
-                    _dummyReverseOutputChannelPtrs = new nint[_numChannels];
-
-                    for (var i = 0; i < _numChannels; i++)
-                    {
-                        _deinterleavedInputApmFrame[i] = new float[_apmFrameSizePerChannel];
-                        _deinterleavedOutputApmFrame[i] = new float[_apmFrameSizePerChannel];
-                        _deinterleavedFarendApmFrame[i] = new float[_apmFrameSizePerChannel];
-                        _inputChannelPtrs[i] = Marshal.AllocHGlobal(_apmFrameSizeBytesPerChannel);
-                        _outputChannelPtrs[i] = Marshal.AllocHGlobal(_apmFrameSizeBytesPerChannel);
-                        _farendChannelPtrs[i] = Marshal.AllocHGlobal(_apmFrameSizeBytesPerChannel);
-                        _dummyReverseOutputChannelPtrs[i] = Marshal.AllocHGlobal(_apmFrameSizeBytesPerChannel);
-                    }
-
-                    _inputChannelArrayHandle = GCHandle.Alloc(_inputChannelPtrs, GCHandleType.Pinned);
-                    _inputChannelArrayPtr = _inputChannelArrayHandle.AddrOfPinnedObject();
-                    _outputChannelArrayHandle = GCHandle.Alloc(_outputChannelPtrs, GCHandleType.Pinned);
-                    _outputChannelArrayPtr = _outputChannelArrayHandle.AddrOfPinnedObject();
-                    _farendChannelArrayHandle = GCHandle.Alloc(_farendChannelPtrs, GCHandleType.Pinned);
-                    _farendChannelArrayPtr = _farendChannelArrayHandle.AddrOfPinnedObject();
-                    _dummyReverseOutputChannelArrayHandle =
-                        GCHandle.Alloc(_dummyReverseOutputChannelPtrs, GCHandleType.Pinned);
-                    _dummyReverseOutputChannelArrayPtr = _dummyReverseOutputChannelArrayHandle.AddrOfPinnedObject();
+                    _frameArena = new ApmFrameArena(_numChannels, _apmFrameSizePerChannel, 4);
+                    _inputChannelArrayPtr = _frameArena.GetChannelArray(InputFrame);
+                    _outputChannelArrayPtr = _frameArena.GetChannelArray(OutputFrame);
+                    _farendChannelArrayPtr = _frameArena.GetChannelArray(FarendFrame);
+                    _dummyReverseOutputChannelArrayPtr = _frameArena.GetChannelArray(ReverseOutputFrame);
 
                     if (EchoCancellation.Enabled)
                         switch (_device)
@@ -677,77 +672,101 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
         public override void Process(Span<float> buffer, int channels) // Near-end processing
         {
             if (!Enabled || !_isApmSuccessfullyInitialized || _apm == null || _apmConfig == null ||
-                _inputStreamConfig == null || _outputStreamConfig == null || _deinterleavedInputApmFrame == null ||
-                _deinterleavedOutputApmFrame == null || _inputChannelArrayPtr == IntPtr.Zero ||
-                _outputChannelArrayPtr == IntPtr.Zero || buffer.Length == 0)
+                _inputStreamConfig == null || _outputStreamConfig == null || _frameArena == null ||
+                buffer.Length == 0)
                 return;
 
-            foreach (var t in buffer)
-                _inputRingBuffer.Enqueue(t);
-
             var totalSamplesInApmFrame = _apmFrameSizePerChannel * _numChannels;
+            var frame = _interleavedApmFrame.AsSpan(0, totalSamplesInApmFrame);
             var processedAnyFrames = false;
+            var consumed = 0;
+            var produced = 0;
 
-            while (_inputRingBuffer.Count >= totalSamplesInApmFrame)
+            // Feed the buffer through the fixed-size rings in pieces. Processed output is written back over
+            // the part of the buffer that has already been consumed, so the whole exchange is in place.
+            while (true)
             {
-                processedAnyFrames = true;
-                var currentApmInterleavedInputFrame = ArrayPool<float>.Shared.Rent(totalSamplesInApmFrame);
-                try
-                {
-                    for (var i = 0; i < totalSamplesInApmFrame; i++)
-                        if (!_inputRingBuffer.TryDequeue(out currentApmInterleavedInputFrame[i]))
-                            break;
+                var written = _inputRingBuffer.Write(buffer[consumed..]);
+                consumed += written;
 
-                    Deinterleave(currentApmInterleavedInputFrame.AsSpan(0, totalSamplesInApmFrame),
-                        _numChannels, _apmFrameSizePerChannel, _deinterleavedInputApmFrame);
+                while (_inputRingBuffer.Count >= totalSamplesInApmFrame &&
+                       _outputRingBuffer.FreeSpace >= totalSamplesInApmFrame)
+                {
+                    processedAnyFrames = true;
+                    _inputRingBuffer.Read(frame);
 
-                    for (var ch = 0; ch < _numChannels; ch++)
-                        Marshal.Copy(_deinterleavedInputApmFrame[ch], 0, _inputChannelPtrs![ch], _apmFrameSizePerChannel);
+                    // Render before capture, so the echo reference for this frame is already in the AEC.
+                    ProcessQueuedFarend(totalSamplesInApmFrame);
 
                     ApmError error;
                     lock (_apmLock)
                     {
-                        if (!_isApmSuccessfullyInitialized || _apm == null) error = ApmError.UnspecifiedError;
+                        if (!_isApmSuccessfullyInitialized || _apm == null || _frameArena == null)
+                            error = ApmError.UnspecifiedError;
                         else
-                            error = NativeMethods.ProcessStream(
-                                _apm.NativePtr, _inputChannelArrayPtr,
-                                _inputStreamConfig.NativePtr, _outputStreamConfig.NativePtr,
+                        {
+                            _frameArena.Write(InputFrame, frame);
+                            error = _apm.ProcessStream(_inputChannelArrayPtr, _inputStreamConfig, _outputStreamConfig,
                                 _outputChannelArrayPtr);
-                    }
 
-                    var resultBufferToInterleave = _deinterleavedInputApmFrame;
-                    if (error == ApmError.NoError)
-                    {
-                        for (var ch = 0; ch < _numChannels; ch++)
-                            Marshal.Copy(_outputChannelPtrs![ch], _deinterleavedOutputApmFrame![ch], 0,
-                                _apmFrameSizePerChannel);
-                        resultBufferToInterleave = _deinterleavedOutputApmFrame;
-                    }
-                    else
-                    {
-                        UnityEngine.Debug.LogError($"WebRTC APM: Error processing stream: {error}. Passing through.");
+                            // On failure the frame is passed through unchanged.
+                            if (error == ApmError.NoError)
+                                _frameArena.Read(OutputFrame, frame);
+                        }
                     }
 
-                    Interleave(resultBufferToInterleave, _numChannels, _apmFrameSizePerChannel,
-                        currentApmInterleavedInputFrame.AsSpan(0, totalSamplesInApmFrame));
+                    if (error != ApmError.NoError)
+                        UnityEngine.Debug.LogError($"WebRTC APM: Error processing stream: {error}. Passing through.");
 
-                    for (var i = 0; i < totalSamplesInApmFrame; i++)
-                        _outputRingBuffer.Enqueue(currentApmInterleavedInputFrame[i]);
-                }
-                finally
-                {
-                    ArrayPool<float>.Shared.Return(currentApmInterleavedInputFrame);
+                    _outputRingBuffer.Write(frame);
                 }
+
+                var read = _outputRingBuffer.Read(buffer[produced..consumed]);
+                produced += read;
+
+                if (consumed == buffer.Length || (written == 0 && read == 0)) break;
             }
 
-            for (var i = 0; i < buffer.Length; i++)
+            var gain = PostProcessGain;
+            for (var i = 0; i < produced; i++)
+                buffer[i] *= gain;
+
+            if (produced < buffer.Length && processedAnyFrames)
+                buffer[produced..].Clear();
+        }
+
+        /// <summary>
+        /// Queues far-end (loudspeaker) reference audio for echo cancellation. Use this for playback that does not go
+        /// through the device this modifier was created with, e.g. Unity's <c>OnAudioFilterRead</c>, a second playback
+        /// device or a network stream.
+        /// </summary>
+        /// <remarks>
+        /// The samples must be interleaved in the modifier's format (sample rate and channel count). The call is
+        /// lock-free and allocation-free: samples are copied into a fixed reference queue, and the near-end thread
+        /// feeds them to the APM in whole 10 ms frames right before each near-end frame is processed. One producer
+        /// thread may call this at a time. Samples that do not fit (about 320 ms of backlog) are dropped and counted
+        /// in <see cref="FarendDroppedSamples"/>.
+        /// </remarks>
+        /// <param name="samples">Interleaved far-end samples.</param>
+        /// <returns>The number of samples queued.</returns>
+        public int EnqueueFarend(ReadOnlySpan<float> samples)
+        {
+            if (_isDisposed || samples.IsEmpty) return 0;
+
+            var written = _farendReferenceRingBuffer.Write(samples);
+            if (written < samples.Length)
+                Interlocked.Add(ref _farendDroppedSamples, samples.Length - written);
+            return written;
+        }
+
+        private void ProcessQueuedFarend(int totalSamplesInApmFrame)
+        {
+            var frame = _interleavedFarendReferenceFrame.AsSpan(0, totalSamplesInApmFrame);
+            while (_farendReferenceRingBuffer.Count >= totalSamplesInApmFrame)
             {
-                if (_outputRingBuffer.TryDequeue(out var sample)) buffer[i] = sample * PostProcessGain;
-                else
-                {
-                    if (processedAnyFrames) buffer[i..].Clear();
-                    break;
-                }
+                _farendReferenceRingBuffer.Read(frame);
+                if (EchoCancellation.Enabled)
+                    ProcessFarendFrame(frame);
             }
         }
 
@@ -755,51 +774,47 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
         {
             if (capability != Capability.Playback || !Enabled || !_isApmSuccessfullyInitialized || _apm == null ||
                 !EchoCancellation.Enabled || // Only process if AEC itself is enabled
-                _deinterleavedFarendApmFrame == null || _reverseInputStreamConfig == null ||
-                _reverseOutputStreamConfig == null || _farendChannelArrayPtr == IntPtr.Zero ||
-                _dummyReverseOutputChannelArrayPtr == IntPtr.Zero || samples.Length == 0)
+                samples.Length == 0)
                 return;
 
-            foreach (var sample in samples) _farendInputRingBuffer.Enqueue(sample);
-
             var totalSamplesInApmFrame = _apmFrameSizePerChannel * _numChannels;
+            var frame = _interleavedFarendApmFrame.AsSpan(0, totalSamplesInApmFrame);
+            var consumed = 0;
 
-            while (_farendInputRingBuffer.Count >= totalSamplesInApmFrame)
+            while (consumed < samples.Length)
             {
-                var currentApmInterleavedFarendFrame = ArrayPool<float>.Shared.Rent(totalSamplesInApmFrame);
-                try
-                {
-                    for (var i = 0; i < totalSamplesInApmFrame; i++)
-                        if (!_farendInputRingBuffer.TryDequeue(out currentApmInterleavedFarendFrame[i]))
-                            break;
-
-                    Deinterleave(currentApmInterleavedFarendFrame.AsSpan(0, totalSamplesInApmFrame),
-                        _numChannels, _apmFrameSizePerChannel, _deinterleavedFarendApmFrame);
-
-                    for (var ch = 0; ch < _numChannels; ch++)
-                        Marshal.Copy(_deinterleavedFarendApmFrame[ch], 0, _farendChannelPtrs![ch], _apmFrameSizePerChannel);
-
-                    ApmError error;
-                    lock (_apmLock)
-                    {
-                        if (!_isApmSuccessfullyInitialized || _apm == null) error = ApmError.UnspecifiedError;
-                        else
-                            error = NativeMethods.ProcessReverseStream(
-                                _apm.NativePtr, _farendChannelArrayPtr,
-                                _reverseInputStreamConfig.NativePtr, _reverseOutputStreamConfig.NativePtr,
-                                _dummyReverseOutputChannelArrayPtr);
-                    }
+                consumed += _farendInputRingBuffer.Write(samples[consumed..]);
 
-                    if (error != ApmError.NoError)
-                        UnityEngine.Debug.LogError($"WebRTC APM: Error processing reverse stream: {error}.");
-                }
-                finally
+                while (_farendInputRingBuffer.Count >= totalSamplesInApmFrame)
                 {
-                    ArrayPool<float>.Shared.Return(currentApmInterleavedFarendFrame);
+                    _farendInputRingBuffer.Read(frame);
+                    ProcessFarendFrame(frame);
                 }
             }
         }
 
+        /// <summary>
+        /// Feeds one interleaved far-end frame to the APM's reverse stream. Both the device callback and the queued
+        /// reference path share the far-end native frame, so the whole exchange runs under the APM lock.
+        /// </summary>
+        private void ProcessFarendFrame(ReadOnlySpan<float> frame)
+        {
+            ApmError error;
+            lock (_apmLock)
+            {
+                if (!_isApmSuccessfullyInitialized || _apm == null || _frameArena == null ||
+                    _reverseInputStreamConfig == null || _reverseOutputStreamConfig == null)
+                    return;
+
+                _frameArena.Write(FarendFrame, frame);
+                error = _apm.ProcessReverseStream(_farendChannelArrayPtr, _reverseInputStreamConfig,
+                    _reverseOutputStreamConfig, _dummyReverseOutputChannelArrayPtr);
+            }
+
+            if (error != ApmError.NoError)
+                UnityEngine.Debug.LogError($"WebRTC APM: Error processing reverse stream: {error}.");
+        }
+
         /// <summary>
         /// This method is not supported by the WebRtcApmModifier as it processes audio in frames, not sample-by-sample.
         /// </summary>
@@ -810,65 +825,15 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
         public override float ProcessSample(float sample, int channel) =>
             throw new NotSupportedException("WebRtcApmModifier processes audio in frames.");
 
-        private static void Deinterleave(ReadOnlySpan<float> interleaved, int numChannels, int frameSizePerChannel,
-            float[][]? deinterleavedTarget)
-        {
-            if (deinterleavedTarget == null) return;
-            for (var ch = 0; ch < numChannels; ch++)
-            {
-                if (deinterleavedTarget[ch] == null || deinterleavedTarget[ch].Length != frameSizePerChannel)
-                    deinterleavedTarget[ch] = new float[frameSizePerChannel];
-                for (var i = 0; i < frameSizePerChannel; i++)
-                {
-                    var idx = i * numChannels + ch;
-                    deinterleavedTarget[ch][i] = idx < interleaved.Length ? interleaved[idx] : 0f;
-                }
-            }
-        }
-
-        private static void Interleave(float[][] deinterleaved, int numChannels, int frameSizePerChannel,
-            Span<float> interleavedTarget)
-        {
-            for (var ch = 0; ch < numChannels; ch++)
-            {
-                if (deinterleaved?[ch] == null || deinterleaved[ch].Length < frameSizePerChannel) continue;
-                for (var i = 0; i < frameSizePerChannel; i++)
-                {
-                    var idx = i * numChannels + ch;
-                    if (idx < interleavedTarget.Length) interleavedTarget[idx] = deinterleaved[ch][i];
-                }
-            }
-        }
-
         private void DisposeApmNativeResources()
         {
             lock (_apmLock)
             {
-                // Free GCHandles first
-                if (_inputChannelArrayHandle.IsAllocated) _inputChannelArrayHandle.Free();
-                if (_outputChannelArrayHandle.IsAllocated) _outputChannelArrayHandle.Free();
-                if (_farendChannelArrayHandle.IsAllocated) _farendChannelArrayHandle.Free();
-                if (_dummyReverseOutputChannelArrayHandle.IsAllocated) _dummyReverseOutputChannelArrayHandle.Free();
+                _frameArena?.Dispose();
+                _frameArena = null;
                 _inputChannelArrayPtr = _outputChannelArrayPtr =
                     _farendChannelArrayPtr = _dummyReverseOutputChannelArrayPtr = IntPtr.Zero;
 
-                // Free HGlobal memory
-                Action<nint[]?> freePtrArray = arr =>
-                {
-                    if (arr != null)
-                        foreach (var ptr in arr)
-                            if (ptr != IntPtr.Zero)
-                                Marshal.FreeHGlobal(ptr);
-                };
-                freePtrArray(_inputChannelPtrs);
-                _inputChannelPtrs = null;
-                freePtrArray(_outputChannelPtrs);
-                _outputChannelPtrs = null;
-                freePtrArray(_farendChannelPtrs);
-                _farendChannelPtrs = null;
-                freePtrArray(_dummyReverseOutputChannelPtrs);
-                _dummyReverseOutputChannelPtrs = null;
-
                 // Dispose managed APM wrappers
                 _apm?.Dispose();
                 _apm = null;
@@ -914,12 +879,6 @@ namespace SoundFlow.Extensions.WebRtc.Apm.Modifiers
                 _outputRingBuffer.Clear();
                 _farendInputRingBuffer.Clear();
 
-                // Set large objects to null for GC
-                _deinterleavedInputApmFrame = null;
-                _deinterleavedOutputApmFrame = null;
-                _deinterleavedFarendApmFrame = null;
-
-
                 _isDisposed = true;
             }
         }
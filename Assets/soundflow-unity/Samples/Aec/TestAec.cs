@@ -77,8 +77,9 @@ public class TestAec : MonoBehaviour
         var captureInfo = SelectDeviceDefault(DeviceType.Capture);
         if (!playbackInfo.HasValue || !captureInfo.HasValue) return;
 
+        // One duplex callback keeps the echo reference clock-locked to the microphone.
         fullDuplexDevice = audioEngine.InitializeFullDuplexDevice(
-            playbackInfo.Value, captureInfo.Value, AecFormat, deviceConfig);
+            playbackInfo.Value, captureInfo.Value, AecFormat, deviceConfig, DuplexMode.Linked);
         fullDuplexDevice.Start();
 
         microphoneDataProvider = new MicrophoneDataProvider(fullDuplexDevice.CaptureDevice);
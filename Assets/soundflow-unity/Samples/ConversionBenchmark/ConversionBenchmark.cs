@@ -0,0 +1,85 @@
+using SoundFlow.Enums;
+using SoundFlow.Utils;
+using System;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using UnityEngine;
+using Debug = UnityEngine.Debug;
+
+/// <summary>
+/// Microbenchmark for the <see cref="DeviceBufferHelper"/> sample-format conversions.
+/// Attach to any GameObject; results are logged as samples/sec per format and direction on Start.
+/// Run it on the target device, since that is where S16/U8 device formats are negotiated.
+/// </summary>
+public class ConversionBenchmark : MonoBehaviour
+{
+    [Tooltip("Samples per conversion call, e.g. one 10 ms stereo period at 48 kHz is 960.")]
+    public int bufferSamples = 960;
+
+    [Tooltip("Minimum measured time per case, in milliseconds.")]
+    public int durationMs = 250;
+
+    private static readonly SampleFormat[] Formats =
+        { SampleFormat.U8, SampleFormat.S16, SampleFormat.S24, SampleFormat.S32, SampleFormat.F32 };
+
+    void Start()
+    {
+        Debug.Log($"ConversionBenchmark: {bufferSamples} samples/call, Vector<float>.Count = {System.Numerics.Vector<float>.Count}, " +
+                  $"hardware accelerated = {System.Numerics.Vector.IsHardwareAccelerated}");
+
+        var source = new float[bufferSamples];
+        var scratch = new float[bufferSamples];
+        var random = new System.Random(1234);
+        for (var i = 0; i < source.Length; i++)
+            source[i] = (float)(random.NextDouble() * 2.0 - 1.0);
+
+        var native = Marshal.AllocHGlobal(bufferSamples * sizeof(int));
+        try
+        {
+            foreach (var format in Formats)
+            {
+                var toDevice = Measure(() =>
+                {
+                    source.AsSpan().CopyTo(scratch); // ConvertToDeviceFormat clears its source.
+                    DeviceBufferHelper.ConvertToDeviceFormat(scratch, native, bufferSamples, format, false);
+                });
+                var toDeviceDither = format is SampleFormat.U8 or SampleFormat.S16 or SampleFormat.S24
+                    ? Measure(() =>
+                    {
+                        source.AsSpan().CopyTo(scratch);
+                        DeviceBufferHelper.ConvertToDeviceFormat(scratch, native, bufferSamples, format, true);
+                    })
+                    : double.NaN;
+                var fromDevice = Measure(() =>
+                    DeviceBufferHelper.ConvertFromDeviceFormat(native, scratch, bufferSamples, format));
+
+                Debug.Log($"{format,-4} to device: {toDevice / 1e6,8:F1} M samples/s" +
+                          (double.IsNaN(toDeviceDither) ? "" : $" | dithered: {toDeviceDither / 1e6,8:F1} M samples/s") +
+                          $" | from device: {fromDevice / 1e6,8:F1} M samples/s");
+            }
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(native);
+        }
+    }
+
+    /// <summary>
+    /// Runs <paramref name="action"/> repeatedly for at least <see cref="durationMs"/> and returns samples per second.
+    /// </summary>
+    private double Measure(Action action)
+    {
+        for (var i = 0; i < 100; i++) action(); // Warm up the JIT and caches.
+
+        var stopwatch = Stopwatch.StartNew();
+        long calls = 0;
+        while (stopwatch.ElapsedMilliseconds < durationMs)
+        {
+            for (var i = 0; i < 100; i++) action();
+            calls += 100;
+        }
+        stopwatch.Stop();
+
+        return calls * (double)bufferSamples / stopwatch.Elapsed.TotalSeconds;
+    }
+}
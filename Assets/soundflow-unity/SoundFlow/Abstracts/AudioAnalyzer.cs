@@ -1,14 +1,36 @@
-﻿using SoundFlow.Interfaces;
+﻿using SoundFlow.Enums;
+using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
+using System.Threading;
 
 namespace SoundFlow.Abstracts
 {
     /// <summary>
     /// Base class for audio analyzer components that extract data for visualizers.
     /// </summary>
+    /// <remarks>
+    /// By default <see cref="Analyze"/> and the visualizer run inline on the audio thread. After
+    /// <see cref="EnableAnalysisTap"/> the audio thread only copies each block into a lock-free snapshot ring, and the
+    /// analysis runs later on a shared worker thread or wherever <see cref="PumpAnalysis"/> is called. The audio
+    /// thread never waits: blocks that do not fit in the ring are dropped and counted in <see cref="DroppedBlocks"/>,
+    /// so a slow analyzer or visualizer can lag behind but cannot cause an underrun. The ring records where each block
+    /// ends, so the analysis always sees whole blocks, never the tail of one joined to the head of the next.
+    /// </remarks>
     public abstract class AudioAnalyzer
     {
+        private const int DefaultTapCapacity = 16384;
+        private const int MaxPendingBlocks = 256;
+
+        /// <summary>
+        /// Pumps the analyzers whose tap uses <see cref="AnalysisDispatch.Worker"/>. An analyzer that throws is
+        /// unregistered and its tap disabled; the others keep running.
+        /// </summary>
+        private static readonly PeriodicWorker<AudioAnalyzer> AnalysisWorker =
+            new("SoundFlow Analysis Worker", 10, (analyzer, _) => analyzer.PumpAnalysis(),
+                (analyzer, error) => analyzer.FailAnalysis(error));
+
         /// <summary>
         /// Gets the audio format of the analyzer.
         /// </summary>
@@ -27,6 +49,11 @@ namespace SoundFlow.Abstracts
 
         private readonly IVisualizer? _visualizer;
 
+        private volatile AnalysisTap? _tap;
+        private readonly object _pumpLock = new();
+        private long _droppedBlocks;
+        private long _coalescedSamples;
+
         /// <summary>
         /// Initializes a new instance of the <see cref="AudioAnalyzer"/> class.
         /// </summary>
@@ -40,12 +67,133 @@ namespace SoundFlow.Abstracts
 
 
         /// <summary>
-        /// Processes the audio data and sends it to the visualizer.
+        /// Gets where the analysis runs. <see cref="AnalysisDispatch.Inline"/> unless an analysis tap is enabled.
+        /// </summary>
+        public AnalysisDispatch Dispatch => _tap?.Dispatch ?? AnalysisDispatch.Inline;
+
+        /// <summary>
+        /// Gets the number of blocks the audio thread dropped because the snapshot ring was full.
+        /// </summary>
+        public long DroppedBlocks => Interlocked.Read(ref _droppedBlocks);
+
+        /// <summary>
+        /// Gets the number of pending samples discarded unanalyzed by <see cref="AnalysisCoalescing.Latest"/>.
+        /// </summary>
+        public long CoalescedSamples => Interlocked.Read(ref _coalescedSamples);
+
+        /// <summary>
+        /// Gets the exception that stopped this analyzer on the shared analysis worker, if any. The worker then
+        /// disables the tap, so the analyzer runs inline on the audio thread again; enable the tap again to resume.
+        /// </summary>
+        public Exception? AnalysisError { get; internal set; }
+
+        /// <summary>
+        /// Moves the analysis off the audio thread. Takes effect from the next processed block.
+        /// </summary>
+        /// <param name="dispatch">
+        /// Where the analysis runs. <see cref="AnalysisDispatch.Inline"/> is the same as <see cref="DisableAnalysisTap"/>.
+        /// </param>
+        /// <param name="coalescing">How blocks that queued up between two analysis passes are handled.</param>
+        /// <param name="decimation">Only every n-th block is captured for analysis. 1 captures every block.</param>
+        /// <param name="capacitySamples">The number of samples the snapshot ring holds.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if decimation or capacity is not positive.</exception>
+        public void EnableAnalysisTap(AnalysisDispatch dispatch, AnalysisCoalescing coalescing = AnalysisCoalescing.Latest,
+            int decimation = 1, int capacitySamples = DefaultTapCapacity)
+        {
+            if (decimation <= 0)
+                throw new ArgumentOutOfRangeException(nameof(decimation), "Decimation must be positive.");
+            if (capacitySamples <= 0)
+                throw new ArgumentOutOfRangeException(nameof(capacitySamples), "Capacity must be positive.");
+
+            DisableAnalysisTap();
+            if (dispatch == AnalysisDispatch.Inline)
+                return;
+
+            AnalysisError = null;
+            _tap = new AnalysisTap(dispatch, coalescing, decimation, capacitySamples);
+            if (dispatch == AnalysisDispatch.Worker)
+                AnalysisWorker.Register(this);
+        }
+
+        /// <summary>
+        /// Returns the analysis to the audio thread, discarding any audio still waiting in the snapshot ring.
+        /// </summary>
+        public void DisableAnalysisTap()
+        {
+            var tap = _tap;
+            if (tap == null) return;
+
+            _tap = null;
+            if (tap.Dispatch == AnalysisDispatch.Worker)
+                AnalysisWorker.Unregister(this);
+        }
+
+        /// <summary>
+        /// Records an exception thrown while the shared worker pumped this analyzer and drops the tap it was pumping,
+        /// so the audio thread stops filling a ring nothing drains any more.
+        /// </summary>
+        private void FailAnalysis(Exception error)
+        {
+            AnalysisWorker.Unregister(this);
+            AnalysisError = error;
+            if (_tap is { Dispatch: AnalysisDispatch.Worker })
+                _tap = null;
+        }
+
+        /// <summary>
+        /// Analyzes the audio captured by the analysis tap since the last call, and sends it to the visualizer.
+        /// Call it periodically when the tap uses <see cref="AnalysisDispatch.Manual"/>; with
+        /// <see cref="AnalysisDispatch.Worker"/> the shared worker calls it. Never call it from the audio thread.
+        /// </summary>
+        /// <returns>The number of samples analyzed, or zero if none were pending or no tap is enabled.</returns>
+        public int PumpAnalysis()
+        {
+            var tap = _tap;
+            if (tap == null) return 0;
+
+            lock (_pumpLock)
+            {
+                var ring = tap.Ring;
+                var channels = Math.Max(1, Volatile.Read(ref tap.Channels));
+                var blocksWritten = Volatile.Read(ref tap.BlocksWritten);
+                if (blocksWritten == tap.BlocksRead) return 0;
+
+                // Only blocks already recorded in BlockEnds are complete; one still being written stays pending.
+                var mask = tap.BlockEnds.Length - 1;
+                var readPosition = ring.TotalRead;
+                var end = tap.BlockEnds[(blocksWritten - 1) & mask];
+                if (tap.Coalescing == AnalysisCoalescing.Latest && blocksWritten - 1 > tap.BlocksRead)
+                {
+                    // Start the read at the boundary of the newest block. Its slot is safe to read: the producer
+                    // cannot reuse it before BlocksRead moves past it.
+                    var skip = (int)(tap.BlockEnds[(blocksWritten - 2) & mask] - readPosition);
+                    ring.AdvanceRead(skip);
+                    Interlocked.Add(ref _coalescedSamples, skip);
+                    readPosition += skip;
+                }
+
+                var block = tap.Scratch.AsSpan(0, ring.Read(tap.Scratch.AsSpan(0, (int)(end - readPosition))));
+                Volatile.Write(ref tap.BlocksRead, blocksWritten);
+                Analyze(block, channels);
+                _visualizer?.ProcessOnAudioData(block);
+                return block.Length;
+            }
+        }
+
+        /// <summary>
+        /// Processes the audio data and sends it to the visualizer, or queues it for the analysis tap if one is enabled.
         /// </summary>
         public void Process(Span<float> buffer, int channels)
         {
             if (!Enabled) return;
 
+            var tap = _tap;
+            if (tap != null)
+            {
+                Capture(tap, buffer, channels);
+                return;
+            }
+
             // Perform analysis on the buffer.
             Analyze(buffer, channels);
 
@@ -53,11 +201,60 @@ namespace SoundFlow.Abstracts
             _visualizer?.ProcessOnAudioData(buffer);
         }
 
+        /// <summary>
+        /// Copies a block into the snapshot ring on the audio thread, dropping it whole if it or its boundary does
+        /// not fit.
+        /// </summary>
+        private void Capture(AnalysisTap tap, ReadOnlySpan<float> buffer, int channels)
+        {
+            if (buffer.IsEmpty || tap.BlockCounter++ % tap.Decimation != 0) return;
+
+            Volatile.Write(ref tap.Channels, channels);
+            var blocks = tap.BlocksWritten;
+            if (blocks - Volatile.Read(ref tap.BlocksRead) >= tap.BlockEnds.Length || !tap.Ring.TryWrite(buffer))
+            {
+                Interlocked.Increment(ref _droppedBlocks);
+                return;
+            }
+
+            // Publishing the count after the end position lets the consumer trust every slot below it.
+            tap.BlockEnds[blocks & (tap.BlockEnds.Length - 1)] = tap.Ring.TotalWritten;
+            Volatile.Write(ref tap.BlocksWritten, blocks + 1);
+        }
+
         /// <summary>
         /// Analyzes the audio data.
         /// </summary>
         /// <param name="buffer">The audio buffer.</param>
         /// <param name="channels">The number of channels in the buffer.</param>
         protected abstract void Analyze(Span<float> buffer, int channels);
+
+        /// <summary>
+        /// The snapshot ring and settings of an enabled analysis tap. The audio thread is the ring's producer and
+        /// <see cref="PumpAnalysis"/> its consumer. <see cref="BlockEnds"/> is a second ring, in step with the first,
+        /// holding the ring position at which each captured block ends.
+        /// </summary>
+        private sealed class AnalysisTap
+        {
+            public readonly AnalysisDispatch Dispatch;
+            public readonly AnalysisCoalescing Coalescing;
+            public readonly int Decimation;
+            public readonly SpscRingBuffer Ring;
+            public readonly float[] Scratch;
+            public readonly long[] BlockEnds = new long[MaxPendingBlocks];
+            public int Channels = 1;
+            public long BlocksWritten;
+            public long BlocksRead;
+            public long BlockCounter;
+
+            public AnalysisTap(AnalysisDispatch dispatch, AnalysisCoalescing coalescing, int decimation, int capacitySamples)
+            {
+                Dispatch = dispatch;
+                Coalescing = coalescing;
+                Decimation = decimation;
+                Ring = new SpscRingBuffer(capacitySamples);
+                Scratch = new float[Ring.Capacity];
+            }
+        }
     }
 }
\ No newline at end of file
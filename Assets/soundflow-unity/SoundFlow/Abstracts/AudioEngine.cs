@@ -1,8 +1,13 @@
 using SoundFlow.Abstracts.Devices;
+using SoundFlow.Components;
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
+using SoundFlow.Providers;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
+using System.Collections.Generic;
+using System.Diagnostics;
 using System.IO;
 
 namespace SoundFlow.Abstracts
@@ -18,8 +23,9 @@ namespace SoundFlow.Abstracts
     /// </summary>
     public abstract class AudioEngine : IDisposable
     {
-        private SoundComponent? _soloedComponent;
+        private volatile SoundComponent? _soloedComponent;
         private readonly object _lock = new();
+        private volatile bool _performanceMonitoring;
 
 
 
@@ -81,13 +87,107 @@ namespace SoundFlow.Abstracts
         /// <summary>
         /// Gets the currently soloed component, if any.
         /// </summary>
+        /// <remarks>Lock-free, as it is queried by every playback callback.</remarks>
         /// <returns>The soloed SoundComponent or null.</returns>
-        public SoundComponent? GetSoloedComponent()
+        public SoundComponent? GetSoloedComponent() => _soloedComponent;
+
+        /// <summary>
+        /// Gets or sets whether device callbacks, graph nodes and modifiers are timed. Off by default.
+        /// </summary>
+        /// <remarks>
+        /// Measuring reads the <see cref="Stopwatch"/> a few times per node per block and never allocates. The
+        /// results are read through <see cref="GetPerformanceSnapshot"/>, or per object through
+        /// <see cref="SoundComponent.InclusiveTime"/>, <see cref="SoundComponent.ExclusiveTime"/> and
+        /// <see cref="SoundModifier.ProcessTime"/>.
+        /// </remarks>
+        public bool PerformanceMonitoring
         {
-            lock (_lock)
+            get => _performanceMonitoring;
+            set => _performanceMonitoring = value;
+        }
+
+        /// <summary>
+        /// Gets the devices currently initialized by this engine. Used to build performance snapshots.
+        /// </summary>
+        /// <returns>The active devices.</returns>
+        protected virtual IReadOnlyList<AudioDevice> GetActiveDevices() => Array.Empty<AudioDevice>();
+
+        /// <summary>
+        /// Captures the callback statistics of every active device and the render timings of every node in their
+        /// graphs. Safe to call from any thread except the audio thread, which it never blocks.
+        /// </summary>
+        /// <returns>A copy of the current statistics.</returns>
+        public PerformanceSnapshot GetPerformanceSnapshot()
+        {
+            var devices = new List<DevicePerformance>();
+            var nodes = new List<NodePerformance>();
+            var visited = new HashSet<SoundComponent>();
+
+            foreach (var device in GetActiveDevices())
+            {
+                // A duplex device is a pair of devices that are reported on their own.
+                if (device is FullDuplexDevice) continue;
+
+                var monitor = device.CallbackMonitor;
+                var histogram = new long[CallbackMonitor.HistogramBuckets];
+                monitor.CopyHistogram(histogram);
+                devices.Add(new DevicePerformance(device, monitor.Duration.Snapshot(),
+                    monitor.BudgetTicks * 1000.0 / Stopwatch.Frequency, monitor.Jitter.Snapshot(), monitor.DeadlineMisses,
+                    monitor.LateCallbacks, histogram));
+
+                if (device is AudioPlaybackDevice playback)
+                    CollectNodes(playback.MasterMixer, 0, nodes, visited);
+            }
+
+            return new PerformanceSnapshot(devices, nodes);
+        }
+
+        /// <summary>
+        /// Clears the statistics of every active device and every node in their graphs.
+        /// </summary>
+        public void ResetPerformanceStatistics()
+        {
+            var nodes = new List<NodePerformance>();
+            var visited = new HashSet<SoundComponent>();
+
+            foreach (var device in GetActiveDevices())
             {
-                return _soloedComponent;
+                device.CallbackMonitor.Reset();
+                if (device is AudioPlaybackDevice playback)
+                    CollectNodes(playback.MasterMixer, 0, nodes, visited);
             }
+
+            foreach (var node in visited)
+                node.ResetTiming();
+        }
+
+        private static void CollectNodes(SoundComponent component, int depth, List<NodePerformance> nodes,
+            HashSet<SoundComponent> visited)
+        {
+            if (!visited.Add(component)) return;
+
+            var modifiers = component.ModifiersSnapshot;
+            var modifierPerformance = new ModifierPerformance[modifiers.Length];
+            for (var i = 0; i < modifiers.Length; i++)
+                modifierPerformance[i] = new ModifierPerformance(modifiers[i]);
+
+            var starvations = component is SoundPlayerBase player
+                ? player.DataProvider switch
+                {
+                    ChunkedDataProvider chunked => chunked.StarvationCount,
+                    MicrophoneDataProvider microphone => microphone.UnderrunCount,
+                    _ => -1
+                }
+                : -1;
+
+            nodes.Add(new NodePerformance(component, depth, modifierPerformance, starvations));
+
+            foreach (var input in component.InputsSnapshot)
+                CollectNodes(input, depth + 1, nodes, visited);
+
+            if (component is Mixer mixer)
+                foreach (var child in mixer.Components)
+                    CollectNodes(child, depth + 1, nodes, visited);
         }
 
         /// <summary>
@@ -133,8 +233,12 @@ namespace SoundFlow.Abstracts
         /// <param name="captureDeviceInfo">The capture device to use. Use null for the system default.</param>
         /// <param name="format">The audio format to use for both devices.</param>
         /// <param name="config">Optional detailed configuration for the devices.</param>
+        /// <param name="mode">
+        /// Whether input and output run on two independent devices, or on one duplex device whose callback delivers
+        /// input and renders output together for the lowest round-trip latency and a clock-locked echo reference.
+        /// </param>
         /// <returns>An initialized <see cref="FullDuplexDevice"/> ready for use.</returns>
-        public abstract FullDuplexDevice InitializeFullDuplexDevice(DeviceInfo? playbackDeviceInfo, DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig? config = null);
+        public abstract FullDuplexDevice InitializeFullDuplexDevice(DeviceInfo? playbackDeviceInfo, DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig? config = null, DuplexMode mode = DuplexMode.Separate);
 
         /// <summary>
         /// Initializes a loopback capture device, allowing for the recording of system audio output.
@@ -149,6 +253,12 @@ namespace SoundFlow.Abstracts
         /// Switches an active playback device to a new physical device, preserving its audio graph.
         /// The old device instance will be disposed.
         /// </summary>
+        /// <remarks>
+        /// The switch is not synchronized with other users of <paramref name="oldDevice"/>: call it on the thread
+        /// that owns the device, or make sure no other thread starts, stops, reconfigures or disposes the old
+        /// device until it returns, and that every reference to it is replaced by the returned device. Afterwards
+        /// the old instance is disposed and must not be used. The same applies to every overload.
+        /// </remarks>
         /// <param name="oldDevice">The playback device instance to replace.</param>
         /// <param name="newDeviceInfo">The info for the new physical device to use.</param>
         /// <param name="config">Optional configuration for the new device.</param>
@@ -157,7 +267,8 @@ namespace SoundFlow.Abstracts
 
         /// <summary>
         /// Switches an active capture device to a new physical device, preserving its event subscribers.
-        /// The old device instance will be disposed.
+        /// The old device instance will be disposed. Not synchronized with other users of the old device; see
+        /// <see cref="SwitchDevice(AudioPlaybackDevice, DeviceInfo, DeviceConfig)"/>.
         /// </summary>
         /// <param name="oldDevice">The capture device instance to replace.</param>
         /// <param name="newDeviceInfo">The info for the new physical device to use.</param>
@@ -166,8 +277,9 @@ namespace SoundFlow.Abstracts
         public abstract AudioCaptureDevice SwitchDevice(AudioCaptureDevice oldDevice, DeviceInfo newDeviceInfo, DeviceConfig? config = null);
 
         /// <summary>
-        /// Switches the devices used by a full-duplex instance, preserving its state.
-        /// The old duplex device instance will be disposed.
+        /// Switches the devices used by a full-duplex instance, preserving its state and <see cref="FullDuplexDevice.Mode"/>.
+        /// The old duplex device instance will be disposed. Not synchronized with other users of the old device;
+        /// see <see cref="SwitchDevice(AudioPlaybackDevice, DeviceInfo, DeviceConfig)"/>.
         /// </summary>
         /// <param name="oldDevice">The full-duplex device instance to replace.</param>
         /// <param name="newPlaybackInfo">Info for the new playback device. If null, the existing playback device is used.</param>
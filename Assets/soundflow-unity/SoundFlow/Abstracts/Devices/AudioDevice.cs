@@ -1,5 +1,6 @@
 using SoundFlow.Enums;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Abstracts.Devices
@@ -44,11 +45,25 @@ namespace SoundFlow.Abstracts.Devices
         /// </summary>
         public bool IsDisposed { get; protected set; }
 
+        /// <summary>
+        /// Gets the estimated latency of the device in milliseconds: from rendering a frame to hearing it on a
+        /// playback device, from capturing a frame to receiving it on a capture device, or the sum of both on a
+        /// full-duplex device, which is the echo path delay an echo canceller needs. 0 if the backend cannot tell.
+        /// </summary>
+        /// <remarks>The estimate uses the size of the callbacks seen so far, so it is most accurate once the device runs.</remarks>
+        public virtual double LatencyMilliseconds => 0;
+
         /// <summary>
         /// Occurs when the audio device is disposed.
         /// </summary>
         public EventHandler? OnDisposed;
 
+        /// <summary>
+        /// Gets the callback statistics recorded while the engine's <see cref="AudioEngine.PerformanceMonitoring"/>
+        /// is enabled. Written by the backend's callback.
+        /// </summary>
+        internal CallbackMonitor CallbackMonitor { get; } = new();
+
         /// <summary>
         /// Initializes a new instance of the <see cref="AudioDevice"/> class.
         /// </summary>
@@ -14,6 +14,12 @@ namespace SoundFlow.Abstracts.Devices
         /// </summary>
         public Mixer MasterMixer { get; }
 
+        /// <summary>
+        /// Gets the largest number of frames the device renders in one pass through the graph, used to size render
+        /// buffers up front; 0 if the backend cannot tell.
+        /// </summary>
+        public virtual int MaxBlockFrames => 0;
+
         /// <summary>
         /// Initializes a new instance of the <see cref="AudioPlaybackDevice"/> class.
         /// </summary>
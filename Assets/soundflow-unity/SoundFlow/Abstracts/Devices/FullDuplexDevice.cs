@@ -1,4 +1,5 @@
 ﻿using SoundFlow.Components;
+using SoundFlow.Enums;
 using SoundFlow.Structs;
 using System;
 
@@ -9,6 +10,11 @@ namespace SoundFlow.Abstracts.Devices
     /// easy full-duplex (simultaneous input and output) operation.
     /// Ideal for live effects processing, VoIP, or instrument monitoring.
     /// </summary>
+    /// <remarks>
+    /// In <see cref="DuplexMode.Linked"/> mode both devices are views of one duplex device: every callback raises
+    /// <see cref="OnAudioProcessed"/> with the captured block, then renders the same number of frames through
+    /// <see cref="MasterMixer"/>. Backends without native duplex support fall back to <see cref="DuplexMode.Separate"/>.
+    /// </remarks>
     public sealed class FullDuplexDevice : AudioDevice, IDisposable
     {
         /// <summary>
@@ -21,6 +27,11 @@ namespace SoundFlow.Abstracts.Devices
         /// </summary>
         public AudioCaptureDevice CaptureDevice { get; }
 
+        /// <summary>
+        /// Gets how input and output are driven: by two independent callbacks, or by a single duplex callback.
+        /// </summary>
+        public DuplexMode Mode { get; }
+
         /// <summary>
         /// Gets the master mixer for the playback device. You can add other components
         /// (e.g., music players, synthesizers) to this mixer to play them.
@@ -44,12 +55,34 @@ namespace SoundFlow.Abstracts.Devices
         /// <param name="captureDeviceInfo">The device information for the capture device.</param>
         /// <param name="format">The audio format to use.</param>
         /// <param name="config">The device configuration to use.</param>
-        internal FullDuplexDevice(AudioEngine engine, DeviceInfo? playbackDeviceInfo, DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig config) : base(engine, format, config)
+        /// <param name="mode">The mode reported by <see cref="Mode"/>, for backends whose separate devices already run in lockstep.</param>
+        internal FullDuplexDevice(AudioEngine engine, DeviceInfo? playbackDeviceInfo, DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig config, DuplexMode mode = DuplexMode.Separate)
+            : this(engine, engine.InitializePlaybackDevice(playbackDeviceInfo, format, config),
+                engine.InitializeCaptureDevice(captureDeviceInfo, format, config), format, config, mode)
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="FullDuplexDevice"/> class over devices created by the backend,
+        /// such as the two sides of a native duplex device.
+        /// </summary>
+        /// <param name="engine">The audio engine to use.</param>
+        /// <param name="playbackDevice">The playback side.</param>
+        /// <param name="captureDevice">The capture side.</param>
+        /// <param name="format">The audio format to use.</param>
+        /// <param name="config">The device configuration to use.</param>
+        /// <param name="mode">How the two sides are driven.</param>
+        internal FullDuplexDevice(AudioEngine engine, AudioPlaybackDevice playbackDevice, AudioCaptureDevice captureDevice, AudioFormat format, DeviceConfig config, DuplexMode mode) : base(engine, format, config)
         {
-            PlaybackDevice = engine.InitializePlaybackDevice(playbackDeviceInfo, format, config);
-            CaptureDevice = engine.InitializeCaptureDevice(captureDeviceInfo, format, config);
+            PlaybackDevice = playbackDevice;
+            CaptureDevice = captureDevice;
+            Mode = mode;
+            Capability = Capability.Mixed;
         }
 
+        /// <inheritdoc />
+        public override double LatencyMilliseconds => PlaybackDevice.LatencyMilliseconds + CaptureDevice.LatencyMilliseconds;
+
         /// <summary>
         /// Starts both the capture and playback devices.
         /// </summary>
@@ -0,0 +1,211 @@
+using SoundFlow.Components;
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+namespace SoundFlow.Abstracts
+{
+    /// <summary>
+    ///     An immutable, flattened render order for the graph below a root <see cref="SoundComponent"/>.
+    /// </summary>
+    /// <remarks>
+    ///     Plans are compiled on the thread that edits the graph and executed by the audio thread.
+    ///     Every component is emitted as a begin step and an end step in post-order, so its inputs (and, for mixers,
+    ///     its children) are rendered between the two. Each nesting depth owns one preallocated scratch buffer,
+    ///     which makes execution a single loop over a flat array with no locks, recursion or allocations.
+    ///     The buffers are sized for the largest block of the device the root renders for; a larger block is
+    ///     rendered as consecutive sub-blocks that fit them.
+    /// </remarks>
+    internal sealed class RenderPlan
+    {
+        /// <summary>
+        ///     Serializes plan compilation and publication across all roots.
+        /// </summary>
+        internal static readonly object CompileLock = new();
+
+        private const int DefaultScratchCapacity = 4096;
+
+        private readonly RenderStep[] _steps;
+        private readonly float[][] _scratch;
+        private readonly int _capacity;
+
+        // Per nesting depth, the start timestamp and enclosing child time of the component being timed.
+        private readonly long[] _timingStart;
+        private readonly long[] _timingOuterChildTicks;
+
+        private RenderPlan(RenderStep[] steps, float[][] scratch, int capacity)
+        {
+            _steps = steps;
+            _scratch = scratch;
+            _capacity = capacity;
+            _timingStart = new long[scratch.Length];
+            _timingOuterChildTicks = new long[scratch.Length];
+        }
+
+        /// <summary>
+        ///     Compiles a render plan for the graph below <paramref name="root"/>.
+        /// </summary>
+        /// <param name="root">The component the plan renders.</param>
+        /// <param name="previous">The plan being replaced, whose scratch buffers are reused.</param>
+        /// <returns>The compiled plan.</returns>
+        public static RenderPlan Compile(SoundComponent root, RenderPlan? previous)
+        {
+            var steps = new List<RenderStep>();
+            var path = new HashSet<SoundComponent>();
+            var children = new List<SoundComponent>();
+            var maxDepth = 0;
+
+            Emit(root, 0, RenderStep.RootTarget);
+
+            var previousScratch = previous?._scratch ?? Array.Empty<float[]>();
+            var capacity = Math.Max(DefaultScratchCapacity, Math.Max(previous?._capacity ?? 0, GetDeviceCapacity(root)));
+
+            var scratch = new float[maxDepth + 1][];
+            for (var i = 0; i < scratch.Length; i++)
+                scratch[i] = i < previousScratch.Length && previousScratch[i].Length >= capacity
+                    ? previousScratch[i]
+                    : new float[capacity];
+
+            return new RenderPlan(steps.ToArray(), scratch, capacity);
+
+            void Emit(SoundComponent node, int depth, int targetSlot)
+            {
+                // Cycles cannot be rendered; the recursive path would never terminate either.
+                if (!path.Add(node)) return;
+
+                maxDepth = Math.Max(maxDepth, depth);
+                var beginIndex = steps.Count;
+                steps.Add(default);
+
+                foreach (var input in node.InputsSnapshot)
+                    Emit(input, depth + 1, depth);
+
+                children.Clear();
+                var flattensChildren = node.CollectRenderChildren(children);
+                foreach (var child in children.ToArray())
+                    Emit(child, depth + 1, depth);
+
+                var endIndex = steps.Count;
+                steps.Add(new RenderStep(node, depth, targetSlot, endIndex, true, !flattensChildren,
+                    node.ModifiersSnapshot, node.AnalyzersSnapshot));
+                steps[beginIndex] = new RenderStep(node, depth, targetSlot, endIndex, false, false,
+                    Array.Empty<SoundModifier>(), Array.Empty<AudioAnalyzer>());
+
+                path.Remove(node);
+            }
+        }
+
+        /// <summary>
+        ///     Gets the number of samples in the largest block of the playback device at the top of
+        ///     <paramref name="root"/>'s mixer tree, or 0 if it is not attached to one.
+        /// </summary>
+        private static int GetDeviceCapacity(SoundComponent root)
+        {
+            var top = root as Mixer ?? root.Parent;
+            while (top?.Parent != null) top = top.Parent;
+
+            var deviceSamples = (long)(top?.ParentDevice?.MaxBlockFrames ?? 0) * Math.Max(1, root.Format.Channels);
+            return (int)Math.Min(deviceSamples, int.MaxValue);
+        }
+
+        /// <summary>
+        ///     Renders the plan and mixes the root's output into <paramref name="output"/>.
+        ///     Must only be called from one thread at a time.
+        /// </summary>
+        /// <param name="output">The buffer to mix into.</param>
+        /// <param name="channels">The number of channels in the buffer.</param>
+        public void Execute(Span<float> output, int channels)
+        {
+            if (output.Length <= _capacity)
+            {
+                ExecuteBlock(output, channels);
+                return;
+            }
+
+            // Longer than the device promised: render whole-frame sub-blocks rather than grow the scratch buffers.
+            var blockSamples = _capacity - _capacity % Math.Max(1, channels);
+            for (var offset = 0; offset < output.Length; offset += blockSamples)
+                ExecuteBlock(output.Slice(offset, Math.Min(blockSamples, output.Length - offset)), channels);
+        }
+
+        private void ExecuteBlock(Span<float> output, int channels)
+        {
+            var steps = _steps;
+            var scratch = _scratch;
+            var length = output.Length;
+            var monitoring = steps.Length > 0 && steps[0].Component.Engine.PerformanceMonitoring;
+
+            for (var i = 0; i < steps.Length; i++)
+            {
+                ref readonly var step = ref steps[i];
+                var component = step.Component;
+
+                if (!step.IsEnd)
+                {
+                    if (!component.IsRenderable)
+                    {
+                        // Skip the whole subtree, exactly like the recursive path returns early.
+                        i = step.EndIndex;
+                        continue;
+                    }
+
+                    scratch[step.Slot].AsSpan(0, length).Clear();
+
+                    if (monitoring)
+                    {
+                        // Mirrors the recursive path: the subtree's own timings nest inside this depth's slot.
+                        _timingOuterChildTicks[step.Slot] = TimingCounter.ChildTicks;
+                        TimingCounter.ChildTicks = 0;
+                        _timingStart[step.Slot] = Stopwatch.GetTimestamp();
+                    }
+
+                    continue;
+                }
+
+                var working = scratch[step.Slot].AsSpan(0, length);
+                if (step.GeneratesAudio)
+                    component.RenderGenerate(working, channels);
+
+                var target = step.TargetSlot == RenderStep.RootTarget
+                    ? output
+                    : scratch[step.TargetSlot].AsSpan(0, length);
+
+                component.FinishRender(working, target, channels, step.Modifiers, step.Analyzers);
+
+                if (monitoring)
+                    component.EndTiming(_timingStart[step.Slot], _timingOuterChildTicks[step.Slot]);
+            }
+        }
+
+        /// <summary>
+        ///     A single entry of a render plan.
+        /// </summary>
+        private readonly struct RenderStep
+        {
+            public const int RootTarget = -1;
+
+            public readonly SoundComponent Component;
+            public readonly int Slot;
+            public readonly int TargetSlot;
+            public readonly int EndIndex;
+            public readonly bool IsEnd;
+            public readonly bool GeneratesAudio;
+            public readonly SoundModifier[] Modifiers;
+            public readonly AudioAnalyzer[] Analyzers;
+
+            public RenderStep(SoundComponent component, int slot, int targetSlot, int endIndex, bool isEnd,
+                bool generatesAudio, SoundModifier[] modifiers, AudioAnalyzer[] analyzers)
+            {
+                Component = component;
+                Slot = slot;
+                TargetSlot = targetSlot;
+                EndIndex = endIndex;
+                IsEnd = isEnd;
+                GeneratesAudio = generatesAudio;
+                Modifiers = modifiers;
+                Analyzers = analyzers;
+            }
+        }
+    }
+}
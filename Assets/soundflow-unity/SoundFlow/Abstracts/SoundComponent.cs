@@ -1,10 +1,10 @@
 using SoundFlow.Components;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.Buffers;
 using System.Collections.Generic;
-using System.Numerics;
-using System.Runtime.CompilerServices;
+using System.Diagnostics;
 
 namespace SoundFlow.Abstracts
 {
@@ -16,20 +16,28 @@ namespace SoundFlow.Abstracts
     {
         private static readonly ArrayPool<float> BufferPool = ArrayPool<float>.Shared;
 
-        // Connection state
-        private readonly List<SoundComponent> _inputs = new List<SoundComponent>();
+        // Connection state. Inputs, modifiers and analyzers are copy-on-write arrays so the audio thread
+        // can read them without taking a lock.
+        private volatile SoundComponent[] _inputs = Array.Empty<SoundComponent>();
         private readonly List<SoundComponent> _outputs = new List<SoundComponent>();
         private readonly object _connectionsLock = new();
 
         // Processing state
-        private readonly List<SoundModifier> _modifiers = new List<SoundModifier>();
-        private readonly List<AudioAnalyzer> _analyzers = new List<AudioAnalyzer>();
+        private volatile SoundModifier[] _modifiers = Array.Empty<SoundModifier>();
+        private volatile AudioAnalyzer[] _analyzers = Array.Empty<AudioAnalyzer>();
         private float _pan = 0.5f;
         private bool _solo;
         private float _volume = 1f;
-        private Vector2 _volumePanFactors;
         private readonly object _stateLock = new();
 
+        // Compiled rendering state
+        private bool _compiledRendering;
+        private volatile RenderPlan? _renderPlan;
+
+        // Performance monitoring, written by whichever thread renders this component.
+        internal readonly TimingCounter InclusiveTiming = new();
+        internal readonly TimingCounter ExclusiveTiming = new();
+
         /// <summary>
         /// 
         /// </summary>
@@ -55,6 +63,18 @@ namespace SoundFlow.Abstracts
         /// </summary>
         public Mixer? Parent { get; set; }
 
+        /// <summary>
+        ///     Gets the time spent rendering this component including its inputs and children, measured while the
+        ///     engine's <see cref="AudioEngine.PerformanceMonitoring"/> is enabled.
+        /// </summary>
+        public TimingStats InclusiveTime => InclusiveTiming.Snapshot();
+
+        /// <summary>
+        ///     Gets the time spent rendering this component itself, excluding its inputs and children, measured while
+        ///     the engine's <see cref="AudioEngine.PerformanceMonitoring"/> is enabled.
+        /// </summary>
+        public TimingStats ExclusiveTime => ExclusiveTiming.Snapshot();
+
         /// <summary>
         ///     Initializes a new instance of the <see cref="SoundComponent" /> class.
         /// </summary>
@@ -62,7 +82,6 @@ namespace SoundFlow.Abstracts
         {
             Engine = engine;
             Format = format;
-            UpdateVolumePanFactors(Format.Channels);
         }
 
         /// <summary>
@@ -107,11 +126,7 @@ namespace SoundFlow.Abstracts
             {
                 //ObjectDisposedException.ThrowIf(IsDisposed, this);
                 //ArgumentOutOfRangeException.ThrowIfNegative(value);
-                lock (_stateLock)
-                {
-                    _volume = value;
-                    UpdateVolumePanFactors(Format.Channels);
-                }
+                _volume = value;
             }
         }
 
@@ -127,11 +142,7 @@ namespace SoundFlow.Abstracts
             {
                 //ObjectDisposedException.ThrowIf(IsDisposed, this);
                 if (value is < 0f or > 1f) throw new ArgumentOutOfRangeException(nameof(value), "Pan must be between 0.0 and 1.0.");
-                lock (_stateLock)
-                {
-                    _pan = value;
-                    UpdateVolumePanFactors(Format.Channels);
-                }
+                _pan = value;
             }
         }
 
@@ -168,40 +179,83 @@ namespace SoundFlow.Abstracts
         /// <summary>
         ///     Modifiers applied to the component
         /// </summary>
-        public IReadOnlyList<SoundModifier?> Modifiers
-        {
-            get
-            {
-                lock (_stateLock) return new List<SoundModifier?>(_modifiers);
-            }
-        }
+        public IReadOnlyList<SoundModifier?> Modifiers => new List<SoundModifier?>(_modifiers);
 
         /// <summary>
         ///     Analyzers applied to the component
         /// </summary>
-        public IReadOnlyList<AudioAnalyzer> Analyzers
+        public IReadOnlyList<AudioAnalyzer> Analyzers => new List<AudioAnalyzer>(_analyzers);
+
+        /// <summary>
+        ///     Whether this component renders its graph from a precompiled render plan when it is processed as a root,
+        ///     for example as the master mixer of a playback device.
+        /// </summary>
+        /// <remarks>
+        ///     The plan is a flat, topologically sorted list of the components below this one with preassigned scratch
+        ///     buffers. It is rebuilt on the thread that edits the graph (<see cref="ConnectInput"/>,
+        ///     <see cref="AddModifier"/>, <see cref="Mixer.AddComponent"/>, ...) and published atomically, so the audio
+        ///     thread walks it without taking locks or allocating.
+        /// </remarks>
+        public bool CompiledRendering
         {
-            get
+            get => _compiledRendering;
+            set
             {
-                lock (_stateLock) return new List<AudioAnalyzer>(_analyzers);
+                lock (RenderPlan.CompileLock)
+                {
+                    _compiledRendering = value;
+                    _renderPlan = value ? RenderPlan.Compile(this, _renderPlan) : null;
+                }
             }
         }
 
-        private void UpdateVolumePanFactors(int channels)
+        /// <summary>
+        ///     Gets whether the component currently takes part in rendering.
+        /// </summary>
+        internal bool IsRenderable => Enabled && !Mute && !IsDisposed;
+
+        /// <summary>
+        ///     Gets the current input connections without copying them. For the render path only.
+        /// </summary>
+        internal SoundComponent[] InputsSnapshot => _inputs;
+
+        /// <summary>
+        ///     Gets the current modifiers without copying them. For the render path only.
+        /// </summary>
+        internal SoundModifier[] ModifiersSnapshot => _modifiers;
+
+        /// <summary>
+        ///     Gets the current analyzers without copying them. For the render path only.
+        /// </summary>
+        internal AudioAnalyzer[] AnalyzersSnapshot => _analyzers;
+
+        /// <summary>
+        ///     Fills one gain per interleaved channel from the current volume and constant-power pan.
+        ///     Channels beyond the first two get the average of the left and right gains.
+        /// </summary>
+        /// <returns>True if every gain is unity, so the signal can be mixed without scaling.</returns>
+        private bool GetChannelGains(Span<float> gains, int channels)
         {
-            var panValue = Math.Clamp(_pan, 0f, 1f);
-            if (channels == 1)
-            {
-                // For mono, combine pan to a single gain factor.
-                _volumePanFactors = new Vector2(_volume, 0);
-            }
-            else
+            var volume = _volume;
+
+            // For mono, pan has no effect.
+            if (channels <= 1)
             {
-                _volumePanFactors = new Vector2(
-                    _volume * MathF.Sqrt(1f - panValue),
-                    _volume * MathF.Sqrt(panValue)
-                );
+                gains[0] = Math.Abs(volume);
+                return Math.Abs(gains[0] - 1f) < 1e-6f;
             }
+
+            var panValue = Math.Clamp(_pan, 0f, 1f);
+            var left = volume * MathF.Sqrt(1f - panValue);
+            var right = volume * MathF.Sqrt(panValue);
+            var average = (left + right) * 0.5f;
+
+            gains[0] = left;
+            gains[1] = right;
+            for (var i = 2; i < channels; i++)
+                gains[i] = average;
+
+            return channels == 2 && Math.Abs(left - 1f) < 1e-7f && Math.Abs(right - 1f) < 1e-7f;
         }
 
         /// <summary>
@@ -232,14 +286,16 @@ namespace SoundFlow.Abstracts
             lock (first._connectionsLock)
                 lock (second._connectionsLock)
                 {
-                    if (_inputs.Contains(input)) return;
+                    if (Array.IndexOf(_inputs, input) >= 0) return;
 
                     if (IsReachable(input, this))
                         throw new InvalidOperationException("Connection would create a cycle");
 
-                    _inputs.Add(input);
+                    _inputs = CopyWith(_inputs, input);
                     input._outputs.Add(this);
                 }
+
+            InvalidateRenderPlans();
         }
 
         /// <summary>
@@ -257,11 +313,14 @@ namespace SoundFlow.Abstracts
 
             lock (_connectionsLock)
             {
-                if (!_inputs.Remove(input)) return;
+                if (Array.IndexOf(_inputs, input) < 0) return;
+                _inputs = CopyWithout(_inputs, input);
 
                 lock (input._connectionsLock)
                     input._outputs.Remove(this);
             }
+
+            InvalidateRenderPlans();
         }
 
         private static bool IsReachable(SoundComponent start, SoundComponent target)
@@ -297,9 +356,11 @@ namespace SoundFlow.Abstracts
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
             lock (_stateLock)
             {
-                if (!_modifiers.Contains(modifier))
-                    _modifiers.Add(modifier);
+                if (Array.IndexOf(_modifiers, modifier) >= 0) return;
+                _modifiers = CopyWith(_modifiers, modifier);
             }
+
+            InvalidateRenderPlans();
         }
 
         /// <summary>
@@ -311,7 +372,9 @@ namespace SoundFlow.Abstracts
         {
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
             lock (_stateLock)
-                _modifiers.Remove(modifier);
+                _modifiers = CopyWithout(_modifiers, modifier);
+
+            InvalidateRenderPlans();
         }
 
         /// <summary>
@@ -324,9 +387,11 @@ namespace SoundFlow.Abstracts
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
             lock (_stateLock)
             {
-                if (!_analyzers.Contains(analyzer))
-                    _analyzers.Add(analyzer);
+                if (Array.IndexOf(_analyzers, analyzer) >= 0) return;
+                _analyzers = CopyWith(_analyzers, analyzer);
             }
+
+            InvalidateRenderPlans();
         }
 
         /// <summary>
@@ -338,237 +403,193 @@ namespace SoundFlow.Abstracts
         {
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
             lock (_stateLock)
-                _analyzers.Remove(analyzer);
+                _analyzers = CopyWithout(_analyzers, analyzer);
+
+            InvalidateRenderPlans();
         }
 
-        internal void Process(Span<float> outputBuffer, int channels)
+        /// <summary>
+        ///     Rebuilds the render plan of every compiled root that renders this component.
+        ///     Must be called after any change to the topology below a component.
+        /// </summary>
+        internal void InvalidateRenderPlans()
         {
-            if (!Enabled || Mute || IsDisposed) return;
-
-            float[]? rentedBuffer = null;
-            try
+            lock (RenderPlan.CompileLock)
             {
-                rentedBuffer = BufferPool.Rent(outputBuffer.Length);
-                var workingBuffer = rentedBuffer.AsSpan(0, outputBuffer.Length);
-                workingBuffer.Clear();
+                var visited = new HashSet<SoundComponent>();
+                var pending = new Stack<SoundComponent>();
+                pending.Push(this);
 
-                SoundComponent[] currentInputs;
-                lock (_connectionsLock)
+                while (pending.Count > 0)
                 {
-                    currentInputs = _inputs.Count == 0 ? Array.Empty<SoundComponent>() : _inputs.ToArray();
-                }
+                    var current = pending.Pop();
+                    if (!visited.Add(current)) continue;
 
-                foreach (var input in currentInputs)
-                    input.Process(workingBuffer, channels);
-
-                GenerateAudio(workingBuffer, channels);
+                    current.OnRenderTopologyChanged();
+                    if (current._compiledRendering)
+                        current._renderPlan = RenderPlan.Compile(current, current._renderPlan);
 
-                SoundModifier[] currentModifiers;
-                AudioAnalyzer[] currentAnalyzers;
-                Vector2 currentVolumePan;
+                    lock (current._connectionsLock)
+                    {
+                        foreach (var output in current._outputs)
+                            pending.Push(output);
+                    }
 
-                lock (_stateLock)
-                {
-                    currentModifiers = _modifiers.Count == 0 ? Array.Empty<SoundModifier>() : _modifiers.ToArray();
-                    currentAnalyzers = _analyzers.Count == 0 ? Array.Empty<AudioAnalyzer>() : _analyzers.ToArray();
-                    UpdateVolumePanFactors(channels);
-                    currentVolumePan = _volumePanFactors;
+                    var parent = current.Parent;
+                    if (parent != null) pending.Push(parent);
                 }
-
-                foreach (var modifier in currentModifiers)
-                    if (modifier.Enabled)
-                        modifier.Process(workingBuffer, channels);
-
-                ApplyVolumeAndPanning(workingBuffer, currentVolumePan, channels);
-
-                MixBuffers(workingBuffer, outputBuffer);
-
-                foreach (var analyzer in currentAnalyzers)
-                    analyzer.Process(workingBuffer, channels);
-            }
-            finally
-            {
-                if (rentedBuffer != null)
-                    BufferPool.Return(rentedBuffer);
             }
         }
 
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private static void MixBuffers(ReadOnlySpan<float> source, Span<float> destination)
-        {
-            if (source.Length != destination.Length)
-                throw new ArgumentException("Source and destination buffers must have the same length.");
-
-            // SIMD-accelerated mixing
-            var count = 0;
-            var simdLength = source.Length - (source.Length % Vector<float>.Count);
-
-            // Ensure there's enough data for SIMD operations
-            if (simdLength > 0 && Vector<float>.Count <= source.Length && Vector<float>.Count <= destination.Length)
-            {
-                // Rent temporary arrays from the pool to hold the slice data
-                float[] tempSourceArray = ArrayPool<float>.Shared.Rent(Vector<float>.Count);
-                float[] tempDestArray = ArrayPool<float>.Shared.Rent(Vector<float>.Count);
-
-                while (count < simdLength)
-                {
-                    // Copy the current slice of the source Span into the temporary source array
-                    source.Slice(count, Vector<float>.Count).CopyTo(tempSourceArray);
-                    // Copy the current slice of the destination Span into the temporary dest array
-                    destination.Slice(count, Vector<float>.Count).CopyTo(tempDestArray);
-
-                    // Now create Vector<float> instances from the float[] arrays
-                    var vs = new Vector<float>(tempSourceArray);
-                    var vd = new Vector<float>(tempDestArray);
-
-                    // Perform the SIMD operation and copy the result back to the temporary dest array
-                    (vd + vs).CopyTo(tempDestArray);
-
-                    // Copy the processed data from the temporary dest array back to the original destination Span
-                    tempDestArray.AsSpan(0, Vector<float>.Count).CopyTo(destination.Slice(count, Vector<float>.Count));
-
-                    count += Vector<float>.Count;
-                }
-            }
+        /// <summary>
+        ///     Collects components that this component renders as part of <see cref="GenerateAudio"/>.
+        /// </summary>
+        /// <param name="children">The list to add the rendered components to.</param>
+        /// <returns>
+        ///     True if rendering the collected components in order fully replaces <see cref="GenerateAudio"/>,
+        ///     so a render plan can schedule them itself and skip the call.
+        /// </returns>
+        internal virtual bool CollectRenderChildren(List<SoundComponent> children) => false;
 
-            // Scalar remainder
-            while (count < source.Length)
-            {
-                destination[count] += source[count];
-                count++;
-            }
+        /// <summary>
+        ///     Called under the plan compile lock when the graph below this component has changed, before any
+        ///     render plan that includes it is rebuilt.
+        /// </summary>
+        internal virtual void OnRenderTopologyChanged()
+        {
         }
 
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private void ApplyVolumeAndPanning(Span<float> buffer, Vector2 volumePan, int channels)
+        internal void Process(Span<float> outputBuffer, int channels)
         {
-            switch (channels)
+            var plan = _renderPlan;
+            if (plan != null)
             {
-                case 1:
-                    // Constant power calculation for mono
-                    var monoGain = MathF.Sqrt(volumePan.X * volumePan.X + volumePan.Y * volumePan.Y);
-                    ApplyMonoVolume(buffer, monoGain);
-                    break;
-                case 2:
-                    ApplyStereoVolume(buffer, volumePan);
-                    break;
-                default:
-                    ApplyMultiChannelVolume(buffer, channels, volumePan);
-                    break;
+                plan.Execute(outputBuffer, channels);
+                return;
             }
-        }
 
-        private static void ApplyMonoVolume(Span<float> buffer, float volume)
-        {
-            if (Math.Abs(volume - 1f) < 1e-6f) return;
+            if (!IsRenderable) return;
 
-            if (Vector.IsHardwareAccelerated && buffer.Length >= Vector<float>.Count)
+            // Time spent in nested Process calls accumulates in ChildTicks; what is left is this component's own.
+            var monitoring = Engine.PerformanceMonitoring;
+            long start = 0, outerChildTicks = 0;
+            if (monitoring)
             {
-                var vecVolume = new Vector<float>(volume);
-                var count = 0;
-
-                // Rent a temporary array for the slice
-                float[] tempBufferSlice = ArrayPool<float>.Shared.Rent(Vector<float>.Count);
-
-                for (; count <= buffer.Length - Vector<float>.Count; count += Vector<float>.Count)
-                {
-                    // 1. Copy current Span slice to the temporary array
-                    buffer.Slice(count, Vector<float>.Count).CopyTo(tempBufferSlice);
+                outerChildTicks = TimingCounter.ChildTicks;
+                TimingCounter.ChildTicks = 0;
+                start = Stopwatch.GetTimestamp();
+            }
 
-                    // 2. Create Vector<float> from the float[] (tempBufferSlice)
-                    var vec = new Vector<float>(tempBufferSlice);
+            float[]? rentedBuffer = null;
+            try
+            {
+                rentedBuffer = BufferPool.Rent(outputBuffer.Length);
+                var workingBuffer = rentedBuffer.AsSpan(0, outputBuffer.Length);
+                workingBuffer.Clear();
 
-                    // 3. Perform SIMD operation and write result back to the temporary array
-                    (vec * vecVolume).CopyTo(tempBufferSlice);
+                foreach (var input in _inputs)
+                    input.Process(workingBuffer, channels);
 
-                    // 4. Copy processed data from temporary array back to the original Span
-                    tempBufferSlice.AsSpan(0, Vector<float>.Count).CopyTo(buffer.Slice(count, Vector<float>.Count));
-                }
+                GenerateAudio(workingBuffer, channels);
 
-                for (; count < buffer.Length; count++)
-                    buffer[count] *= volume;
+                FinishRender(workingBuffer, outputBuffer, channels, _modifiers, _analyzers);
             }
-            else
+            finally
             {
-                for (var i = 0; i < buffer.Length; i++)
-                    buffer[i] *= volume;
+                if (rentedBuffer != null)
+                    BufferPool.Return(rentedBuffer);
+
+                if (monitoring)
+                    EndTiming(start, outerChildTicks);
             }
         }
 
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private static void ApplyStereoVolume(Span<float> buffer, Vector2 volume)
+        /// <summary>
+        ///     Records one render of this component that began at <paramref name="start"/>, and adds it to the
+        ///     enclosing component's child time.
+        /// </summary>
+        internal void EndTiming(long start, long outerChildTicks)
         {
-            // Early exit for unity volume (both channels at 1.0)
-            if (Math.Abs(volume.X - 1f) < 1e-7f && Math.Abs(volume.Y - 1f) < 1e-7f)
-                return;
+            var inclusive = Stopwatch.GetTimestamp() - start;
+            InclusiveTiming.Record(inclusive);
+            ExclusiveTiming.Record(inclusive - TimingCounter.ChildTicks);
+            TimingCounter.ChildTicks = outerChildTicks + inclusive;
+        }
 
-            var volX = volume.X;
-            var volY = volume.Y;
+        /// <summary>
+        ///     Clears the performance statistics of this component and its modifiers.
+        /// </summary>
+        internal void ResetTiming()
+        {
+            InclusiveTiming.Reset();
+            ExclusiveTiming.Reset();
+            foreach (var modifier in _modifiers)
+                modifier.ProcessTiming.Reset();
+        }
 
-            var i = 0;
+        /// <summary>
+        ///     Generates this component's own audio. Entry point for the render plan.
+        /// </summary>
+        internal void RenderGenerate(Span<float> workingBuffer, int channels) => GenerateAudio(workingBuffer, channels);
 
-            if (Vector.IsHardwareAccelerated && buffer.Length >= Vector<float>.Count)
+        /// <summary>
+        ///     Applies modifiers, volume and panning to the rendered audio, mixes it into the output and feeds the analyzers.
+        /// </summary>
+        internal void FinishRender(Span<float> workingBuffer, Span<float> outputBuffer, int channels,
+            SoundModifier[] modifiers, AudioAnalyzer[] analyzers)
+        {
+            if (Engine.PerformanceMonitoring)
             {
-                var vectorSize = Vector<float>.Count;
-
-                if (vectorSize % 2 == 0)
+                foreach (var modifier in modifiers)
                 {
-                    Span<float> gainFactorsSpan = stackalloc float[vectorSize];
-                    for (var k = 0; k < vectorSize; k += 2)
-                    {
-                        gainFactorsSpan[k] = volX;
-                        gainFactorsSpan[k + 1] = volY;
-                    }
-                    var simdGainFactors = new Vector<float>(gainFactorsSpan);
-
-                    // Rent a temporary array for the audio slice
-                    float[] tempAudioSlice = ArrayPool<float>.Shared.Rent(vectorSize);
-
-                    for (; i <= buffer.Length - vectorSize; i += vectorSize)
-                    {
-                        // 1. Copy current Span slice to the temporary array
-                        buffer.Slice(i, vectorSize).CopyTo(tempAudioSlice);
-
-                        // 2. Create Vector<float> from the float[] (tempAudioSlice)
-                        var audioSimd = new Vector<float>(tempAudioSlice);
-
-                        // 3. Perform SIMD operation and write result back to the temporary array
-                        (audioSimd * simdGainFactors).CopyTo(tempAudioSlice);
-
-                        // 4. Copy processed data from temporary array back to the original Span
-                        tempAudioSlice.AsSpan(0, vectorSize).CopyTo(buffer.Slice(i, vectorSize));
-                    }
+                    if (!modifier.Enabled) continue;
+                    var start = Stopwatch.GetTimestamp();
+                    modifier.Process(workingBuffer, channels);
+                    modifier.ProcessTiming.Record(Stopwatch.GetTimestamp() - start);
                 }
             }
-
-            // Scalar processing for the remainder or if SIMD is not applicable/enabled
-            for (; i <= buffer.Length - 2; i += 2)
+            else
             {
-                buffer[i] *= volX;
-                buffer[i + 1] *= volY;
+                foreach (var modifier in modifiers)
+                    if (modifier.Enabled)
+                        modifier.Process(workingBuffer, channels);
             }
 
-            // Handle the last odd element if the buffer length is odd
-            if (i < buffer.Length)
-            {
-                buffer[i] *= (volX + volY) * 0.5f;
-            }
-        }
+            if (workingBuffer.Length != outputBuffer.Length)
+                throw new ArgumentException("Source and destination buffers must have the same length.");
 
-        private static void ApplyMultiChannelVolume(Span<float> buffer, int channels, Vector2 volumePan)
-        {
-            if (channels < 2) return;
+            // Volume/pan and the mix into the output happen in one pass. Analyzers observe the post-gain signal,
+            // so the scaled samples are only written back when someone will read them.
+            Span<float> gains = stackalloc float[Math.Max(1, channels)];
+            if (GetChannelGains(gains, channels))
+                SampleMath.Add(workingBuffer, outputBuffer);
+            else if (analyzers.Length == 0)
+                SampleMath.MultiplyAdd(workingBuffer, gains, outputBuffer);
+            else
+                SampleMath.ScaleAndAdd(workingBuffer, gains, outputBuffer);
 
-            var weights = new float[channels];
-            weights[0] = volumePan.X;
-            weights[1] = volumePan.Y;
-            var avg = (volumePan.X + volumePan.Y) * 0.5f;
+            foreach (var analyzer in analyzers)
+                analyzer.Process(workingBuffer, channels);
+        }
 
-            for (var i = 2; i < channels; i++)
-                weights[i] = avg;
+        private static T[] CopyWith<T>(T[] source, T item)
+        {
+            var result = new T[source.Length + 1];
+            Array.Copy(source, result, source.Length);
+            result[source.Length] = item;
+            return result;
+        }
 
-            for (var i = 0; i < buffer.Length; i++)
-                buffer[i] *= weights[i % channels];
+        private static T[] CopyWithout<T>(T[] source, T item)
+        {
+            var index = Array.IndexOf(source, item);
+            if (index < 0) return source;
+            if (source.Length == 1) return Array.Empty<T>();
+
+            var result = new T[source.Length - 1];
+            Array.Copy(source, 0, result, 0, index);
+            Array.Copy(source, index + 1, result, index, source.Length - index - 1);
+            return result;
         }
 
         /// <summary>
@@ -623,15 +644,21 @@ namespace SoundFlow.Abstracts
 
                 lock (_stateLock)
                 {
-                    _modifiers.Clear();
-                    _analyzers.Clear();
+                    _modifiers = Array.Empty<SoundModifier>();
+                    _analyzers = Array.Empty<AudioAnalyzer>();
+                }
+
+                lock (RenderPlan.CompileLock)
+                {
+                    _compiledRendering = false;
+                    _renderPlan = null;
                 }
             }
 
             // Clear connection lists. This is defensive, as they should be empty by now.
             lock (_connectionsLock)
             {
-                _inputs.Clear();
+                _inputs = Array.Empty<SoundComponent>();
                 _outputs.Clear();
             }
 
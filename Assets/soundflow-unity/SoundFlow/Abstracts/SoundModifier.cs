@@ -1,3 +1,5 @@
+using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Abstracts
@@ -6,6 +8,14 @@ namespace SoundFlow.Abstracts
     /// An abstract representation of a sound modifier.
     /// Implementations of this class alter audio data to apply various effects.
     /// </summary>
+    /// <remarks>
+    /// Modifiers are driven one block at a time: <see cref="Process"/> calls <see cref="BeginBlock"/> once, then
+    /// <see cref="ProcessBlock"/> over the whole interleaved buffer. The default block implementation calls
+    /// <see cref="ProcessSample"/> for every sample in frame order; performance-sensitive modifiers override
+    /// <see cref="ProcessBlock"/> and walk each channel as a strided span
+    /// (<c>buffer[channel], buffer[channel + channels], ...</c>) with its state held in locals, and apply
+    /// parameter changes in <see cref="BeginBlock"/> instead of per sample.
+    /// </remarks>
     public abstract class SoundModifier
     {
         /// <summary>
@@ -18,6 +28,14 @@ namespace SoundFlow.Abstracts
         /// </summary>
         public bool Enabled { get; set; } = true;
 
+        /// <summary>
+        /// Gets the time spent in <see cref="Process"/>, measured while the engine's
+        /// <see cref="AudioEngine.PerformanceMonitoring"/> is enabled.
+        /// </summary>
+        public TimingStats ProcessTime => ProcessTiming.Snapshot();
+
+        internal readonly TimingCounter ProcessTiming = new();
+
         /// <summary>
         /// Applies the modifier to a buffer of audio samples.
         /// </summary>
@@ -25,11 +43,32 @@ namespace SoundFlow.Abstracts
         /// <param name="channels">The number of channels in the buffer.</param>
         public virtual void Process(Span<float> buffer, int channels)
         {
-            if (!Enabled) return;
+            if (!Enabled || channels <= 0) return;
+
+            BeginBlock(channels);
+            ProcessBlock(buffer, channels);
+        }
+
+        /// <summary>
+        /// Called once at the start of every block, before <see cref="ProcessBlock"/>. Override to apply pending
+        /// parameter and coefficient updates and to size per-channel state for <paramref name="channels"/>.
+        /// </summary>
+        /// <param name="channels">The number of channels in the upcoming block.</param>
+        protected virtual void BeginBlock(int channels)
+        {
+        }
 
-            for (var i = 0; i < buffer.Length; i++)
+        /// <summary>
+        /// Processes one block of interleaved samples in place.
+        /// </summary>
+        /// <param name="buffer">The interleaved samples to modify.</param>
+        /// <param name="channels">The number of channels in the buffer. Always positive.</param>
+        protected virtual void ProcessBlock(Span<float> buffer, int channels)
+        {
+            for (int i = 0, channel = 0; i < buffer.Length; i++)
             {
-                buffer[i] = ProcessSample(buffer[i], i % channels);
+                buffer[i] = ProcessSample(buffer[i], channel);
+                if (++channel == channels) channel = 0;
             }
         }
 
@@ -41,4 +80,4 @@ namespace SoundFlow.Abstracts
         /// <returns>The modified audio sample.</returns>
         public abstract float ProcessSample(float sample, int channel);
     }
-}
\ No newline at end of file
+}
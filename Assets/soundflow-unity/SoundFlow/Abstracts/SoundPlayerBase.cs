@@ -1,6 +1,8 @@
-﻿using SoundFlow.Enums;
+﻿using SoundFlow.Components;
+using SoundFlow.Enums;
 using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.IO;
 
@@ -14,9 +16,12 @@ namespace SoundFlow.Abstracts
     {
         private readonly ISoundDataProvider _dataProvider;
         private int _rawSamplePosition;
-        private float _currentFractionalFrame;
         private float[] _resampleBuffer;
         private int _resampleBufferValidSamples;
+        private int _resampleBufferReadOffset;
+        private volatile Resampler? _resampler;
+        private volatile bool _resampleToOutputRate;
+        private volatile ResamplerQuality _resamplerQuality = ResamplerQuality.Medium;
         private float _playbackSpeed = 1.0f;
         private int _loopStartSamples;
         private int _loopEndSamples = -1;
@@ -45,20 +50,61 @@ namespace SoundFlow.Abstracts
         /// <inheritdoc />
         public PlaybackState State { get; private set; }
 
+        /// <inheritdoc />
+        public PositionClock Clock { get; }
+
         /// <inheritdoc />
         public bool IsLooping { get; set; }
 
+        /// <summary>
+        /// Gets or sets whether audio from a data provider whose sample rate differs from the player's format is
+        /// converted to the player's rate. Off by default, because some providers only assume a rate (for example
+        /// a <see cref="SoundFlow.Providers.RawDataProvider"/> created from a bare sample array reports 48 kHz).
+        /// </summary>
+        public bool ResampleToOutputRate
+        {
+            get => _resampleToOutputRate;
+            set
+            {
+                _resampleToOutputRate = value;
+                PrepareResampler();
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the filter quality used when <see cref="ResampleToOutputRate"/> converts the sample rate.
+        /// Cheap tiers suit short, numerous effects; <see cref="Enums.ResamplerQuality.High"/> suits music.
+        /// </summary>
+        /// <remarks>
+        /// The converter is built by the thread setting this property or <see cref="ResampleToOutputRate"/> and
+        /// takes over from the next block, so the audio thread never computes a filter bank.
+        /// </remarks>
+        public ResamplerQuality ResamplerQuality
+        {
+            get => _resamplerQuality;
+            set
+            {
+                _resamplerQuality = value;
+                PrepareResampler();
+            }
+        }
+
+        /// <summary>
+        /// Gets the data provider this player reads from.
+        /// </summary>
+        internal ISoundDataProvider DataProvider => _dataProvider;
+
         /// <inheritdoc />
         public float Time =>
-            _dataProvider.Length == 0 || Format.Channels == 0 || Format.SampleRate == 0
+            _dataProvider.Length == 0 || Format.Channels == 0 || SourceSampleRate == 0
                 ? 0
-                : (float)_rawSamplePosition / Format.Channels / Format.SampleRate;
+                : (float)_rawSamplePosition / Format.Channels / SourceSampleRate;
 
         /// <inheritdoc />
         public float Duration =>
-            _dataProvider.Length == 0 || Format.Channels == 0 || Format.SampleRate == 0
+            _dataProvider.Length == 0 || Format.Channels == 0 || SourceSampleRate == 0
                 ? 0f
-                : (float)_dataProvider.Length / Format.Channels / Format.SampleRate;
+                : (float)_dataProvider.Length / Format.Channels / SourceSampleRate;
 
         /// <inheritdoc />
         public int LoopStartSamples => _loopStartSamples;
@@ -67,15 +113,21 @@ namespace SoundFlow.Abstracts
         public int LoopEndSamples => _loopEndSamples;
 
         /// <inheritdoc />
-        public float LoopStartSeconds => (Format.Channels == 0 || Format.SampleRate == 0)
+        public float LoopStartSeconds => (Format.Channels == 0 || SourceSampleRate == 0)
             ? 0
-            : (float)_loopStartSamples / Format.Channels / Format.SampleRate;
+            : (float)_loopStartSamples / Format.Channels / SourceSampleRate;
 
         /// <inheritdoc />
         public float LoopEndSeconds =>
-            _loopEndSamples == -1 || Format.Channels == 0 || Format.SampleRate == 0
+            _loopEndSamples == -1 || Format.Channels == 0 || SourceSampleRate == 0
                 ? -1
-                : (float)_loopEndSamples / Format.Channels / Format.SampleRate;
+                : (float)_loopEndSamples / Format.Channels / SourceSampleRate;
+
+        /// <summary>
+        /// The rate at which the provider's samples are played: its own when converting, otherwise the player's.
+        /// </summary>
+        private int SourceSampleRate =>
+            _resampleToOutputRate && _dataProvider.SampleRate > 0 ? _dataProvider.SampleRate : Format.SampleRate;
 
 
         /// <summary>
@@ -88,6 +140,7 @@ namespace SoundFlow.Abstracts
         protected SoundPlayerBase(AudioEngine engine, AudioFormat format, ISoundDataProvider dataProvider) : base(engine, format)
         {
             _dataProvider = dataProvider ?? throw new ArgumentNullException(nameof(dataProvider));
+            Clock = new PositionClock(this);
             var initialChannels = format.Channels > 0 ? format.Channels : 2;
             var initialSampleRate = format.SampleRate > 0 ? format.SampleRate : 44100;
             var resampleBufferFrames = Math.Max(256, initialSampleRate / 10);
@@ -98,6 +151,12 @@ namespace SoundFlow.Abstracts
 
         /// <inheritdoc />
         protected override void GenerateAudio(Span<float> output, int channels)
+        {
+            RenderPlayback(output, channels);
+            Clock.Publish(_rawSamplePosition, State == PlaybackState.Playing);
+        }
+
+        private void RenderPlayback(Span<float> output, int channels)
         {
             // Clear output if not playing or no channels.
             if (State != PlaybackState.Playing || channels == 0)
@@ -106,8 +165,10 @@ namespace SoundFlow.Abstracts
                 return;
             }
 
-            // Directly read from provider when playback speed is 1.0
-            if (Math.Abs(_playbackSpeed - 1.0f) < 0.001f)
+            var resampler = GetResampler(channels);
+
+            // Directly read from provider when playback speed is 1.0 and no rate conversion is needed.
+            if (resampler == null && Math.Abs(_playbackSpeed - 1.0f) < 0.001f)
             {
                 var samplesRead = _dataProvider.ReadBytes(output);
                 _rawSamplePosition += samplesRead;
@@ -123,89 +184,73 @@ namespace SoundFlow.Abstracts
             if (_timeStretcher.GetTargetSpeed() == 0f && _playbackSpeed != 0f && channels > 0)
                 _timeStretcher.SetChannels(channels);
 
-            if (channels == 0)
-            {
-                output.Clear();
-                return;
-            }
-
-            var outputFramesTotal = output.Length / channels;
             var outputBufferOffset = 0;
             var totalSourceSamplesAdvancedThisCall = 0; // Total samples advanced in the original source.
 
-            for (var i = 0; i < outputFramesTotal; i++)
-            {
-                var currentIntegerFrame = (int)Math.Floor(_currentFractionalFrame);
-                // We need 2 frames for linear interpolation (current and next).
-                var samplesRequiredInBufferForInterpolation = (currentIntegerFrame + 2) * channels;
+            // Without time stretching, a provider that holds float samples feeds the converter from its own memory.
+            var inPlaceSource = resampler != null && Math.Abs(_playbackSpeed - 1.0f) < 0.1f
+                ? _dataProvider as ISampleSpanSource
+                : null;
 
-                // Fill _resampleBuffer if not enough data for interpolation.
-                if (_resampleBufferValidSamples < samplesRequiredInBufferForInterpolation)
+            // Drain the resample buffer in blocks, straight through or through the rate converter, refilling it
+            // from the time stretcher or provider whenever less than a frame is left.
+            while (outputBufferOffset < output.Length)
+            {
+                // The converter only writes whole frames: a partial trailing frame would never make progress.
+                if (output.Length - outputBufferOffset < channels)
                 {
-                    var sourceSamplesForFill = FillResampleBuffer(samplesRequiredInBufferForInterpolation, channels);
-                    totalSourceSamplesAdvancedThisCall += sourceSamplesForFill;
-
-                    // If still not enough data after filling, end of stream.
-                    if (_resampleBufferValidSamples < samplesRequiredInBufferForInterpolation)
-                    {
-                        _rawSamplePosition += totalSourceSamplesAdvancedThisCall;
-                        _rawSamplePosition = Math.Min(_rawSamplePosition, _dataProvider.Length);
-                        HandleEndOfStream(output[outputBufferOffset..], channels);
-                        return;
-                    }
+                    output[outputBufferOffset..].Clear();
+                    break;
                 }
 
-                // Perform linear interpolation.
-                var frameIndex0 = currentIntegerFrame;
-                var t = _currentFractionalFrame - frameIndex0;
-                for (var ch = 0; ch < channels; ch++)
+                var available = _resampleBufferValidSamples - _resampleBufferReadOffset;
+                if (available == 0 && inPlaceSource is { CanReadInPlace: true })
                 {
-                    var sampleIndex0 = frameIndex0 * channels + ch;
-                    var sampleIndex1 = (frameIndex0 + 1) * channels + ch;
-                    if (sampleIndex1 >= _resampleBufferValidSamples)
-                    {
-                        // If next sample is out of bounds, use current or 0.
-                        output[outputBufferOffset + ch] =
-                            (sampleIndex0 < _resampleBufferValidSamples && sampleIndex0 >= 0)
-                                ? _resampleBuffer[sampleIndex0]
-                                : 0f;
-                        continue;
-                    }
-
-                    // If current sample is out of bounds, use 0.
-                    if (sampleIndex0 < 0)
+                    var inPlace = inPlaceSource.PeekSamples(int.MaxValue);
+                    inPlace = inPlace[..(inPlace.Length - inPlace.Length % channels)];
+                    if (inPlace.Length > 0)
                     {
-                        output[outputBufferOffset + ch] = 0f;
+                        outputBufferOffset += resampler!.Process(inPlace, output[outputBufferOffset..], out var inPlaceConsumed);
+                        inPlaceSource.Advance(inPlaceConsumed);
+                        totalSourceSamplesAdvancedThisCall += inPlaceConsumed;
                         continue;
                     }
-
-                    // Interpolate sample value.
-                    output[outputBufferOffset + ch] =
-                        _resampleBuffer[sampleIndex0] * (1.0f - t) + _resampleBuffer[sampleIndex1] * t;
                 }
 
-                outputBufferOffset += channels;
-                _currentFractionalFrame += 1.0f;
-
-                // Discard consumed samples from the resample buffer.
-                var framesConsumedFromResampleBuffer = (int)Math.Floor(_currentFractionalFrame);
-                if (framesConsumedFromResampleBuffer > 0)
+                if (available < channels)
                 {
-                    var samplesConsumedFromResampleBuf = framesConsumedFromResampleBuffer * channels;
+                    var wanted = Math.Max(channels, Math.Min(output.Length - outputBufferOffset, _resampleBuffer.Length));
+                    totalSourceSamplesAdvancedThisCall += FillResampleBuffer(wanted, channels);
+                    available = _resampleBufferValidSamples - _resampleBufferReadOffset;
 
-                    var actualDiscard = Math.Min(samplesConsumedFromResampleBuf, _resampleBufferValidSamples);
-                    if (actualDiscard > 0)
+                    // End of stream: let the converter emit what its lookahead still holds, then stop or loop.
+                    if (available < channels)
                     {
-                        var remaining = _resampleBufferValidSamples - actualDiscard;
-                        if (remaining > 0)
-                            // Shift remaining samples to the beginning.
-                            Buffer.BlockCopy(_resampleBuffer, actualDiscard * sizeof(float), _resampleBuffer, 0,
-                                remaining * sizeof(float));
-                        _resampleBufferValidSamples = remaining;
+                        if (resampler != null)
+                            outputBufferOffset += resampler.Flush(output[outputBufferOffset..]);
+                        if (outputBufferOffset == output.Length) break;
+
+                        _rawSamplePosition += totalSourceSamplesAdvancedThisCall;
+                        _rawSamplePosition = Math.Min(_rawSamplePosition, _dataProvider.Length);
+                        HandleEndOfStream(output[outputBufferOffset..], channels);
+                        return;
                     }
+                }
 
-                    _currentFractionalFrame -= framesConsumedFromResampleBuffer;
+                var source = _resampleBuffer.AsSpan(_resampleBufferReadOffset, available - available % channels);
+                int written, consumed;
+                if (resampler != null)
+                {
+                    written = resampler.Process(source, output[outputBufferOffset..], out consumed);
+                }
+                else
+                {
+                    written = consumed = Math.Min(source.Length, output.Length - outputBufferOffset);
+                    source[..written].CopyTo(output[outputBufferOffset..]);
                 }
+
+                _resampleBufferReadOffset += consumed;
+                outputBufferOffset += written;
             }
 
             // Update raw sample position based on actual source samples advanced.
@@ -213,6 +258,38 @@ namespace SoundFlow.Abstracts
             _rawSamplePosition = Math.Min(_rawSamplePosition, _dataProvider.Length);
         }
 
+        /// <summary>
+        /// Gets the rate converter for this block, or null if the provider already plays at the player's rate.
+        /// A block rendered with a channel count other than the player format's is not converted.
+        /// </summary>
+        private Resampler? GetResampler(int channels)
+        {
+            var resampler = _resampler;
+            return resampler != null && resampler.Channels == channels ? resampler : null;
+        }
+
+        /// <summary>
+        /// Builds the rate converter for the current settings on the calling thread and publishes it for the next
+        /// block, or clears it when no conversion is needed.
+        /// </summary>
+        private void PrepareResampler()
+        {
+            var sourceRate = _dataProvider.SampleRate;
+            var channels = Format.Channels;
+            if (!_resampleToOutputRate || sourceRate <= 0 || Format.SampleRate <= 0 || sourceRate == Format.SampleRate ||
+                channels <= 0)
+            {
+                _resampler = null;
+                return;
+            }
+
+            var quality = _resamplerQuality;
+            var current = _resampler;
+            if (current != null && current.Quality == quality) return;
+
+            _resampler = new Resampler(channels, quality, (double)sourceRate / Format.SampleRate);
+        }
+
         /// <summary>
         /// Fills the internal resample buffer using the time stretcher and data provider.
         /// </summary>
@@ -223,6 +300,17 @@ namespace SoundFlow.Abstracts
         {
             if (channels == 0) return 0;
 
+            // Move the unread tail to the front; this happens once per refill rather than once per frame.
+            if (_resampleBufferReadOffset > 0)
+            {
+                var unread = _resampleBufferValidSamples - _resampleBufferReadOffset;
+                if (unread > 0)
+                    Buffer.BlockCopy(_resampleBuffer, _resampleBufferReadOffset * sizeof(float), _resampleBuffer, 0,
+                        unread * sizeof(float));
+                _resampleBufferValidSamples = Math.Max(0, unread);
+                _resampleBufferReadOffset = 0;
+            }
+
             // Resize the resampling buffer if too small.
             if (_resampleBuffer.Length < minSamplesRequiredInOutputBuffer)
             {
@@ -362,7 +450,7 @@ namespace SoundFlow.Abstracts
                 if (!remainingOutputBuffer.IsEmpty)
                 {
                     var spaceToFill = remainingOutputBuffer.Length;
-                    var currentlyValidInResample = _resampleBufferValidSamples;
+                    var currentlyValidInResample = _resampleBufferValidSamples - _resampleBufferReadOffset;
 
                     if (currentlyValidInResample < spaceToFill)
                     {
@@ -371,18 +459,12 @@ namespace SoundFlow.Abstracts
                         _rawSamplePosition = Math.Min(_rawSamplePosition, _dataProvider.Length);
                     }
 
-                    var toCopy = Math.Min(spaceToFill, _resampleBufferValidSamples);
+                    var toCopy = Math.Min(spaceToFill, _resampleBufferValidSamples - _resampleBufferReadOffset);
                     if (toCopy > 0)
                     {
-                        SafeCopyTo(_resampleBuffer.AsSpan(0, toCopy), remainingOutputBuffer.Slice(0, toCopy));
-                        var remainingInResampleAfterCopy = _resampleBufferValidSamples - toCopy;
-                        if (remainingInResampleAfterCopy > 0)
-                        {
-                            Buffer.BlockCopy(_resampleBuffer, toCopy * sizeof(float), _resampleBuffer, 0,
-                                remainingInResampleAfterCopy * sizeof(float));
-                        }
-
-                        _resampleBufferValidSamples = remainingInResampleAfterCopy;
+                        SafeCopyTo(_resampleBuffer.AsSpan(_resampleBufferReadOffset, toCopy),
+                            remainingOutputBuffer.Slice(0, toCopy));
+                        _resampleBufferReadOffset += toCopy;
                         if (toCopy < spaceToFill)
                         {
                             remainingOutputBuffer.Slice(toCopy).Clear();
@@ -452,6 +534,7 @@ namespace SoundFlow.Abstracts
         {
             Enabled = false;
             State = PlaybackState.Paused;
+            Clock.Publish(_rawSamplePosition, false);
         }
 
         /// <inheritdoc />
@@ -462,11 +545,12 @@ namespace SoundFlow.Abstracts
             Seek(0, Format.Channels);
             _timeStretcher.Reset();
             _resampleBufferValidSamples = 0;
+            _resampleBufferReadOffset = 0;
             Array.Clear(_resampleBuffer, 0, _resampleBuffer.Length);
+            _resampler?.Reset();
             _timeStretcherInputBufferValidSamples = 0;
             _timeStretcherInputBufferReadOffset = 0;
             Array.Clear(_timeStretcherInputBuffer, 0, _timeStretcherInputBuffer.Length);
-            _currentFractionalFrame = 0f;
         }
 
         /// <inheritdoc />
@@ -503,7 +587,7 @@ namespace SoundFlow.Abstracts
 
         private bool Seek(float timeInSeconds, int channels)
         {
-            if (channels == 0 || Format.SampleRate == 0) return false;
+            if (channels == 0 || SourceSampleRate == 0) return false;
             timeInSeconds = Math.Max(0, timeInSeconds);
             // Convert time in seconds to sample offset in source data.
             var sampleOffset = (int)(timeInSeconds / Duration * _dataProvider.Length);
@@ -527,11 +611,13 @@ namespace SoundFlow.Abstracts
             sampleOffset = Math.Clamp(sampleOffset, 0, maxSeekableSample);
             _dataProvider.Seek(sampleOffset);
             _rawSamplePosition = sampleOffset;
-            _currentFractionalFrame = 0f;
             _resampleBufferValidSamples = 0;
+            _resampleBufferReadOffset = 0;
+            _resampler?.Reset();
             _timeStretcher.Reset();
             _timeStretcherInputBufferValidSamples = 0;
             _timeStretcherInputBufferReadOffset = 0;
+            Clock.Publish(sampleOffset, false);
             return true;
         }
 
@@ -551,7 +637,7 @@ namespace SoundFlow.Abstracts
         public void SetLoopPoints(float startTime, float? endTime = null)
         {
             var channels = Format.Channels;
-            var sampleRate = Format.SampleRate;
+            var sampleRate = SourceSampleRate;
             if (channels == 0 || sampleRate == 0) return;
 
             if (startTime < 0)
@@ -620,12 +706,13 @@ namespace SoundFlow.Abstracts
         {
             if (disposing)
             {
+                Clock.Dispose();
                 _dataProvider.Dispose();
             }
         }
 
         /// <inheritdoc />
-        public void Dispose()
+        public override void Dispose()
         {
             if (IsDisposed) return;
             Dispose(true);
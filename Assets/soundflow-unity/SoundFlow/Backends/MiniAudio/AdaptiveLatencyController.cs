@@ -0,0 +1,501 @@
+using SoundFlow.Abstracts.Devices;
+using SoundFlow.Backends.MiniAudio.Devices;
+using SoundFlow.Utils;
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace SoundFlow.Backends.MiniAudio
+{
+    /// <summary>
+    /// Watches the callbacks of a MiniAudio device and renegotiates its period at runtime: larger after underruns
+    /// or overruns, smaller again after a long stretch without them.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Every <see cref="IntervalMilliseconds"/> the controller counts the callbacks that missed their deadline or
+    /// started late, and takes the longest callback and the largest start jitter of the interval. Any xrun doubles
+    /// the period, up to <see cref="MaxPeriodSizeInFrames"/>, and the period that failed is never requested again.
+    /// After <see cref="StableIntervals"/> clean intervals the period shrinks by a quarter, down to
+    /// <see cref="MinPeriodSizeInFrames"/>, as long as the callbacks and the jitter would fit in half of the
+    /// smaller period. The callbacks are timed while a controller is attached, whatever the engine's
+    /// <see cref="Abstracts.AudioEngine.PerformanceMonitoring"/> says.
+    /// </para>
+    /// <para>
+    /// Periods are changed through <see cref="MiniAudioEngine.SwitchDevice(AudioPlaybackDevice, Structs.DeviceInfo, DeviceConfig)"/>
+    /// and its overloads, so the mixer graph, capture subscribers and duplex mode survive, but the old device is
+    /// disposed and every switch is heard as a short gap. Keep using <see cref="Device"/> rather than the device
+    /// the controller was created with. Controllers are evaluated by one process-wide background thread, which
+    /// exits while no controller is attached.
+    /// </para>
+    /// <para>
+    /// By default that thread also performs the switch and raises <see cref="LatencyChanged"/>, so the device
+    /// is replaced while other threads may still hold it; see the thread contract of
+    /// <see cref="Abstracts.AudioEngine.SwitchDevice(AudioPlaybackDevice, Structs.DeviceInfo, DeviceConfig)"/>.
+    /// Set <see cref="DeferSwitches"/> to have it only raise <see cref="SwitchRequested"/>, and apply the switch
+    /// on the thread that owns the device with <see cref="ApplyPendingSwitch"/>.
+    /// </para>
+    /// </remarks>
+    public sealed class AdaptiveLatencyController : IDisposable
+    {
+        private const int PollMilliseconds = 50;
+
+        private static readonly PeriodicWorker<AdaptiveLatencyController> Controllers =
+            new("SoundFlow Latency Controller", PollMilliseconds, (controller, now) => controller.Evaluate(now));
+
+        private readonly object _lock = new();
+        private readonly MiniAudioEngine _engine;
+        private volatile AudioDevice _device;
+        private CallbackMonitor[] _monitors = Array.Empty<CallbackMonitor>();
+        private volatile uint _periodSizeInFrames;
+        private volatile uint _requestedPeriodSizeInFrames;
+        private volatile bool _deferSwitches;
+        private bool _switching;
+        private uint _failedPeriodSizeInFrames;
+        private uint _minPeriodSizeInFrames;
+        private uint _maxPeriodSizeInFrames;
+        private int _intervalMilliseconds = 1000;
+        private int _stableIntervals = 10;
+        private long _nextEvaluation;
+        private long _lastXruns;
+        private long _xruns;
+        private int _cleanIntervals;
+        private bool _settling = true;
+        private bool _isDisposed;
+
+        /// <summary>
+        /// Occurs after the controller switched the device to a new period. Raised on the thread that switched it:
+        /// the controller thread, or the caller of <see cref="ApplyPendingSwitch"/>.
+        /// </summary>
+        public event EventHandler<LatencyChangedEventArgs>? LatencyChanged;
+
+        /// <summary>
+        /// Occurs on the controller thread when <see cref="DeferSwitches"/> is set and the period should change.
+        /// Call <see cref="ApplyPendingSwitch"/> from the thread that owns the device to carry it out.
+        /// </summary>
+        public event EventHandler? SwitchRequested;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="AdaptiveLatencyController"/> class and starts watching
+        /// <paramref name="device"/>.
+        /// </summary>
+        /// <param name="device">
+        /// A playback, capture or full-duplex device created by a <see cref="MiniAudioEngine"/> with a
+        /// <see cref="MiniAudioDeviceConfig"/>.
+        /// </param>
+        /// <exception cref="ArgumentException">Thrown if the device does not belong to a <see cref="MiniAudioEngine"/>.</exception>
+        /// <exception cref="ObjectDisposedException">Thrown if the device is disposed.</exception>
+        public AdaptiveLatencyController(AudioDevice device)
+        {
+            if (device == null) throw new ArgumentNullException(nameof(device));
+            if (device.Engine is not MiniAudioEngine engine || device.Config is not MiniAudioDeviceConfig config)
+                throw new ArgumentException("The device must be created by a MiniAudioEngine.", nameof(device));
+            if (device.IsDisposed) throw new ObjectDisposedException(nameof(device));
+
+            _engine = engine;
+            _device = device;
+
+            var sampleRate = device.Format.SampleRate;
+            _minPeriodSizeInFrames = (uint)Math.Max(1, sampleRate / 400);
+            _maxPeriodSizeInFrames = (uint)Math.Max(_minPeriodSizeInFrames, sampleRate / 10);
+            _periodSizeInFrames = config.PeriodSizeInFrames > 0
+                ? config.PeriodSizeInFrames
+                : (uint)((long)sampleRate * config.PeriodSizeInMilliseconds / 1000);
+
+            Attach(device);
+            Controllers.Register(this);
+        }
+
+        /// <summary>
+        /// Gets the device currently controlled. Changes with every switch.
+        /// </summary>
+        public AudioDevice Device => _device;
+
+        /// <summary>
+        /// Gets the period requested for <see cref="Device"/>, in frames, or 0 until the first callback if the
+        /// configuration left it to the backend.
+        /// </summary>
+        public uint PeriodSizeInFrames => _periodSizeInFrames;
+
+        /// <summary>
+        /// Gets the period a deferred switch is waiting to apply, in frames, or 0 if none is pending.
+        /// </summary>
+        public uint RequestedPeriodSizeInFrames => _requestedPeriodSizeInFrames;
+
+        /// <summary>
+        /// Gets or sets whether the controller leaves switching to the device's owner. When true, it raises
+        /// <see cref="SwitchRequested"/> instead of switching, and the switch happens in
+        /// <see cref="ApplyPendingSwitch"/>. Defaults to false.
+        /// </summary>
+        public bool DeferSwitches
+        {
+            get => _deferSwitches;
+            set => _deferSwitches = value;
+        }
+
+        /// <summary>
+        /// Gets the number of xruns (deadline misses and late callbacks) seen since the controller was created.
+        /// </summary>
+        public long Xruns => Interlocked.Read(ref _xruns);
+
+        /// <summary>
+        /// Gets or sets the smallest period the controller requests, in frames. Defaults to 2.5 ms.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is 0 or above <see cref="MaxPeriodSizeInFrames"/>.</exception>
+        public uint MinPeriodSizeInFrames
+        {
+            get => Volatile.Read(ref _minPeriodSizeInFrames);
+            set
+            {
+                if (value == 0 || value > MaxPeriodSizeInFrames)
+                    throw new ArgumentOutOfRangeException(nameof(value), "Minimum period must be positive and not above the maximum.");
+                Volatile.Write(ref _minPeriodSizeInFrames, value);
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the largest period the controller requests, in frames. Defaults to 100 ms.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is below <see cref="MinPeriodSizeInFrames"/>.</exception>
+        public uint MaxPeriodSizeInFrames
+        {
+            get => Volatile.Read(ref _maxPeriodSizeInFrames);
+            set
+            {
+                if (value < MinPeriodSizeInFrames)
+                    throw new ArgumentOutOfRangeException(nameof(value), "Maximum period must not be below the minimum.");
+                Volatile.Write(ref _maxPeriodSizeInFrames, value);
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets how often the callbacks are evaluated, in milliseconds. Defaults to 1000.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is not positive.</exception>
+        public int IntervalMilliseconds
+        {
+            get => Volatile.Read(ref _intervalMilliseconds);
+            set
+            {
+                if (value <= 0) throw new ArgumentOutOfRangeException(nameof(value), "Interval must be positive.");
+                Volatile.Write(ref _intervalMilliseconds, value);
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the number of consecutive intervals without xruns before the period shrinks. Defaults to 10.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is not positive.</exception>
+        public int StableIntervals
+        {
+            get => Volatile.Read(ref _stableIntervals);
+            set
+            {
+                if (value <= 0) throw new ArgumentOutOfRangeException(nameof(value), "Interval count must be positive.");
+                Volatile.Write(ref _stableIntervals, value);
+            }
+        }
+
+        /// <summary>
+        /// Switches the device to <see cref="RequestedPeriodSizeInFrames"/>, on the calling thread. Call it from
+        /// the thread that owns the device, after <see cref="SwitchRequested"/>.
+        /// </summary>
+        /// <returns>True if the device was switched; false if no switch was pending or the switch failed.</returns>
+        public bool ApplyPendingSwitch()
+        {
+            AudioDevice device;
+            uint period, target;
+            lock (_lock)
+            {
+                target = _requestedPeriodSizeInFrames;
+                _requestedPeriodSizeInFrames = 0;
+                if (_isDisposed || _switching || target == 0) return false;
+
+                device = _device;
+                period = _periodSizeInFrames;
+                if (device.IsDisposed || target == period) return false;
+                _switching = true;
+            }
+
+            return ApplySwitch(device, period, target);
+        }
+
+        /// <summary>
+        /// Stops watching the device, leaving it at its current period. Does not wait for a switch in progress,
+        /// which then leaves the new device unwatched.
+        /// </summary>
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                if (_isDisposed) return;
+                _isDisposed = true;
+                _requestedPeriodSizeInFrames = 0;
+                Detach();
+            }
+
+            Controllers.Unregister(this);
+        }
+
+        private void Attach(AudioDevice device)
+        {
+            _monitors = device is FullDuplexDevice duplex
+                ? new[] { duplex.PlaybackDevice.CallbackMonitor, duplex.CaptureDevice.CallbackMonitor }
+                : new[] { device.CallbackMonitor };
+
+            foreach (var monitor in _monitors)
+            {
+                monitor.IsWatched = true;
+                monitor.TakePeaks(out _, out _);
+            }
+
+            _lastXruns = CountXruns();
+            _cleanIntervals = 0;
+            _settling = true;
+        }
+
+        private void Detach()
+        {
+            foreach (var monitor in _monitors)
+                monitor.IsWatched = false;
+        }
+
+        private long CountXruns()
+        {
+            long xruns = 0;
+            foreach (var monitor in _monitors)
+                xruns += monitor.DeadlineMisses + monitor.LateCallbacks;
+            return xruns;
+        }
+
+        /// <summary>
+        /// Evaluates the interval that ended at <paramref name="now"/>, if it has, and switches the device (or
+        /// requests the switch) when the period should change. Called by the controller thread.
+        /// </summary>
+        private void Evaluate(long now)
+        {
+            AudioDevice device;
+            uint period, target;
+            lock (_lock)
+            {
+                if (_isDisposed || _switching || now < _nextEvaluation) return;
+                _nextEvaluation = now + IntervalMilliseconds * Stopwatch.Frequency / 1000;
+
+                device = _device;
+                if (device.IsDisposed)
+                {
+                    // Switched or disposed behind the controller's back: there is nothing left to control.
+                    _isDisposed = true;
+                    Detach();
+                    target = 0;
+                }
+                else if (!device.IsRunning)
+                {
+                    Attach(device);
+                    return;
+                }
+                else
+                {
+                    target = EvaluateRunning(device);
+                }
+
+                period = _periodSizeInFrames;
+                if (target != 0 && _deferSwitches)
+                {
+                    _requestedPeriodSizeInFrames = target;
+                }
+                else if (target != 0)
+                {
+                    _switching = true;
+                }
+            }
+
+            if (target == 0)
+            {
+                if (_isDisposed) Controllers.Unregister(this);
+            }
+            else if (_deferSwitches)
+            {
+                SwitchRequested?.Invoke(this, EventArgs.Empty);
+            }
+            else
+            {
+                ApplySwitch(device, period, target);
+            }
+        }
+
+        /// <summary>
+        /// Switches <paramref name="device"/> from <paramref name="period"/> to <paramref name="target"/> frames.
+        /// Runs without the controller lock, so <see cref="Dispose"/> on another thread never waits for the device
+        /// to restart; the switching flag keeps the controller thread away meanwhile.
+        /// </summary>
+        private bool ApplySwitch(AudioDevice device, uint period, uint target)
+        {
+            var switched = Switch(device, target, out var restored);
+
+            LatencyChangedEventArgs? change = null;
+            lock (_lock)
+            {
+                _switching = false;
+                var current = switched ?? restored;
+                if (current != null) _device = current;
+
+                if (switched == null)
+                    _failedPeriodSizeInFrames = Math.Max(_failedPeriodSizeInFrames, target);
+                else
+                    _periodSizeInFrames = target;
+
+                if (current == null || _isDisposed)
+                {
+                    _isDisposed = true;
+                    Detach();
+                }
+                else
+                {
+                    Attach(current);
+                    if (switched != null) change = new LatencyChangedEventArgs(switched, period, target);
+                }
+            }
+
+            if (_isDisposed) Controllers.Unregister(this);
+            if (change == null) return false;
+
+            LatencyChanged?.Invoke(this, change);
+            return true;
+        }
+
+        /// <summary>
+        /// Takes the peaks and xruns of the interval that just ended and returns the period to switch to, or 0 to
+        /// stay on the current one. Called under the controller lock.
+        /// </summary>
+        private uint EvaluateRunning(AudioDevice device)
+        {
+            long peakDurationTicks = 0, peakJitterTicks = 0;
+            uint observedFrames = 0;
+            foreach (var monitor in _monitors)
+            {
+                monitor.TakePeaks(out var duration, out var jitter);
+                peakDurationTicks = Math.Max(peakDurationTicks, duration);
+                peakJitterTicks = Math.Max(peakJitterTicks, jitter);
+                observedFrames = Math.Max(observedFrames, monitor.PeriodFrames);
+            }
+
+            var xruns = CountXruns();
+            // Resetting the engine's performance statistics clears the counters as well.
+            var newXruns = xruns >= _lastXruns ? xruns - _lastXruns : xruns;
+            _lastXruns = xruns;
+
+            // Devices often start with a few irregular callbacks; judge them from the second interval on.
+            if (_settling)
+            {
+                _settling = false;
+                return 0;
+            }
+
+            if (observedFrames == 0) return 0;
+
+            var period = _periodSizeInFrames;
+            if (period == 0)
+                _periodSizeInFrames = period = observedFrames;
+
+            uint target;
+            if (newXruns > 0)
+            {
+                Interlocked.Add(ref _xruns, newXruns);
+                _cleanIntervals = 0;
+                _failedPeriodSizeInFrames = Math.Max(_failedPeriodSizeInFrames, period);
+                target = (uint)Math.Min((long)period * 2, MaxPeriodSizeInFrames);
+            }
+            else
+            {
+                if (++_cleanIntervals < StableIntervals) return 0;
+                _cleanIntervals = 0;
+
+                target = Math.Max(period - period / 4, MinPeriodSizeInFrames);
+                if (target <= _failedPeriodSizeInFrames) return 0;
+
+                // The callbacks must still fit comfortably in the smaller period, and the jitter must not eat it.
+                var halfTargetTicks = (long)target * Stopwatch.Frequency / device.Format.SampleRate / 2;
+                if (peakDurationTicks > halfTargetTicks || peakJitterTicks > halfTargetTicks) return 0;
+            }
+
+            return target == period ? 0 : target;
+        }
+
+        /// <summary>
+        /// Switches to the new period. If the device refuses it, the old device is already gone, so the graph is
+        /// brought back on the period that worked and returned in <paramref name="restored"/>; both are null when
+        /// even that fails.
+        /// </summary>
+        private AudioDevice? Switch(AudioDevice device, uint periodSizeInFrames, out AudioDevice? restored)
+        {
+            var config = (MiniAudioDeviceConfig)device.Config;
+            restored = null;
+            try
+            {
+                return SwitchTo(device, config.WithPeriodSize(periodSizeInFrames));
+            }
+            catch (Exception)
+            {
+                try
+                {
+                    restored = SwitchTo(device, config);
+                }
+                catch (Exception)
+                {
+                    // Nothing left to control.
+                }
+
+                return null;
+            }
+        }
+
+        private AudioDevice SwitchTo(AudioDevice device, DeviceConfig config) => device switch
+        {
+            FullDuplexDevice duplex => _engine.SwitchDevice(duplex, null, null, config),
+            AudioPlaybackDevice playback => _engine.SwitchDevice(playback, playback.Info ?? default, config),
+            AudioCaptureDevice capture => _engine.SwitchDevice(capture, capture.Info ?? default, config),
+            _ => throw new NotSupportedException($"Cannot switch a {device.GetType().Name}.")
+        };
+    }
+
+    /// <summary>
+    /// Event arguments for <see cref="AdaptiveLatencyController.LatencyChanged"/>.
+    /// </summary>
+    public class LatencyChangedEventArgs : EventArgs
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LatencyChangedEventArgs"/> class.
+        /// </summary>
+        /// <param name="device">The device that replaced the previous one.</param>
+        /// <param name="previousPeriodSizeInFrames">The period before the switch, in frames.</param>
+        /// <param name="periodSizeInFrames">The period after the switch, in frames.</param>
+        public LatencyChangedEventArgs(AudioDevice device, uint previousPeriodSizeInFrames, uint periodSizeInFrames)
+        {
+            Device = device;
+            PreviousPeriodSizeInFrames = previousPeriodSizeInFrames;
+            PeriodSizeInFrames = periodSizeInFrames;
+        }
+
+        /// <summary>
+        /// Gets the device that replaced the previous one. The previous device is disposed.
+        /// </summary>
+        public AudioDevice Device { get; }
+
+        /// <summary>
+        /// Gets the period before the switch, in frames.
+        /// </summary>
+        public uint PreviousPeriodSizeInFrames { get; }
+
+        /// <summary>
+        /// Gets the period after the switch, in frames.
+        /// </summary>
+        public uint PeriodSizeInFrames { get; }
+
+        /// <summary>
+        /// Gets the estimated latency of the new device in milliseconds; for a full-duplex device, the echo path
+        /// delay to give an echo canceller. See <see cref="AudioDevice.LatencyMilliseconds"/>.
+        /// </summary>
+        public double LatencyMilliseconds => Device.LatencyMilliseconds;
+    }
+}
@@ -10,7 +10,7 @@ namespace SoundFlow.Backends.MiniAudio.Devices
 { 
     internal sealed class MiniAudioCaptureDevice : AudioCaptureDevice
     {
-        private readonly MiniAudioDevice _device;
+        private readonly MiniAudioDevice? _device;
 
         public MiniAudioCaptureDevice(AudioEngine engine, nint context, DeviceInfo? info, AudioFormat format, DeviceConfig config) : base(engine, format, config)
         {
@@ -20,15 +20,28 @@ namespace SoundFlow.Backends.MiniAudio.Devices
             Capability = _device.Capability;
         }
 
+        /// <summary>
+        /// Creates the capture side of a duplex device. It owns no native device; the linked
+        /// <see cref="MiniAudioPlaybackDevice"/> hands it each block of input through <see cref="DeliverInput"/>.
+        /// </summary>
+        public MiniAudioCaptureDevice(AudioEngine engine, DeviceInfo? info, AudioFormat format, DeviceConfig config) : base(engine, format, config)
+        {
+            Info = info;
+            Capability = Capability.Record;
+        }
+
+        public override double LatencyMilliseconds =>
+            MiniAudioDevice.EstimateLatencyMilliseconds(Config, CallbackMonitor.PeriodFrames, Format.SampleRate, false);
+
         public override void Start()
         {
-            _device.Start();
+            _device?.Start();
             IsRunning = true;
         }
 
         public override void Stop()
         {
-            _device.Stop();
+            _device?.Stop();
             IsRunning = false;
         }
 
@@ -36,7 +49,7 @@ namespace SoundFlow.Backends.MiniAudio.Devices
         {
             if (IsDisposed) return;
             OnDisposedHandler();
-            _device.Dispose();
+            _device?.Dispose();
             IsDisposed = true;
         }
 
@@ -45,14 +58,22 @@ namespace SoundFlow.Backends.MiniAudio.Devices
         /// This method converts the raw device data to the standard 32-bit float format and raises the event.
         /// </summary>
         private void ProcessAudioCallback(nint pOutput, nint pInput, uint frameCount, MiniAudioDevice device)
+        {
+            DeliverInput(pInput, frameCount, device.Format);
+        }
+
+        /// <summary>
+        /// Converts a block of native input to float and raises <see cref="AudioCaptureDevice.OnAudioProcessed"/>.
+        /// </summary>
+        internal void DeliverInput(nint pInput, uint frameCount, AudioFormat format)
         {
             if (pInput == IntPtr.Zero) return;
 
-            var length = (int)frameCount * device.Format.Channels;
+            var length = (int)frameCount * format.Channels;
             if (length <= 0) return;
 
             // Fast path: If the device is already providing F32, no conversion is needed.
-            if (device.Format.Format == SampleFormat.F32)
+            if (format.Format == SampleFormat.F32)
             {
                 var inputSpan = Utils.Extensions.GetSpan<float>(pInput, length);
                 InvokeOnAudioProcessed(inputSpan);
@@ -66,7 +87,7 @@ namespace SoundFlow.Backends.MiniAudio.Devices
                 var floatSpan = tempBuffer.AsSpan(0, length);
 
                 // 1. Convert from the device's native format into our temporary float buffer.
-                DeviceBufferHelper.ConvertFromDeviceFormat(pInput, floatSpan, length, device.Format.Format);
+                DeviceBufferHelper.ConvertFromDeviceFormat(pInput, floatSpan, length, format.Format);
 
                 // 2. Invoke the event with the correctly converted sample data.
                 InvokeOnAudioProcessed(floatSpan);
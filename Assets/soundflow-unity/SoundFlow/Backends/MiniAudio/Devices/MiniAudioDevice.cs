@@ -1,5 +1,6 @@
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Runtime.InteropServices;
 using SoundFlow.Abstracts.Devices;
 using SoundFlow.Backends.MiniAudio.Structs;
@@ -13,29 +14,61 @@ namespace SoundFlow.Backends.MiniAudio.Devices
 
     internal sealed class MiniAudioDevice : IDisposable
     {
+        /// <summary>
+        /// The number of periods miniaudio allocates when the configuration leaves it at 0.
+        /// </summary>
+        public const uint DefaultPeriods = 3;
+
+        /// <summary>
+        /// The period miniaudio uses when the configuration leaves both period sizes at 0, in milliseconds.
+        /// </summary>
+        public const uint DefaultPeriodMilliseconds = 10;
+
         private readonly nint _device;
         private readonly OnProcessCallback _onProcess;
+        private readonly AudioDevice _owner;
 
         public DeviceInfo? Info { get; }
+        public DeviceInfo? CaptureInfo { get; }
         public Capability Capability { get; }
         public AudioFormat Format { get; }
         public MiniAudioEngine Engine { get; }
 
         public MiniAudioDevice(AudioDevice owner, nint context, DeviceInfo? info, AudioFormat format, DeviceConfig config,
-            OnProcessCallback onProcess)
+            OnProcessCallback onProcess) : this(owner, context, info, info, false, format, config, onProcess)
+        {
+        }
+
+        /// <summary>
+        /// Creates a native duplex device: each callback receives <paramref name="captureInfo"/>'s input and
+        /// <paramref name="playbackInfo"/>'s output buffer for the same frames.
+        /// </summary>
+        public MiniAudioDevice(AudioDevice owner, nint context, DeviceInfo? playbackInfo, DeviceInfo? captureInfo,
+            AudioFormat format, DeviceConfig config, OnProcessCallback onProcess)
+            : this(owner, context, playbackInfo, captureInfo, true, format, config, onProcess)
+        {
+        }
+
+        private MiniAudioDevice(AudioDevice owner, nint context, DeviceInfo? info, DeviceInfo? captureInfo, bool duplex,
+            AudioFormat format, DeviceConfig config, OnProcessCallback onProcess)
         {
             if (config is not MiniAudioDeviceConfig miniAudioDeviceConfig)
                 throw new ArgumentException($"config must be of type {typeof(MiniAudioDeviceConfig)}");
 
             Info = info;
+            CaptureInfo = captureInfo;
             Format = format;
             _onProcess = onProcess;
+            _owner = owner;
             Engine = (MiniAudioEngine)owner.Engine;
 
-            if (owner is AudioCaptureDevice)
+            if (duplex)
+            {
+                Capability = Capability.Mixed;
+            }
+            else if (owner is AudioCaptureDevice)
             {
-                if (miniAudioDeviceConfig != null &&
-                    miniAudioDeviceConfig.Capture != null &&
+                if (miniAudioDeviceConfig.Capture != null &&
                     miniAudioDeviceConfig.Capture.IsLoopback)
                 {
                     Capability = Capability.Loopback;
@@ -111,7 +144,7 @@ namespace SoundFlow.Backends.MiniAudio.Devices
             {
                 Format = Format.Format,
                 Channels = (uint)Format.Channels,
-                pDeviceID = Info?.Id ?? IntPtr.Zero,
+                pDeviceID = CaptureInfo?.Id ?? IntPtr.Zero,
                 ShareMode = maConfig.Capture.ShareMode
             }, handles);
 
@@ -198,7 +231,70 @@ namespace SoundFlow.Backends.MiniAudio.Devices
 
         public void Process(nint pOutput, nint pInput, uint frameCount)
         {
+            var monitor = _owner.CallbackMonitor;
+            monitor.PeriodFrames = frameCount;
+            if (!Engine.PerformanceMonitoring && !monitor.IsWatched)
+            {
+                _onProcess(pOutput, pInput, frameCount, this);
+                return;
+            }
+
+            var start = Stopwatch.GetTimestamp();
             _onProcess(pOutput, pInput, frameCount, this);
+            monitor.Record(start, Stopwatch.GetTimestamp(), frameCount, Format.SampleRate);
+        }
+
+        /// <summary>
+        /// Estimates the largest callback a device created with <paramref name="config"/> can make: one period, or
+        /// the whole buffer when callbacks are not fixed-size.
+        /// </summary>
+        /// <param name="config">The configuration the device was created with.</param>
+        /// <param name="sampleRate">The device sample rate.</param>
+        /// <returns>The estimated number of frames, or 0 if unknown.</returns>
+        public static int EstimateMaxBlockFrames(DeviceConfig config, int sampleRate)
+        {
+            if (sampleRate <= 0 || config is not MiniAudioDeviceConfig maConfig) return 0;
+
+            long period = maConfig.PeriodSizeInFrames > 0
+                ? maConfig.PeriodSizeInFrames
+                : (long)sampleRate * (maConfig.PeriodSizeInMilliseconds > 0 ? maConfig.PeriodSizeInMilliseconds : DefaultPeriodMilliseconds) / 1000;
+            if (maConfig.NoFixedSizedCallback)
+                period *= maConfig.Periods > 0 ? maConfig.Periods : DefaultPeriods;
+            return (int)Math.Min(period, int.MaxValue);
+        }
+
+        /// <summary>
+        /// Estimates the latency of one direction of a device: the time between a frame being rendered and heard,
+        /// or between it being captured and handed to the callback.
+        /// </summary>
+        /// <remarks>
+        /// The native layer does not report the buffer it negotiated, so the estimate uses the observed callback size,
+        /// falling back to the requested period, and the requested period count, falling back to miniaudio's
+        /// default of <see cref="DefaultPeriods"/>. Playback holds every period of the buffer ahead of the speaker;
+        /// capture delivers each period as soon as it fills.
+        /// </remarks>
+        /// <param name="config">The configuration the device was created with.</param>
+        /// <param name="observedFrames">The size of the latest callback, or 0 if none has run yet.</param>
+        /// <param name="sampleRate">The device sample rate.</param>
+        /// <param name="playback">Whether to estimate the output latency rather than the input latency.</param>
+        /// <returns>The estimated latency in milliseconds.</returns>
+        public static double EstimateLatencyMilliseconds(DeviceConfig config, uint observedFrames, int sampleRate,
+            bool playback)
+        {
+            if (sampleRate <= 0 || config is not MiniAudioDeviceConfig maConfig) return 0;
+
+            double periodMilliseconds;
+            if (observedFrames > 0)
+                periodMilliseconds = observedFrames * 1000.0 / sampleRate;
+            else if (maConfig.PeriodSizeInFrames > 0)
+                periodMilliseconds = maConfig.PeriodSizeInFrames * 1000.0 / sampleRate;
+            else if (maConfig.PeriodSizeInMilliseconds > 0)
+                periodMilliseconds = maConfig.PeriodSizeInMilliseconds;
+            else
+                periodMilliseconds = DefaultPeriodMilliseconds;
+
+            var periods = maConfig.Periods > 0 ? maConfig.Periods : DefaultPeriods;
+            return playback ? periodMilliseconds * periods : periodMilliseconds;
         }
 
         public void Dispose()
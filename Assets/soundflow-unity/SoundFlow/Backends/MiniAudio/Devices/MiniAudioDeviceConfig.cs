@@ -11,6 +11,71 @@ namespace SoundFlow.Backends.MiniAudio.Devices
     /// </summary>
     public class MiniAudioDeviceConfig : DeviceConfig
     {
+        private const uint LowestLatencyPeriodMicroseconds = 2500;
+        private const uint BalancedPeriodMicroseconds = 10000;
+        private const uint PowerSavingPeriodMicroseconds = 40000;
+
+        /// <summary>
+        /// Creates a configuration for a named latency profile.
+        /// </summary>
+        /// <remarks>
+        /// The period is given in frames so it is exact at <paramref name="sampleRate"/>. On Windows the lowest latency
+        /// profile also registers the stream as pro audio. The result is a starting point: an
+        /// <see cref="AdaptiveLatencyController"/> can move the period at runtime to what the device actually sustains.
+        /// </remarks>
+        /// <param name="profile">The latency trade-off.</param>
+        /// <param name="sampleRate">The sample rate the device will be opened with.</param>
+        /// <returns>A new configuration.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="sampleRate"/> is not positive or the profile is unknown.</exception>
+        public static MiniAudioDeviceConfig FromProfile(LatencyProfile profile, int sampleRate)
+        {
+            if (sampleRate <= 0)
+                throw new ArgumentOutOfRangeException(nameof(sampleRate), "Sample rate must be positive.");
+
+            return profile switch
+            {
+                LatencyProfile.LowestLatency => new MiniAudioDeviceConfig
+                {
+                    PeriodSizeInFrames = FramesFor(LowestLatencyPeriodMicroseconds, sampleRate),
+                    Periods = 2,
+                    // Fixed-size callbacks add an intermediate buffer of a whole period in front of the device.
+                    NoFixedSizedCallback = true,
+                    Playback = new DeviceSubConfig { ShareMode = ShareMode.Exclusive },
+                    Capture = new DeviceSubConfig { ShareMode = ShareMode.Exclusive },
+                    Wasapi = new WasapiSettings { Usage = WasapiUsage.ProAudio }
+                },
+                LatencyProfile.Balanced => new MiniAudioDeviceConfig
+                {
+                    PeriodSizeInFrames = FramesFor(BalancedPeriodMicroseconds, sampleRate),
+                    Periods = 3
+                },
+                LatencyProfile.PowerSaving => new MiniAudioDeviceConfig
+                {
+                    PeriodSizeInFrames = FramesFor(PowerSavingPeriodMicroseconds, sampleRate),
+                    Periods = 3
+                },
+                _ => throw new ArgumentOutOfRangeException(nameof(profile), profile, "Unknown latency profile.")
+            };
+        }
+
+        private static uint FramesFor(uint microseconds, int sampleRate) =>
+            (uint)Math.Max(1, (long)sampleRate * microseconds / 1000000);
+
+        /// <summary>
+        /// Copies this configuration with a different period size, leaving this instance unchanged.
+        /// </summary>
+        /// <param name="periodSizeInFrames">The new period size in frames.</param>
+        /// <returns>A new configuration.</returns>
+        internal MiniAudioDeviceConfig WithPeriodSize(uint periodSizeInFrames)
+        {
+            var copy = (MiniAudioDeviceConfig)MemberwiseClone();
+            copy.PeriodSizeInFrames = periodSizeInFrames;
+            copy.PeriodSizeInMilliseconds = 0;
+            copy.Playback = new DeviceSubConfig { ShareMode = Playback.ShareMode, IsLoopback = Playback.IsLoopback };
+            copy.Capture = new DeviceSubConfig { ShareMode = Capture.ShareMode, IsLoopback = Capture.IsLoopback };
+            return copy;
+        }
+
         /// <summary>
         /// Gets or sets the desired period size in frames per channel. Takes precedence over PeriodSizeInMilliseconds.
         /// Set to 0 to use the backend's default.
@@ -11,6 +11,7 @@ namespace SoundFlow.Backends.MiniAudio.Devices
     internal sealed class MiniAudioPlaybackDevice : AudioPlaybackDevice
     {
         private readonly MiniAudioDevice _device;
+        private readonly MiniAudioCaptureDevice? _linkedCapture;
 
         public MiniAudioPlaybackDevice(AudioEngine engine, nint context, DeviceInfo? info, AudioFormat format, DeviceConfig config) : base(engine, format, config)
         {
@@ -21,6 +22,26 @@ namespace SoundFlow.Backends.MiniAudio.Devices
             Capability = _device.Capability;
         }
 
+        /// <summary>
+        /// Creates the playback side of a duplex device. It owns the native duplex device, and each callback delivers
+        /// the captured block to <paramref name="linkedCapture"/> before rendering the output.
+        /// </summary>
+        public MiniAudioPlaybackDevice(AudioEngine engine, nint context, DeviceInfo? info, AudioFormat format, DeviceConfig config,
+            MiniAudioCaptureDevice linkedCapture) : base(engine, format, config)
+        {
+            _linkedCapture = linkedCapture;
+            _device = new MiniAudioDevice(this, context, info, linkedCapture.Info, format, config, ProcessAudioCallback);
+
+            Info = _device.Info;
+            Capability = Capability.Playback;
+        }
+
+        public override double LatencyMilliseconds =>
+            MiniAudioDevice.EstimateLatencyMilliseconds(Config, CallbackMonitor.PeriodFrames, Format.SampleRate, true);
+
+        public override int MaxBlockFrames =>
+            Math.Max(MiniAudioDevice.EstimateMaxBlockFrames(Config, Format.SampleRate), (int)CallbackMonitor.PeriodFrames);
+
         public override void Start()
         {
             _device.Start();
@@ -47,6 +68,15 @@ namespace SoundFlow.Backends.MiniAudio.Devices
         /// </summary>
         private void ProcessAudioCallback(nint pOutput, nint pInput, uint frameCount, MiniAudioDevice device)
         {
+            // Input first, so whatever the capture subscribers queue for playback is rendered in this same callback.
+            var linkedCapture = _linkedCapture;
+            if (linkedCapture != null)
+            {
+                linkedCapture.CallbackMonitor.PeriodFrames = frameCount;
+                if (linkedCapture.IsRunning && !linkedCapture.IsDisposed)
+                    linkedCapture.DeliverInput(pInput, frameCount, device.Format);
+            }
+
             if (pOutput == IntPtr.Zero) return;
 
             var length = (int)frameCount * Format.Channels;
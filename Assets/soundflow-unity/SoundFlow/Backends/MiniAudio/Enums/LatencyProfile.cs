@@ -0,0 +1,26 @@
+namespace SoundFlow.Backends.MiniAudio.Enums
+{
+    /// <summary>
+    /// Named trade-offs between latency and robustness, used by <see cref="Devices.MiniAudioDeviceConfig.FromProfile"/>.
+    /// </summary>
+    public enum LatencyProfile
+    {
+        /// <summary>
+        /// Exclusive mode (WASAPI exclusive, AAudio exclusive sharing) with the smallest period and a double buffer.
+        /// For live monitoring and instruments; weak devices may underrun, and devices that refuse exclusive
+        /// mode fail to initialize.
+        /// </summary>
+        LowestLatency,
+
+        /// <summary>
+        /// Shared mode with a 10 ms period and a triple buffer. Suits voice chat on most devices.
+        /// </summary>
+        Balanced,
+
+        /// <summary>
+        /// Shared mode with a large period, so the device wakes the CPU as rarely as possible. For music and
+        /// background playback where latency does not matter.
+        /// </summary>
+        PowerSaving
+    }
+}
@@ -22,6 +22,8 @@ namespace SoundFlow.Backends.MiniAudio
     public sealed class MiniAudioEngine : AudioEngine
     {
         private nint _context;
+        // Guarded by itself: devices are switched by adaptive latency controllers and listed by performance
+        // snapshots on other threads.
         private readonly List<AudioDevice> _activeDevices = new List<AudioDevice>();
 
         internal static readonly Native.AudioCallback DataCallback = OnAudioData;
@@ -37,6 +39,12 @@ namespace SoundFlow.Backends.MiniAudio
         }
 
         internal void RegisterDevice(nint pDevice, MiniAudioDevice device) => DeviceMap.TryAdd(pDevice, device);
+
+        /// <inheritdoc />
+        protected override IReadOnlyList<AudioDevice> GetActiveDevices()
+        {
+            lock (_activeDevices) return _activeDevices.ToArray();
+        }
         internal void UnregisterDevice(nint pDevice) => DeviceMap.TryRemove(pDevice, out _);
 
         /// <inheritdoc />
@@ -53,11 +61,11 @@ namespace SoundFlow.Backends.MiniAudio
         /// <inheritdoc />
         protected override void CleanupBackend()
         {
-            foreach (var device in _activeDevices.ToList())
+            foreach (var device in GetActiveDevices())
             {
                 device.Dispose();
             }
-            _activeDevices.Clear();
+            lock (_activeDevices) _activeDevices.Clear();
 
             Native.ContextUninit(_context);
             Native.Free(_context);
@@ -72,7 +80,7 @@ namespace SoundFlow.Backends.MiniAudio
 
             config ??= GetDefaultDeviceConfig();
             var device = new MiniAudioPlaybackDevice(this, _context, deviceInfo, format, config);
-            _activeDevices.Add(device);
+            AddActiveDevice(device);
             device.OnDisposed += OnDeviceDisposing;
             return device;
         }
@@ -85,20 +93,37 @@ namespace SoundFlow.Backends.MiniAudio
 
             config ??= GetDefaultDeviceConfig();
             var device = new MiniAudioCaptureDevice(this, _context, deviceInfo, format, config);
-            _activeDevices.Add(device);
+            AddActiveDevice(device);
             device.OnDisposed += OnDeviceDisposing;
             return device;
         }
 
         /// <inheritdoc />
-        public override FullDuplexDevice InitializeFullDuplexDevice(DeviceInfo? playbackDeviceInfo, DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig? config = null)
+        /// <remarks>
+        /// <see cref="DuplexMode.Linked"/> creates a single miniaudio duplex device. Its playback side is registered
+        /// as an active device and reports the callback statistics; its capture side has no callback of its own.
+        /// </remarks>
+        public override FullDuplexDevice InitializeFullDuplexDevice(DeviceInfo? playbackDeviceInfo, DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig? config = null, DuplexMode mode = DuplexMode.Separate)
         {
             if (config != null && config is not MiniAudioDeviceConfig)
                 throw new ArgumentException($"config must be of type {typeof(MiniAudioDeviceConfig)}");
 
             config ??= GetDefaultDeviceConfig();
-            var device = new FullDuplexDevice(this, playbackDeviceInfo, captureDeviceInfo, format, config);
-            _activeDevices.Add(device);
+            FullDuplexDevice device;
+            if (mode == DuplexMode.Linked)
+            {
+                var capture = new MiniAudioCaptureDevice(this, captureDeviceInfo, format, config);
+                var playback = new MiniAudioPlaybackDevice(this, _context, playbackDeviceInfo, format, config, capture);
+                AddActiveDevice(playback);
+                playback.OnDisposed += OnDeviceDisposing;
+                device = new FullDuplexDevice(this, playback, capture, format, config, mode);
+            }
+            else
+            {
+                device = new FullDuplexDevice(this, playbackDeviceInfo, captureDeviceInfo, format, config);
+            }
+
+            AddActiveDevice(device);
             device.OnDisposed += OnDeviceDisposing;
             return device;
         }
@@ -175,7 +200,7 @@ namespace SoundFlow.Backends.MiniAudio
 
             oldDevice.Dispose();
 
-            var newDevice = InitializeFullDuplexDevice(playbackInfo, captureInfo, oldDevice.Format, config);
+            var newDevice = InitializeFullDuplexDevice(playbackInfo, captureInfo, oldDevice.Format, config, oldDevice.Mode);
 
             // Restore state to the new underlying devices
             DeviceSwitcher.RestorePlaybackState(newDevice.PlaybackDevice, preservedComponents);
@@ -186,11 +211,16 @@ namespace SoundFlow.Backends.MiniAudio
             return newDevice;
         }
 
+        private void AddActiveDevice(AudioDevice device)
+        {
+            lock (_activeDevices) _activeDevices.Add(device);
+        }
+
         private void OnDeviceDisposing(object? sender, EventArgs e)
         {
             if (sender is AudioDevice device)
             {
-                _activeDevices.Remove(device);
+                lock (_activeDevices) _activeDevices.Remove(device);
             }
         }
 
@@ -0,0 +1,110 @@
+using SoundFlow.Abstracts.Devices;
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Structs;
+using System;
+
+namespace SoundFlow.Backends.Offline.Devices
+{
+    /// <summary>
+    /// A capture device without hardware for an <see cref="OfflineEngine"/>.
+    /// </summary>
+    /// <remarks>
+    /// A record device reads its input from <see cref="Source"/> (silence when there is none or it has ended) each
+    /// time the engine is rendered, or from samples pushed with <see cref="Capture(Span{float})"/>. A loopback device
+    /// raises <see cref="AudioCaptureDevice.OnAudioProcessed"/> with every block its playback device renders, so a
+    /// <see cref="SoundFlow.Components.Recorder"/> on it bounces the mix.
+    /// </remarks>
+    public sealed class OfflineCaptureDevice : AudioCaptureDevice
+    {
+        private readonly float[] _block;
+        private readonly OfflinePlaybackDevice? _loopbackSource;
+
+        internal OfflineCaptureDevice(OfflineEngine engine, DeviceInfo? info, AudioFormat format,
+            OfflineDeviceConfig config, OfflinePlaybackDevice? loopbackSource = null) : base(engine, format, config)
+        {
+            if (format.Channels <= 0)
+                throw new ArgumentException("Number of channels must be greater than 0.", nameof(format));
+            if (config.BlockSize <= 0)
+                throw new ArgumentOutOfRangeException(nameof(config), "Block size must be positive.");
+
+            Info = info;
+            BlockSize = config.BlockSize;
+            _block = new float[BlockSize * format.Channels];
+            _loopbackSource = loopbackSource;
+            Capability = loopbackSource != null ? Capability.Loopback : Capability.Record;
+
+            if (_loopbackSource != null)
+                _loopbackSource.OnAudioRendered += OnLoopbackRendered;
+        }
+
+        /// <summary>
+        /// Gets the number of frames per channel delivered per <see cref="AudioCaptureDevice.OnAudioProcessed"/> call.
+        /// </summary>
+        public int BlockSize { get; }
+
+        /// <summary>
+        /// Gets or sets the provider read as the device's input when the engine is rendered. Its samples must be in
+        /// the device's format. Ignored by loopback devices.
+        /// </summary>
+        public ISoundDataProvider? Source { get; set; }
+
+        /// <inheritdoc />
+        public override void Start() => IsRunning = !IsDisposed;
+
+        /// <inheritdoc />
+        public override void Stop() => IsRunning = false;
+
+        /// <summary>
+        /// Delivers captured samples to the subscribers of <see cref="AudioCaptureDevice.OnAudioProcessed"/> as if
+        /// they had come from hardware.
+        /// </summary>
+        /// <param name="samples">Interleaved samples in the device's format. Subscribers may modify them.</param>
+        public void Capture(Span<float> samples)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            var blockSamples = _block.Length;
+            for (var offset = 0; offset < samples.Length; offset += blockSamples)
+                InvokeOnAudioProcessed(samples.Slice(offset, Math.Min(blockSamples, samples.Length - offset)));
+        }
+
+        /// <summary>
+        /// Reads up to one block of input from <see cref="Source"/> and delivers it.
+        /// </summary>
+        internal void CaptureFrames(int frames)
+        {
+            var block = _block.AsSpan(0, Math.Min(frames, BlockSize) * Format.Channels);
+            var read = 0;
+            var source = Source;
+            if (source != null && !source.IsDisposed)
+            {
+                while (read < block.Length)
+                {
+                    var count = source.ReadBytes(block[read..]);
+                    if (count <= 0) break;
+                    read += count;
+                }
+            }
+
+            block[read..].Clear();
+            InvokeOnAudioProcessed(block);
+        }
+
+        private void OnLoopbackRendered(Span<float> samples, Capability capability)
+        {
+            if (IsRunning && samples.Length % Format.Channels == 0)
+                InvokeOnAudioProcessed(samples);
+        }
+
+        /// <inheritdoc />
+        public override void Dispose()
+        {
+            if (IsDisposed) return;
+            IsRunning = false;
+            if (_loopbackSource != null)
+                _loopbackSource.OnAudioRendered -= OnLoopbackRendered;
+            OnDisposedHandler();
+            IsDisposed = true;
+        }
+    }
+}
@@ -0,0 +1,22 @@
+using SoundFlow.Abstracts.Devices;
+
+namespace SoundFlow.Backends.Offline.Devices
+{
+    /// <summary>
+    /// Configuration for the devices of an <see cref="OfflineEngine"/>.
+    /// </summary>
+    public class OfflineDeviceConfig : DeviceConfig
+    {
+        /// <summary>
+        /// The default block size in frames.
+        /// </summary>
+        public const int DefaultBlockSize = 512;
+
+        /// <summary>
+        /// Gets or sets the number of frames per channel processed by each pass through the component graph,
+        /// the offline equivalent of a device period. Larger blocks render faster; smaller blocks match the timing
+        /// of a low-latency device more closely.
+        /// </summary>
+        public int BlockSize { get; set; } = DefaultBlockSize;
+    }
+}
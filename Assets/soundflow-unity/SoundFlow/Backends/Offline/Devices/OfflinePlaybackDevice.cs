@@ -0,0 +1,142 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Abstracts.Devices;
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Structs;
+using System;
+using System.Threading;
+
+namespace SoundFlow.Backends.Offline.Devices
+{
+    /// <summary>
+    /// A playback device without hardware. Audio is pulled through <see cref="AudioPlaybackDevice.MasterMixer"/>
+    /// (or the soloed component) block by block whenever the device is rendered, as fast as the graph can run.
+    /// </summary>
+    /// <remarks>
+    /// Render the device directly with <see cref="Render(Span{float})"/> or <see cref="Render(ISoundEncoder, long)"/>,
+    /// or advance every running device of the engine together with <see cref="OfflineEngine.Render(long)"/>.
+    /// Rendering happens synchronously on the calling thread and does not require the device to be started.
+    /// </remarks>
+    public sealed class OfflinePlaybackDevice : AudioPlaybackDevice
+    {
+        private readonly float[] _block;
+        private long _framesRendered;
+
+        /// <summary>
+        /// Occurs after each block has been rendered, with the block's interleaved samples.
+        /// </summary>
+        public event AudioProcessCallback? OnAudioRendered;
+
+        internal OfflinePlaybackDevice(OfflineEngine engine, DeviceInfo? info, AudioFormat format,
+            OfflineDeviceConfig config) : base(engine, format, config)
+        {
+            if (format.Channels <= 0)
+                throw new ArgumentException("Number of channels must be greater than 0.", nameof(format));
+            if (config.BlockSize <= 0)
+                throw new ArgumentOutOfRangeException(nameof(config), "Block size must be positive.");
+
+            Info = info;
+            Capability = Capability.Playback;
+            BlockSize = config.BlockSize;
+            _block = new float[BlockSize * format.Channels];
+        }
+
+        /// <summary>
+        /// Gets the number of frames per channel processed by each pass through the graph.
+        /// </summary>
+        public int BlockSize { get; }
+
+        /// <inheritdoc />
+        public override int MaxBlockFrames => BlockSize;
+
+        /// <summary>
+        /// Gets the total number of frames rendered by this device.
+        /// </summary>
+        public long FramesRendered => Interlocked.Read(ref _framesRendered);
+
+        /// <summary>
+        /// Gets the amount of audio rendered by this device.
+        /// </summary>
+        public TimeSpan RenderedTime => TimeSpan.FromSeconds((double)FramesRendered / Format.SampleRate);
+
+        /// <inheritdoc />
+        public override void Start() => IsRunning = !IsDisposed;
+
+        /// <inheritdoc />
+        public override void Stop() => IsRunning = false;
+
+        /// <summary>
+        /// Renders the graph into <paramref name="destination"/>. Only whole frames are written.
+        /// </summary>
+        /// <param name="destination">The buffer to fill with interleaved samples.</param>
+        /// <returns>The number of samples written.</returns>
+        public int Render(Span<float> destination)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            var channels = Format.Channels;
+            var total = destination.Length - destination.Length % channels;
+            var blockSamples = _block.Length;
+
+            for (var offset = 0; offset < total; offset += blockSamples)
+                RenderBlock(destination.Slice(offset, Math.Min(blockSamples, total - offset)));
+
+            return total;
+        }
+
+        /// <summary>
+        /// Renders <paramref name="frames"/> frames of the graph straight into <paramref name="encoder"/>.
+        /// </summary>
+        /// <param name="encoder">The encoder receiving the rendered audio, e.g. from <see cref="AudioEngine.CreateEncoder"/>.</param>
+        /// <param name="frames">The number of frames per channel to render.</param>
+        /// <returns>The number of samples encoded.</returns>
+        /// <exception cref="ArgumentNullException">Thrown if encoder is null.</exception>
+        public long Render(ISoundEncoder encoder, long frames)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (encoder == null) throw new ArgumentNullException(nameof(encoder));
+
+            var encoded = 0L;
+            while (frames > 0)
+            {
+                var block = RenderFrames((int)Math.Min(frames, BlockSize));
+                encoded += encoder.Encode(block);
+                frames -= block.Length / Format.Channels;
+            }
+
+            return encoded;
+        }
+
+        /// <summary>
+        /// Renders up to one block into the device's own buffer.
+        /// </summary>
+        internal Span<float> RenderFrames(int frames)
+        {
+            var block = _block.AsSpan(0, Math.Min(frames, BlockSize) * Format.Channels);
+            RenderBlock(block);
+            return block;
+        }
+
+        private void RenderBlock(Span<float> buffer)
+        {
+            buffer.Clear();
+
+            var soloedComponent = Engine.GetSoloedComponent();
+            if (soloedComponent != null)
+                soloedComponent.Process(buffer, Format.Channels);
+            else
+                MasterMixer.Process(buffer, Format.Channels);
+
+            Interlocked.Add(ref _framesRendered, buffer.Length / Format.Channels);
+            OnAudioRendered?.Invoke(buffer, Capability.Playback);
+        }
+
+        /// <inheritdoc />
+        public override void Dispose()
+        {
+            if (IsDisposed) return;
+            IsRunning = false;
+            OnDisposedHandler();
+            IsDisposed = true;
+        }
+    }
+}
@@ -0,0 +1,241 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Abstracts.Devices;
+using SoundFlow.Backends.MiniAudio;
+using SoundFlow.Backends.Offline.Devices;
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Structs;
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+
+namespace SoundFlow.Backends.Offline
+{
+    /// <summary>
+    /// An audio engine without audio hardware. Its devices are driven by explicit render calls instead of a device
+    /// callback, so the component graph runs as fast as the CPU allows: bounce mixes, bake assets or run audio
+    /// regression tests in a fraction of realtime.
+    /// </summary>
+    /// <remarks>
+    /// <see cref="Render(long)"/> advances every running device by the same number of frames, one block at a time:
+    /// record devices deliver their input first, then playback devices render their graph, and loopback devices
+    /// receive what their playback device rendered. Encoders and decoders are provided by MiniAudio.
+    /// </remarks>
+    public sealed class OfflineEngine : AudioEngine
+    {
+        private readonly List<AudioDevice> _activeDevices = new();
+
+        /// <summary>
+        /// Initializes and returns an offline playback device.
+        /// </summary>
+        /// <param name="format">The audio format to render.</param>
+        /// <param name="blockSize">The number of frames per channel processed per pass through the graph.</param>
+        /// <returns>An offline playback device.</returns>
+        public OfflinePlaybackDevice CreatePlaybackDevice(AudioFormat format,
+            int blockSize = OfflineDeviceConfig.DefaultBlockSize) =>
+            (OfflinePlaybackDevice)InitializePlaybackDevice(null, format, new OfflineDeviceConfig { BlockSize = blockSize });
+
+        /// <summary>
+        /// Renders every running device of this engine by <paramref name="frames"/> frames.
+        /// </summary>
+        /// <param name="frames">The number of frames per channel to render.</param>
+        public void Render(long frames)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            var devices = _activeDevices.ToArray();
+            var captures = devices.OfType<OfflineCaptureDevice>()
+                .Where(d => d.IsRunning && d.Capability == Capability.Record).ToArray();
+            var playbacks = devices.OfType<OfflinePlaybackDevice>().Where(d => d.IsRunning).ToArray();
+            if (captures.Length == 0 && playbacks.Length == 0) return;
+
+            // Step by the smallest block so every device sees each block boundary in the same order.
+            var step = int.MaxValue;
+            foreach (var capture in captures) step = Math.Min(step, capture.BlockSize);
+            foreach (var playback in playbacks) step = Math.Min(step, playback.BlockSize);
+
+            while (frames > 0)
+            {
+                var block = (int)Math.Min(frames, step);
+                foreach (var capture in captures)
+                    capture.CaptureFrames(block);
+                foreach (var playback in playbacks)
+                    playback.RenderFrames(block);
+                frames -= block;
+            }
+        }
+
+        /// <summary>
+        /// Renders every running device of this engine for <paramref name="duration"/>, using the sample rate of
+        /// <paramref name="format"/>.
+        /// </summary>
+        /// <param name="duration">The amount of audio to render.</param>
+        /// <param name="format">The format whose sample rate converts the duration to frames.</param>
+        public void Render(TimeSpan duration, AudioFormat format) =>
+            Render((long)Math.Round(duration.TotalSeconds * format.SampleRate));
+
+        /// <inheritdoc />
+        protected override void InitializeBackend()
+        {
+        }
+
+        /// <inheritdoc />
+        protected override void CleanupBackend()
+        {
+            foreach (var device in _activeDevices.ToList())
+                device.Dispose();
+            _activeDevices.Clear();
+        }
+
+        /// <inheritdoc />
+        public override AudioPlaybackDevice InitializePlaybackDevice(DeviceInfo? deviceInfo, AudioFormat format,
+            DeviceConfig? config = null)
+        {
+            var device = new OfflinePlaybackDevice(this, deviceInfo, format, GetConfig(config));
+            Register(device);
+            return device;
+        }
+
+        /// <inheritdoc />
+        public override AudioCaptureDevice InitializeCaptureDevice(DeviceInfo? deviceInfo, AudioFormat format,
+            DeviceConfig? config = null)
+        {
+            var device = new OfflineCaptureDevice(this, deviceInfo, format, GetConfig(config));
+            Register(device);
+            return device;
+        }
+
+        /// <inheritdoc />
+        /// <remarks>
+        /// Both modes behave the same: <see cref="Render(long)"/> already delivers each block of input before
+        /// rendering the same frames of output, which is what <see cref="DuplexMode.Linked"/> asks of hardware.
+        /// </remarks>
+        public override FullDuplexDevice InitializeFullDuplexDevice(DeviceInfo? playbackDeviceInfo,
+            DeviceInfo? captureDeviceInfo, AudioFormat format, DeviceConfig? config = null,
+            DuplexMode mode = DuplexMode.Separate)
+        {
+            var device = new FullDuplexDevice(this, playbackDeviceInfo, captureDeviceInfo, format, GetConfig(config), mode);
+            Register(device);
+            return device;
+        }
+
+        /// <summary>
+        /// Initializes a loopback capture device that receives every block rendered by the first offline playback
+        /// device of this engine.
+        /// </summary>
+        /// <exception cref="NotSupportedException">Thrown if the engine has no playback device to loop back.</exception>
+        /// <exception cref="ArgumentException">Thrown if the format's channel count differs from the playback device.</exception>
+        public override AudioCaptureDevice InitializeLoopbackDevice(AudioFormat format, DeviceConfig? config = null)
+        {
+            var playback = _activeDevices.OfType<OfflinePlaybackDevice>().FirstOrDefault();
+            if (playback == null)
+                throw new NotSupportedException("Initialize an offline playback device before its loopback device.");
+            if (playback.Format.Channels != format.Channels)
+                throw new ArgumentException("The loopback format must have the same channel count as the playback device.",
+                    nameof(format));
+
+            var device = new OfflineCaptureDevice(this, null, format, GetConfig(config), playback);
+            Register(device);
+            return device;
+        }
+
+        /// <inheritdoc />
+        public override AudioPlaybackDevice SwitchDevice(AudioPlaybackDevice oldDevice, DeviceInfo newDeviceInfo,
+            DeviceConfig? config = null)
+        {
+            var wasRunning = oldDevice.IsRunning;
+            var preservedComponents = DeviceSwitcher.PreservePlaybackState(oldDevice);
+
+            oldDevice.Dispose();
+
+            var newDevice = InitializePlaybackDevice(newDeviceInfo, oldDevice.Format, config ?? oldDevice.Config);
+            DeviceSwitcher.RestorePlaybackState(newDevice, preservedComponents);
+
+            if (wasRunning) newDevice.Start();
+
+            return newDevice;
+        }
+
+        /// <inheritdoc />
+        public override AudioCaptureDevice SwitchDevice(AudioCaptureDevice oldDevice, DeviceInfo newDeviceInfo,
+            DeviceConfig? config = null)
+        {
+            var wasRunning = oldDevice.IsRunning;
+            var preservedSubscribers = DeviceSwitcher.PreserveCaptureState(oldDevice);
+
+            oldDevice.Dispose();
+
+            var newDevice = InitializeCaptureDevice(newDeviceInfo, oldDevice.Format, config ?? oldDevice.Config);
+            DeviceSwitcher.RestoreCaptureState(newDevice, preservedSubscribers);
+
+            if (wasRunning) newDevice.Start();
+
+            return newDevice;
+        }
+
+        /// <inheritdoc />
+        public override FullDuplexDevice SwitchDevice(FullDuplexDevice oldDevice, DeviceInfo? newPlaybackInfo,
+            DeviceInfo? newCaptureInfo, DeviceConfig? config = null)
+        {
+            var wasRunning = oldDevice.IsRunning;
+
+            var preservedComponents = DeviceSwitcher.PreservePlaybackState(oldDevice.PlaybackDevice);
+            var preservedSubscribers = DeviceSwitcher.PreserveCaptureState(oldDevice.CaptureDevice);
+
+            var playbackInfo = newPlaybackInfo ?? oldDevice.PlaybackDevice.Info;
+            var captureInfo = newCaptureInfo ?? oldDevice.CaptureDevice.Info;
+
+            oldDevice.Dispose();
+
+            var newDevice = InitializeFullDuplexDevice(playbackInfo, captureInfo, oldDevice.Format,
+                config ?? oldDevice.Config, oldDevice.Mode);
+
+            DeviceSwitcher.RestorePlaybackState(newDevice.PlaybackDevice, preservedComponents);
+            DeviceSwitcher.RestoreCaptureState(newDevice.CaptureDevice, preservedSubscribers);
+
+            if (wasRunning) newDevice.Start();
+
+            return newDevice;
+        }
+
+        /// <inheritdoc />
+        public override ISoundEncoder CreateEncoder(Stream stream, EncodingFormat encodingFormat, AudioFormat format)
+        {
+            return new MiniAudioEncoder(stream, encodingFormat, format.Format, format.Channels, format.SampleRate);
+        }
+
+        /// <inheritdoc />
+        public override ISoundDecoder CreateDecoder(Stream stream, AudioFormat format)
+        {
+            return new MiniAudioDecoder(stream, format.Format, format.Channels, format.SampleRate);
+        }
+
+        /// <summary>
+        /// The offline engine has no hardware devices to enumerate.
+        /// </summary>
+        public override void UpdateDevicesInfo()
+        {
+        }
+
+        private static OfflineDeviceConfig GetConfig(DeviceConfig? config)
+        {
+            if (config != null && config is not OfflineDeviceConfig)
+                throw new ArgumentException($"config must be of type {typeof(OfflineDeviceConfig)}");
+
+            return (OfflineDeviceConfig?)config ?? new OfflineDeviceConfig();
+        }
+
+        private void Register(AudioDevice device)
+        {
+            _activeDevices.Add(device);
+            device.OnDisposed += OnDeviceDisposing;
+        }
+
+        private void OnDeviceDisposing(object? sender, EventArgs e)
+        {
+            if (sender is AudioDevice device)
+                _activeDevices.Remove(device);
+        }
+    }
+}
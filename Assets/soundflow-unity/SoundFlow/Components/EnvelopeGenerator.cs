@@ -1,4 +1,5 @@
 ﻿using SoundFlow.Abstracts;
+using SoundFlow.Enums;
 using SoundFlow.Structs;
 using System;
 
@@ -107,6 +108,22 @@ namespace SoundFlow.Components
         /// </summary>
         public bool Retrigger { get; set; } = false;
 
+        /// <summary>
+        /// Gets or sets how often the envelope computes its level. At <see cref="Enums.ControlRate.Block"/>, each
+        /// block advances the stages in one step and <see cref="LevelChanged"/> is raised once per block.
+        /// </summary>
+        public ControlRate ControlRate { get; set; } = ControlRate.Audio;
+
+        /// <summary>
+        /// Gets the current envelope level.
+        /// </summary>
+        public float Level => _currentLevel;
+
+        /// <summary>
+        /// Gets the current envelope stage.
+        /// </summary>
+        public EnvelopeState State => _currentState;
+
         // Internal State
         private EnvelopeState _currentState = EnvelopeState.Idle;
         private float _currentLevel;
@@ -117,6 +134,7 @@ namespace SoundFlow.Components
         /// <summary>
         /// Occurs when the envelope level changes during audio generation.
         /// Subscribers can use this event to react to envelope level changes, for example, to visualize the envelope shape.
+        /// It is raised every frame, or once per block at <see cref="Enums.ControlRate.Block"/>.
         /// </summary>
         public event Action<float>? LevelChanged;
 
@@ -167,16 +185,79 @@ namespace SoundFlow.Components
         /// <inheritdoc/>
         protected override void GenerateAudio(Span<float> buffer, int channels)
         {
-            for (var i = 0; i < buffer.Length; i++)
+            var frames = buffer.Length / channels;
+
+            if (ControlRate == ControlRate.Block)
+            {
+                if (frames == 0) return;
+                Advance(frames);
+                LevelChanged?.Invoke(_currentLevel);
+                return;
+            }
+
+            for (var frame = 0; frame < frames; frame++)
             {
                 Update();
                 LevelChanged?.Invoke(_currentLevel);
             }
         }
 
+        /// <summary>
+        /// Advances the envelope by <paramref name="frames"/> updates at once, jumping straight to each stage
+        /// boundary it crosses. Ends at the same level and stage as calling <see cref="Update"/> that many times.
+        /// </summary>
+        private void Advance(int frames)
+        {
+            var remaining = frames;
+            while (remaining > 0)
+            {
+                switch (_currentState)
+                {
+                    case EnvelopeState.Attack:
+                        remaining = Ramp(remaining, 1f - _currentLevel, _attackRate);
+                        break;
+                    case EnvelopeState.Decay:
+                        remaining = Ramp(remaining, _currentLevel - SustainLevel, -_decayRate);
+                        break;
+                    case EnvelopeState.Release:
+                        remaining = Ramp(remaining, _currentLevel, -_releaseRate);
+                        break;
+                    case EnvelopeState.Sustain when Trigger == TriggerMode.Trigger:
+                        Update();
+                        remaining--;
+                        break;
+                    default:
+                        // Sustain and Idle hold their level.
+                        remaining = 0;
+                        break;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Moves the level by <paramref name="rate"/> per update, for as many updates as the stage has left of
+        /// <paramref name="distance"/>, and finishes the stage through <see cref="Update"/> if it ends in time.
+        /// </summary>
+        /// <returns>The updates left after this stage.</returns>
+        private int Ramp(int remaining, float distance, float rate)
+        {
+            // Updates needed to cover the distance; the last one lands on the boundary and changes stage.
+            var speed = Math.Abs(rate);
+            var steps = distance <= 0f ? 1.0 : speed > 0f ? Math.Ceiling(distance / speed) : double.MaxValue;
+            if (steps > remaining)
+            {
+                _currentLevel += rate * remaining;
+                return 0;
+            }
+
+            _currentLevel += rate * (int)(steps - 1);
+            Update();
+            return remaining - (int)steps;
+        }
+
         /// <summary>
         /// Updates the envelope level based on the current state and calculated rates.
-        /// This method is called per sample in the <see cref="GenerateAudio"/> method to advance the envelope through its stages.
+        /// This method is called per frame in the <see cref="GenerateAudio"/> method to advance the envelope through its stages.
         /// </summary>
         private void Update()
         {
@@ -1,5 +1,6 @@
 ﻿using SoundFlow.Abstracts;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Components
@@ -37,7 +38,7 @@ namespace SoundFlow.Components
 
         /// <summary>
         /// Gets or sets the type of filter.
-        /// Changing the filter type recalculates the filter coefficients.
+        /// Changing the filter type recalculates the filter coefficients at the next block.
         /// </summary>
         public FilterType Type
         {
@@ -45,7 +46,7 @@ namespace SoundFlow.Components
             set
             {
                 _type = value;
-                CalculateCoefficients();
+                _coefficientsChanged = true;
             }
         }
 
@@ -54,7 +55,7 @@ namespace SoundFlow.Components
         /// <summary>
         /// Gets or sets the cutoff frequency of the filter in Hertz.
         /// This frequency determines the point at which the filter starts to attenuate the signal.
-        /// Changing the cutoff frequency recalculates the filter coefficients.
+        /// Changing the cutoff frequency recalculates the filter coefficients at the next block.
         /// </summary>
         public float CutoffFrequency
         {
@@ -62,7 +63,7 @@ namespace SoundFlow.Components
             set
             {
                 _cutoffFrequency = value;
-                CalculateCoefficients();
+                _coefficientsChanged = true;
             }
         }
 
@@ -78,14 +79,17 @@ namespace SoundFlow.Components
             get => _resonance;
             set
             {
-                _resonance = value;
-                CalculateCoefficients();
+                // Clamp resonance to avoid instability at very high resonance values
+                _resonance = Math.Clamp(value, 0.01f, 0.99f);
+                _coefficientsChanged = true;
             }
         }
 
-        // Internal state for the biquad filter
-        private float _x1, _x2, _y1, _y2; // Delay elements for input (x) and output (y) samples
-        private float _a0, _a1, _a2, _b1, _b2; // Filter coefficients for the biquad filter structure
+        // Runs on the audio thread: one section per channel, allocated up front for the usual channel counts and
+        // only rebuilt if the graph has more channels than that.
+        private BiquadCascade _cascade;
+        private int _channels;
+        private volatile bool _coefficientsChanged = true;
 
         /// <summary>
         /// Initializes a new instance of the <see cref="Filter"/> class with default settings and calculates initial filter coefficients.
@@ -94,6 +98,8 @@ namespace SoundFlow.Components
         /// <param name="format">The audio format containing channels and sample rate and sample format</param>
         public Filter(AudioEngine engine, AudioFormat format) : base(engine, format)
         {
+            _channels = Math.Max(1, format.Channels);
+            _cascade = new BiquadCascade(Math.Max(_channels, BiquadCascade.DefaultLaneCapacity), 1);
             CalculateCoefficients();
         }
 
@@ -103,87 +109,45 @@ namespace SoundFlow.Components
         /// <inheritdoc/>
         protected override void GenerateAudio(Span<float> buffer, int channels)
         {
-            for (var i = 0; i < buffer.Length; i++)
+            if (channels <= 0) return;
+
+            if (channels != _channels)
             {
-                buffer[i] = ProcessSample(buffer[i]);
+                if (channels > _cascade.Lanes)
+                    _cascade = new BiquadCascade(channels, 1);
+                else
+                    _cascade.Reset();
+
+                _cascade.SmoothingSamples = 0;
+                _channels = channels;
+                _coefficientsChanged = true;
             }
-        }
 
-        /// <summary>
-        /// Processes a single audio sample through the biquad filter.
-        /// </summary>
-        /// <param name="input">The input audio sample.</param>
-        /// <returns>The filtered audio sample.</returns>
-        private float ProcessSample(float input)
-        {
-            var output = _a0 * input + _a1 * _x1 + _a2 * _x2 - _b1 * _y1 - _b2 * _y2;
-
-            // Update delay elements for the next sample
-            _x2 = _x1;
-            _x1 = input;
-            _y2 = _y1;
-            _y1 = output;
+            if (_coefficientsChanged)
+                CalculateCoefficients();
 
-            return output;
+            _cascade.Process(buffer[..(buffer.Length - buffer.Length % channels)], channels);
         }
 
         /// <summary>
         /// Calculates the biquad filter coefficients based on the current <see cref="Type"/>, <see cref="CutoffFrequency"/>, and <see cref="Resonance"/> parameters.
-        /// This method uses standard formulas for digital biquad filter coefficient calculation and normalizes the coefficients.
+        /// The first design is applied immediately; later ones are interpolated over a few milliseconds to avoid clicks.
         /// </summary>
         private void CalculateCoefficients()
         {
-            // Clamp resonance to avoid instability at very high resonance values
-            _resonance = Math.Clamp(_resonance, 0.01f, 0.99f);
-            // Pre-compute common values to optimize coefficient calculations
+            _coefficientsChanged = false;
             float sampleRate = Format.SampleRate;
-            var omega = 2.0f * MathF.PI * CutoffFrequency / sampleRate; // Angular frequency
-            var sinOmega = MathF.Sin(omega);
-            var cosOmega = MathF.Cos(omega);
-            var alpha = sinOmega / (2 * Resonance); // Bandwidth parameter, related to resonance
-
-            // Calculate coefficients based on the selected filter type
-            switch (Type)
+            var coefficients = Type switch
             {
-                case FilterType.LowPass:
-                    _a0 = (1 - cosOmega) / 2;
-                    _a1 = 1 - cosOmega;
-                    _a2 = (1 - cosOmega) / 2;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1 - alpha;
-                    break;
-                case FilterType.HighPass:
-                    _a0 = (1 + cosOmega) / 2;
-                    _a1 = -(1 + cosOmega);
-                    _a2 = (1 + cosOmega) / 2;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1 - alpha;
-                    break;
-                case FilterType.BandPass:
-                    _a0 = alpha;
-                    _a1 = 0;
-                    _a2 = -alpha;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1 - alpha;
-                    break;
-                case FilterType.Notch:
-                    _a0 = 1;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1 - alpha;
-                    break;
-                default:
-                    throw new ArgumentOutOfRangeException();
-            }
-
-            // Normalize coefficients by dividing by a0 (which is actually 'a0' in biquad formulas, and in our case it's (1+alpha) after calculations)
-            var a0Inv = 1 / (1 + alpha);
-            _a0 *= a0Inv;
-            _a1 *= a0Inv;
-            _a2 *= a0Inv;
-            _b1 *= a0Inv;
-            _b2 *= a0Inv;
+                FilterType.LowPass => BiquadCoefficients.LowPass(sampleRate, CutoffFrequency, Resonance),
+                FilterType.HighPass => BiquadCoefficients.HighPass(sampleRate, CutoffFrequency, Resonance),
+                FilterType.BandPass => BiquadCoefficients.BandPass(sampleRate, CutoffFrequency, Resonance),
+                FilterType.Notch => BiquadCoefficients.Notch(sampleRate, CutoffFrequency, Resonance),
+                _ => throw new ArgumentOutOfRangeException()
+            };
+
+            _cascade.SetCoefficients(0, coefficients);
+            _cascade.SmoothingSamples = BiquadCascade.GetDefaultSmoothingSamples(Format.SampleRate);
         }
     }
 }
\ No newline at end of file
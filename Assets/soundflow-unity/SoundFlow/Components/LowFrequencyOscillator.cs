@@ -1,4 +1,5 @@
 ﻿using SoundFlow.Abstracts;
+using SoundFlow.Enums;
 using SoundFlow.Structs;
 using System;
 
@@ -106,6 +107,13 @@ namespace SoundFlow.Components
         /// </summary>
         public TriggerMode Mode { get; set; } = TriggerMode.FreeRunning;
 
+        /// <summary>
+        /// Gets or sets how often the LFO computes its value. At <see cref="Enums.ControlRate.Block"/>, the
+        /// waveform is evaluated once per block, the output ramps towards it, and <see cref="OnOutputChanged"/> is
+        /// invoked once per block.
+        /// </summary>
+        public ControlRate ControlRate { get; set; } = ControlRate.Audio;
+
         /// <summary>
         /// Gets or sets the phase offset of the LFO in radians.
         /// This allows for shifting the starting point of the waveform.
@@ -113,7 +121,8 @@ namespace SoundFlow.Components
         public float Phase { get; set; } = 0f;
 
         /// <summary>
-        /// An event that is invoked whenever the LFO's output value changes during audio generation.
+        /// An event that is invoked whenever the LFO's output value changes during audio generation: every frame, or
+        /// once per block at <see cref="Enums.ControlRate.Block"/>.
         /// Subscribers can use this to react to changes in the LFO's output, for example, to drive visualisations or other components.
         /// </summary>
         public Action<float>? OnOutputChanged { get; set; }
@@ -124,6 +133,7 @@ namespace SoundFlow.Components
         private readonly Random _random = new();
         private float _lastOutput;
         private float _shValue;
+        private bool _blockStarted;
 
         /// <summary>
         /// Triggers the LFO to reset its phase if in <see cref="TriggerMode.NoteTrigger"/> mode.
@@ -143,12 +153,62 @@ namespace SoundFlow.Components
         /// <inheritdoc/>
         protected override void GenerateAudio(Span<float> buffer, int channels)
         {
+            var frames = buffer.Length / channels;
+            if (frames == 0) return;
+
             _phaseIncrement = (float)(2.0 * Math.PI * Rate / Format.SampleRate);
 
-            for (var i = 0; i < buffer.Length; i++)
+            if (ControlRate == ControlRate.Block)
+            {
+                GenerateBlock(buffer, channels, frames);
+                return;
+            }
+
+            _blockStarted = false;
+            for (var frame = 0; frame < frames; frame++)
+            {
+                var value = GenerateSample();
+                var sample = frame * channels;
+                for (var ch = 0; ch < channels; ch++)
+                    buffer[sample + ch] = value;
+            }
+        }
+
+        /// <summary>
+        /// Advances the LFO by a whole block, evaluates the waveform once at its end and ramps the output to it.
+        /// </summary>
+        private void GenerateBlock(Span<float> buffer, int channels, int frames)
+        {
+            if (Mode == TriggerMode.FreeRunning)
+            {
+                var cycle = (float)(2.0 * Math.PI);
+                var phase = _currentPhase + _phaseIncrement * frames;
+
+                // Sample and hold picks a new value once per cycle started during the block.
+                if (phase >= cycle && Type == WaveformType.SampleAndHold)
+                    _shValue = (float)(_random.NextDouble() * 2.0 - 1.0);
+
+                _currentPhase = phase % cycle;
+            }
+
+            var start = _lastOutput;
+            _lastOutput = Evaluate() * Depth;
+            if (!_blockStarted)
             {
-                buffer[i] = GenerateSample();
+                start = _lastOutput;
+                _blockStarted = true;
             }
+
+            var step = (_lastOutput - start) / frames;
+            for (var frame = 0; frame < frames; frame++)
+            {
+                var value = start + step * (frame + 1);
+                var sample = frame * channels;
+                for (var ch = 0; ch < channels; ch++)
+                    buffer[sample + ch] = value;
+            }
+
+            OnOutputChanged?.Invoke(_lastOutput);
         }
 
         /// <summary>
@@ -157,45 +217,15 @@ namespace SoundFlow.Components
         /// <returns>The generated LFO sample value.</returns>
         private float GenerateSample()
         {
-            var sampleValue = 0f;
-
-            switch (Type)
+            if (Type == WaveformType.SampleAndHold && Mode == TriggerMode.FreeRunning)
             {
-                case WaveformType.Sine:
-                    sampleValue = MathF.Sin(_currentPhase + Phase);
-                    break;
-                case WaveformType.Square:
-                    sampleValue = (_currentPhase + Phase) % (2 * Math.PI) < Math.PI ? 1f : -1f;
-                    break;
-                case WaveformType.Triangle:
-                    {
-                        var phaseValue = (_currentPhase + Phase) / (float)(2.0 * Math.PI);
-                        var progress = phaseValue - (int)phaseValue; // Normalize to 0-1
-                        sampleValue = progress < 0.5f ? 4f * progress - 1f : -4f * progress + 3f;
-                        break;
-                    }
-                case WaveformType.Sawtooth:
-                    sampleValue = 2f * (((_currentPhase + Phase) % (2 * MathF.PI)) / (float)(2.0 * Math.PI)) - 1f;
-                    break;
-                case WaveformType.ReverseSawtooth:
-                    sampleValue = 1f - 2f * (((_currentPhase + Phase) % (2 * MathF.PI)) / (float)(2.0 * Math.PI));
-                    break;
-                case WaveformType.Random:
-                    sampleValue = (float)(_random.NextDouble() * 2.0 - 1.0);
-                    break;
-                case WaveformType.SampleAndHold:
-                    if (Mode == TriggerMode.FreeRunning)
-                    {
-                        // Update on each new cycle
-                        if (_currentPhase < _phaseIncrement) // Approaching the start of a new cycle
-                            _shValue = (float)(_random.NextDouble() * 2.0 - 1.0);
-                    }
-
-                    // In NoteTrigger mode, _shValue is updated in the Trigger() method
-                    sampleValue = _shValue;
-                    break;
+                // Update on each new cycle
+                if (_currentPhase < _phaseIncrement) // Approaching the start of a new cycle
+                    _shValue = (float)(_random.NextDouble() * 2.0 - 1.0);
             }
 
+            var sampleValue = Evaluate();
+
             // Update the phase (only if FreeRunning)
             if (Mode == TriggerMode.FreeRunning)
             {
@@ -216,6 +246,37 @@ namespace SoundFlow.Components
             return _lastOutput;
         }
 
+        /// <summary>
+        /// Evaluates the waveform at the current phase, before scaling by <see cref="Depth"/>.
+        /// </summary>
+        private float Evaluate()
+        {
+            switch (Type)
+            {
+                case WaveformType.Sine:
+                    return MathF.Sin(_currentPhase + Phase);
+                case WaveformType.Square:
+                    return (_currentPhase + Phase) % (2 * Math.PI) < Math.PI ? 1f : -1f;
+                case WaveformType.Triangle:
+                    {
+                        var phaseValue = (_currentPhase + Phase) / (float)(2.0 * Math.PI);
+                        var progress = phaseValue - (int)phaseValue; // Normalize to 0-1
+                        return progress < 0.5f ? 4f * progress - 1f : -4f * progress + 3f;
+                    }
+                case WaveformType.Sawtooth:
+                    return 2f * (((_currentPhase + Phase) % (2 * MathF.PI)) / (float)(2.0 * Math.PI)) - 1f;
+                case WaveformType.ReverseSawtooth:
+                    return 1f - 2f * (((_currentPhase + Phase) % (2 * MathF.PI)) / (float)(2.0 * Math.PI));
+                case WaveformType.Random:
+                    return (float)(_random.NextDouble() * 2.0 - 1.0);
+                case WaveformType.SampleAndHold:
+                    // In NoteTrigger mode, _shValue is updated in the Trigger() method
+                    return _shValue;
+                default:
+                    return 0f;
+            }
+        }
+
         /// <summary>
         /// Gets the last generated output value of the LFO.
         /// </summary>
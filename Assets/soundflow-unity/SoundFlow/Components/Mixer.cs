@@ -1,12 +1,15 @@
 using SoundFlow.Abstracts;
 using SoundFlow.Abstracts.Devices;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Numerics;
 using System.Runtime.CompilerServices;
+using System.Threading;
 
 namespace SoundFlow.Components
 {
@@ -17,10 +20,22 @@ namespace SoundFlow.Components
     {
         private readonly ConcurrentDictionary<SoundComponent, byte> _components = new();
 
+        // Copy-on-write view of the components, read by the audio thread without taking a lock.
+        private volatile SoundComponent[] _componentsSnapshot = Array.Empty<SoundComponent>();
+
         private readonly object _modificationLock = new();
 
         private volatile bool _isDisposed;
 
+        // Parallel rendering state. Editors publish a new schedule; the audio thread switches to it once no branch
+        // of the active one is still running late on a worker.
+        private volatile bool _parallelRendering;
+        private volatile ParallelSchedule? _pendingSchedule;
+        private ParallelSchedule? _activeSchedule;
+        private float _parallelDeadline = 0.75f;
+        private volatile int _largestBlock;
+        private long _deadlineMisses;
+
         /// <summary>
         /// Gets the playback device this mixer is the master for, if any.
         /// </summary>
@@ -60,6 +75,58 @@ namespace SoundFlow.Components
         /// <inheritdoc />
         public override string Name { get; set; }
 
+        /// <summary>
+        ///     Gets or sets whether the mixer renders its components on the shared render worker pool.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     The components are grouped into independent branches: components whose sub-graphs share any component
+        ///     are rendered together, in order, by one thread. Each branch renders into its own buffer and the buffers
+        ///     are summed in a fixed order, so the output does not depend on which thread finished first. The audio
+        ///     thread helps render and then waits at most <see cref="ParallelDeadline"/> of the block for the rest.
+        ///     </para>
+        ///     <para>
+        ///     A branch that misses the deadline is left out of that block (it contributes silence and is counted in
+        ///     <see cref="DeadlineMisses"/>) and is not scheduled again until its worker has finished, so a stalled
+        ///     voice drops out instead of making the device callback late. Worth enabling for mixers with several
+        ///     heavy branches; with one branch, or on a single-core machine, the mixer renders serially.
+        ///     </para>
+        ///     <para>
+        ///     The branch buffers are allocated when the schedule is built, sized for the largest block the device
+        ///     reports through <see cref="AudioPlaybackDevice.MaxBlockFrames"/>. A longer block is rendered serially
+        ///     on the audio thread instead, and the next change to the mixer's components sizes the buffers for it.
+        ///     </para>
+        /// </remarks>
+        public bool ParallelRendering
+        {
+            get => _parallelRendering;
+            set
+            {
+                if (_parallelRendering == value) return;
+                _parallelRendering = value;
+                if (!value) _pendingSchedule = null;
+
+                // Compiled plans either flatten this mixer's children or render it as a single parallel step.
+                InvalidateRenderPlans();
+            }
+        }
+
+        /// <summary>
+        ///     Gets or sets the fraction of a block's duration the audio thread waits for worker branches in
+        ///     <see cref="ParallelRendering"/> mode. Defaults to 0.75. Values above 1 only make sense when rendering
+        ///     offline; <see cref="float.PositiveInfinity"/> waits for every branch.
+        /// </summary>
+        public float ParallelDeadline
+        {
+            get => _parallelDeadline;
+            set => _parallelDeadline = float.IsNaN(value) ? 0f : Math.Max(0f, value);
+        }
+
+        /// <summary>
+        ///     Gets the number of branches left out of a block because they missed the parallel render deadline.
+        /// </summary>
+        public long DeadlineMisses => Interlocked.Read(ref _deadlineMisses);
+
         /// <summary>
         ///     Adds a sound component to the mixer.
         /// </summary>
@@ -80,9 +147,16 @@ namespace SoundFlow.Components
                     throw new ArgumentException("Adding this component would create a cycle in the audio graph.",
                         nameof(component));
 
-                if (_components.TryAdd(component, 0))
-                    component.Parent = this;
+                if (!_components.TryAdd(component, 0)) return;
+
+                component.Parent = this;
+                _componentsSnapshot = _components.Keys.ToArray();
             }
+
+            InvalidateRenderPlans();
+
+            // Parallel mixers below were scheduled before they knew the device they now render for.
+            if (component is Mixer mixer) mixer.RefreshParallelSchedules();
         }
 
         /// <summary>
@@ -115,8 +189,69 @@ namespace SoundFlow.Components
 
             lock (_modificationLock)
             {
-                if (_components.TryRemove(component, out _))
-                    component.Parent = null;
+                if (!_components.TryRemove(component, out _)) return;
+
+                component.Parent = null;
+                _componentsSnapshot = _components.Keys.ToArray();
+            }
+
+            InvalidateRenderPlans();
+        }
+
+        /// <inheritdoc />
+        internal override bool CollectRenderChildren(List<SoundComponent> children)
+        {
+            // In parallel mode the plan renders this mixer as one step and GenerateAudio fans out to the workers.
+            if (_parallelRendering) return false;
+
+            children.AddRange(_componentsSnapshot);
+            return true;
+        }
+
+        /// <inheritdoc />
+        internal override void OnRenderTopologyChanged()
+        {
+            if (_parallelRendering)
+                _pendingSchedule = ParallelSchedule.Build(_componentsSnapshot, GetBranchCapacity());
+        }
+
+        /// <summary>
+        ///     Gets the number of samples each branch buffer needs: enough for the largest block of the device at the
+        ///     root of this mixer's tree, or of any block rendered so far.
+        /// </summary>
+        private int GetBranchCapacity()
+        {
+            var root = this;
+            while (root.Parent != null) root = root.Parent;
+
+            var deviceSamples = (long)(root.ParentDevice?.MaxBlockFrames ?? 0) * Math.Max(1, Format.Channels);
+            var capacity = Math.Max(ParallelSchedule.DefaultBufferCapacity, Math.Max(_largestBlock, deviceSamples));
+            return (int)Math.Min(capacity, int.MaxValue);
+        }
+
+        /// <summary>
+        ///     Rebuilds the schedules of the parallel mixers in this mixer's tree, so their branch buffers fit the
+        ///     device the tree is now attached to.
+        /// </summary>
+        private void RefreshParallelSchedules()
+        {
+            lock (RenderPlan.CompileLock)
+            {
+                var pending = new Stack<Mixer>();
+                var visited = new HashSet<Mixer>();
+                pending.Push(this);
+                while (pending.Count > 0)
+                {
+                    var mixer = pending.Pop();
+                    if (!visited.Add(mixer)) continue;
+
+                    if (mixer._parallelRendering)
+                        mixer._pendingSchedule = ParallelSchedule.Build(mixer._componentsSnapshot, mixer.GetBranchCapacity());
+
+                    foreach (var child in mixer._componentsSnapshot)
+                        if (child is Mixer childMixer)
+                            pending.Push(childMixer);
+                }
             }
         }
 
@@ -126,15 +261,53 @@ namespace SoundFlow.Components
             if (!Enabled || Mute || _isDisposed)
                 return;
 
-            lock (_modificationLock)
+            var schedule = GetSchedule();
+            var pool = RenderWorkerPool.Shared;
+            if (schedule != null && buffer.Length > schedule.Capacity)
             {
-                foreach (var component in _components.Keys)
-                {
-                    if (component is { Enabled: true, Mute: false })
-                        component.Process(buffer, channels);
+                // No room in the branch buffers, and growing them here would allocate on the audio thread.
+                if (buffer.Length > _largestBlock) _largestBlock = buffer.Length;
+                var skipped = schedule.RenderInline(buffer, channels);
+                if (skipped > 0) Interlocked.Add(ref _deadlineMisses, skipped);
+                return;
+            }
 
-                }
+            if (schedule != null && (schedule.BranchCount > 1 || schedule.HasRunningBranches) && pool.WorkerCount > 0)
+            {
+                var blockSeconds = (double)buffer.Length / Math.Max(1, channels) / Math.Max(1, Format.SampleRate);
+                var wait = blockSeconds * _parallelDeadline * Stopwatch.Frequency;
+                var deadline = wait < long.MaxValue / 2 ? Stopwatch.GetTimestamp() + (long)wait : long.MaxValue;
+                var misses = schedule.Render(buffer, channels, deadline, pool);
+                if (misses > 0) Interlocked.Add(ref _deadlineMisses, misses);
+                return;
+            }
+
+            foreach (var component in _componentsSnapshot)
+            {
+                if (component is { Enabled: true, Mute: false })
+                    component.Process(buffer, channels);
+            }
+        }
+
+        /// <summary>
+        ///     Picks the schedule for this block. Audio thread only.
+        /// </summary>
+        private ParallelSchedule? GetSchedule()
+        {
+            var active = _activeSchedule;
+            if (active != null && active.HasRunningBranches)
+                return active; // A late worker still owns part of the old graph.
+
+            var pending = _pendingSchedule;
+            if (pending != null)
+            {
+                Interlocked.CompareExchange(ref _pendingSchedule, null, pending);
+                active = pending;
             }
+
+            if (!_parallelRendering) active = null;
+            _activeSchedule = active;
+            return active;
         }
 
         /// <summary>
@@ -160,9 +333,249 @@ namespace SoundFlow.Components
                         disposable.Dispose();
                 }
                 _components.Clear();
+                _componentsSnapshot = Array.Empty<SoundComponent>();
             }
 
             base.Dispose();
         }
+
+        /// <summary>
+        ///     The branches of a parallel mixer and the per-block task list shared with the render workers.
+        /// </summary>
+        private sealed class ParallelSchedule : IRenderWorkItem
+        {
+            private const int Idle = 0;
+            private const int Queued = 1;
+            private const int Running = 2;
+            private const int Done = 3;
+            /// <summary>
+            ///     The smallest branch buffer, in samples.
+            /// </summary>
+            public const int DefaultBufferCapacity = 4096;
+
+            private readonly Branch[] _branches;
+            private readonly int[] _tasks;
+            private int _taskCount;
+            private int _nextTask;
+            private int _length;
+            private int _channels;
+
+            private ParallelSchedule(Branch[] branches, int capacity)
+            {
+                _branches = branches;
+                _tasks = new int[branches.Length];
+                Capacity = capacity;
+            }
+
+            public int BranchCount => _branches.Length;
+
+            /// <summary>
+            ///     Gets the length of the branch buffers, in samples: the longest block this schedule can render.
+            /// </summary>
+            public int Capacity { get; }
+
+            public bool HasRunningBranches
+            {
+                get
+                {
+                    foreach (var branch in _branches)
+                        if (Volatile.Read(ref branch.State) == Running)
+                            return true;
+                    return false;
+                }
+            }
+
+            /// <summary>
+            ///     Groups <paramref name="components"/> into branches that share no component below them.
+            /// </summary>
+            public static ParallelSchedule Build(SoundComponent[] components, int capacity)
+            {
+                var group = new int[components.Length];
+                for (var i = 0; i < group.Length; i++) group[i] = i;
+
+                int Find(int i)
+                {
+                    while (group[i] != i) i = group[i] = group[group[i]];
+                    return i;
+                }
+
+                var owner = new Dictionary<SoundComponent, int>();
+                var pending = new Stack<SoundComponent>();
+                var children = new List<SoundComponent>();
+                for (var i = 0; i < components.Length; i++)
+                {
+                    pending.Push(components[i]);
+                    var visited = new HashSet<SoundComponent>();
+                    while (pending.Count > 0)
+                    {
+                        var node = pending.Pop();
+                        if (!visited.Add(node)) continue;
+
+                        if (owner.TryGetValue(node, out var other))
+                            group[Find(i)] = Find(other);
+                        else
+                            owner[node] = i;
+
+                        foreach (var input in node.InputsSnapshot)
+                            pending.Push(input);
+
+                        children.Clear();
+                        if (node is Mixer mixer) children.AddRange(mixer._componentsSnapshot);
+                        else node.CollectRenderChildren(children);
+                        foreach (var child in children)
+                            pending.Push(child);
+                    }
+                }
+
+                // Branches keep the mixer's component order, both inside a branch and between branches.
+                var members = new Dictionary<int, List<SoundComponent>>();
+                var order = new List<int>();
+                for (var i = 0; i < components.Length; i++)
+                {
+                    var root = Find(i);
+                    if (!members.TryGetValue(root, out var list))
+                    {
+                        members[root] = list = new List<SoundComponent>();
+                        order.Add(root);
+                    }
+
+                    list.Add(components[i]);
+                }
+
+                var branches = new Branch[order.Count];
+                for (var b = 0; b < branches.Length; b++)
+                    branches[b] = new Branch(members[order[b]].ToArray(), capacity);
+                return new ParallelSchedule(branches, capacity);
+            }
+
+            /// <summary>
+            ///     Renders every branch and mixes the finished ones into <paramref name="output"/>.
+            /// </summary>
+            /// <returns>The number of branches that missed the deadline.</returns>
+            public int Render(Span<float> output, int channels, long deadline, RenderWorkerPool pool)
+            {
+                var length = output.Length;
+                var misses = 0;
+                var count = 0;
+
+                _length = length;
+                _channels = channels;
+                for (var b = 0; b < _branches.Length; b++)
+                {
+                    var branch = _branches[b];
+                    if (Volatile.Read(ref branch.State) == Running)
+                    {
+                        misses++; // Still busy with an earlier block.
+                        continue;
+                    }
+
+                    Volatile.Write(ref branch.State, Queued);
+                    _tasks[count++] = b;
+                }
+
+                Volatile.Write(ref _taskCount, count);
+                Volatile.Write(ref _nextTask, 0);
+
+                var shared = pool.TryBegin(this, count - 1);
+                RunPending();
+
+                for (var t = 0; t < count; t++)
+                {
+                    var branch = _branches[_tasks[t]];
+                    int state;
+                    var spins = 0;
+                    while (((state = Volatile.Read(ref branch.State)) == Running || state == Queued) &&
+                           Stopwatch.GetTimestamp() < deadline)
+                    {
+                        // Yield now and then so workers sharing this core are not starved by the wait.
+                        if (++spins % 8 == 0) Thread.Yield();
+                        else Thread.SpinWait(16);
+                    }
+                }
+
+                if (shared) pool.End();
+
+                for (var t = 0; t < count; t++)
+                {
+                    var branch = _branches[_tasks[t]];
+
+                    // A task claimed but not yet started is withdrawn; one still running is left to finish late.
+                    if (Interlocked.CompareExchange(ref branch.State, Idle, Queued) == Queued ||
+                        Volatile.Read(ref branch.State) != Done)
+                    {
+                        misses++;
+                        continue;
+                    }
+
+                    SampleMath.Add(branch.Buffer.AsSpan(0, length), output);
+                    Volatile.Write(ref branch.State, Idle);
+                }
+
+                return misses;
+            }
+
+            /// <summary>
+            ///     Renders every branch straight into <paramref name="output"/> on the calling thread, for a block
+            ///     longer than the branch buffers.
+            /// </summary>
+            /// <returns>The number of branches left out because a worker is still rendering them late.</returns>
+            public int RenderInline(Span<float> output, int channels)
+            {
+                var skipped = 0;
+                foreach (var branch in _branches)
+                {
+                    if (Volatile.Read(ref branch.State) == Running)
+                    {
+                        skipped++;
+                        continue;
+                    }
+
+                    foreach (var component in branch.Components)
+                    {
+                        if (component is { Enabled: true, Mute: false })
+                            component.Process(output, channels);
+                    }
+                }
+
+                return skipped;
+            }
+
+            /// <inheritdoc />
+            public void RunPending()
+            {
+                while (true)
+                {
+                    var task = Interlocked.Increment(ref _nextTask) - 1;
+                    if (task >= Volatile.Read(ref _taskCount)) return;
+
+                    var branch = _branches[_tasks[task]];
+                    if (Interlocked.CompareExchange(ref branch.State, Running, Queued) != Queued)
+                        continue;
+
+                    var buffer = branch.Buffer.AsSpan(0, _length);
+                    buffer.Clear();
+                    foreach (var component in branch.Components)
+                    {
+                        if (component is { Enabled: true, Mute: false })
+                            component.Process(buffer, _channels);
+                    }
+
+                    Volatile.Write(ref branch.State, Done);
+                }
+            }
+
+            private sealed class Branch
+            {
+                public readonly SoundComponent[] Components;
+                public readonly float[] Buffer;
+                public int State;
+
+                public Branch(SoundComponent[] components, int capacity)
+                {
+                    Components = components;
+                    Buffer = new float[capacity];
+                }
+            }
+        }
     }
 }
\ No newline at end of file
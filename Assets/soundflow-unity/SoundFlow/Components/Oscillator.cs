@@ -1,5 +1,6 @@
 ﻿using SoundFlow.Abstracts;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Components
@@ -7,6 +8,11 @@ namespace SoundFlow.Components
     /// <summary>
     /// Generates various types of audio waveforms at a specified frequency and amplitude.
     /// </summary>
+    /// <remarks>
+    /// Every waveform except <see cref="WaveformType.Noise"/> is read from the shared band-limited
+    /// <see cref="Wavetable"/> set, so high notes do not alias. Frequency and amplitude changes ramp across the next
+    /// block. To render many voices at once, use <see cref="OscillatorBank"/>.
+    /// </remarks>
     public class Oscillator : SoundComponent
     {
         /// <summary>
@@ -50,7 +56,10 @@ namespace SoundFlow.Components
         /// </summary>
         /// <param name="engine">The parent audio engine.</param>
         /// <param name="format">The audio format containing channels and sample rate and sample format</param>
-        public Oscillator(AudioEngine engine, AudioFormat format) : base(engine, format) { }
+        public Oscillator(AudioEngine engine, AudioFormat format) : base(engine, format)
+        {
+            WarmWavetables();
+        }
 
         // Parameters
         /// <summary>
@@ -78,60 +87,109 @@ namespace SoundFlow.Components
         public float Phase { get; set; } = 0f;
 
         /// <summary>
-        /// Gets or sets the pulse width for the <see cref="WaveformType.Pulse"/> waveform, as a fraction of the cycle (0 to 1).
+        /// Gets or sets the pulse width for the <see cref="WaveformType.Pulse"/> waveform, as the fraction of the cycle spent high (0 to 1).
         /// A value of 0.5 results in a square wave. This parameter is only effective when <see cref="Type"/> is set to <see cref="WaveformType.Pulse"/>.
         /// </summary>
         public float PulseWidth { get; set; } = 0.5f;
 
         // Internal state
-        private float _phaseIncrement;
-        private float _currentPhase;
+        private float _increment = -1f; // in cycles per sample; negative until the first block
+        private float _amplitude;
+        private float _currentPhase; // in cycles
         private readonly Random _random = new();
 
         /// <inheritdoc/>
         public override string Name { get; set; } = "Oscillator";
 
+        /// <summary>
+        /// Gets the shared wavetable a waveform is read from, or null for <see cref="WaveformType.Noise"/>. Pulse
+        /// waves are the difference of two phase-shifted sawtooth reads.
+        /// </summary>
+        internal static Wavetable? GetWavetable(WaveformType type) => type switch
+        {
+            WaveformType.Sine => Wavetable.Sine,
+            WaveformType.Square => Wavetable.Square,
+            WaveformType.Sawtooth or WaveformType.Pulse => Wavetable.Sawtooth,
+            WaveformType.Triangle => Wavetable.Triangle,
+            _ => null
+        };
+
+        /// <summary>
+        /// Builds the shared wavetables, so switching waveforms never builds one on the audio thread.
+        /// </summary>
+        internal static void WarmWavetables()
+        {
+            _ = Wavetable.Sine;
+            _ = Wavetable.Sawtooth;
+            _ = Wavetable.Square;
+            _ = Wavetable.Triangle;
+        }
+
         /// <inheritdoc/>
         protected override void GenerateAudio(Span<float> buffer, int channels)
         {
-            // Calculate the phase increment per sample based on the frequency
-            _phaseIncrement = (float)(2.0 * Math.PI * Frequency / Format.SampleRate);
+            var frames = buffer.Length / channels;
+            if (frames == 0) return;
 
-            for (var i = 0; i < buffer.Length; i++)
+            var type = Type;
+            var targetIncrement = Math.Clamp(Frequency / Format.SampleRate, 0f, 0.5f);
+            var targetAmplitude = Amplitude;
+            if (_increment < 0f)
             {
-                buffer[i] = GenerateSample();
+                _increment = targetIncrement;
+                _amplitude = targetAmplitude;
             }
-        }
 
-        /// <summary>
-        /// Generates a single audio sample based on the current waveform type, phase, and amplitude.
-        /// This method updates the internal phase for the next sample.
-        /// </summary>
-        /// <returns>The generated audio sample value.</returns>
-        private float GenerateSample()
-        {
-            var sampleValue = Type switch
-            {
-                WaveformType.Sine => MathF.Sin(_currentPhase + Phase),
-                WaveformType.Square => _currentPhase + Phase < Math.PI ? 1f : -1f,
-                WaveformType.Sawtooth => (float)(2.0 * (_currentPhase + Phase) / (2.0 * Math.PI) - 1.0),
-                WaveformType.Triangle =>
-                    (float)(2.0 * Math.Abs(2.0 * (_currentPhase + Phase) / (2.0 * Math.PI) - 1.0) - 1.0),
-                WaveformType.Noise => (float)(_random.NextDouble() * 2.0 - 1.0),
-                WaveformType.Pulse =>
-                    _currentPhase + Phase < Math.PI * PulseWidth ? 1f : -1f,
-                _ => 0f
-            };
-
-
-            // Update the phase for the next sample
-            _currentPhase += _phaseIncrement;
-            if (_currentPhase >= 2.0 * Math.PI)
+            var increment = _increment;
+            var amplitude = _amplitude;
+            var incrementStep = (targetIncrement - increment) / frames;
+            var amplitudeStep = (targetAmplitude - amplitude) / frames;
+            var phase = _currentPhase;
+
+            // The phase offset is in radians; the tables are read in cycles.
+            var offset = Phase / (2f * MathF.PI);
+            offset -= MathF.Floor(offset);
+            var width = Math.Clamp(PulseWidth, 0f, 1f);
+
+            var table = GetWavetable(type);
+            var level = table?.GetLevel(MathF.Max(increment, targetIncrement)) ?? 0;
+
+            for (var frame = 0; frame < frames; frame++)
             {
-                _currentPhase -= (float)(2.0 * Math.PI);
+                float value;
+                if (table == null)
+                {
+                    value = (float)(_random.NextDouble() * 2.0 - 1.0);
+                }
+                else
+                {
+                    var position = phase + offset;
+                    if (position >= 1f) position -= 1f;
+                    value = table.Read(level, position);
+
+                    if (type == WaveformType.Pulse)
+                    {
+                        var shifted = position - width;
+                        if (shifted < 0f) shifted += 1f;
+                        value = table.Read(level, shifted) - value + 2f * width - 1f;
+                    }
+                }
+
+                value *= amplitude;
+                var sample = frame * channels;
+                for (var ch = 0; ch < channels; ch++)
+                    buffer[sample + ch] = value;
+
+                // Update the phase for the next sample
+                phase += increment;
+                if (phase >= 1f) phase -= 1f;
+                increment += incrementStep;
+                amplitude += amplitudeStep;
             }
 
-            return sampleValue * Amplitude;
+            _currentPhase = phase;
+            _increment = targetIncrement;
+            _amplitude = targetAmplitude;
         }
     }
 }
\ No newline at end of file
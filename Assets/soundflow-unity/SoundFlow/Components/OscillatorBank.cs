@@ -0,0 +1,438 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Structs;
+using SoundFlow.Utils;
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+
+namespace SoundFlow.Components
+{
+    /// <summary>
+    /// Renders a fixed number of band-limited wavetable oscillators and mixes them into one signal, written to every
+    /// output channel.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Voices are rendered <see cref="Vector{T}.Count"/> at a time, one SIMD lane per voice: phase accumulation,
+    /// interpolation and the frequency and amplitude ramps all run on vectors, and only the table reads are done
+    /// lane by lane. Each voice picks its <see cref="Wavetable"/> level once per block from its frequency, so no
+    /// partial reaches Nyquist. Groups of voices that stay silent for a whole block only advance their phase.
+    /// </para>
+    /// <para>
+    /// Voice parameters can be set from any thread and take effect at the next block. Frequency and amplitude ramp
+    /// linearly across that block, so automation and note changes do not click.
+    /// </para>
+    /// </remarks>
+    public sealed class OscillatorBank : SoundComponent
+    {
+        // Requested parameters, written by any thread.
+        private readonly float[] _frequencies;
+        private readonly float[] _amplitudes;
+        private readonly float[] _pulseWidths;
+        private readonly Oscillator.WaveformType[] _waveforms;
+        private readonly float[] _phaseResets; // in cycles, NaN when none is pending
+        private volatile bool _phaseResetPending;
+
+        // Render state, one entry per lane: the voice count rounded up to whole vectors, spare lanes silent.
+        private readonly int _lanes;
+        private readonly float[] _phase;
+        private readonly float[] _increment;
+        private readonly float[] _incrementStep;
+        private readonly float[] _incrementTarget;
+        private readonly float[] _gain;
+        private readonly float[] _gainStep;
+        private readonly float[] _gainTarget;
+        private readonly nint[] _levels; // address of each lane's table level
+
+        // Pulse voices read the sawtooth table twice: value = primary * saw(p) + secondary * saw(p - shift) + bias.
+        private readonly float[] _primary;
+        private readonly float[] _secondary;
+        private readonly float[] _shift;
+        private readonly float[] _bias;
+
+        private float[] _mix = Array.Empty<float>();
+        private Vector<float>[] _laneMix = Array.Empty<Vector<float>>();
+        private bool _started;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="OscillatorBank"/> class with every voice silent.
+        /// </summary>
+        /// <param name="engine">The parent audio engine.</param>
+        /// <param name="format">The audio format containing channels and sample rate and sample format</param>
+        /// <param name="voiceCount">The number of oscillators.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="voiceCount"/> is not positive.</exception>
+        public OscillatorBank(AudioEngine engine, AudioFormat format, int voiceCount) : base(engine, format)
+        {
+            if (voiceCount <= 0)
+                throw new ArgumentOutOfRangeException(nameof(voiceCount), "An oscillator bank needs at least one voice.");
+
+            Oscillator.WarmWavetables();
+            VoiceCount = voiceCount;
+
+            var width = Vector.IsHardwareAccelerated ? Vector<float>.Count : 1;
+            _lanes = (voiceCount + width - 1) / width * width;
+
+            _frequencies = new float[voiceCount];
+            _amplitudes = new float[voiceCount];
+            _pulseWidths = new float[voiceCount];
+            _waveforms = new Oscillator.WaveformType[voiceCount];
+            _phaseResets = new float[voiceCount];
+            _frequencies.AsSpan().Fill(440f);
+            _pulseWidths.AsSpan().Fill(0.5f);
+            _phaseResets.AsSpan().Fill(float.NaN);
+
+            _phase = new float[_lanes];
+            _increment = new float[_lanes];
+            _incrementStep = new float[_lanes];
+            _incrementTarget = new float[_lanes];
+            _gain = new float[_lanes];
+            _gainStep = new float[_lanes];
+            _gainTarget = new float[_lanes];
+            _levels = new nint[_lanes];
+            _primary = new float[_lanes];
+            _secondary = new float[_lanes];
+            _shift = new float[_lanes];
+            _bias = new float[_lanes];
+
+            _levels.AsSpan().Fill(Wavetable.Sine.Address);
+            _primary.AsSpan().Fill(1f);
+        }
+
+        /// <inheritdoc/>
+        public override string Name { get; set; } = "Oscillator Bank";
+
+        /// <summary>
+        /// Gets the number of oscillators.
+        /// </summary>
+        public int VoiceCount { get; }
+
+        /// <summary>
+        /// Sets the frequency of a voice in Hertz. Values above Nyquist are clamped to it.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        /// <param name="frequency">The frequency in Hertz.</param>
+        public void SetFrequency(int voice, float frequency)
+        {
+            CheckVoice(voice);
+            _frequencies[voice] = Math.Max(0f, frequency);
+        }
+
+        /// <summary>
+        /// Gets the frequency of a voice in Hertz.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        public float GetFrequency(int voice)
+        {
+            CheckVoice(voice);
+            return _frequencies[voice];
+        }
+
+        /// <summary>
+        /// Sets the amplitude of a voice. Zero silences it.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        /// <param name="amplitude">The amplitude, typically 0 to 1.</param>
+        public void SetAmplitude(int voice, float amplitude)
+        {
+            CheckVoice(voice);
+            _amplitudes[voice] = amplitude;
+        }
+
+        /// <summary>
+        /// Gets the amplitude of a voice.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        public float GetAmplitude(int voice)
+        {
+            CheckVoice(voice);
+            return _amplitudes[voice];
+        }
+
+        /// <summary>
+        /// Sets the waveform of a voice.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        /// <param name="waveform">The waveform. <see cref="Oscillator.WaveformType.Noise"/> is not supported.</param>
+        /// <exception cref="ArgumentException">Thrown if <paramref name="waveform"/> has no wavetable.</exception>
+        public void SetWaveform(int voice, Oscillator.WaveformType waveform)
+        {
+            CheckVoice(voice);
+            if (Oscillator.GetWavetable(waveform) == null)
+                throw new ArgumentException($"{waveform} waveforms cannot be rendered by an oscillator bank.", nameof(waveform));
+            _waveforms[voice] = waveform;
+        }
+
+        /// <summary>
+        /// Gets the waveform of a voice.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        public Oscillator.WaveformType GetWaveform(int voice)
+        {
+            CheckVoice(voice);
+            return _waveforms[voice];
+        }
+
+        /// <summary>
+        /// Sets the pulse width of a <see cref="Oscillator.WaveformType.Pulse"/> voice, as the fraction of the cycle spent high.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        /// <param name="width">The pulse width, 0 to 1.</param>
+        public void SetPulseWidth(int voice, float width)
+        {
+            CheckVoice(voice);
+            _pulseWidths[voice] = Math.Clamp(width, 0f, 1f);
+        }
+
+        /// <summary>
+        /// Restarts a voice's cycle at the given phase at the next block, e.g. on note-on.
+        /// </summary>
+        /// <param name="voice">The voice index.</param>
+        /// <param name="phase">The phase in radians.</param>
+        public void ResetPhase(int voice, float phase = 0f)
+        {
+            CheckVoice(voice);
+            var cycles = phase / (2f * MathF.PI);
+            _phaseResets[voice] = cycles - MathF.Floor(cycles);
+            _phaseResetPending = true;
+        }
+
+        /// <inheritdoc/>
+        protected override void GenerateAudio(Span<float> buffer, int channels)
+        {
+            var frames = buffer.Length / channels;
+            if (frames == 0) return;
+
+            if (_mix.Length < frames)
+                _mix = new float[frames];
+            var mix = _mix.AsSpan(0, frames);
+            mix.Clear();
+
+            PrepareVoices(frames);
+
+            if (Vector.IsHardwareAccelerated)
+            {
+                // Voices accumulate lane-wise; the lanes of each frame are summed once, after every group.
+                if (_laneMix.Length < frames)
+                    _laneMix = new Vector<float>[frames];
+                var laneMix = _laneMix.AsSpan(0, frames);
+                laneMix.Clear();
+
+                for (var lane = 0; lane < _lanes; lane += Vector<float>.Count)
+                    RenderGroup(lane, laneMix);
+
+                for (var frame = 0; frame < frames; frame++)
+                    mix[frame] = Vector.Dot(laneMix[frame], Vector<float>.One);
+            }
+            else
+            {
+                for (var lane = 0; lane < _lanes; lane++)
+                    RenderVoice(lane, mix);
+            }
+
+            // Land exactly on the targets so repeated ramps do not drift.
+            _incrementTarget.AsSpan().CopyTo(_increment);
+            _gainTarget.AsSpan().CopyTo(_gain);
+
+            for (var frame = 0; frame < frames; frame++)
+            {
+                var value = mix[frame];
+                var sample = frame * channels;
+                for (var ch = 0; ch < channels; ch++)
+                    buffer[sample + ch] = value;
+            }
+        }
+
+        /// <summary>
+        /// Applies the requested parameters: per-block ramps, table levels and pulse coefficients for every voice.
+        /// </summary>
+        private void PrepareVoices(int frames)
+        {
+            if (_phaseResetPending)
+            {
+                // Cleared before scanning, so a reset requested meanwhile is kept for the next block.
+                _phaseResetPending = false;
+                for (var voice = 0; voice < VoiceCount; voice++)
+                {
+                    var reset = _phaseResets[voice];
+                    if (float.IsNaN(reset)) continue;
+                    _phase[voice] = reset;
+                    _phaseResets[voice] = float.NaN;
+                }
+            }
+
+            var inverseFrames = 1f / frames;
+            for (var voice = 0; voice < VoiceCount; voice++)
+            {
+                var increment = Math.Min(_frequencies[voice] / Format.SampleRate, 0.5f);
+                var gain = _amplitudes[voice];
+                if (!_started)
+                {
+                    _increment[voice] = increment;
+                    _gain[voice] = gain;
+                }
+
+                _incrementTarget[voice] = increment;
+                _incrementStep[voice] = (increment - _increment[voice]) * inverseFrames;
+                _gainTarget[voice] = gain;
+                _gainStep[voice] = (gain - _gain[voice]) * inverseFrames;
+
+                var waveform = _waveforms[voice];
+                var table = Oscillator.GetWavetable(waveform)!;
+                var level = table.GetLevel(Math.Max(increment, _increment[voice]));
+                _levels[voice] = table.Address + level * Wavetable.LevelStride * sizeof(float);
+
+                if (waveform == Oscillator.WaveformType.Pulse)
+                {
+                    var width = _pulseWidths[voice];
+                    _primary[voice] = -1f;
+                    _secondary[voice] = 1f;
+                    _shift[voice] = width;
+                    _bias[voice] = 2f * width - 1f;
+                }
+                else
+                {
+                    _primary[voice] = 1f;
+                    _secondary[voice] = 0f;
+                    _shift[voice] = 0f;
+                    _bias[voice] = 0f;
+                }
+            }
+
+            _started = true;
+        }
+
+        private unsafe void RenderGroup(int lane, Span<Vector<float>> mix)
+        {
+            var width = Vector<float>.Count;
+            var frames = mix.Length;
+            var phase = new Vector<float>(_phase, lane);
+            var increment = new Vector<float>(_increment, lane);
+            var incrementStep = new Vector<float>(_incrementStep, lane);
+            var gain = new Vector<float>(_gain, lane);
+            var gainStep = new Vector<float>(_gainStep, lane);
+
+            if (Vector.EqualsAll(gain, Vector<float>.Zero) &&
+                Vector.EqualsAll(new Vector<float>(_gainTarget, lane), Vector<float>.Zero))
+            {
+                // Silent for the whole block: keep the phases running so voices fade back in coherently.
+                var advance = increment * new Vector<float>(frames) +
+                              incrementStep * new Vector<float>(0.5f * frames * (frames - 1));
+                phase += advance;
+                phase -= Vector.ConvertToSingle(Vector.ConvertToInt32(phase));
+                phase.CopyTo(_phase, lane);
+                return;
+            }
+
+            var primary = new Vector<float>(_primary, lane);
+            var secondary = new Vector<float>(_secondary, lane);
+            var shift = new Vector<float>(_shift, lane);
+            var bias = new Vector<float>(_bias, lane);
+            var pulse = !Vector.EqualsAll(secondary, Vector<float>.Zero);
+            var one = Vector<float>.One;
+
+            var tables = stackalloc float*[width];
+            for (var l = 0; l < width; l++)
+                tables[l] = (float*)_levels[lane + l];
+            var scratch = stackalloc float[3 * width];
+
+            for (var frame = 0; frame < frames; frame++)
+            {
+                var value = primary * Read(phase, tables, scratch);
+                if (pulse)
+                {
+                    var shifted = phase - shift;
+                    shifted = Vector.ConditionalSelect(Vector.LessThan(shifted, Vector<float>.Zero), shifted + one, shifted);
+                    value += secondary * Read(shifted, tables, scratch) + bias;
+                }
+
+                mix[frame] += value * gain;
+
+                phase += increment;
+                phase -= Vector.ConvertToSingle(Vector.ConvertToInt32(phase));
+                increment += incrementStep;
+                gain += gainStep;
+            }
+
+            phase.CopyTo(_phase, lane);
+        }
+
+        /// <summary>
+        /// Reads every lane's table at its phase with linear interpolation; only the table reads are per lane.
+        /// </summary>
+        /// <param name="phase">The phase of each lane.</param>
+        /// <param name="tables">The table level of each lane.</param>
+        /// <param name="scratch">Room for three vectors.</param>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static unsafe Vector<float> Read(Vector<float> phase, float** tables, float* scratch)
+        {
+            var width = Vector<float>.Count;
+            var position = phase * new Vector<float>(Wavetable.TableSize);
+
+            // Rounding can land a wrapped phase on exactly 1; the guard sample covers the last index.
+            var index = Vector.Min(Vector.ConvertToInt32(position), new Vector<int>(Wavetable.TableSize - 1));
+            var fraction = position - Vector.ConvertToSingle(index);
+
+            var indices = (int*)scratch;
+            var low = scratch + width;
+            var high = low + width;
+            *(Vector<int>*)indices = index;
+            for (var l = 0; l < width; l++)
+            {
+                var sample = tables[l] + indices[l];
+                low[l] = sample[0];
+                high[l] = sample[1];
+            }
+
+            var a = *(Vector<float>*)low;
+            return a + fraction * (*(Vector<float>*)high - a);
+        }
+
+        private unsafe void RenderVoice(int voice, Span<float> mix)
+        {
+            var phase = _phase[voice];
+            var increment = _increment[voice];
+            var incrementStep = _incrementStep[voice];
+            var gain = _gain[voice];
+            var gainStep = _gainStep[voice];
+            var table = (float*)_levels[voice];
+            var primary = _primary[voice];
+            var secondary = _secondary[voice];
+            var shift = _shift[voice];
+            var bias = _bias[voice];
+
+            for (var frame = 0; frame < mix.Length; frame++)
+            {
+                var value = primary * Read(table, phase);
+                if (secondary != 0f)
+                {
+                    var shifted = phase - shift;
+                    if (shifted < 0f) shifted += 1f;
+                    value += secondary * Read(table, shifted) + bias;
+                }
+
+                mix[frame] += value * gain;
+
+                phase += increment;
+                if (phase >= 1f) phase -= 1f;
+                increment += incrementStep;
+                gain += gainStep;
+            }
+
+            _phase[voice] = phase;
+        }
+
+        private static unsafe float Read(float* table, float phase)
+        {
+            var position = phase * Wavetable.TableSize;
+            var index = Math.Min((int)position, Wavetable.TableSize - 1);
+            var a = table[index];
+            return a + (position - index) * (table[index + 1] - a);
+        }
+
+        private void CheckVoice(int voice)
+        {
+            if ((uint)voice >= (uint)VoiceCount)
+                throw new ArgumentOutOfRangeException(nameof(voice));
+        }
+    }
+}
@@ -4,10 +4,12 @@ using SoundFlow.Enums;
 using SoundFlow.Exceptions;
 using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
 using System.IO;
+using System.Threading;
 
 namespace SoundFlow.Components
 {
@@ -16,8 +18,20 @@ namespace SoundFlow.Components
     /// Supports various sample and encoding formats and can integrate with <see cref="SoundModifier"/> and <see cref="AudioAnalyzer"/> components for real-time processing and analysis during recording.
     /// Implements the <see cref="IDisposable"/> interface to ensure resources are released properly.
     /// </summary>
+    /// <remarks>
+    /// By default samples are encoded and written to the stream inline on the capture callback thread. When an
+    /// encoder queue depth is given, the callback only copies samples into a lock-free ring and a background thread
+    /// encodes them in large batches through a buffered stream, so a slow disk or network never stalls capture. If
+    /// the writer falls behind and the queue fills, whole capture blocks are dropped and counted in
+    /// <see cref="DroppedSamples"/>; <see cref="StopRecording"/> writes out everything still queued before the
+    /// encoder is finalized.
+    /// </remarks>
     public class Recorder : IDisposable
     {
+        private const int WriterBatchesPerQueue = 4;
+        private const int WriterIdleWaitMilliseconds = 20;
+        private const int WriteBufferSize = 64 * 1024;
+
         /// <summary>
         /// Gets the current playback state of the recorder.
         /// </summary>
@@ -62,14 +76,35 @@ namespace SoundFlow.Components
         private readonly AudioEngine _engine;
         private readonly AudioFormat _format;
 
+        // Asynchronous writer state. The capture callback is the ring's producer and the writer thread its consumer;
+        // the writer owns the encoder and the buffered stream while it runs.
+        private SpscRingBuffer? _encoderQueue;
+        private float[]? _writerBatch;
+        private BufferedStream? _writeBuffer;
+        private Thread? _writerThread;
+        private AutoResetEvent? _writerSignal;
+        private volatile bool _stopWriter;
+        private volatile Exception? _encoderError;
+        private long _droppedSamples;
+        private int _peakQueuedSamples;
+
         /// <summary>
         /// Initializes a new instance of the <see cref="Recorder"/> class to record audio to a file.
         /// </summary>
         /// <param name="captureDevice">The capture device to record from.</param>
         /// <param name="stream">The stream to write encoded recorded audio to.</param>
         /// <param name="encodingFormat">The desired encoding format for the recorded audio file. Defaults to <see cref="EncodingFormat.Wav"/>.</param>
-        public Recorder(AudioCaptureDevice captureDevice, Stream stream, EncodingFormat encodingFormat = EncodingFormat.Wav)
+        /// <param name="encoderQueueMilliseconds">
+        /// The amount of audio, in milliseconds, that can wait for a background thread to encode and write it.
+        /// Zero (the default) encodes synchronously on the capture callback thread.
+        /// </param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="encoderQueueMilliseconds"/> is negative.</exception>
+        public Recorder(AudioCaptureDevice captureDevice, Stream stream, EncodingFormat encodingFormat = EncodingFormat.Wav,
+            int encoderQueueMilliseconds = 0)
         {
+            if (encoderQueueMilliseconds < 0)
+                throw new ArgumentOutOfRangeException(nameof(encoderQueueMilliseconds), "Encoder queue depth cannot be negative.");
+
             _captureDevice = captureDevice;
             _engine = captureDevice.Engine;
             SampleFormat = captureDevice.Format.Format;
@@ -78,6 +113,7 @@ namespace SoundFlow.Components
             SampleRate = captureDevice.Format.SampleRate;
             Channels = captureDevice.Format.Channels;
             _format = captureDevice.Format;
+            EncoderQueueMilliseconds = encoderQueueMilliseconds;
         }
 
         /// <summary>
@@ -105,6 +141,34 @@ namespace SoundFlow.Components
         /// </summary>
         public ReadOnlyCollection<AudioAnalyzer> Analyzers => _analyzers.AsReadOnly();
 
+        /// <summary>
+        /// Gets the depth of the background encoder queue in milliseconds, or zero if samples are encoded synchronously.
+        /// </summary>
+        public int EncoderQueueMilliseconds { get; }
+
+        /// <summary>
+        /// Gets the number of samples currently waiting for the background writer. Always zero in synchronous mode.
+        /// </summary>
+        public int QueuedSamples => _encoderQueue?.Count ?? 0;
+
+        /// <summary>
+        /// Gets the highest number of samples that have waited for the background writer during the current recording.
+        /// </summary>
+        public int PeakQueuedSamples => Volatile.Read(ref _peakQueuedSamples);
+
+        /// <summary>
+        /// Gets the number of samples discarded during the current recording because the encoder queue was full or
+        /// the encoder had failed. Always zero in synchronous mode.
+        /// </summary>
+        public long DroppedSamples => Interlocked.Read(ref _droppedSamples);
+
+        /// <summary>
+        /// Gets the exception that stopped the background writer, if encoding or writing failed. Samples captured
+        /// after the failure are dropped. Always null in synchronous mode, where such exceptions propagate from the
+        /// capture callback instead.
+        /// </summary>
+        public Exception? EncoderError => _encoderError;
+
         /// <summary>
         /// Starts the audio recording process.
         /// If recording to a file, it initializes the audio encoder.
@@ -121,9 +185,16 @@ namespace SoundFlow.Components
 
             if (Stream != Stream.Null)
             {
-                _encoder = _engine.CreateEncoder(Stream, EncodingFormat, _format);
+                var asynchronous = EncoderQueueMilliseconds > 0;
+                if (asynchronous)
+                    _writeBuffer = new BufferedStream(Stream, WriteBufferSize);
+
+                _encoder = _engine.CreateEncoder(_writeBuffer ?? Stream, EncodingFormat, _format);
                 if (_encoder == null)
                     throw new BackendException(_engine.GetType().Name, Result.Error, "Failed to create encoder.");
+
+                if (asynchronous)
+                    StartWriter();
             }
 
             _captureDevice.OnAudioProcessed += OnAudioProcessed;
@@ -167,8 +238,17 @@ namespace SoundFlow.Components
 
             _captureDevice.OnAudioProcessed -= OnAudioProcessed;
 
+            StopWriter();
             _encoder?.Dispose();
             _encoder = null;
+            if (_writeBuffer != null)
+            {
+                // Flush the tail, including the header the encoder rewrites on dispose, without closing the caller's stream.
+                try { _writeBuffer.Flush(); }
+                catch (IOException e) { _encoderError ??= e; }
+                _writeBuffer = null;
+            }
+
             State = PlaybackState.Stopped;
         }
 
@@ -210,6 +290,121 @@ namespace SoundFlow.Components
             _analyzers.Remove(analyzer);
         }
 
+        /// <summary>
+        /// Creates the encoder queue and starts the background writer for a new recording.
+        /// </summary>
+        private void StartWriter()
+        {
+            var channels = Math.Max(1, Channels);
+            var queueFrames = Math.Max(1, (int)((long)SampleRate * EncoderQueueMilliseconds / 1000));
+            var batchFrames = Math.Max(1, queueFrames / WriterBatchesPerQueue);
+
+            _encoderQueue = new SpscRingBuffer(queueFrames * channels);
+            _writerBatch = new float[batchFrames * channels];
+            _writerSignal ??= new AutoResetEvent(false);
+            _stopWriter = false;
+            _encoderError = null;
+            _droppedSamples = 0;
+            _peakQueuedSamples = 0;
+
+            _writerThread = new Thread(WriterLoop)
+            {
+                IsBackground = true,
+                Name = "SoundFlow Recorder Writer"
+            };
+            _writerThread.Start();
+        }
+
+        /// <summary>
+        /// Stops the background writer once it has encoded everything still queued.
+        /// </summary>
+        private void StopWriter()
+        {
+            if (_writerThread == null)
+                return;
+
+            _stopWriter = true;
+            _writerSignal!.Set();
+            _writerThread.Join();
+            // The signal is kept for the next recording and only disposed with the recorder.
+            _writerThread = null;
+        }
+
+        /// <summary>
+        /// Drains the encoder queue in batches until stopped, then drains whatever is left.
+        /// </summary>
+        private void WriterLoop()
+        {
+            var queue = _encoderQueue!;
+            var batch = _writerBatch!;
+            var encoder = _encoder!;
+            var channels = Math.Max(1, Channels);
+
+            while (true)
+            {
+                // Read the stop flag before draining so samples queued before the stop request are always written.
+                // Until then only full batches are encoded, which keeps the writes large and sequential.
+                var stopping = _stopWriter;
+                var minimum = stopping ? channels : batch.Length;
+
+                while (queue.Count >= minimum)
+                {
+                    var count = queue.Read(batch.AsSpan(0, Math.Min(batch.Length, queue.Count / channels * channels)));
+                    if (_encoderError != null)
+                    {
+                        Interlocked.Add(ref _droppedSamples, count);
+                        continue;
+                    }
+
+                    try
+                    {
+                        encoder.Encode(batch.AsSpan(0, count));
+                    }
+                    catch (Exception e)
+                    {
+                        _encoderError = e;
+                        Interlocked.Add(ref _droppedSamples, count);
+                    }
+                }
+
+                if (stopping)
+                    return;
+
+                _writerSignal!.WaitOne(WriterIdleWaitMilliseconds);
+            }
+        }
+
+        /// <summary>
+        /// Copies a block of captured samples into the encoder queue, dropping the whole block if it does not fit.
+        /// </summary>
+        private void EnqueueForEncoder(SpscRingBuffer queue, ReadOnlySpan<float> samples)
+        {
+            if (_encoderError != null || !queue.TryWrite(samples))
+            {
+                Interlocked.Add(ref _droppedSamples, samples.Length);
+                return;
+            }
+
+            var depth = queue.Count;
+            if (depth > _peakQueuedSamples)
+                Volatile.Write(ref _peakQueuedSamples, depth);
+
+            // Wake the writer once per batch, when this block fills it; a wake-up missed because the writer drained
+            // concurrently only delays it until its idle timeout.
+            var batch = _writerBatch!.Length;
+            if (depth >= batch && depth - samples.Length < batch)
+            {
+                try
+                {
+                    _writerSignal?.Set();
+                }
+                catch (ObjectDisposedException)
+                {
+                    // A callback still in flight while the recorder is disposed.
+                }
+            }
+        }
+
         /// <summary>
         /// Handles the audio processed event from the audio engine.
         /// This method is invoked by the audio engine when new audio samples are available.
@@ -236,7 +431,12 @@ namespace SoundFlow.Components
 
             // Pass samples
             ProcessCallback?.Invoke(samples, capability);
-            _encoder?.Encode(samples);
+
+            var queue = _encoderQueue;
+            if (queue != null)
+                EnqueueForEncoder(queue, samples);
+            else
+                _encoder?.Encode(samples);
         }
 
         /// <inheritdoc />
@@ -244,6 +444,8 @@ namespace SoundFlow.Components
         {
             StopRecording();
             _captureDevice.OnAudioProcessed -= OnAudioProcessed;
+            // The writer thread has been joined, so nothing waits on the signal any more.
+            Interlocked.Exchange(ref _writerSignal, null)?.Dispose();
             ProcessCallback = null;
             _modifiers.Clear();
             _analyzers.Clear();
@@ -0,0 +1,340 @@
+using SoundFlow.Enums;
+using System;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Components
+{
+    /// <summary>
+    ///     A streaming, block-based sample rate converter built on a polyphase windowed-sinc filter bank.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The filter for each output frame is interpolated between the two nearest of a fixed set of precomputed
+    ///     phases, so any ratio works, including one that changes between blocks. When downsampling, the cutoff
+    ///     follows the output Nyquist frequency so the result does not alias. The filter is lengthened with the
+    ///     downsampling ratio given to the constructor (a power of two up to <see cref="MaxTapScale"/> times the
+    ///     tier's length), which keeps the transition band the same width relative to the output rate. Raising
+    ///     <see cref="Ratio"/> past that later keeps the shorter filter, so its stopband degrades; create a new
+    ///     instance instead. <see cref="ResamplerQuality.Linear"/> always uses two taps.
+    ///     </para>
+    ///     <para>
+    ///     Each channel keeps its history in a mirrored ring (every frame is written twice, <c>taps</c> apart), so
+    ///     the filter window is always one contiguous span: no samples are ever moved, and the dot products run on
+    ///     <see cref="Vector{T}"/> lanes. The output is aligned with the input (output frame 0 is input frame 0),
+    ///     at the cost of <see cref="LookaheadFrames"/> frames of input buffered before the first frame comes out;
+    ///     <see cref="Flush"/> drains them at the end of a stream.
+    ///     </para>
+    /// </remarks>
+    public sealed class Resampler
+    {
+        /// <summary>
+        ///     The largest factor by which the filter is lengthened for downsampling.
+        /// </summary>
+        public const int MaxTapScale = 8;
+
+        private readonly int _taps;
+        private readonly int _phases;
+        private readonly int _center;
+        private readonly double _kaiserBeta;
+        private readonly double _rolloff;
+        private readonly float[] _table;
+        private readonly float[] _history;
+
+        private double _ratio = 1.0;
+        private double _cutoff = -1;
+        private double _time;
+        private long _readPos;
+        private long _writeCount;
+        private long _inputFrames;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="Resampler"/> class.
+        /// </summary>
+        /// <param name="channels">The number of interleaved channels.</param>
+        /// <param name="quality">The filter quality tier.</param>
+        /// <param name="ratio">The number of input frames per output frame (input rate / output rate).</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if channels or ratio is not positive.</exception>
+        public Resampler(int channels, ResamplerQuality quality = ResamplerQuality.Medium, double ratio = 1.0)
+        {
+            if (channels <= 0) throw new ArgumentOutOfRangeException(nameof(channels), "Channels must be positive.");
+
+            Channels = channels;
+            Quality = quality;
+            (_taps, _phases, _kaiserBeta, _rolloff) = quality switch
+            {
+                ResamplerQuality.Linear => (2, 1, 0.0, 1.0),
+                ResamplerQuality.Low => (8, 32, 5.0, 0.85),
+                ResamplerQuality.High => (32, 128, 9.5, 0.95),
+                _ => (16, 64, 7.0, 0.9)
+            };
+            if (quality != ResamplerQuality.Linear && ratio > 1.0 && !double.IsInfinity(ratio))
+            {
+                var scale = 1;
+                while (scale < MaxTapScale && scale < ratio - 1e-9) scale *= 2;
+                _taps *= scale;
+            }
+
+            _center = _taps / 2 - 1;
+            _table = new float[(_phases + 1) * _taps];
+            _history = new float[channels * 2 * _taps];
+
+            Ratio = ratio;
+            Reset();
+        }
+
+        /// <summary>
+        ///     Gets the number of interleaved channels.
+        /// </summary>
+        public int Channels { get; }
+
+        /// <summary>
+        ///     Gets the filter quality tier.
+        /// </summary>
+        public ResamplerQuality Quality { get; }
+
+        /// <summary>
+        ///     Gets the number of input frames that must be buffered before the first output frame.
+        /// </summary>
+        public int LookaheadFrames => _taps - _center - 1;
+
+        /// <summary>
+        ///     Gets or sets the number of input frames consumed per output frame (input rate / output rate).
+        ///     May be changed between calls to <see cref="Process"/>.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is not a positive finite number.</exception>
+        public double Ratio
+        {
+            get => _ratio;
+            set
+            {
+                if (!(value > 0) || double.IsInfinity(value))
+                    throw new ArgumentOutOfRangeException(nameof(value), "Ratio must be a positive finite number.");
+                _ratio = value;
+
+                // The filter bank only depends on the cutoff, which stops moving once upsampling.
+                var cutoff = _rolloff * Math.Min(1.0, 1.0 / value);
+                if (Math.Abs(cutoff - _cutoff) > 1e-4) BuildTable(cutoff);
+            }
+        }
+
+        /// <summary>
+        ///     Converts as much of <paramref name="input"/> as is needed to fill <paramref name="output"/>, or all of
+        ///     it if the output has room.
+        /// </summary>
+        /// <param name="input">Interleaved input samples.</param>
+        /// <param name="output">The destination for interleaved output samples.</param>
+        /// <param name="inputConsumed">The number of input samples consumed. The rest must be passed again.</param>
+        /// <returns>
+        ///     The number of output samples written. Both counts are whole frames, so an output with room for less
+        ///     than a frame writes and consumes nothing: callers must not call again with the same spans.
+        /// </returns>
+        public int Process(ReadOnlySpan<float> input, Span<float> output, out int inputConsumed)
+        {
+            return Render(input, output, false, out inputConsumed);
+        }
+
+        /// <summary>
+        ///     Writes out the frames still held back by the filter lookahead once the input has ended.
+        ///     Call repeatedly until it returns zero.
+        /// </summary>
+        /// <param name="output">The destination for interleaved output samples.</param>
+        /// <returns>The number of output samples written.</returns>
+        public int Flush(Span<float> output)
+        {
+            return Render(ReadOnlySpan<float>.Empty, output, true, out _);
+        }
+
+        /// <summary>
+        ///     Clears the filter history and phase, ready for a new stream.
+        /// </summary>
+        public void Reset()
+        {
+            Array.Clear(_history, 0, _history.Length);
+            _time = 0;
+            _readPos = 0;
+            _inputFrames = 0;
+            // The frames before the stream are silence, so the first filter window is centred on input frame 0.
+            _writeCount = _center;
+        }
+
+        private int Render(ReadOnlySpan<float> input, Span<float> output, bool flushing, out int inputConsumed)
+        {
+            var channels = Channels;
+            var taps = _taps;
+            var mask = taps - 1;
+            var inputFrames = input.Length / channels;
+            var outputFrames = output.Length / channels;
+            var inFrame = 0;
+            var outFrame = 0;
+
+            while (outFrame < outputFrames)
+            {
+                // The output time, in input frames, is _readPos + _time; once flushing, stop past the last input.
+                if (flushing && _readPos + _time >= _inputFrames) break;
+
+                while (_writeCount < _readPos + taps)
+                {
+                    if (flushing)
+                    {
+                        PushSilence();
+                        continue;
+                    }
+
+                    if (inFrame == inputFrames) goto Done;
+                    Push(input.Slice(inFrame * channels, channels));
+                    inFrame++;
+                }
+
+                var phasePosition = _time * _phases;
+                var phase = (int)phasePosition;
+                var fraction = (float)(phasePosition - phase);
+                var row0 = new ReadOnlySpan<float>(_table, phase * taps, taps);
+                var row1 = new ReadOnlySpan<float>(_table, (phase + 1) * taps, taps);
+                var start = (int)(_readPos & mask);
+
+                for (var ch = 0; ch < channels; ch++)
+                {
+                    var window = new ReadOnlySpan<float>(_history, ch * 2 * taps + start, taps);
+                    output[outFrame * channels + ch] = Dot(row0, row1, window, fraction);
+                }
+
+                outFrame++;
+                _time += _ratio;
+                var advance = (long)_time;
+                _time -= advance;
+                _readPos += advance;
+            }
+
+            Done:
+            inputConsumed = inFrame * channels;
+            return outFrame * channels;
+        }
+
+        private void Push(ReadOnlySpan<float> frame)
+        {
+            var taps = _taps;
+            var index = (int)(_writeCount & (taps - 1));
+            for (var ch = 0; ch < frame.Length; ch++)
+            {
+                var plane = ch * 2 * taps;
+                _history[plane + index] = frame[ch];
+                _history[plane + index + taps] = frame[ch];
+            }
+
+            _writeCount++;
+            _inputFrames++;
+        }
+
+        private void PushSilence()
+        {
+            var taps = _taps;
+            var index = (int)(_writeCount & (taps - 1));
+            for (var ch = 0; ch < Channels; ch++)
+            {
+                var plane = ch * 2 * taps;
+                _history[plane + index] = 0f;
+                _history[plane + index + taps] = 0f;
+            }
+
+            _writeCount++;
+        }
+
+        /// <summary>
+        ///     Applies the filter interpolated between two phases to one window of samples.
+        /// </summary>
+        private static float Dot(ReadOnlySpan<float> row0, ReadOnlySpan<float> row1, ReadOnlySpan<float> window,
+            float fraction)
+        {
+            var sum0 = 0f;
+            var sum1 = 0f;
+            var i = 0;
+            if (Vector.IsHardwareAccelerated && window.Length >= Vector<float>.Count)
+            {
+                var h0 = MemoryMarshal.Cast<float, Vector<float>>(row0);
+                var h1 = MemoryMarshal.Cast<float, Vector<float>>(row1);
+                var x = MemoryMarshal.Cast<float, Vector<float>>(window);
+                var acc0 = Vector<float>.Zero;
+                var acc1 = Vector<float>.Zero;
+                for (var v = 0; v < x.Length; v++)
+                {
+                    acc0 += h0[v] * x[v];
+                    acc1 += h1[v] * x[v];
+                }
+
+                sum0 = Vector.Dot(acc0, Vector<float>.One);
+                sum1 = Vector.Dot(acc1, Vector<float>.One);
+                i = x.Length * Vector<float>.Count;
+            }
+
+            for (; i < window.Length; i++)
+            {
+                sum0 += row0[i] * window[i];
+                sum1 += row1[i] * window[i];
+            }
+
+            return sum0 + (sum1 - sum0) * fraction;
+        }
+
+        /// <summary>
+        ///     Fills the filter bank: row p holds the taps for a fractional delay of p / phases, with one extra row
+        ///     for a full frame so every phase has a neighbour to interpolate towards.
+        /// </summary>
+        private void BuildTable(double cutoff)
+        {
+            _cutoff = cutoff;
+            var taps = _taps;
+
+            if (Quality == ResamplerQuality.Linear)
+            {
+                // Rows [1, 0] and [0, 1]; interpolating between them is linear interpolation.
+                _table[0] = 1f;
+                _table[1] = 0f;
+                _table[2] = 0f;
+                _table[3] = 1f;
+                return;
+            }
+
+            var halfWidth = taps / 2.0;
+            var besselBeta = BesselI0(_kaiserBeta);
+            for (var p = 0; p <= _phases; p++)
+            {
+                var fraction = (double)p / _phases;
+                var row = _table.AsSpan(p * taps, taps);
+                var sum = 0.0;
+                for (var k = 0; k < taps; k++)
+                {
+                    var t = k - _center - fraction;
+                    var x = t / halfWidth;
+                    var window = BesselI0(_kaiserBeta * Math.Sqrt(Math.Max(0.0, 1.0 - x * x))) / besselBeta;
+                    var arg = Math.PI * cutoff * t;
+                    var sinc = Math.Abs(arg) < 1e-9 ? 1.0 : Math.Sin(arg) / arg;
+                    var h = cutoff * sinc * window;
+                    row[k] = (float)h;
+                    sum += h;
+                }
+
+                // Unity gain at DC for every phase, so a fractional delay never changes the level.
+                var normalize = sum != 0 ? (float)(1.0 / sum) : 0f;
+                for (var k = 0; k < taps; k++)
+                    row[k] *= normalize;
+            }
+        }
+
+        private static double BesselI0(double x)
+        {
+            var sum = 1.0;
+            var term = 1.0;
+            var half = x / 2;
+            for (var k = 1; k < 32; k++)
+            {
+                term *= half / k;
+                var squared = term * term;
+                sum += squared;
+                if (squared < sum * 1e-12) break;
+            }
+
+            return sum;
+        }
+    }
+}
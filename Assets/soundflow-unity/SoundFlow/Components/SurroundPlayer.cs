@@ -2,9 +2,9 @@
 using SoundFlow.Interfaces;
 using SoundFlow.Modifiers;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.Collections.Generic;
-using System.Linq;
 using System.Numerics;
 
 namespace SoundFlow.Components
@@ -90,10 +90,20 @@ namespace SoundFlow.Components
             Vbap
         }
 
+        private PanningMethod _panning = PanningMethod.Vbap;
+
         /// <summary>
         /// The panning method to use for surround sound.
         /// </summary>
-        public PanningMethod Panning { get; set; } = PanningMethod.Vbap;
+        public PanningMethod Panning
+        {
+            get => _panning;
+            set
+            {
+                _panning = value;
+                _gainsDirty = true;
+            }
+        }
 
         // VBAP Parameters
         private Vector2 _listenerPosition = Vector2.Zero;
@@ -107,7 +117,7 @@ namespace SoundFlow.Components
             set
             {
                 _listenerPosition = value;
-                _vbapPanningFactorsDirty = true;
+                _gainsDirty = true;
             }
         }
 
@@ -138,10 +148,33 @@ namespace SoundFlow.Components
         // Surround sound parameters (predefined configurations)
         private readonly Dictionary<SpeakerConfiguration, SurroundConfiguration> _predefinedConfigurations = new();
 
-        private float[] _delayLines = Array.Empty<float>();
-        private int[] _delayIndices = Array.Empty<int>();
-        private float[][] _panningFactors = Array.Empty<float[]>(); // 2D array of [virtualSpeaker][outputChannel]
-        private bool _vbapPanningFactorsDirty = true;
+        // Room for blocks of up to this many frames before the delay ring has to grow.
+        private const int RingBlockFrames = 2048;
+
+        // Gain matrix of [virtualSpeaker * channels + outputChannel], speaker volumes included. Each block ramps from
+        // _blockStartGains, where the previous block ended, to _gains.
+        private float[] _gains = Array.Empty<float>();
+        private float[] _blockStartGains = Array.Empty<float>();
+        private volatile bool _gainsDirty = true;
+        private SurroundConfiguration? _gainsConfiguration;
+        private int _gainsChannels;
+        private float _gainsRolloff;
+        private float[] _gainsVolumes = Array.Empty<float>();
+        private Vector2[] _outputSpeakerLayout = Array.Empty<Vector2>();
+
+        // One ring of the mono input shared by every virtual speaker, each reading it through its own delay tap.
+        private float[] _delayRing = Array.Empty<float>();
+        private int _ringLength;
+        private int _ringWrite;
+        private int[] _tapDelays = Array.Empty<int>();
+        private int _maxTapDelay;
+        private SurroundConfiguration? _delayConfiguration;
+        private float[] _delaySnapshot = Array.Empty<float>();
+        private volatile bool _delayResetPending = true;
+
+        private float[] _monoBuffer = Array.Empty<float>();
+        private float[] _lfeBuffer = Array.Empty<float>();
+        private float[] _planarBuffer = Array.Empty<float>();
 
         /// <summary>
         /// A sound player that simulates surround sound with support for different speaker configurations.
@@ -224,15 +257,13 @@ namespace SoundFlow.Components
             };
 
             InitializeDelayLines();
-            _vbapPanningFactorsDirty = true;
+            _gainsDirty = true;
         }
 
         private void InitializeDelayLines()
         {
-            var numChannels = _currentConfiguration.SpeakerPositions.Length;
-            var maxDelaySamples = (int)(_currentConfiguration.Delays.Max() * Format.SampleRate / 1000f);
-            _delayLines = new float[numChannels * (maxDelaySamples + 1)];
-            _delayIndices = new int[numChannels];
+            // Applied by the audio thread at the start of the next block, so the ring is never swapped mid-block.
+            _delayResetPending = true;
         }
 
         /// <inheritdoc />
@@ -244,53 +275,74 @@ namespace SoundFlow.Components
 
         private void ProcessSurroundAudio(Span<float> buffer, int channels)
         {
-            UpdatePanningFactors(channels);
-
             var frameCount = buffer.Length / channels;
+            if (frameCount == 0) return;
+
+            var configuration = _currentConfiguration;
+            var speakers = configuration.SpeakerPositions.Length;
+            EnsureBlockBuffers(frameCount, channels);
+            UpdateDelayLine(configuration, frameCount);
+            UpdateGains(configuration, channels);
+
+            // Assuming base audio is mono
+            // TODO: refactor when support for getting audio data is added (e.g., mono, stereo, 5.1 or 7.1, etc.)
+            var mono = _monoBuffer.AsSpan(0, frameCount);
+            if (channels >= 2)
+            {
+                // down-mixing stereo to mono
+                for (var frame = 0; frame < frameCount; frame++)
+                    mono[frame] = (buffer[frame * channels] + buffer[frame * channels + 1]) / 2;
+            }
+            else
+            {
+                buffer[..frameCount].CopyTo(mono);
+            }
+
+            WriteDelayLine(mono);
 
-            for (var frame = 0; frame < frameCount; frame++)
+            // Accumulate every virtual speaker into planar output channels, so the gains apply as vector kernels.
+            var planar = _planarBuffer.AsSpan(0, frameCount * channels);
+            planar.Clear();
+            var lfeSpeaker = _speakerConfig != SpeakerConfiguration.Stereo ? speakers - 1 : -1;
+
+            for (var speakerIndex = 0; speakerIndex < speakers; speakerIndex++)
             {
-                // Assuming base audio is mono
-                // TODO: refactor when support for getting audio data is added (e.g., mono, stereo, 5.1 or 7.1, etc.)
-                var inputSample = buffer[frame * channels];
+                ReadOnlySpan<float> tap = ReadTap(_tapDelays[speakerIndex], frameCount);
 
-                // down-mixing stereo to mono
-                if (channels >= 2)
+                // Apply low-pass filter to LFE channel (e.g., last speaker in 5.1)
+                if (speakerIndex == lfeSpeaker)
                 {
-                    var left = buffer[frame * channels];
-                    var right = buffer[frame * channels + 1];
-                    inputSample = (left + right) / 2;
+                    var lfe = _lfeBuffer.AsSpan(0, frameCount);
+                    tap.CopyTo(lfe);
+                    _lowPassFilter.Process(lfe, 1);
+                    tap = lfe;
                 }
 
-                // Clear the current frame's output
                 for (var ch = 0; ch < channels; ch++)
                 {
-                    buffer[frame * channels + ch] = 0f;
+                    var index = speakerIndex * channels + ch;
+                    var startGain = _blockStartGains[index];
+                    var endGain = _gains[index];
+
+                    // VBAP leaves most of the matrix at zero.
+                    if (startGain == 0f && endGain == 0f) continue;
+
+                    var destination = planar.Slice(ch * frameCount, frameCount);
+                    if (startGain == endGain)
+                        SampleMath.MultiplyAdd(tap, endGain, destination);
+                    else
+                        SampleMath.MultiplyAddRamp(tap, startGain, endGain, destination);
                 }
+            }
 
-                // Process each virtual speaker
-                for (var speakerIndex = 0; speakerIndex < _currentConfiguration.SpeakerPositions.Length; speakerIndex++)
-                {
-                    var delayedSample = ApplyDelayAndVolume(
-                        inputSample,
-                        _currentConfiguration.Volumes[speakerIndex],
-                        _currentConfiguration.Delays[speakerIndex],
-                        speakerIndex
-                    );
-
-                    // Apply low-pass filter to LFE channel (e.g., last speaker in 5.1)
-                    if (speakerIndex == _currentConfiguration.SpeakerPositions.Length - 1 &&
-                        _speakerConfig != SpeakerConfiguration.Stereo)
-                    {
-                        delayedSample = ApplyLowPassFilter(delayedSample);
-                    }
+            _ringWrite = (_ringWrite + frameCount) % _ringLength;
+            _gains.AsSpan().CopyTo(_blockStartGains);
 
-                    // Distribute the delayed sample to each output channel based on panning factors
-                    for (var ch = 0; ch < channels; ch++)
-                    {
-                        buffer[frame * channels + ch] += delayedSample * _panningFactors[speakerIndex][ch];
-                    }
-                }
+            for (var ch = 0; ch < channels; ch++)
+            {
+                var source = planar.Slice(ch * frameCount, frameCount);
+                for (var frame = 0; frame < frameCount; frame++)
+                    buffer[frame * channels + ch] = source[frame];
             }
         }
 
@@ -301,42 +353,147 @@ namespace SoundFlow.Components
             InitializeDelayLines(); // Re-initialize delay lines on loop or stop to avoid artifacts.
         }
 
+        private void EnsureBlockBuffers(int frameCount, int channels)
+        {
+            if (_monoBuffer.Length < frameCount)
+            {
+                _monoBuffer = new float[frameCount];
+                _lfeBuffer = new float[frameCount];
+            }
+
+            if (_planarBuffer.Length < frameCount * channels)
+                _planarBuffer = new float[frameCount * channels];
+        }
 
-        private void UpdatePanningFactors(int channels)
+        /// <summary>
+        /// Recomputes the tap of every speaker when the delays change, and resets or grows the ring when needed.
+        /// </summary>
+        private void UpdateDelayLine(SurroundConfiguration configuration, int frameCount)
         {
-            switch (Panning)
+            var reset = _delayResetPending;
+            if (!reset && configuration == _delayConfiguration && SameValues(configuration.Delays, _delaySnapshot) &&
+                _ringLength >= _maxTapDelay + frameCount)
+                return;
+
+            _delayResetPending = false;
+            var delays = configuration.Delays;
+            if (_tapDelays.Length != delays.Length)
+                _tapDelays = new int[delays.Length];
+
+            var maxDelay = 0;
+            for (var i = 0; i < delays.Length; i++)
+            {
+                _tapDelays[i] = Math.Max(0, (int)(delays[i] * Format.SampleRate / 1000f));
+                maxDelay = Math.Max(maxDelay, _tapDelays[i]);
+            }
+
+            _maxTapDelay = maxDelay;
+            _delayConfiguration = configuration;
+            Snapshot(delays, ref _delaySnapshot);
+
+            if (_ringLength < maxDelay + frameCount)
+            {
+                // Stored twice back to back, so even a tap that wraps around is one contiguous span.
+                _ringLength = maxDelay + Math.Max(frameCount, RingBlockFrames);
+                _delayRing = new float[2 * _ringLength];
+                _ringWrite = 0;
+            }
+            else if (reset)
+            {
+                Array.Clear(_delayRing, 0, _delayRing.Length);
+            }
+        }
+
+        private void WriteDelayLine(ReadOnlySpan<float> block)
+        {
+            var first = Math.Min(block.Length, _ringLength - _ringWrite);
+            block[..first].CopyTo(_delayRing.AsSpan(_ringWrite));
+            block[..first].CopyTo(_delayRing.AsSpan(_ringWrite + _ringLength));
+
+            var rest = block[first..];
+            rest.CopyTo(_delayRing);
+            rest.CopyTo(_delayRing.AsSpan(_ringLength));
+        }
+
+        /// <summary>
+        /// Gets the block as heard <paramref name="delaySamples"/> later, in place in the ring. Only valid between
+        /// <see cref="WriteDelayLine"/> and the advance of the write position.
+        /// </summary>
+        private ReadOnlySpan<float> ReadTap(int delaySamples, int frameCount)
+        {
+            var start = _ringWrite - delaySamples;
+            if (start < 0) start += _ringLength;
+            return _delayRing.AsSpan(start, frameCount);
+        }
+
+        /// <summary>
+        /// Recomputes the gain matrix when the listener, panning, configuration, volumes or channel count change.
+        /// The block then ramps from the previous matrix to the new one; a change of shape applies at once.
+        /// </summary>
+        private void UpdateGains(SurroundConfiguration configuration, int channels)
+        {
+            var rolloff = VbapParameters.RolloffFactor;
+            if (!_gainsDirty && configuration == _gainsConfiguration && channels == _gainsChannels &&
+                rolloff == _gainsRolloff && SameValues(configuration.Volumes, _gainsVolumes))
+                return;
+
+            // Cleared before reading the parameters, so a change made meanwhile is picked up next block.
+            _gainsDirty = false;
+
+            var speakers = configuration.SpeakerPositions.Length;
+            var reshaped = _gains.Length != speakers * channels || channels != _gainsChannels;
+            if (_gains.Length != speakers * channels)
+            {
+                _gains = new float[speakers * channels];
+                _blockStartGains = new float[speakers * channels];
+            }
+
+            if (_outputSpeakerLayout.Length != channels)
+                _outputSpeakerLayout = GetOutputSpeakerLayout(channels);
+
+            switch (_panning)
             {
                 case PanningMethod.Linear:
-                    _panningFactors = CalculateLinearPanningFactors(channels);
+                    CalculateLinearPanningFactors(configuration, channels, _gains);
                     break;
                 case PanningMethod.EqualPower:
-                    _panningFactors = CalculateEqualPowerPanningFactors(channels);
+                    CalculateEqualPowerPanningFactors(configuration, channels, _gains);
                     break;
                 case PanningMethod.Vbap:
                 default:
-                    RecalculateVbapPanningFactorsIfNecessary(channels);
+                    CalculateVbapPanningFactors(configuration, channels, _gains);
                     break;
             }
+
+            for (var speakerIndex = 0; speakerIndex < speakers; speakerIndex++)
+                SampleMath.Scale(_gains.AsSpan(speakerIndex * channels, channels), configuration.Volumes[speakerIndex]);
+
+            if (reshaped)
+                _gains.AsSpan().CopyTo(_blockStartGains);
+
+            _gainsConfiguration = configuration;
+            _gainsChannels = channels;
+            _gainsRolloff = rolloff;
+            Snapshot(configuration.Volumes, ref _gainsVolumes);
         }
 
-        private float[][] CalculateLinearPanningFactors(int channels)
+        private void CalculateLinearPanningFactors(SurroundConfiguration configuration, int channels, Span<float> factors)
         {
-            var numVirtualSpeakers = _currentConfiguration.SpeakerPositions.Length;
+            var numVirtualSpeakers = configuration.SpeakerPositions.Length;
             var numOutputChannels = channels;
-            var factors = new float[numVirtualSpeakers][];
 
             // Get physical output speaker positions
-            var outputSpeakerPositions = GetOutputSpeakerLayout(numOutputChannels);
+            var outputSpeakerPositions = _outputSpeakerLayout;
+            Span<float> distances = stackalloc float[numOutputChannels];
 
             for (var vsIdx = 0; vsIdx < numVirtualSpeakers; vsIdx++)
             {
-                factors[vsIdx] = new float[numOutputChannels];
-                var virtualPos = _currentConfiguration.SpeakerPositions[vsIdx];
+                var row = factors.Slice(vsIdx * numOutputChannels, numOutputChannels);
+                var virtualPos = configuration.SpeakerPositions[vsIdx];
                 var relativeVec = virtualPos - _listenerPosition;
 
                 // Calculate weights based on inverse distance to output speakers
                 var totalWeight = 0f;
-                var distances = new float[numOutputChannels];
 
                 for (var ch = 0; ch < numOutputChannels; ch++)
                 {
@@ -349,31 +506,28 @@ namespace SoundFlow.Components
                 // Assign weights inversely proportional to distance
                 for (var ch = 0; ch < numOutputChannels; ch++)
                 {
-                    factors[vsIdx][ch] = (1f / (distances[ch] + 0.001f)) / totalWeight;
+                    row[ch] = (1f / (distances[ch] + 0.001f)) / totalWeight;
                 }
             }
-
-            return factors;
         }
 
-        private float[][] CalculateEqualPowerPanningFactors(int channels)
+        private void CalculateEqualPowerPanningFactors(SurroundConfiguration configuration, int channels, Span<float> factors)
         {
-            var numSpeakers = _currentConfiguration.SpeakerPositions.Length;
+            var numSpeakers = configuration.SpeakerPositions.Length;
             var numOutputChannels = channels;
-            var factors = new float[numSpeakers][];
 
-            var outputSpeakers = GetOutputSpeakerLayout(numOutputChannels);
+            var outputSpeakers = _outputSpeakerLayout;
+            Span<float> angles = stackalloc float[numOutputChannels];
 
             for (var vsIdx = 0; vsIdx < numSpeakers; vsIdx++)
             {
-                factors[vsIdx] = new float[numOutputChannels];
-                var virtualPos = _currentConfiguration.SpeakerPositions[vsIdx];
+                var row = factors.Slice(vsIdx * numOutputChannels, numOutputChannels);
+                var virtualPos = configuration.SpeakerPositions[vsIdx];
                 var relativeVec = virtualPos - _listenerPosition;
                 var distance = relativeVec.Length();
                 var direction = relativeVec / distance;
 
                 // Calculate angles between virtual source and all output speakers
-                var angles = new float[numOutputChannels];
                 var total = 0f;
 
                 for (var ch = 0; ch < numOutputChannels; ch++)
@@ -388,34 +542,23 @@ namespace SoundFlow.Components
                 for (var ch = 0; ch < numOutputChannels; ch++)
                 {
                     var weight = (1f / (angles[ch] + 0.001f)) / total;
-                    factors[vsIdx][ch] = weight * (1f / (1 + VbapParameters.RolloffFactor * distance));
+                    row[ch] = weight * (1f / (1 + VbapParameters.RolloffFactor * distance));
                 }
             }
-
-            return factors;
         }
 
-        private void RecalculateVbapPanningFactorsIfNecessary(int channels)
+        private void CalculateVbapPanningFactors(SurroundConfiguration configuration, int channels, Span<float> factors)
         {
-            if (!_vbapPanningFactorsDirty)
-                return;
-            _panningFactors = CalculateVbapPanningFactors(channels);
-            _vbapPanningFactorsDirty = false;
-        }
-
-        private float[][] CalculateVbapPanningFactors(int channels)
-        {
-            var numVirtualSpeakers = _currentConfiguration.SpeakerPositions.Length;
+            var numVirtualSpeakers = configuration.SpeakerPositions.Length;
             var numOutputChannels = channels;
-            var factors = new float[numVirtualSpeakers][];
 
             // Get output speaker positions (base positions on current channel count)
-            var outputSpeakerPositions = GetOutputSpeakerLayout(channels);
+            var outputSpeakerPositions = _outputSpeakerLayout;
 
             for (var vsIdx = 0; vsIdx < numVirtualSpeakers; vsIdx++)
             {
-                factors[vsIdx] = new float[numOutputChannels];
-                var virtualPos = _currentConfiguration.SpeakerPositions[vsIdx];
+                var row = factors.Slice(vsIdx * numOutputChannels, numOutputChannels);
+                var virtualPos = configuration.SpeakerPositions[vsIdx];
 
                 // Calculate relative vector from listener to virtual speaker
                 var relativeVec = virtualPos - _listenerPosition;
@@ -423,25 +566,23 @@ namespace SoundFlow.Components
                 var direction = relativeVec / distance;
 
                 // Find the triangle of output speakers that contains the virtual speaker
-                var weights = CalculateVbapWeights(direction, outputSpeakerPositions);
+                CalculateVbapWeights(direction, outputSpeakerPositions, row);
 
                 // Apply distance attenuation and normalize
                 var attenuation = 1f / (1 + VbapParameters.RolloffFactor * distance);
 
                 for (var ch = 0; ch < numOutputChannels; ch++)
                 {
-                    factors[vsIdx][ch] = weights[ch] * attenuation;
+                    row[ch] *= attenuation;
                 }
             }
-
-            return factors;
         }
 
-        private float[] CalculateVbapWeights(Vector2 direction, Vector2[] outputSpeakers)
+        private void CalculateVbapWeights(Vector2 direction, Vector2[] outputSpeakers, Span<float> weights)
         {
             var numSpeakers = outputSpeakers.Length;
-            var weights = new float[numSpeakers];
             var maxContribution = -1f;
+            weights.Clear();
 
             for (var a = 0; a < numSpeakers; a++)
             {
@@ -468,7 +609,7 @@ namespace SoundFlow.Components
                         if (contribution > maxContribution)
                         {
                             maxContribution = contribution;
-                            Array.Clear(weights, 0, weights.Length);
+                            weights.Clear();
                             weights[a] = wa;
                             weights[b] = wb;
                         }
@@ -479,11 +620,13 @@ namespace SoundFlow.Components
             // Normalize if valid weights found
             if (maxContribution > 0)
             {
-                var sum = weights.Sum();
+                var sum = 0f;
+                for (var i = 0; i < weights.Length; i++)
+                    sum += weights[i];
                 for (var i = 0; i < weights.Length; i++)
                     weights[i] /= sum;
 
-                return weights;
+                return;
             }
 
             // Fallback: Find nearest speaker
@@ -501,7 +644,6 @@ namespace SoundFlow.Components
             }
 
             weights[nearest] = 1f;
-            return weights;
         }
 
         private Vector2[] GetOutputSpeakerLayout(int channelCount)
@@ -567,22 +709,13 @@ namespace SoundFlow.Components
             return positions;
         }
 
-        private float ApplyDelayAndVolume(float sample, float volume, float delayMs, int speakerIndex)
-        {
-            var delaySamples = (int)(delayMs * Format.SampleRate / 1000f);
-
-            var delayIndex = (_delayIndices[speakerIndex] - delaySamples + _delayLines.Length) % _delayLines.Length;
-            var delayedSample = _delayLines[delayIndex];
-
-            _delayLines[_delayIndices[speakerIndex]] = sample;
-            _delayIndices[speakerIndex] = (_delayIndices[speakerIndex] + 1) % _delayLines.Length;
-
-            return delayedSample * volume;
-        }
+        private static bool SameValues(float[] values, float[] snapshot) => values.AsSpan().SequenceEqual(snapshot);
 
-        private float ApplyLowPassFilter(float sample)
+        private static void Snapshot(float[] values, ref float[] snapshot)
         {
-            return _lowPassFilter.ProcessSample(sample, 0);
+            if (snapshot.Length != values.Length)
+                snapshot = new float[values.Length];
+            values.CopyTo(snapshot, 0);
         }
 
         #region Audio Playback Control
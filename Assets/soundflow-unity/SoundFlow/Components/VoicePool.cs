@@ -0,0 +1,641 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Providers;
+using SoundFlow.Structs;
+using SoundFlow.Utils;
+using System;
+using System.Threading;
+
+namespace SoundFlow.Components
+{
+    /// <summary>
+    ///     Plays many short-lived sounds (one-shot effects, footsteps, impacts) through a fixed set of preallocated
+    ///     <see cref="SoundPlayer"/> instances, with a cap on how many are rendered at once.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The pool is added to a mixer once and renders its voices itself, so starting a sound does not allocate a
+    ///     player, touch its resample and time-stretch buffers, or take the mixer's locks. Calls from other threads
+    ///     are queued and applied by the audio thread at the start of the next block.
+    ///     </para>
+    ///     <para>
+    ///     Every block the voices are ranked by priority and then by audibility (volume times the audibility the
+    ///     caller reports, e.g. distance attenuation). The best <see cref="MaxVoices"/> are rendered; the rest become
+    ///     virtual: they keep advancing through their sound without being rendered and become real again, at the
+    ///     right position, when they rank high enough. When all voice slots are taken, a new voice steals the slot
+    ///     of the weakest voice, or is rejected if it would be the weakest itself. Ties keep the current order, so
+    ///     voices do not flip between real and virtual on equal scores.
+    ///     </para>
+    ///     <para>
+    ///     Sounds are played from interleaved samples in the pool's format, such as a <see cref="DecodedAsset"/>
+    ///     from the <see cref="DecodedAssetCache"/>, at normal speed.
+    ///     </para>
+    /// </remarks>
+    public sealed class VoicePool : SoundComponent
+    {
+        private const int CommandCapacity = 1024;
+
+        // Commands from any thread to the audio thread. Producers serialize on _commandLock; the audio thread
+        // consumes without locking.
+        private readonly Command[] _commands = new Command[CommandCapacity];
+        private readonly object _commandLock = new();
+        private int _commandWrite;
+        private int _commandRead;
+        private long _nextId;
+        private long _appliedStartId;
+
+        // Audio thread state. _active holds the live voices, ranked best first as of the last block.
+        private readonly Voice[] _voices;
+        private readonly Voice[] _active;
+        private readonly Voice[] _freeVoices;
+        private readonly PooledPlayer[] _freePlayers;
+        private readonly PooledPlayer[] _players;
+        private int _activeCount;
+        private int _freeVoiceCount;
+        private int _freePlayerCount;
+
+        private int _realVoiceCount;
+        private int _virtualVoiceCount;
+        private long _stolenVoices;
+        private long _rejectedVoices;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="VoicePool"/> class.
+        /// </summary>
+        /// <param name="engine">The audio engine instance.</param>
+        /// <param name="format">The audio format of the pool and of the sounds it plays.</param>
+        /// <param name="maxVoices">The number of voices rendered at once; one player is preallocated for each.</param>
+        /// <param name="maxVirtualVoices">The number of additional voices tracked without being rendered.</param>
+        /// <exception cref="ArgumentOutOfRangeException">
+        ///     Thrown if maxVoices is not positive or maxVirtualVoices is negative.
+        /// </exception>
+        public VoicePool(AudioEngine engine, AudioFormat format, int maxVoices, int maxVirtualVoices = 64)
+            : base(engine, format)
+        {
+            if (maxVoices <= 0) throw new ArgumentOutOfRangeException(nameof(maxVoices));
+            if (maxVirtualVoices < 0) throw new ArgumentOutOfRangeException(nameof(maxVirtualVoices));
+
+            MaxVoices = maxVoices;
+            MaxVirtualVoices = maxVirtualVoices;
+
+            var capacity = maxVoices + maxVirtualVoices;
+            _voices = new Voice[capacity];
+            _active = new Voice[capacity];
+            _freeVoices = new Voice[capacity];
+            for (var i = 0; i < capacity; i++)
+            {
+                _voices[i] = new Voice();
+                _freeVoices[_freeVoiceCount++] = _voices[i];
+            }
+
+            _players = new PooledPlayer[maxVoices];
+            _freePlayers = new PooledPlayer[maxVoices];
+            for (var i = 0; i < maxVoices; i++)
+            {
+                var player = new PooledPlayer(engine, format);
+                _players[i] = player;
+                _freePlayers[_freePlayerCount++] = player;
+            }
+        }
+
+        /// <inheritdoc />
+        public override string Name { get; set; } = "Voice Pool";
+
+        /// <summary>
+        ///     Gets the number of voices rendered at once.
+        /// </summary>
+        public int MaxVoices { get; }
+
+        /// <summary>
+        ///     Gets the number of voices tracked beyond <see cref="MaxVoices"/> without being rendered.
+        /// </summary>
+        public int MaxVirtualVoices { get; }
+
+        /// <summary>
+        ///     Gets the number of voices rendered in the last block.
+        /// </summary>
+        public int RealVoiceCount => Volatile.Read(ref _realVoiceCount);
+
+        /// <summary>
+        ///     Gets the number of virtual voices in the last block.
+        /// </summary>
+        public int VirtualVoiceCount => Volatile.Read(ref _virtualVoiceCount);
+
+        /// <summary>
+        ///     Gets the number of voices that were stopped to make room for a stronger one.
+        /// </summary>
+        public long StolenVoices => Interlocked.Read(ref _stolenVoices);
+
+        /// <summary>
+        ///     Gets the number of play requests that were dropped because every slot held a stronger voice or the
+        ///     command queue was full.
+        /// </summary>
+        public long RejectedVoices => Interlocked.Read(ref _rejectedVoices);
+
+        /// <summary>
+        ///     Starts a voice playing a decoded asset.
+        /// </summary>
+        /// <param name="asset">The asset to play. Must be in the pool's format.</param>
+        /// <param name="volume">The volume of the voice.</param>
+        /// <param name="pan">The pan of the voice, between 0 (left) and 1 (right).</param>
+        /// <param name="priority">The priority of the voice. Higher priorities are rendered and kept first.</param>
+        /// <param name="audibility">How audible the voice is apart from its volume, between 0 and 1.</param>
+        /// <param name="loop">Whether the voice loops until stopped.</param>
+        /// <returns>A handle to the voice, or an invalid handle if the request could not be queued.</returns>
+        /// <exception cref="ArgumentNullException">Thrown if asset is null.</exception>
+        public VoiceHandle Play(DecodedAsset asset, float volume = 1f, float pan = 0.5f, int priority = 0,
+            float audibility = 1f, bool loop = false)
+        {
+            if (asset == null) throw new ArgumentNullException(nameof(asset));
+            return Play(asset.Samples, volume, pan, priority, audibility, loop);
+        }
+
+        /// <summary>
+        ///     Starts a voice playing interleaved samples.
+        /// </summary>
+        /// <param name="samples">The samples to play, interleaved in the pool's format. Must not be modified while
+        ///     the voice plays.</param>
+        /// <param name="volume">The volume of the voice.</param>
+        /// <param name="pan">The pan of the voice, between 0 (left) and 1 (right).</param>
+        /// <param name="priority">The priority of the voice. Higher priorities are rendered and kept first.</param>
+        /// <param name="audibility">How audible the voice is apart from its volume, between 0 and 1.</param>
+        /// <param name="loop">Whether the voice loops until stopped.</param>
+        /// <returns>A handle to the voice, or an invalid handle if the request could not be queued.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if volume is negative or pan is outside [0, 1].</exception>
+        public VoiceHandle Play(ReadOnlyMemory<float> samples, float volume = 1f, float pan = 0.5f,
+            int priority = 0, float audibility = 1f, bool loop = false)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (volume < 0) throw new ArgumentOutOfRangeException(nameof(volume));
+            if (pan is < 0f or > 1f)
+                throw new ArgumentOutOfRangeException(nameof(pan), "Pan must be between 0.0 and 1.0.");
+
+            lock (_commandLock)
+            {
+                var id = _nextId + 1;
+                var command = new Command
+                {
+                    Kind = CommandKind.Start, Id = id, Samples = samples, Volume = volume, Pan = pan,
+                    Priority = priority, Audibility = Math.Clamp(audibility, 0f, 1f), Loop = loop
+                };
+                if (!TryEnqueue(command))
+                {
+                    Interlocked.Increment(ref _rejectedVoices);
+                    return default;
+                }
+
+                _nextId = id;
+                return new VoiceHandle(id);
+            }
+        }
+
+        /// <summary>
+        ///     Stops a voice.
+        /// </summary>
+        /// <param name="voice">The voice to stop.</param>
+        public void Stop(VoiceHandle voice) => Send(CommandKind.Stop, voice, 0f);
+
+        /// <summary>
+        ///     Stops every voice started so far.
+        /// </summary>
+        public void StopAll()
+        {
+            lock (_commandLock)
+                TryEnqueue(new Command { Kind = CommandKind.StopAll, Id = _nextId });
+        }
+
+        /// <summary>
+        ///     Sets the volume of a voice.
+        /// </summary>
+        /// <param name="voice">The voice to change.</param>
+        /// <param name="volume">The new volume.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if volume is negative.</exception>
+        public void SetVolume(VoiceHandle voice, float volume)
+        {
+            if (volume < 0) throw new ArgumentOutOfRangeException(nameof(volume));
+            Send(CommandKind.SetVolume, voice, volume);
+        }
+
+        /// <summary>
+        ///     Sets the pan of a voice.
+        /// </summary>
+        /// <param name="voice">The voice to change.</param>
+        /// <param name="pan">The new pan, between 0 (left) and 1 (right).</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if pan is outside [0, 1].</exception>
+        public void SetPan(VoiceHandle voice, float pan)
+        {
+            if (pan is < 0f or > 1f)
+                throw new ArgumentOutOfRangeException(nameof(pan), "Pan must be between 0.0 and 1.0.");
+            Send(CommandKind.SetPan, voice, pan);
+        }
+
+        /// <summary>
+        ///     Sets how audible a voice is apart from its volume, typically from its distance to the listener.
+        /// </summary>
+        /// <param name="voice">The voice to change.</param>
+        /// <param name="audibility">The new audibility, between 0 and 1.</param>
+        public void SetAudibility(VoiceHandle voice, float audibility) =>
+            Send(CommandKind.SetAudibility, voice, Math.Clamp(audibility, 0f, 1f));
+
+        /// <summary>
+        ///     Gets a value indicating whether a voice is still playing, really or virtually.
+        /// </summary>
+        /// <param name="voice">The voice to check.</param>
+        public bool IsPlaying(VoiceHandle voice)
+        {
+            if (!voice.IsValid) return false;
+
+            // Started but not yet picked up by the audio thread.
+            if (voice.Id > Interlocked.Read(ref _appliedStartId) && voice.Id <= Interlocked.Read(ref _nextId))
+                return true;
+
+            foreach (var v in _voices)
+                if (Interlocked.Read(ref v.Id) == voice.Id)
+                    return true;
+            return false;
+        }
+
+        private void Send(CommandKind kind, VoiceHandle voice, float value)
+        {
+            if (!voice.IsValid) return;
+            lock (_commandLock)
+                TryEnqueue(new Command { Kind = kind, Id = voice.Id, Volume = value });
+        }
+
+        private bool TryEnqueue(in Command command)
+        {
+            var write = _commandWrite;
+            if (write - Volatile.Read(ref _commandRead) >= CommandCapacity) return false;
+
+            _commands[write & (CommandCapacity - 1)] = command;
+            Volatile.Write(ref _commandWrite, write + 1);
+            return true;
+        }
+
+        /// <inheritdoc />
+        protected override void GenerateAudio(Span<float> buffer, int channels)
+        {
+            ApplyCommands();
+            Rank();
+            AssignPlayers();
+
+            var real = 0;
+            var virtualCount = 0;
+            for (var i = 0; i < _activeCount; i++)
+            {
+                var voice = _active[i];
+                if (voice.Player != null)
+                {
+                    var player = voice.Player;
+                    player.Volume = voice.Volume;
+                    player.Pan = voice.Pan;
+                    player.Process(buffer, channels);
+                    real++;
+
+                    if (player.State != PlaybackState.Playing)
+                        voice.Finished = true;
+                }
+                else
+                {
+                    virtualCount++;
+                    var length = voice.Samples.Length;
+                    voice.Position += buffer.Length;
+                    if (voice.Position >= length)
+                    {
+                        if (voice.Loop && length > 0) voice.Position %= length;
+                        else voice.Finished = true;
+                    }
+                }
+            }
+
+            RemoveFinished();
+            Volatile.Write(ref _realVoiceCount, real);
+            Volatile.Write(ref _virtualVoiceCount, virtualCount);
+        }
+
+        private void ApplyCommands()
+        {
+            var read = _commandRead;
+            var write = Volatile.Read(ref _commandWrite);
+            for (; read != write; read++)
+            {
+                ref var command = ref _commands[read & (CommandCapacity - 1)];
+                switch (command.Kind)
+                {
+                    case CommandKind.Start:
+                        Start(command);
+                        Interlocked.Exchange(ref _appliedStartId, command.Id);
+                        break;
+                    case CommandKind.StopAll:
+                        for (var i = 0; i < _activeCount; i++)
+                            if (_active[i].Id <= command.Id)
+                                _active[i].Finished = true;
+                        break;
+                    default:
+                        var voice = Find(command.Id);
+                        if (voice == null) break;
+                        switch (command.Kind)
+                        {
+                            case CommandKind.Stop: voice.Finished = true; break;
+                            case CommandKind.SetVolume: voice.Volume = command.Volume; break;
+                            case CommandKind.SetPan: voice.Pan = command.Volume; break;
+                            case CommandKind.SetAudibility: voice.Audibility = command.Volume; break;
+                        }
+                        break;
+                }
+
+                command.Samples = default; // Do not keep the sound alive through the queue.
+            }
+
+            Volatile.Write(ref _commandRead, read);
+            RemoveFinished();
+        }
+
+        private void Start(in Command command)
+        {
+            if (command.Samples.IsEmpty) return;
+
+            if (_freeVoiceCount == 0)
+            {
+                // Steal the weakest live voice, unless the new one would be weaker still.
+                var weakest = -1;
+                for (var i = 0; i < _activeCount; i++)
+                    if (weakest < 0 || Compare(_active[i], _active[weakest]) > 0)
+                        weakest = i;
+
+                if (weakest < 0 ||
+                    Compare(command.Priority, command.Volume * command.Audibility, _active[weakest]) >= 0)
+                {
+                    Interlocked.Increment(ref _rejectedVoices);
+                    return;
+                }
+
+                _active[weakest].Finished = true;
+                RemoveFinished();
+                Interlocked.Increment(ref _stolenVoices);
+            }
+
+            var voice = _freeVoices[--_freeVoiceCount];
+            voice.Samples = command.Samples;
+            voice.Position = 0;
+            voice.Volume = command.Volume;
+            voice.Pan = command.Pan;
+            voice.Priority = command.Priority;
+            voice.Audibility = command.Audibility;
+            voice.Loop = command.Loop;
+            voice.Finished = false;
+            Interlocked.Exchange(ref voice.Id, command.Id);
+            _active[_activeCount++] = voice;
+        }
+
+        /// <summary>
+        ///     Sorts the live voices best first. Insertion sort: the order rarely changes between blocks and it is
+        ///     stable, so ties keep their current ranking.
+        /// </summary>
+        private void Rank()
+        {
+            for (var i = 1; i < _activeCount; i++)
+            {
+                var voice = _active[i];
+                var j = i - 1;
+                while (j >= 0 && Compare(_active[j], voice) > 0)
+                {
+                    _active[j + 1] = _active[j];
+                    j--;
+                }
+
+                _active[j + 1] = voice;
+            }
+        }
+
+        /// <summary>
+        ///     Hands the players to the best <see cref="MaxVoices"/> voices, demoting the rest to virtual.
+        /// </summary>
+        private void AssignPlayers()
+        {
+            for (var i = MaxVoices; i < _activeCount; i++)
+            {
+                var voice = _active[i];
+                if (voice.Player == null) continue;
+                voice.Position = voice.Player.DataPosition;
+                ReleasePlayer(voice);
+            }
+
+            var realCount = Math.Min(_activeCount, MaxVoices);
+            for (var i = 0; i < realCount; i++)
+            {
+                var voice = _active[i];
+                if (voice.Player != null) continue;
+
+                var player = _freePlayers[--_freePlayerCount];
+                player.Start(voice.Samples, voice.Position, voice.Loop);
+                voice.Player = player;
+            }
+        }
+
+        private void RemoveFinished()
+        {
+            var kept = 0;
+            for (var i = 0; i < _activeCount; i++)
+            {
+                var voice = _active[i];
+                if (!voice.Finished)
+                {
+                    _active[kept++] = voice;
+                    continue;
+                }
+
+                if (voice.Player != null) ReleasePlayer(voice);
+                voice.Samples = default;
+                Interlocked.Exchange(ref voice.Id, 0);
+                _freeVoices[_freeVoiceCount++] = voice;
+            }
+
+            for (var i = kept; i < _activeCount; i++)
+                _active[i] = null!;
+            _activeCount = kept;
+        }
+
+        private void ReleasePlayer(Voice voice)
+        {
+            voice.Player!.Release();
+            _freePlayers[_freePlayerCount++] = voice.Player;
+            voice.Player = null;
+        }
+
+        private Voice? Find(long id)
+        {
+            for (var i = 0; i < _activeCount; i++)
+                if (_active[i].Id == id)
+                    return _active[i];
+            return null;
+        }
+
+        // Positive when a ranks below b.
+        private static int Compare(Voice a, Voice b) => Compare(a.Priority, a.Volume * a.Audibility, b);
+
+        private static int Compare(int priority, float audibility, Voice b)
+        {
+            if (priority != b.Priority) return priority < b.Priority ? 1 : -1;
+            var other = b.Volume * b.Audibility;
+            return audibility < other ? 1 : audibility > other ? -1 : 0;
+        }
+
+        /// <inheritdoc />
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                foreach (var player in _players)
+                    player.Dispose();
+            }
+
+            base.Dispose(disposing);
+        }
+
+        private enum CommandKind
+        {
+            Start,
+            Stop,
+            StopAll,
+            SetVolume,
+            SetPan,
+            SetAudibility
+        }
+
+        private struct Command
+        {
+            public CommandKind Kind;
+            public long Id;
+            public ReadOnlyMemory<float> Samples;
+            public float Volume; // Also carries the value of SetPan and SetAudibility.
+            public float Pan;
+            public float Audibility;
+            public int Priority;
+            public bool Loop;
+        }
+
+        private sealed class Voice
+        {
+            public long Id;
+            public ReadOnlyMemory<float> Samples;
+            public int Position;
+            public float Volume;
+            public float Pan;
+            public float Audibility;
+            public int Priority;
+            public bool Loop;
+            public bool Finished;
+            public PooledPlayer? Player;
+        }
+
+        /// <summary>
+        ///     A preallocated player bound for life to a provider that can be pointed at new samples.
+        /// </summary>
+        private sealed class PooledPlayer : SoundPlayerBase
+        {
+            private readonly PooledDataProvider _provider;
+
+            public PooledPlayer(AudioEngine engine, AudioFormat format)
+                : this(engine, format, new PooledDataProvider(format.SampleRate))
+            {
+            }
+
+            private PooledPlayer(AudioEngine engine, AudioFormat format, PooledDataProvider provider)
+                : base(engine, format, provider)
+            {
+                _provider = provider;
+                Enabled = false;
+            }
+
+            public override string Name { get; set; } = "Pooled Voice";
+
+            public int DataPosition => _provider.Position;
+
+            public void Start(ReadOnlyMemory<float> samples, int position, bool loop)
+            {
+                _provider.SetSamples(samples);
+                Stop();
+                if (position > 0) Seek(position);
+                IsLooping = loop;
+                Play();
+            }
+
+            public void Release()
+            {
+                Stop();
+                _provider.SetSamples(ReadOnlyMemory<float>.Empty);
+            }
+        }
+
+        /// <summary>
+        ///     Reads from whichever samples the pool last assigned to it.
+        /// </summary>
+        private sealed class PooledDataProvider : ISoundDataProvider
+        {
+            private ReadOnlyMemory<float> _samples;
+            private int _position;
+
+            public PooledDataProvider(int sampleRate)
+            {
+                SampleRate = sampleRate;
+                Clock = new PositionClock(this);
+            }
+
+            public int Position => _position;
+
+            public int Length => _samples.Length;
+
+            public bool CanSeek => true;
+
+            public SampleFormat SampleFormat => SampleFormat.F32;
+
+            public int SampleRate { get; }
+
+            public bool IsDisposed { get; private set; }
+
+            public event EventHandler<EventArgs>? EndOfStreamReached;
+
+            public PositionClock Clock { get; }
+
+            public event EventHandler<PositionChangedEventArgs>? PositionChanged
+            {
+                add => Clock.Changed += value;
+                remove => Clock.Changed -= value;
+            }
+
+            public void SetSamples(ReadOnlyMemory<float> samples)
+            {
+                _samples = samples;
+                _position = 0;
+                Clock.Publish(0, false);
+            }
+
+            public int ReadBytes(Span<float> buffer)
+            {
+                var count = Math.Min(buffer.Length, _samples.Length - _position);
+                _samples.Span.Slice(_position, count).CopyTo(buffer);
+                _position += count;
+
+                if (_position >= _samples.Length)
+                    EndOfStreamReached?.Invoke(this, EventArgs.Empty);
+                Clock.Publish(_position, count > 0);
+                return count;
+            }
+
+            public void Seek(int offset)
+            {
+                _position = Math.Clamp(offset, 0, _samples.Length);
+                Clock.Publish(_position, false);
+            }
+
+            public void Dispose()
+            {
+                _samples = ReadOnlyMemory<float>.Empty;
+                Clock.Dispose();
+                IsDisposed = true;
+            }
+        }
+    }
+}
@@ -1,4 +1,5 @@
-﻿using System;
+﻿using SoundFlow.Utils;
+using System;
 
 namespace SoundFlow.Abstracts
 {
@@ -13,21 +14,33 @@ namespace SoundFlow.Abstracts
 
         internal const int DefaultWindowSizeFrames = 1024;
         private const int NominalAnalysisHopFrames = DefaultWindowSizeFrames / 4;
-        private const int SearchRadiusFrames = (NominalAnalysisHopFrames * 3) / 8;
+        internal const int SearchRadiusFrames = (NominalAnalysisHopFrames * 3) / 8;
 
         private int _windowSizeSamples;
-        private float[] _inputBufferInternal;
+        private float[] _inputBufferInternal = Array.Empty<float>();
         private int _inputBufferValidSamples;
         private int _inputBufferReadPos;
-        private float[] _analysisWindow;
-        private float[] _prevOutputTail;
+        private float[] _analysisWindow = Array.Empty<float>();
+        private float[] _prevOutputTail = Array.Empty<float>();
         private int _actualPrevTailLength;
-        private float[] _currentAnalysisFrame;
-        private float[] _outputOverlapBuffer;
+        private float[] _currentAnalysisFrame = Array.Empty<float>();
+        private float[] _outputOverlapBuffer = Array.Empty<float>();
         private int _nominalHopSynthesisFrames;
         private bool _isFirstFrame = true;
         private bool _isFlushing;
 
+        // Overlap search scratch: one channel of tail (real) and candidate region (imaginary) per FFT, the summed
+        // cross spectrum, and running sums of the candidate region for its per-offset mean and energy.
+        private static readonly Fft SearchFftSmall = new(1024);
+        private static readonly Fft SearchFftLarge = new(2048);
+        private readonly float[] _searchReal = new float[SearchFftLarge.Size];
+        private readonly float[] _searchImag = new float[SearchFftLarge.Size];
+        private readonly float[] _crossReal = new float[SearchFftLarge.Size];
+        private readonly float[] _crossImag = new float[SearchFftLarge.Size];
+        private double[] _prefixSum = Array.Empty<double>();
+        private double[] _prefixSquares = Array.Empty<double>();
+        private readonly double[] _scores = new double[2 * SearchRadiusFrames + 1];
+
         /// <summary>
         /// Initializes a new instance of the <see cref="WsolaTimeStretcher"/> class.
         /// </summary>
@@ -60,6 +73,8 @@ namespace SoundFlow.Abstracts
                 _analysisWindow[i] = 0.5f * (1 - (float)Math.Cos(2 * Math.PI * i / (DefaultWindowSizeFrames - 1)));
             _currentAnalysisFrame = new float[_windowSizeSamples];
             _outputOverlapBuffer = new float[_windowSizeSamples];
+            _prefixSum = new double[(2 * SearchRadiusFrames + DefaultWindowSizeFrames) * _channels + 1];
+            _prefixSquares = new double[_prefixSum.Length];
             ResetState();
         }
 
@@ -189,92 +204,7 @@ namespace SoundFlow.Abstracts
                     if (prevTailEnergy > silenceThreshold && compareLengthFrames > minValidOverlapForSearch &&
                         compareLengthSamples > 0)
                     {
-                        var maxNcc = -2.0;
-                        // Calculate mean and sum of squared deviations for the previous output tail (A).
-                        double sumA = 0;
-                        for (var iS = 0; iS < compareLengthSamples; ++iS) sumA += _prevOutputTail[iS];
-                        var meanA = sumA / compareLengthSamples;
-                        double sumADevSq = 0;
-                        for (var iS = 0; iS < compareLengthSamples; ++iS)
-                        {
-                            var d = _prevOutputTail[iS] - meanA;
-                            sumADevSq += d * d;
-                        }
-
-                        // Pre-calculate NCC for delta 0 (nominal hop) as a baseline.
-                        var candidateStartAtDelta0 = _inputBufferReadPos + NominalAnalysisHopFrames * _channels;
-                        if (NominalAnalysisHopFrames > 0 &&
-                            (candidateStartAtDelta0 + compareLengthSamples <= _inputBufferValidSamples))
-                        {
-                            double sumBd0 = 0;
-                            for (var iS = 0; iS < compareLengthSamples; ++iS)
-                                sumBd0 += _inputBufferInternal[candidateStartAtDelta0 + iS];
-                            var meanBd0 = sumBd0 / compareLengthSamples;
-                            double sumBDevSqD0 = 0, dotProductDevD0 = 0;
-                            for (var iS = 0; iS < compareLengthSamples; ++iS)
-                            {
-                                var dA = _prevOutputTail[iS] - meanA;
-                                var dB = _inputBufferInternal[candidateStartAtDelta0 + iS] - meanBd0;
-                                dotProductDevD0 += dA * dB;
-                                sumBDevSqD0 += dB * dB;
-                            }
-
-                            var denominatorD0 = Math.Sqrt(sumADevSq * sumBDevSqD0);
-                            if (denominatorD0 < 1e-9)
-                                maxNcc = (sumADevSq < 1e-9 && sumBDevSqD0 < 1e-9) ? 1.0 : 0.0;
-                            else maxNcc = dotProductDevD0 / denominatorD0;
-                        }
-
-                        // Iterate through search radius to find the best overlap.
-                        for (var currentDeltaFrames = -SearchRadiusFrames;
-                             currentDeltaFrames <= SearchRadiusFrames;
-                             currentDeltaFrames++)
-                        {
-                            if (currentDeltaFrames == 0) continue;
-                            var trialAnalysisHopFrames = NominalAnalysisHopFrames + currentDeltaFrames;
-                            if (trialAnalysisHopFrames <= 0) continue;
-                            var candidateSegmentStartSample = _inputBufferReadPos + trialAnalysisHopFrames * _channels;
-                            // Check if candidate segment is within valid input data.
-                            if (candidateSegmentStartSample + compareLengthSamples > _inputBufferValidSamples)
-                            {
-                                if (currentDeltaFrames > 0) break;
-                                continue;
-                            }
-
-                            // Calculate mean and sum of squared deviations for the current candidate segment (B).
-                            double sumB = 0;
-                            for (var iS = 0; iS < compareLengthSamples; ++iS)
-                                sumB += _inputBufferInternal[candidateSegmentStartSample + iS];
-                            var meanB = sumB / compareLengthSamples;
-                            double sumBDevSq = 0, dotProductDev = 0;
-                            for (var iS = 0; iS < compareLengthSamples; ++iS)
-                            {
-                                var dA = _prevOutputTail[iS] - meanA;
-                                var dB = _inputBufferInternal[candidateSegmentStartSample + iS] - meanB;
-                                dotProductDev += dA * dB;
-                                sumBDevSq += dB * dB;
-                            }
-
-                            // Calculate Normalized Cross-Correlation (NCC).
-                            double currentNcc;
-                            var denominator = Math.Sqrt(sumADevSq * sumBDevSq);
-                            if (denominator < 1e-9) currentNcc = (sumADevSq < 1e-9 && sumBDevSq < 1e-9) ? 1.0 : 0.0;
-                            else currentNcc = dotProductDev / denominator;
-                            const float nccQualityThreshold = 0.02f;
-                            if (currentNcc > maxNcc + nccQualityThreshold)
-                            {
-                                maxNcc = currentNcc;
-                                bestOffsetFromNominalFrames = currentDeltaFrames;
-                            }
-                            else if (currentNcc > maxNcc - nccQualityThreshold)
-                            {
-                                if (Math.Abs(currentDeltaFrames) < Math.Abs(bestOffsetFromNominalFrames))
-                                {
-                                    maxNcc = currentNcc;
-                                    bestOffsetFromNominalFrames = currentDeltaFrames;
-                                }
-                            }
-                        }
+                        bestOffsetFromNominalFrames = FindBestOffset(compareLengthSamples);
                     }
                 }
 
@@ -408,6 +338,170 @@ namespace SoundFlow.Abstracts
             return samplesWrittenToOutput;
         }
 
+        /// <summary>
+        /// Finds the analysis hop offset whose input segment best continues the previous output tail, by normalized
+        /// cross-correlation over the whole search radius.
+        /// </summary>
+        /// <param name="compareLengthSamples">The length of the overlap region to compare, in samples.</param>
+        /// <returns>The best offset from the nominal analysis hop, in frames.</returns>
+        private int FindBestOffset(int compareLengthSamples)
+        {
+            // The candidate region spans every offset in the search radius; lag 0 is offset -SearchRadiusFrames.
+            var regionStart = _inputBufferReadPos + (NominalAnalysisHopFrames - SearchRadiusFrames) * _channels;
+            var regionEnd = Math.Min(_inputBufferValidSamples,
+                regionStart + 2 * SearchRadiusFrames * _channels + compareLengthSamples);
+            var regionLength = regionEnd - regionStart;
+            if (regionLength < compareLengthSamples) return 0;
+
+            var scored = ScoreCandidates(_prevOutputTail.AsSpan(0, compareLengthSamples),
+                _inputBufferInternal.AsSpan(regionStart, regionLength), _scores);
+
+            var bestOffsetFromNominalFrames = 0;
+            var maxNcc = -2.0;
+
+            // NCC for delta 0 (nominal hop) as a baseline.
+            if (NominalAnalysisHopFrames > 0 && SearchRadiusFrames < scored)
+                maxNcc = _scores[SearchRadiusFrames];
+
+            // Iterate through search radius to find the best overlap.
+            for (var currentDeltaFrames = -SearchRadiusFrames;
+                 currentDeltaFrames <= SearchRadiusFrames;
+                 currentDeltaFrames++)
+            {
+                if (currentDeltaFrames == 0) continue;
+                var trialAnalysisHopFrames = NominalAnalysisHopFrames + currentDeltaFrames;
+                if (trialAnalysisHopFrames <= 0) continue;
+
+                // Candidates past the buffered input were not scored, nor are any after them.
+                var lag = currentDeltaFrames + SearchRadiusFrames;
+                if (lag >= scored) break;
+                var currentNcc = _scores[lag];
+
+                const float nccQualityThreshold = 0.02f;
+                if (currentNcc > maxNcc + nccQualityThreshold)
+                {
+                    maxNcc = currentNcc;
+                    bestOffsetFromNominalFrames = currentDeltaFrames;
+                }
+                else if (currentNcc > maxNcc - nccQualityThreshold)
+                {
+                    if (Math.Abs(currentDeltaFrames) < Math.Abs(bestOffsetFromNominalFrames))
+                    {
+                        maxNcc = currentNcc;
+                        bestOffsetFromNominalFrames = currentDeltaFrames;
+                    }
+                }
+            }
+
+            return bestOffsetFromNominalFrames;
+        }
+
+        /// <summary>
+        /// Scores how well each candidate segment of <paramref name="region"/> continues <paramref name="tail"/>, as
+        /// their normalized cross-correlation over all channels.
+        /// </summary>
+        /// <remarks>
+        /// The tail is correlated against every candidate lag at once through the FFT (each channel packs the
+        /// tail and the candidate region into one complex transform, and the cross spectra are summed before a
+        /// single inverse), while running sums give each candidate's mean and energy in constant time. This
+        /// replaces a direct correlation per lag and yields the same scores up to float rounding. The tail is
+        /// transformed with its mean removed, so the correlation is already the covariance and no candidate's mean
+        /// has to be subtracted from it; the region is shifted by its own mean, which changes neither the
+        /// covariance nor the energies but keeps a DC offset from swamping them in float.
+        /// </remarks>
+        /// <param name="tail">The interleaved previous output tail, in whole frames.</param>
+        /// <param name="region">
+        /// The interleaved input the candidates are taken from, starting at lag 0; at most
+        /// <c>2 * SearchRadiusFrames</c> frames longer than <paramref name="tail"/>.
+        /// </param>
+        /// <param name="scores">Receives the score of each lag, in frames into <paramref name="region"/>.</param>
+        /// <returns>The number of lags scored: every lag whose candidate lies wholly within the region.</returns>
+        internal int ScoreCandidates(ReadOnlySpan<float> tail, ReadOnlySpan<float> region, Span<double> scores)
+        {
+            var channels = _channels;
+            var compareLengthSamples = tail.Length;
+            var compareLengthFrames = compareLengthSamples / channels;
+            var regionLength = region.Length;
+            var regionFrames = regionLength / channels;
+
+            // Mean and sum of squared deviations for the previous output tail (A).
+            double sumA = 0;
+            for (var iS = 0; iS < compareLengthSamples; ++iS) sumA += tail[iS];
+            var meanA = sumA / compareLengthSamples;
+            double sumADevSq = 0;
+            for (var iS = 0; iS < compareLengthSamples; ++iS)
+            {
+                var d = tail[iS] - meanA;
+                sumADevSq += d * d;
+            }
+
+            double sumRegion = 0;
+            for (var i = 0; i < regionLength; i++) sumRegion += region[i];
+            var meanRegion = sumRegion / regionLength;
+
+            var fft = regionFrames <= SearchFftSmall.Size ? SearchFftSmall : SearchFftLarge;
+            var n = fft.Size;
+            var re = _searchReal.AsSpan(0, n);
+            var im = _searchImag.AsSpan(0, n);
+            var crossRe = _crossReal.AsSpan(0, n);
+            var crossIm = _crossImag.AsSpan(0, n);
+            crossRe.Clear();
+            crossIm.Clear();
+
+            for (var ch = 0; ch < channels; ch++)
+            {
+                re.Clear();
+                im.Clear();
+                for (var f = 0; f < compareLengthFrames; f++)
+                    re[f] = (float)(tail[f * channels + ch] - meanA);
+                for (var f = 0; f < regionFrames; f++)
+                    im[f] = (float)(region[f * channels + ch] - meanRegion);
+
+                fft.Forward(re, im);
+
+                // Split the packed spectrum into tail (A) and region (X) spectra and accumulate conj(A) * X.
+                for (var k = 0; k < n; k++)
+                {
+                    var mirror = (n - k) & (n - 1);
+                    var ar = 0.5f * (re[k] + re[mirror]);
+                    var ai = 0.5f * (im[k] - im[mirror]);
+                    var xr = 0.5f * (im[k] + im[mirror]);
+                    var xi = -0.5f * (re[k] - re[mirror]);
+                    crossRe[k] += ar * xr + ai * xi;
+                    crossIm[k] += ar * xi - ai * xr;
+                }
+            }
+
+            // crossRe[lag] now holds the covariance of the tail and the candidate at that lag, unnormalized.
+            fft.Inverse(crossRe, crossIm);
+
+            _prefixSum[0] = 0;
+            _prefixSquares[0] = 0;
+            for (var i = 0; i < regionLength; i++)
+            {
+                var x = region[i] - meanRegion;
+                _prefixSum[i + 1] = _prefixSum[i] + x;
+                _prefixSquares[i + 1] = _prefixSquares[i] + x * x;
+            }
+
+            var lags = Math.Min(scores.Length, (regionLength - compareLengthSamples) / channels + 1);
+            for (var lag = 0; lag < lags; lag++)
+            {
+                var start = lag * channels;
+                var sumB = _prefixSum[start + compareLengthSamples] - _prefixSum[start];
+                var meanB = sumB / compareLengthSamples;
+                var sumBDevSq = Math.Max(0,
+                    _prefixSquares[start + compareLengthSamples] - _prefixSquares[start] - sumB * meanB);
+                double dotProductDev = _crossReal[lag];
+
+                var denominator = Math.Sqrt(sumADevSq * sumBDevSq);
+                if (denominator < 1e-9) scores[lag] = (sumADevSq < 1e-9 && sumBDevSq < 1e-9) ? 1.0 : 0.0;
+                else scores[lag] = dotProductDev / denominator;
+            }
+
+            return Math.Max(0, lags);
+        }
+
         /// <summary>
         /// Flushes any remaining buffered audio data through the time stretcher.
         /// This is typically called at the end of a stream to ensure all data is processed.
@@ -0,0 +1,19 @@
+﻿namespace SoundFlow.Enums
+{
+    /// <summary>
+    /// Describes how a deferred <see cref="SoundFlow.Abstracts.AudioAnalyzer"/> handles blocks that queued up since
+    /// it last ran.
+    /// </summary>
+    public enum AnalysisCoalescing
+    {
+        /// <summary>
+        /// Analyze only the most recent block and discard older pending audio. Suited to meters and spectrum displays.
+        /// </summary>
+        Latest,
+
+        /// <summary>
+        /// Analyze all pending audio in a single call, so no captured sample is skipped while the snapshot ring has room.
+        /// </summary>
+        Merge
+    }
+}
@@ -0,0 +1,24 @@
+﻿namespace SoundFlow.Enums
+{
+    /// <summary>
+    /// Describes where an <see cref="SoundFlow.Abstracts.AudioAnalyzer"/> runs its analysis and visualizer updates.
+    /// </summary>
+    public enum AnalysisDispatch
+    {
+        /// <summary>
+        /// Analysis runs synchronously on the audio thread, inside the render callback.
+        /// </summary>
+        Inline,
+
+        /// <summary>
+        /// The audio thread only copies blocks into a snapshot ring; a shared background thread analyzes them.
+        /// </summary>
+        Worker,
+
+        /// <summary>
+        /// The audio thread only copies blocks into a snapshot ring; the application analyzes them by calling
+        /// <see cref="SoundFlow.Abstracts.AudioAnalyzer.PumpAnalysis"/>, for example once per frame on Unity's main thread.
+        /// </summary>
+        Manual
+    }
+}
@@ -0,0 +1,19 @@
+namespace SoundFlow.Enums
+{
+    /// <summary>
+    /// Describes how often a control source such as an LFO or envelope computes its value.
+    /// </summary>
+    public enum ControlRate
+    {
+        /// <summary>
+        /// A new value every frame, with change notifications raised per frame.
+        /// </summary>
+        Audio,
+
+        /// <summary>
+        /// One value per block. The block is advanced in a single step, its output ramps from the previous block's
+        /// value, and change notifications are raised once per block.
+        /// </summary>
+        Block
+    }
+}
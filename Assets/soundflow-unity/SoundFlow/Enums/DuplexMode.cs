@@ -0,0 +1,21 @@
+namespace SoundFlow.Enums
+{
+    /// <summary>
+    /// Describes how a <see cref="SoundFlow.Abstracts.Devices.FullDuplexDevice"/> drives its input and output.
+    /// </summary>
+    public enum DuplexMode
+    {
+        /// <summary>
+        /// Two independent devices with their own callbacks, started separately. Input and output run on separate
+        /// clocks, so the delay between them drifts and each side adds its own buffering.
+        /// </summary>
+        Separate,
+
+        /// <summary>
+        /// A single duplex device whose callback receives a block of input and produces the same number of output
+        /// frames. Capture subscribers run first, so audio they hand to the mixer can be played in the same callback,
+        /// and the output is a sample-aligned, clock-locked echo reference for the input.
+        /// </summary>
+        Linked
+    }
+}
@@ -0,0 +1,19 @@
+namespace SoundFlow.Enums
+{
+    /// <summary>
+    /// Describes how a <see cref="SoundFlow.Utils.DynamicsProcessor"/> derives gain from the channels of a frame.
+    /// </summary>
+    public enum DynamicsLinking
+    {
+        /// <summary>
+        /// One detector follows the loudest channel of each frame and every channel gets the same gain, so the
+        /// stereo image does not shift while the signal is compressed.
+        /// </summary>
+        Linked,
+
+        /// <summary>
+        /// Every channel has its own detector and gain, so a loud channel never ducks the others.
+        /// </summary>
+        PerChannel
+    }
+}
@@ -0,0 +1,28 @@
+﻿namespace SoundFlow.Enums
+{
+    /// <summary>
+    ///     Quality tiers of the <see cref="SoundFlow.Components.Resampler"/>, trading filter length for CPU time.
+    /// </summary>
+    public enum ResamplerQuality
+    {
+        /// <summary>
+        ///     Two-tap linear interpolation. Cheapest; audible aliasing and high-frequency loss.
+        /// </summary>
+        Linear,
+
+        /// <summary>
+        ///     8-tap windowed sinc. Suited to short effects and voices where many play at once.
+        /// </summary>
+        Low,
+
+        /// <summary>
+        ///     16-tap windowed sinc. A good default for most content.
+        /// </summary>
+        Medium,
+
+        /// <summary>
+        ///     32-tap windowed sinc with a steep cutoff. For music and other full-bandwidth content.
+        /// </summary>
+        High
+    }
+}
@@ -0,0 +1,36 @@
+using System;
+
+namespace SoundFlow.Interfaces
+{
+    /// <summary>
+    ///     A sound data provider whose samples are already in memory as 32-bit floats and can be read in place,
+    ///     without copying them out through <see cref="ISoundDataProvider.ReadBytes" /> first.
+    /// </summary>
+    /// <remarks>
+    ///     Players use it to feed their rate converter straight from the provider's memory. A read in place is a
+    ///     <see cref="PeekSamples" /> followed by an <see cref="Advance" /> for the samples actually used; the end of
+    ///     the data is still reported by <see cref="ISoundDataProvider.ReadBytes" />.
+    /// </remarks>
+    public interface ISampleSpanSource
+    {
+        /// <summary>
+        ///     Gets whether samples can be read in place. False when the data is stored in another format.
+        /// </summary>
+        bool CanReadInPlace { get; }
+
+        /// <summary>
+        ///     Gets a read-only span over up to <paramref name="sampleCount" /> samples from the current position,
+        ///     without advancing it. The span is empty at the end of the data or when <see cref="CanReadInPlace" />
+        ///     is false, and stays valid until the provider is disposed.
+        /// </summary>
+        /// <param name="sampleCount">The largest number of samples wanted.</param>
+        ReadOnlySpan<float> PeekSamples(int sampleCount);
+
+        /// <summary>
+        ///     Moves the position past samples read in place, publishing it to the provider's clock as
+        ///     <see cref="ISoundDataProvider.ReadBytes" /> would.
+        /// </summary>
+        /// <param name="sampleCount">The number of samples consumed. Clamped to the end of the data.</param>
+        void Advance(int sampleCount);
+    }
+}
@@ -1,5 +1,8 @@
 using SoundFlow.Enums;
+using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
+using System.Diagnostics;
 
 namespace SoundFlow.Interfaces
 {
@@ -62,7 +65,14 @@ namespace SoundFlow.Interfaces
         event EventHandler<EventArgs> EndOfStreamReached;
 
         /// <summary>
-        ///     Raised when the playback position changes.
+        ///     Gets the clock the provider publishes its position to after every read and seek. Poll it from any
+        ///     thread without locking or allocating, e.g. for scrubbers or lip-sync.
+        /// </summary>
+        PositionClock Clock { get; }
+
+        /// <summary>
+        ///     Raised when the playback position changes. Raised on a background thread by <see cref="Clock" />, at
+        ///     most once per <see cref="PositionClock.NotificationIntervalMilliseconds" />, never on the audio thread.
         /// </summary>
         event EventHandler<PositionChangedEventArgs> PositionChanged;
     }
@@ -77,13 +87,29 @@ namespace SoundFlow.Interfaces
         /// </summary>
         /// <param name="newPosition">The new playback position in samples.</param>
         public PositionChangedEventArgs(int newPosition)
+            : this(newPosition, new PositionSnapshot(newPosition, Stopwatch.GetTimestamp(), true))
+        {
+        }
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="PositionChangedEventArgs" /> class from a clock reading.
+        /// </summary>
+        /// <param name="newPosition">The new playback position in samples.</param>
+        /// <param name="snapshot">The clock reading the position was taken from.</param>
+        public PositionChangedEventArgs(int newPosition, PositionSnapshot snapshot)
         {
             NewPosition = newPosition;
+            Snapshot = snapshot;
         }
 
         /// <summary>
         ///     Gets the new playback position in samples.
         /// </summary>
         public int NewPosition { get; }
+
+        /// <summary>
+        ///     Gets the clock reading behind <see cref="NewPosition" />, with the time the audio thread reached it.
+        /// </summary>
+        public PositionSnapshot Snapshot { get; }
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿using SoundFlow.Enums;
+using SoundFlow.Utils;
 using System;
 using System.IO;
 
@@ -37,6 +38,12 @@ namespace SoundFlow.Interfaces
         /// </summary>
         float Time { get; }
 
+        /// <summary>
+        /// Gets the clock publishing the playback position in source samples. Poll it from the UI or for
+        /// lip-sync instead of hooking the render path; reading it never blocks the audio thread.
+        /// </summary>
+        PositionClock Clock { get; }
+
         /// <summary>
         /// Gets the total duration of the audio in seconds.
         /// </summary>
@@ -1,6 +1,7 @@
 ﻿using SoundFlow.Abstracts;
 using SoundFlow.Structs;
 using System;
+using System.Numerics;
 using System.Runtime.CompilerServices;
 
 namespace SoundFlow.Modifiers
@@ -8,17 +9,18 @@ namespace SoundFlow.Modifiers
     /// <summary>
     /// Free-verb algorithmic reverb modifier.
     /// </summary>
+    /// <remarks>
+    /// All delay lines live in a few contiguous arrays allocated by the constructor at their maximum size, so no
+    /// parameter change allocates. The eight parallel comb filters of a channel share one delay line stored
+    /// comb-interleaved (one row of eight samples per time step): their feedback writes are a single vector store
+    /// and their damping filters one vector update. The comb delays are modulated by a slow LFO through the read
+    /// offsets, refreshed every <see cref="ModulationInterval"/> samples, rather than by resizing the lines.
+    /// </remarks>
     public sealed class AlgorithmicReverbModifier : SoundModifier
     {
         private const int NumCombs = 8;
         private const int NumAllPasses = 4;
 
-        // Comb filters (indexed by channel, then by comb filter index)
-        private CombFilter[][] _combFilters;
-
-        // All-pass filters (indexed by channel, then by all-pass filter index)
-        private AllPassFilter[][] _allPassFilters;
-
         private float _wet = 0.5f; // Wet/dry mix (0-1)
         private float _roomSize = 0.5f; // Room size (0-1)
         private float _damp = 0.5f; // Damping (0-1)
@@ -26,16 +28,36 @@ namespace SoundFlow.Modifiers
         private float _preDelay; // Pre-delay time (in milliseconds)
         private float _mix = 0.5f; // Early reflection / reverb tail mix (0-1)
         private int _preDelaySamples;
-        private float[][] _preDelayBuffers; // Pre-delay buffer per channel
-        private int[] _preDelayIndices;
 
         // Modulation
         private const float ModulationRate = 0.1f; // Modulation rate in Hz (fixed for now)
         private const float ModulationDepth = 0.005f; // Modulation depth
-        private float[] _modulatedCombTuning;
-        private float[] _lfoPhase;
+        private const int ModulationInterval = 32; // Samples between comb delay updates
 
         private readonly AudioFormat _format;
+        private readonly int _channels;
+
+        // Comb bank: per channel a ring of CombLineLength rows of NumCombs samples, one write row shared by all
+        // combs, and per comb its current (modulated) delay and damping filter state.
+        private readonly float[] _combLines;
+        private readonly int[] _combWrite;
+        private readonly int[] _combDelays;
+        private readonly float[] _combFilterState;
+        private readonly float[] _combRow = new float[NumCombs];
+
+        // All-pass chain: per channel four rings packed back to back.
+        private readonly float[] _allPassLines;
+        private readonly int[] _allPassOffsets;
+        private readonly int[] _allPassLengths;
+        private readonly int[] _allPassIndices;
+
+        // Pre-delay: per channel a ring of MaxPreDelaySamples.
+        private readonly float[] _preDelayLines;
+        private readonly int[] _preDelayIndices;
+        private readonly int _preDelayLength;
+
+        private readonly float[] _lfoPhase;
+        private readonly int[] _modulationCountdown;
 
         /// <inheritdoc />
         public override string Name { get; set; } = "Free-verb Algorithmic Reverb";
@@ -45,7 +67,7 @@ namespace SoundFlow.Modifiers
         {
             new float[] {1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617}, // Channel 0
             new float[] {1139, 1211, 1298, 1379, 1445, 1514, 1580, 1640}, // Channel 1
-            new float[] {1150, 1222, 1311, 1392, 1460, 1529, 1597, 1657}, // Channel 2 
+            new float[] {1150, 1222, 1311, 1392, 1460, 1529, 1597, 1657}, // Channel 2
             new float[] {1163, 1235, 1324, 1405, 1475, 1544, 1614, 1674}, // Channel 3
             new float[] {1176, 1248, 1337, 1418, 1490, 1559, 1631, 1691}, // Channel 4
             new float[] {1189, 1261, 1350, 1431, 1505, 1574, 1648, 1708}, // Channel 5
@@ -66,7 +88,14 @@ namespace SoundFlow.Modifiers
         };
 
         private const float FixedGain = 0.015f;
-        private const int MaxCombDelaySamples = 8000; // Max delay for comb filters (e.g. ~180ms @ 44.1kHz)
+
+        // Rows per comb ring: a power of two above the longest tuning at full modulation depth.
+        private const int CombLineLength = 2048;
+        private const int CombLineMask = CombLineLength - 1;
+
+        // The comb rows are processed as whole vectors when a vector evenly divides a row.
+        private static readonly bool UseVectors =
+            Vector.IsHardwareAccelerated && Vector<float>.Count <= NumCombs && NumCombs % Vector<float>.Count == 0;
 
         /// <summary>
         /// Initializes a new instance of the <see cref="AlgorithmicReverbModifier" /> class.
@@ -74,13 +103,40 @@ namespace SoundFlow.Modifiers
         public AlgorithmicReverbModifier(AudioFormat format)
         {
             _format = format;
-            //_combFilters = [];
-            //_allPassFilters = [];
-            //_preDelayBuffers = [];
-            //_preDelayIndices = [];
-            _lfoPhase = Array.Empty<float>();
-            _modulatedCombTuning = Array.Empty<float>();
-            UpdateParameters();
+            _channels = Math.Max(0, format.Channels);
+
+            _combLines = new float[_channels * CombLineLength * NumCombs];
+            _combWrite = new int[_channels];
+            _combDelays = new int[_channels * NumCombs];
+            _combFilterState = new float[_channels * NumCombs];
+
+            _allPassOffsets = new int[_channels * NumAllPasses];
+            _allPassLengths = new int[_channels * NumAllPasses];
+            _allPassIndices = new int[_channels * NumAllPasses];
+            var allPassTotal = 0;
+            for (var channel = 0; channel < _channels; channel++)
+            {
+                for (var i = 0; i < NumAllPasses; i++)
+                {
+                    var length = Math.Max(1, (int)AllPassTunings[channel % AllPassTunings.Length][i]);
+                    _allPassOffsets[channel * NumAllPasses + i] = allPassTotal;
+                    _allPassLengths[channel * NumAllPasses + i] = length;
+                    allPassTotal += length;
+                }
+            }
+            _allPassLines = new float[allPassTotal];
+
+            _preDelayLength = Math.Max(1, (int)(_format.SampleRate * 0.1f)); // Max 100ms
+            _preDelayLines = new float[_channels * _preDelayLength];
+            _preDelayIndices = new int[_channels];
+
+            _lfoPhase = new float[_channels];
+            _modulationCountdown = new int[_channels];
+            for (var channel = 0; channel < _channels; channel++)
+            {
+                _lfoPhase[channel] = channel * (MathF.PI / _channels);
+                UpdateCombDelays(channel);
+            }
         }
 
         /// <summary>
@@ -93,29 +149,21 @@ namespace SoundFlow.Modifiers
         }
 
         /// <summary>
-        /// Gets or sets the room size. Clamped between 0 and 1. Updates parameters when changed.
+        /// Gets or sets the room size (the comb feedback). Clamped between 0 and 1.
         /// </summary>
         public float RoomSize
         {
             get => _roomSize;
-            set
-            {
-                _roomSize = Math.Clamp(value, 0f, 1f);
-                UpdateReverbSettings();
-            }
+            set => _roomSize = Math.Clamp(value, 0f, 1f);
         }
 
         /// <summary>
-        /// Gets or sets the damping factor. Clamped between 0 and 1. Updates parameters when changed.
+        /// Gets or sets the damping factor. Clamped between 0 and 1.
         /// </summary>
         public float Damp
         {
             get => _damp;
-            set
-            {
-                _damp = Math.Clamp(value, 0f, 1f);
-                UpdateReverbSettings();
-            }
+            set => _damp = Math.Clamp(value, 0f, 1f);
         }
 
         /// <summary>
@@ -136,7 +184,7 @@ namespace SoundFlow.Modifiers
             set
             {
                 _preDelay = Math.Clamp(value, 0f, 100f);
-                _preDelaySamples = (int)(_preDelay * _format.SampleRate / 1000f);
+                _preDelaySamples = Math.Min(_preDelayLength - 1, (int)(_preDelay * _format.SampleRate / 1000f));
             }
         }
 
@@ -149,167 +197,109 @@ namespace SoundFlow.Modifiers
             set => _mix = Math.Clamp(value, 0f, 1f);
         }
 
-        private void UpdateReverbSettings()
+        /// <inheritdoc />
+        protected override void ProcessBlock(Span<float> buffer, int channels)
         {
-            foreach (var filter in _combFilters)
+            var processed = Math.Min(channels, _channels);
+            for (var channel = 0; channel < processed; channel++)
             {
-                if (filter == null) continue;
-                foreach (var innerFilter in filter)
-                {
-                    if (innerFilter != null)
-                    {
-                        innerFilter.Feedback = _roomSize;
-                        innerFilter.Damp = _damp;
-                    }
-                }
-            }
-        }
-
-        private void UpdateParameters()
-        {
-            var numChannels = _format.Channels;
-            var structureChanged = false;
-
-            // Ensure filter arrays are the correct size
-            if (_combFilters.Length != numChannels)
-            {
-                _combFilters = new CombFilter[numChannels][];
-                _modulatedCombTuning = new float[numChannels * NumCombs];
-                structureChanged = true;
-            }
-
-            if (_allPassFilters.Length != numChannels)
-            {
-                _allPassFilters = new AllPassFilter[numChannels][];
-                structureChanged = true;
-            }
-
-            for (var channel = 0; channel < numChannels; channel++)
-            {
-                if (structureChanged || _combFilters[channel] == null || _combFilters[channel].Length != NumCombs)
-                {
-                    var newChannelCombs = new CombFilter[NumCombs];
-                    for (var i = 0; i < NumCombs; i++)
-                    {
-                        var combTuning = CombTunings[channel % CombTunings.Length][i];
-                        _modulatedCombTuning[channel * NumCombs + i] = combTuning;
-                        newChannelCombs[i] = new CombFilter((int)combTuning)
-                        {
-                            Feedback = _roomSize,
-                            Damp = _damp
-                        };
-                    }
-                    _combFilters[channel] = newChannelCombs;
-                }
-                else // Filters exist, ensure parameters are up-to-date if UpdateParameters was called for other reasons
-                {
-                    for (var i = 0; i < NumCombs; i++)
-                    {
-                        // Re-assign base tuning in case it could change (though CombTunings is static)
-                        _modulatedCombTuning[channel * NumCombs + i] = CombTunings[channel % CombTunings.Length][i];
-                        _combFilters[channel][i].Feedback = _roomSize;
-                        _combFilters[channel][i].Damp = _damp;
-                    }
-                }
-
-                if (structureChanged || _allPassFilters[channel] == null || _allPassFilters[channel].Length != NumAllPasses)
-                {
-                    var newChannelAllPass = new AllPassFilter[NumAllPasses];
-                    for (var i = 0; i < NumAllPasses; i++)
-                    {
-                        newChannelAllPass[i] = new AllPassFilter((int)AllPassTunings[channel % AllPassTunings.Length][i]);
-                    }
-                    _allPassFilters[channel] = newChannelAllPass;
-                }
-            }
-
-            var maxPreDelaySamples = (int)(_format.SampleRate * 0.1f); // Max 100ms
-            maxPreDelaySamples = Math.Max(1, maxPreDelaySamples); // Ensure at least 1 sample
-
-            if (structureChanged || _preDelayBuffers.Length != numChannels || (_preDelayBuffers.Length > 0 && (_preDelayBuffers[0] == null || _preDelayBuffers[0].Length != maxPreDelaySamples)))
-            {
-                _preDelayBuffers = new float[numChannels][];
-                for (var channel = 0; channel < numChannels; channel++)
-                {
-                    _preDelayBuffers[channel] = new float[maxPreDelaySamples];
-                }
-            }
-
-            if (structureChanged || _preDelayIndices.Length != numChannels)
-            {
-                _preDelayIndices = new int[numChannels]; // Resets to 0
-            }
-
-            if (structureChanged || _lfoPhase.Length != numChannels)
-            {
-                var newLfoPhase = new float[numChannels];
-                for (var channel = 0; channel < numChannels; channel++)
-                {
-                    newLfoPhase[channel] = (numChannels > 0) ? channel * (MathF.PI / numChannels) : 0;
-                }
-                _lfoPhase = newLfoPhase;
-            }
-
-            // Update preDelaySamples based on current sample rate if not explicitly set yet
-            if (_preDelaySamples == 0 && _preDelay > 0)
-            {
-                _preDelaySamples = (int)(_preDelay * _format.SampleRate / 1000f);
+                for (var i = channel; i < buffer.Length; i += channels)
+                    buffer[i] = ProcessChannel(buffer[i], channel);
             }
         }
 
         /// <inheritdoc />
         public override float ProcessSample(float sample, int channel)
         {
-            if (channel < 0 || channel >= _format.Channels || channel >= _combFilters.Length) // Safety check
-            {
-                // This case should ideally not happen if AudioEngine.Channels is consistent
-                // Or could return 'sample' to bypass processing for misconfigured channels
+            if (channel < 0 || channel >= _channels) // Safety check
                 return sample;
-            }
 
-            var lfo = MathF.Sin(_lfoPhase[channel]) * ModulationDepth;
-            _lfoPhase[channel] += 2 * MathF.PI * ModulationRate / _format.SampleRate;
-            if (_lfoPhase[channel] > MathF.PI)
-                _lfoPhase[channel] -= 2 * MathF.PI;
+            return ProcessChannel(sample, channel);
+        }
+
+        private float ProcessChannel(float sample, int channel)
+        {
+            if (--_modulationCountdown[channel] <= 0)
+                UpdateCombDelays(channel);
 
             var input = sample * FixedGain;
 
-            if (_preDelaySamples > 0 && _preDelayBuffers[channel].Length > 0)
+            if (_preDelaySamples > 0)
             {
-                _preDelayBuffers[channel][_preDelayIndices[channel]] = input;
-                input = _preDelayBuffers[channel][(_preDelayIndices[channel] - _preDelaySamples + _preDelayBuffers[channel].Length) % _preDelayBuffers[channel].Length];
-                _preDelayIndices[channel] = (_preDelayIndices[channel] + 1) % _preDelayBuffers[channel].Length;
+                var line = channel * _preDelayLength;
+                var index = _preDelayIndices[channel];
+                _preDelayLines[line + index] = input;
+                var read = index - _preDelaySamples;
+                if (read < 0) read += _preDelayLength;
+                input = _preDelayLines[line + read];
+                _preDelayIndices[channel] = index + 1 == _preDelayLength ? 0 : index + 1;
             }
 
+            // Gather the delayed sample of every comb into one row.
+            var combBase = channel * CombLineLength * NumCombs;
+            var write = _combWrite[channel];
+            var delayBase = channel * NumCombs;
+            var row = _combRow;
+            for (var i = 0; i < NumCombs; i++)
+                row[i] = _combLines[combBase + ((write - _combDelays[delayBase + i]) & CombLineMask) * NumCombs + i];
 
-            float earlyReflectionsOutput = 0;
-            float reverbTailOutput = 0;
-
-            var channelCombs = _combFilters[channel];
-            if (channelCombs == null) return sample; // Should not happen if UpdateParameters is correct
+            var damp1 = _damp;
+            var damp2 = 1f - damp1;
+            var feedback = _roomSize;
+            var writeRow = combBase + write * NumCombs;
+            float earlyReflectionsOutput, reverbTailOutput;
 
-            for (var i = 0; i < NumCombs; i++)
+            if (UseVectors)
             {
-                var comb = channelCombs[i];
-                if (comb == null) continue; // Should not happen
+                var width = Vector<float>.Count;
+                var vDamp1 = new Vector<float>(damp1);
+                var vDamp2 = new Vector<float>(damp2);
+                var vFeedback = new Vector<float>(feedback);
+                var vInput = new Vector<float>(input);
+                var early = Vector<float>.Zero;
+                var tail = Vector<float>.Zero;
+                for (var i = 0; i < NumCombs; i += width)
+                {
+                    var output = new Vector<float>(row, i);
+                    var state = output * vDamp2 + new Vector<float>(_combFilterState, delayBase + i) * vDamp1;
+                    state.CopyTo(_combFilterState, delayBase + i);
+                    (vInput + state * vFeedback).CopyTo(_combLines, writeRow + i);
 
-                var modulatedDelay = _modulatedCombTuning[channel * NumCombs + i] * (1 + lfo);
-                comb.SetDelay((int)modulatedDelay);
+                    if (i < NumCombs / 2) early += output;
+                    tail += output;
+                }
 
-                var combOutput = comb.Process(input);
-                if (i < NumCombs / 2)
-                    earlyReflectionsOutput += combOutput;
-                reverbTailOutput += combOutput;
+                earlyReflectionsOutput = EarlySum(early, width);
+                reverbTailOutput = Vector.Dot(tail, Vector<float>.One);
+            }
+            else
+            {
+                earlyReflectionsOutput = 0;
+                reverbTailOutput = 0;
+                for (var i = 0; i < NumCombs; i++)
+                {
+                    var output = row[i];
+                    var state = output * damp2 + _combFilterState[delayBase + i] * damp1;
+                    _combFilterState[delayBase + i] = state;
+                    _combLines[writeRow + i] = input + state * feedback;
+
+                    if (i < NumCombs / 2)
+                        earlyReflectionsOutput += output;
+                    reverbTailOutput += output;
+                }
             }
 
-            var channelAllPasses = _allPassFilters[channel];
-            if (channelAllPasses == null) return sample; // Should not happen
+            _combWrite[channel] = (write + 1) & CombLineMask;
 
+            var allPassBase = channel * NumAllPasses;
             for (var i = 0; i < NumAllPasses; i++)
             {
-                var allPass = channelAllPasses[i];
-                if (allPass == null) continue; // Should not happen
-                reverbTailOutput = allPass.Process(reverbTailOutput);
+                var offset = _allPassOffsets[allPassBase + i];
+                var index = _allPassIndices[allPassBase + i];
+                var buffered = _allPassLines[offset + index];
+                _allPassLines[offset + index] = reverbTailOutput + buffered * 0.5f;
+                reverbTailOutput = -reverbTailOutput + buffered;
+                _allPassIndices[allPassBase + i] = index + 1 == _allPassLengths[allPassBase + i] ? 0 : index + 1;
             }
 
             var mixedOutput = earlyReflectionsOutput * (1 - _mix) + reverbTailOutput * _mix;
@@ -323,93 +313,36 @@ namespace SoundFlow.Modifiers
             return sample * (1 - _wet) + mixedOutput * _wet * (1 - spread);
         }
 
-        private class CombFilter
+        /// <summary>
+        /// Sums the lanes of <paramref name="early"/> that belong to the first half of the combs. When a vector
+        /// covers the whole row, those are only its lower lanes.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static float EarlySum(Vector<float> early, int width)
         {
-            private float[] _buffer;
-            private int _bufferIndex;
-            private float _feedback;
-            private float _damp1;
-            private float _damp2;
-            private float _lastOut;
-
-            public CombFilter(int initialDelay)
-            {
-                _feedback = 0.5f;
-                _damp1 = 0.5f;
-                _damp2 = 1f - _damp1;
-                _lastOut = 0f;
-                _bufferIndex = 0;
-                // Initialize buffer robustly
-                var clampedDelay = Math.Clamp(initialDelay, 1, MaxCombDelaySamples);
-                _buffer = new float[clampedDelay];
-            }
-
-            public float Feedback
-            {
-                get => _feedback;
-                set => _feedback = value;
-            }
-
-            public float Damp
-            {
-                get => _damp1;
-                set
-                {
-                    _damp1 = value;
-                    _damp2 = 1f - value;
-                }
-            }
-
-            [MethodImpl(MethodImplOptions.AggressiveInlining)]
-            public float Process(float input)
-            {
-                var output = _buffer[_bufferIndex];
-                _lastOut = (output * _damp2) + (_lastOut * _damp1);
-                _buffer[_bufferIndex] = input + _lastOut * _feedback;
-                _bufferIndex = (_bufferIndex + 1) % _buffer.Length;
-                return output;
-            }
+            if (width < NumCombs) return Vector.Dot(early, Vector<float>.One);
 
-            public void SetDelay(int delay)
-            {
-                delay = Math.Clamp(delay, 1, MaxCombDelaySamples);
-
-                if (_buffer.Length == delay)
-                    return;
-
-                // Reallocate buffer. This is expensive if called frequently per sample.
-                // For Freeverb-style LFO modulation on delay lines, a common approach is fixed-size buffer
-                // and modulated read pointers, or accepting slight artifacts/state reset.
-                _buffer = new float[delay];
-                Array.Clear(_buffer, 0, _buffer.Length); // Clear new buffer
-                _bufferIndex = 0; // Reset index
-                _lastOut = 0f; // Reset filter state
-            }
+            var sum = 0f;
+            for (var i = 0; i < NumCombs / 2; i++)
+                sum += early[i];
+            return sum;
         }
 
-        private class AllPassFilter
+        /// <summary>
+        /// Advances the modulation LFO of a channel by one update interval and recomputes its comb read offsets.
+        /// </summary>
+        private void UpdateCombDelays(int channel)
         {
-            private readonly float[] _buffer;
-            private int _bufferIndex;
-            private const float Feedback = 0.5f;
+            var lfo = MathF.Sin(_lfoPhase[channel]) * ModulationDepth;
+            _lfoPhase[channel] += 2 * MathF.PI * ModulationRate * ModulationInterval / Math.Max(1, _format.SampleRate);
+            if (_lfoPhase[channel] > MathF.PI)
+                _lfoPhase[channel] -= 2 * MathF.PI;
 
-            public AllPassFilter(int delay)
-            {
-                // Clamp delay to a reasonable range for AllPass filters
-                delay = Math.Clamp(delay, 1, MaxCombDelaySamples / 2); // Typically shorter than combs
-                _buffer = new float[delay];
-                _bufferIndex = 0;
-            }
+            var tunings = CombTunings[channel % CombTunings.Length];
+            for (var i = 0; i < NumCombs; i++)
+                _combDelays[channel * NumCombs + i] = Math.Clamp((int)(tunings[i] * (1 + lfo)), 1, CombLineLength - 1);
 
-            [MethodImpl(MethodImplOptions.AggressiveInlining)]
-            public float Process(float input)
-            {
-                var buffered = _buffer[_bufferIndex];
-                var output = -input + buffered;
-                _buffer[_bufferIndex] = input + buffered * Feedback;
-                _bufferIndex = (_bufferIndex + 1) % _buffer.Length;
-                return output;
-            }
+            _modulationCountdown[channel] = ModulationInterval;
         }
     }
-}
\ No newline at end of file
+}
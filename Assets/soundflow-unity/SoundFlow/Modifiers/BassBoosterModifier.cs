@@ -1,5 +1,5 @@
-﻿using SoundFlow.Abstracts;
-using SoundFlow.Structs;
+﻿using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Modifiers
@@ -7,21 +7,36 @@ namespace SoundFlow.Modifiers
     /// <summary>
     /// Boosts bass frequencies using a resonant low-pass filter.
     /// </summary>
-    public class BassBoosterModifier : SoundModifier
+    public class BassBoosterModifier : BiquadModifier
     {
+        private float _cutoff;
+        private float _boostGain;
+
         /// <summary>
         /// Gets or sets the cutoff frequency in Hertz.
         /// </summary>
-        public float Cutoff { get; set; }
+        public float Cutoff
+        {
+            get => _cutoff;
+            set
+            {
+                _cutoff = value;
+                InvalidateCoefficients();
+            }
+        }
 
         /// <summary>
         /// Gets or sets the boost gain in decibels.
         /// </summary>
-        public float BoostGain { get; set; }
-
-        private readonly float[] _lpState;
-        private readonly float[] _resonanceState;
-        private readonly AudioFormat _format;
+        public float BoostGain
+        {
+            get => _boostGain;
+            set
+            {
+                _boostGain = value;
+                InvalidateCoefficients();
+            }
+        }
 
         /// <summary>
         /// Initializes a new instance of the <see cref="BassBoosterModifier"/> class.
@@ -29,33 +44,23 @@ namespace SoundFlow.Modifiers
         /// <param name="format">The audio format to process.</param>
         /// <param name="cutoff">The cutoff frequency in Hertz.</param>
         /// <param name="boostGain">The boost gain in decibels.</param>
-        public BassBoosterModifier(AudioFormat format, float cutoff = 150f, float boostGain = 6f)
+        public BassBoosterModifier(AudioFormat format, float cutoff = 150f, float boostGain = 6f) : base(format, 1)
         {
-            _format = format;
             Cutoff = Math.Max(20, cutoff); // Minimum 20Hz
             BoostGain = MathF.Pow(10, boostGain / 20f); // Convert dB to linear
-            _lpState = new float[format.Channels];
-            _resonanceState = new float[format.Channels];
         }
 
         /// <inheritdoc />
-        public override float ProcessSample(float sample, int channel)
+        protected override void UpdateCoefficients(BiquadCascade cascade)
         {
-            // 1-pole low-pass with resonance
-            var dt = _format.InverseSampleRate;
-            var rc = 1f / (2 * MathF.PI * Cutoff);
-            var alpha = dt / (rc + dt);
-
-            // Low-pass filter
-            _lpState[channel] += alpha * (sample - _lpState[channel]);
-
-            // Add resonance feedback
-            var feedbackFactor = 0.5f * BoostGain;
-            feedbackFactor = Math.Min(0.95f, feedbackFactor); // Clamp to a max value less than 1
-            _resonanceState[channel] = _lpState[channel] + _resonanceState[channel] * feedbackFactor;
-
-            // Mix boosted bass with original
-            return sample + _resonanceState[channel];
+            // The booster adds a 1-pole low-pass (pole p) fed through a resonator (pole fb) back onto the dry signal:
+            // H = 1 + alpha / ((1 - p z^-1)(1 - fb z^-1)), which collapses into a single biquad section.
+            var alpha = BiquadCoefficients.OnePoleLowPassAlpha(Format.SampleRate, _cutoff);
+            var pole = 1 - alpha;
+            var feedbackFactor = Math.Min(0.95f, 0.5f * _boostGain); // Clamp to a max value less than 1
+            var sum = pole + feedbackFactor;
+            var product = pole * feedbackFactor;
+            cascade.SetCoefficients(0, new BiquadCoefficients(1 + alpha, -sum, product, -sum, product));
         }
     }
 }
\ No newline at end of file
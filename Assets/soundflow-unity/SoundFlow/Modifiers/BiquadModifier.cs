@@ -0,0 +1,93 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Structs;
+using SoundFlow.Utils;
+using System;
+
+namespace SoundFlow.Modifiers
+{
+    /// <summary>
+    /// Base class for linear filter modifiers that run on a shared <see cref="BiquadCascade"/>.
+    /// </summary>
+    /// <remarks>
+    /// Parameter setters call <see cref="InvalidateCoefficients"/>; the new design is computed once at the next
+    /// block boundary on the audio thread and ramped in over <see cref="BiquadCascade.GetDefaultSmoothingSamples"/>
+    /// frames, so the filters can be automated without clicks. The cascade is allocated up front for
+    /// <see cref="BiquadCascade.DefaultLaneCapacity"/> channels (or the format's, if more), so a change of channel
+    /// count only resets the filter state; only a graph with even more channels rebuilds it on the audio thread.
+    /// </remarks>
+    public abstract class BiquadModifier : SoundModifier
+    {
+        private readonly int _stages;
+        private BiquadCascade _cascade;
+        private int _channels;
+        private volatile bool _coefficientsChanged = true;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BiquadModifier"/> class.
+        /// </summary>
+        /// <param name="format">The audio format to process.</param>
+        /// <param name="stages">The number of biquad sections per channel.</param>
+        protected BiquadModifier(AudioFormat format, int stages)
+        {
+            Format = format;
+            _stages = stages;
+            _channels = Math.Max(1, format.Channels);
+            _cascade = new BiquadCascade(Math.Max(_channels, BiquadCascade.DefaultLaneCapacity), stages);
+        }
+
+        /// <summary>
+        /// Gets the audio format the modifier was created for.
+        /// </summary>
+        protected AudioFormat Format { get; }
+
+        /// <summary>
+        /// Marks the filter design as stale so it is recomputed at the next block boundary.
+        /// </summary>
+        protected void InvalidateCoefficients() => _coefficientsChanged = true;
+
+        /// <summary>
+        /// Computes the coefficients of every section from the current parameters.
+        /// </summary>
+        /// <param name="cascade">The cascade to update through <see cref="BiquadCascade.SetCoefficients(int, BiquadCoefficients)"/>.</param>
+        protected abstract void UpdateCoefficients(BiquadCascade cascade);
+
+        /// <inheritdoc />
+        protected override void BeginBlock(int channels)
+        {
+            if (channels != _channels)
+            {
+                if (channels > _cascade.Lanes)
+                    _cascade = new BiquadCascade(channels, _stages);
+                else
+                    _cascade.Reset();
+
+                // A new channel layout starts from silence, so the design applies at once rather than ramping.
+                _cascade.SmoothingSamples = 0;
+                _channels = channels;
+                _coefficientsChanged = true;
+            }
+
+            if (!_coefficientsChanged) return;
+            _coefficientsChanged = false;
+
+            // The first design is applied immediately; later changes are ramped.
+            UpdateCoefficients(_cascade);
+            _cascade.SmoothingSamples = BiquadCascade.GetDefaultSmoothingSamples(Format.SampleRate);
+        }
+
+        /// <inheritdoc />
+        protected override void ProcessBlock(Span<float> buffer, int channels)
+        {
+            _cascade.Process(buffer[..(buffer.Length - buffer.Length % channels)], channels);
+        }
+
+        /// <inheritdoc />
+        public override float ProcessSample(float sample, int channel)
+        {
+            if (_coefficientsChanged || channel >= _channels)
+                BeginBlock(Math.Max(_channels, channel + 1));
+
+            return _cascade.ProcessSample(sample, channel);
+        }
+    }
+}
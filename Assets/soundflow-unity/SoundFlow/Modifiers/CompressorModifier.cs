@@ -1,5 +1,7 @@
 ﻿using SoundFlow.Abstracts;
+using SoundFlow.Enums;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Modifiers
@@ -7,41 +9,85 @@ namespace SoundFlow.Modifiers
     /// <summary>
     /// A dynamic range compressor modifier.
     /// </summary>
+    /// <remarks>
+    /// A thin wrapper over <see cref="DynamicsProcessor"/>, which processes each block at once. Parameter changes
+    /// take effect at the next block.
+    /// </remarks>
     public class CompressorModifier : SoundModifier
     {
+        private readonly DynamicsProcessor _processor;
+
         /// <summary>
         /// The threshold level in dBFS (-inf to 0).
         /// </summary>
-        public float ThresholdDb { get; set; }
+        public float ThresholdDb
+        {
+            get => _processor.ThresholdDb;
+            set => _processor.ThresholdDb = value;
+        }
 
         /// <summary>
         /// The compression ratio (1:1 to inf:1).
         /// </summary>
-        public float Ratio { get; set; }
+        public float Ratio
+        {
+            get => _processor.Ratio;
+            set => _processor.Ratio = value;
+        }
 
         /// <summary>
         /// The attack time in milliseconds.
         /// </summary>
-        public float AttackMs { get; set; }
+        public float AttackMs
+        {
+            get => _processor.AttackMs;
+            set => _processor.AttackMs = value;
+        }
 
         /// <summary>
         /// The release time in milliseconds.
         /// </summary>
-        public float ReleaseMs { get; set; }
+        public float ReleaseMs
+        {
+            get => _processor.ReleaseMs;
+            set => _processor.ReleaseMs = value;
+        }
 
         /// <summary>
         /// The knee radius in dBFS. A knee radius of 0 is a hard knee.
         /// </summary>
-        public float KneeDb { get; set; }
+        public float KneeDb
+        {
+            get => _processor.KneeDb;
+            set => _processor.KneeDb = value;
+        }
 
         /// <summary>
         /// The make-up gain in dBFS.
         /// </summary>
-        public float MakeupGainDb { get; set; }
+        public float MakeupGainDb
+        {
+            get => _processor.MakeupGainDb;
+            set => _processor.MakeupGainDb = value;
+        }
 
-        private float _envelope;
-        private float _gain;
-        private readonly AudioFormat _format;
+        /// <summary>
+        /// The lookahead in milliseconds. The output is delayed by the same amount; 0 disables lookahead.
+        /// </summary>
+        public float LookaheadMs
+        {
+            get => _processor.LookaheadMs;
+            set => _processor.LookaheadMs = value;
+        }
+
+        /// <summary>
+        /// Whether the channels are compressed together or each on its own.
+        /// </summary>
+        public DynamicsLinking Linking
+        {
+            get => _processor.Linking;
+            set => _processor.Linking = value;
+        }
 
         /// <summary>
         /// Constructs a new instance of <see cref="CompressorModifier"/>.
@@ -55,49 +101,24 @@ namespace SoundFlow.Modifiers
         /// <param name="makeupGainDb">The makeup gain in dB.</param>
         public CompressorModifier(AudioFormat format, float thresholdDb, float ratio, float attackMs, float releaseMs, float kneeDb = 0, float makeupGainDb = 0)
         {
-            _format = format;
-            ThresholdDb = thresholdDb;
-            Ratio = ratio;
-            AttackMs = attackMs;
-            ReleaseMs = releaseMs;
-            KneeDb = kneeDb;
-            MakeupGainDb = makeupGainDb;
-            _gain = 1f;
+            _processor = new DynamicsProcessor(format.SampleRate)
+            {
+                ThresholdDb = thresholdDb,
+                Ratio = ratio,
+                AttackMs = attackMs,
+                ReleaseMs = releaseMs,
+                KneeDb = kneeDb,
+                MakeupGainDb = makeupGainDb
+            };
         }
 
         /// <inheritdoc />
-        public override float ProcessSample(float sample, int channel)
+        protected override void ProcessBlock(Span<float> buffer, int channels)
         {
-            // Convert to dB
-            var sampleDb = LinearToDb(MathF.Abs(sample));
-
-            // Calculate envelope with different attack/release
-            var alphaA = MathF.Exp(-1f / (AttackMs * 0.001f * _format.SampleRate));
-            var alphaR = MathF.Exp(-1f / (ReleaseMs * 0.001f * _format.SampleRate));
-
-            _envelope = sampleDb > _envelope
-                ? alphaA * _envelope + (1 - alphaA) * sampleDb
-                : alphaR * _envelope + (1 - alphaR) * sampleDb;
-
-            // Calculate gain reduction
-            var overshootDb = _envelope - ThresholdDb;
-            var reductionDb = 0f;
-
-            // Logarithmic Soft Knee
-            if (overshootDb > 0)
-                reductionDb = KneeDb > 0
-                    ? (Ratio - 1) / Ratio * KneeDb * MathF.Log10(1 + overshootDb / KneeDb)
-                    : overshootDb * (Ratio - 1) / Ratio; // Hard knee (or if kneeDb <= 0, treat as hard knee)
-
-            // Smooth gain changes
-            var targetGain = DbToLinear(-reductionDb + MakeupGainDb);
-            var alpha = reductionDb == 0 ? alphaR : alphaA;
-            _gain = alpha * _gain + (1 - alpha) * targetGain;
-
-            return sample * _gain;
+            _processor.Process(buffer[..(buffer.Length - buffer.Length % channels)], channels);
         }
 
-        private static float DbToLinear(float db) => MathF.Pow(10, db / 20f);
-        private static float LinearToDb(float linear) => 20f * MathF.Log10(linear);
+        /// <inheritdoc />
+        public override float ProcessSample(float sample, int channel) => _processor.ProcessSample(sample, channel);
     }
 }
\ No newline at end of file
@@ -1,16 +1,16 @@
-﻿using SoundFlow.Abstracts;
-using SoundFlow.Structs;
+﻿using SoundFlow.Structs;
+using SoundFlow.Utils;
+using System;
 
 namespace SoundFlow.Modifiers
 {
     /// <summary>
     /// A sound modifier that implements a frequency band modifier.
     /// </summary>
-    public class FrequencyBandModifier : SoundModifier
+    public class FrequencyBandModifier : BiquadModifier
     {
-        private readonly LowPassModifier _lowPass;
-        private readonly HighPassModifier _highPass;
-        private readonly AudioFormat _format;
+        private float _lowCutoffFrequency;
+        private float _highCutoffFrequency;
 
         /// <summary>
         /// Constructs a new instance of <see cref="FrequencyBandModifier"/>.
@@ -19,10 +19,10 @@ namespace SoundFlow.Modifiers
         /// <param name="lowCutoffFrequency">The low cutoff frequency in Hertz.</param>
         /// <param name="highCutoffFrequency">The high cutoff frequency in Hertz.</param>
         public FrequencyBandModifier(AudioFormat format, float lowCutoffFrequency, float highCutoffFrequency)
+            : base(format, 2)
         {
-            _format = format; // Store the format
-            _highPass = new HighPassModifier(format, lowCutoffFrequency);
-            _lowPass = new LowPassModifier(format, highCutoffFrequency);
+            LowCutoffFrequency = lowCutoffFrequency;
+            HighCutoffFrequency = highCutoffFrequency;
         }
 
         /// <summary>
@@ -31,8 +31,12 @@ namespace SoundFlow.Modifiers
         /// <value>This value ranges from 0.0 to <see cref="AudioFormat.SampleRate"/>.</value>
         public float HighCutoffFrequency
         {
-            get => _lowPass.CutoffFrequency;
-            set => _lowPass.CutoffFrequency = value;
+            get => _highCutoffFrequency;
+            set
+            {
+                _highCutoffFrequency = Math.Max(20, value); // Minimum 20Hz
+                InvalidateCoefficients();
+            }
         }
 
         /// <summary>
@@ -41,16 +45,20 @@ namespace SoundFlow.Modifiers
         /// <value>This value ranges from 0.0 to <see cref="AudioFormat.SampleRate"/>.</value>
         public float LowCutoffFrequency
         {
-            get => _highPass.CutoffFrequency;
-            set => _highPass.CutoffFrequency = value;
+            get => _lowCutoffFrequency;
+            set
+            {
+                _lowCutoffFrequency = Math.Max(20, value); // Minimum 20Hz
+                InvalidateCoefficients();
+            }
         }
 
         /// <inheritdoc/>
-        public override float ProcessSample(float sample, int channel)
+        protected override void UpdateCoefficients(BiquadCascade cascade)
         {
-            sample = _highPass.ProcessSample(sample, channel);
-            sample = _lowPass.ProcessSample(sample, channel);
-            return sample;
+            // High-pass at the low edge, then low-pass at the high edge.
+            cascade.SetCoefficients(0, BiquadCoefficients.OnePoleHighPass(Format.SampleRate, _lowCutoffFrequency));
+            cascade.SetCoefficients(1, BiquadCoefficients.OnePoleLowPass(Format.SampleRate, _highCutoffFrequency));
         }
     }
 }
\ No newline at end of file
@@ -1,5 +1,5 @@
-﻿using SoundFlow.Abstracts;
-using SoundFlow.Structs;
+﻿using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Modifiers
@@ -7,23 +7,17 @@ namespace SoundFlow.Modifiers
     /// <summary>
     /// A sound modifier that implements a high-pass filter.
     /// </summary>
-    public class HighPassModifier : SoundModifier
+    public class HighPassModifier : BiquadModifier
     {
-        private readonly float[] _previousOutput;
-        private readonly float[] _previousSample;
         private float _cutoffFrequency;
-        private readonly AudioFormat _format;
 
         /// <summary>
         /// Initializes a new instance of the <see cref="HighPassModifier"/> class.
         /// </summary>
         /// <param name="format">The audio format to process.</param>
         /// <param name="cutoffFrequency">The cutoff frequency of the filter.</param>
-        public HighPassModifier(AudioFormat format, float cutoffFrequency)
+        public HighPassModifier(AudioFormat format, float cutoffFrequency) : base(format, 1)
         {
-            _format = format;
-            _previousOutput = new float[format.Channels];
-            _previousSample = new float[format.Channels];
             CutoffFrequency = cutoffFrequency;
         }
 
@@ -33,19 +27,17 @@ namespace SoundFlow.Modifiers
         public float CutoffFrequency
         {
             get => _cutoffFrequency;
-            set => _cutoffFrequency = Math.Max(20, value); // Minimum 20Hz
+            set
+            {
+                _cutoffFrequency = Math.Max(20, value); // Minimum 20Hz
+                InvalidateCoefficients();
+            }
         }
 
         /// <inheritdoc />
-        public override float ProcessSample(float sample, int channel)
+        protected override void UpdateCoefficients(BiquadCascade cascade)
         {
-            var dt = _format.InverseSampleRate;
-            var rc = 1f / (2 * MathF.PI * _cutoffFrequency);
-            var alpha = rc / (rc + dt);
-            var output = alpha * (_previousOutput[channel] + sample - _previousSample[channel]);
-            _previousOutput[channel] = output;
-            _previousSample[channel] = sample;
-            return output;
+            cascade.SetCoefficients(0, BiquadCoefficients.OnePoleHighPass(Format.SampleRate, _cutoffFrequency));
         }
     }
 }
\ No newline at end of file
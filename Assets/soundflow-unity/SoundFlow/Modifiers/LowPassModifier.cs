@@ -1,5 +1,5 @@
-﻿using SoundFlow.Abstracts;
-using SoundFlow.Structs;
+﻿using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Modifiers
@@ -7,22 +7,18 @@ namespace SoundFlow.Modifiers
     /// <summary>
     /// A sound modifier that implements a low-pass filter.
     /// </summary>
-    public class LowPassModifier : SoundModifier
+    public class LowPassModifier : BiquadModifier
     {
-        private readonly float[] _previousOutput;
         private float _cutoffFrequency;
-        private readonly AudioFormat _format;
 
         /// <summary>
         /// Initializes a new instance of the <see cref="LowPassModifier"/> class.
         /// </summary>
         /// <param name="format">The audio format to process.</param>
         /// <param name="cutoffFrequency">The cutoff frequency of the filter.</param>
-        public LowPassModifier(AudioFormat format, float cutoffFrequency)
+        public LowPassModifier(AudioFormat format, float cutoffFrequency) : base(format, 1)
         {
-            _previousOutput = new float[format.Channels];
             CutoffFrequency = cutoffFrequency;
-            _format = format;
         }
 
         /// <summary>
@@ -31,17 +27,17 @@ namespace SoundFlow.Modifiers
         public float CutoffFrequency
         {
             get => _cutoffFrequency;
-            set => _cutoffFrequency = Math.Max(20, value); // Minimum 20Hz
+            set
+            {
+                _cutoffFrequency = Math.Max(20, value); // Minimum 20Hz
+                InvalidateCoefficients();
+            }
         }
 
         /// <inheritdoc />
-        public override float ProcessSample(float sample, int channel)
+        protected override void UpdateCoefficients(BiquadCascade cascade)
         {
-            var dt = _format.InverseSampleRate;
-            var rc = 1f / (2 * MathF.PI * _cutoffFrequency);
-            var alpha = dt / (rc + dt);
-            _previousOutput[channel] += alpha * (sample - _previousOutput[channel]);
-            return _previousOutput[channel];
+            cascade.SetCoefficients(0, BiquadCoefficients.OnePoleLowPass(Format.SampleRate, _cutoffFrequency));
         }
     }
 }
\ No newline at end of file
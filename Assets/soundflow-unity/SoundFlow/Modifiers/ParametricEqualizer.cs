@@ -1,7 +1,9 @@
 ﻿using SoundFlow.Abstracts;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.Collections.Generic;
+using System.Threading;
 
 namespace SoundFlow.Modifiers
 {
@@ -18,9 +20,16 @@ namespace SoundFlow.Modifiers
         /// </summary>
         public List<EqualizerBand> Bands { get; private set; } = new List<EqualizerBand>();
 
-        private readonly Dictionary<int, List<BiquadFilter>> _filtersPerChannel = new Dictionary<int, List<BiquadFilter>>();
         private readonly AudioFormat _format;
 
+        // One cascade stage per band, one lane per channel. A copy of the band parameters each stage was designed
+        // from is kept so edits to a band's properties are picked up at the next block boundary. Adding or removing
+        // bands builds the next layout on the caller's thread; the audio thread only swaps it in.
+        private const int ParametersPerBand = 5;
+        private Layout? _layout;
+        private volatile Layout? _pendingLayout;
+        private int _channels;
+
         /// <summary>
         /// Constructs a new instance of <see cref="ParametricEqualizer"/>.
         /// </summary>
@@ -28,63 +37,94 @@ namespace SoundFlow.Modifiers
         public ParametricEqualizer(AudioFormat format)
         {
             _format = format; // Store the format
+            _channels = Math.Max(1, format.Channels);
+            _pendingLayout = CreateLayout(_channels);
         }
 
         /// <summary>
-        /// Initializes the filters for each channel based on the current EQ bands.
+        /// Builds a cascade for the current EQ bands, with room for at least <paramref name="channels"/> channels.
         /// </summary>
-        private void InitializeFilters()
+        private Layout CreateLayout(int channels)
         {
-            _filtersPerChannel.Clear();
-            for (var channel = 0; channel < _format.Channels; channel++)
-            {
-                List<BiquadFilter> filters = new List<BiquadFilter>();
-                foreach (var band in Bands)
-                {
-                    var filter = new BiquadFilter();
-                    filter.UpdateCoefficients(band, _format.SampleRate);
-                    filters.Add(filter);
-                }
-
-                _filtersPerChannel[channel] = filters;
-            }
+            var bandCount = Bands.Count;
+            var layout = new Layout(new BiquadCascade(Math.Max(channels, BiquadCascade.DefaultLaneCapacity), bandCount),
+                new float[bandCount * ParametersPerBand]);
+            for (var band = 0; band < bandCount; band++)
+                UpdateBand(layout, band, Bands[band]);
+
+            // Bands are applied immediately on a rebuild; later edits ramp in.
+            layout.Cascade.SmoothingSamples = BiquadCascade.GetDefaultSmoothingSamples(_format.SampleRate);
+            return layout;
         }
 
-        /// <inheritdoc/>
-        public override void Process(Span<float> buffer, int channels)
+        private void UpdateBand(Layout layout, int index, EqualizerBand band)
         {
-            for (var i = 0; i < buffer.Length; i++)
-            {
-                var channel = i % _format.Channels;
-                buffer[i] = ProcessSample(buffer[i], channel);
-            }
+            var parameters = layout.BandParameters.AsSpan(index * ParametersPerBand, ParametersPerBand);
+            parameters[0] = (float)band.Type;
+            parameters[1] = band.Frequency;
+            parameters[2] = band.GainDb;
+            parameters[3] = band.Q;
+            parameters[4] = band.S;
+            layout.Cascade.SetCoefficients(index, band.GetCoefficients(_format.SampleRate));
+        }
+
+        private static bool HasBandChanged(Layout layout, int index, EqualizerBand band)
+        {
+            var parameters = layout.BandParameters.AsSpan(index * ParametersPerBand, ParametersPerBand);
+            return parameters[0] != (float)band.Type || parameters[1] != band.Frequency ||
+                   parameters[2] != band.GainDb || parameters[3] != band.Q || parameters[4] != band.S;
         }
 
         /// <inheritdoc/>
-        public override float ProcessSample(float sample, int channel)
+        protected override void BeginBlock(int channels)
         {
-            if (!_filtersPerChannel.TryGetValue(channel, out var value))
+            var pending = Interlocked.Exchange(ref _pendingLayout, null);
+            if (pending != null && channels <= pending.Cascade.Lanes)
             {
-                // Initialize filters for this channel if not already done
-                var filters = new List<BiquadFilter>();
-                foreach (var band in Bands)
-                {
-                    var filter = new BiquadFilter();
-                    filter.UpdateCoefficients(band, _format.SampleRate);
-                    filters.Add(filter);
-                }
-
-                value = filters;
-                _filtersPerChannel[channel] = value;
+                _layout = pending;
+                _channels = channels;
+                return;
             }
 
-            var processedSample = sample;
-            foreach (var filter in value)
+            var layout = _layout;
+            if (layout == null || channels > layout.Cascade.Lanes || Bands.Count != layout.Cascade.Stages)
             {
-                processedSample = filter.ProcessSample(processedSample);
+                // Bands edited in the list directly, or more channels than preallocated: the only rebuilds left
+                // on the audio thread.
+                _layout = CreateLayout(channels);
+                _channels = channels;
+                return;
             }
 
-            return processedSample;
+            if (channels != _channels)
+            {
+                layout.Cascade.Reset();
+                _channels = channels;
+            }
+
+            // Parameter edits only retarget the band's coefficients; the filter state carries across and the cascade
+            // interpolates towards the new design.
+            for (var band = 0; band < layout.Cascade.Stages; band++)
+            {
+                var current = Bands[band];
+                if (HasBandChanged(layout, band, current))
+                    UpdateBand(layout, band, current);
+            }
+        }
+
+        /// <inheritdoc/>
+        protected override void ProcessBlock(Span<float> buffer, int channels)
+        {
+            _layout!.Cascade.Process(buffer[..(buffer.Length - buffer.Length % channels)], channels);
+        }
+
+        /// <inheritdoc/>
+        public override float ProcessSample(float sample, int channel)
+        {
+            if (_pendingLayout != null || _layout == null || channel >= _channels)
+                BeginBlock(Math.Max(_channels, channel + 1));
+
+            return _layout!.Cascade.ProcessSample(sample, channel);
         }
 
         /// <summary>
@@ -94,7 +134,7 @@ namespace SoundFlow.Modifiers
         public void AddBands(IEnumerable<EqualizerBand> bands)
         {
             Bands.AddRange(bands);
-            InitializeFilters();
+            _pendingLayout = CreateLayout(_channels);
         }
 
         /// <summary>
@@ -104,7 +144,7 @@ namespace SoundFlow.Modifiers
         public void AddBand(EqualizerBand band)
         {
             Bands.Add(band);
-            InitializeFilters();
+            _pendingLayout = CreateLayout(_channels);
         }
 
         /// <summary>
@@ -114,7 +154,22 @@ namespace SoundFlow.Modifiers
         public void RemoveBand(EqualizerBand band)
         {
             Bands.Remove(band);
-            InitializeFilters();
+            _pendingLayout = CreateLayout(_channels);
+        }
+
+        /// <summary>
+        /// A cascade together with the band parameters its stages were designed from.
+        /// </summary>
+        private sealed class Layout
+        {
+            public readonly BiquadCascade Cascade;
+            public readonly float[] BandParameters;
+
+            public Layout(BiquadCascade cascade, float[] bandParameters)
+            {
+                Cascade = cascade;
+                BandParameters = bandParameters;
+            }
         }
     }
 
@@ -207,14 +262,38 @@ namespace SoundFlow.Modifiers
             this.Q = q;
             this.S = s;
         }
+
+        /// <summary>
+        /// Designs the biquad section for this band.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate of the audio data.</param>
+        /// <returns>The normalized section coefficients.</returns>
+        public BiquadCoefficients GetCoefficients(float sampleRate)
+        {
+            return Type switch
+            {
+                FilterType.Peaking => BiquadCoefficients.Peaking(sampleRate, Frequency, GainDb, Q),
+                FilterType.LowShelf => BiquadCoefficients.LowShelf(sampleRate, Frequency, GainDb, S),
+                FilterType.HighShelf => BiquadCoefficients.HighShelf(sampleRate, Frequency, GainDb, S),
+                FilterType.LowPass => BiquadCoefficients.LowPass(sampleRate, Frequency, Q),
+                FilterType.HighPass => BiquadCoefficients.HighPass(sampleRate, Frequency, Q),
+                FilterType.BandPass => BiquadCoefficients.BandPass(sampleRate, Frequency, Q),
+                FilterType.Notch => BiquadCoefficients.Notch(sampleRate, Frequency, Q),
+                FilterType.AllPass => BiquadCoefficients.AllPass(sampleRate, Frequency, Q),
+                _ => throw new NotImplementedException("Filter type not implemented")
+            };
+        }
     }
 
     /// <summary>
-    /// A biquad filter used to process audio samples.
+    /// A single-channel biquad filter used to process audio samples one at a time.
     /// </summary>
+    /// <remarks>
+    /// Block processing should use <see cref="BiquadCascade"/>, which runs many channels and sections at once.
+    /// </remarks>
     public class BiquadFilter
     {
-        private float _a0, _a1, _a2, _b0, _b1, _b2;
+        private BiquadCoefficients _coefficients = BiquadCoefficients.Identity;
         private float _x1, _x2, _y1, _y2;
 
         /// <summary>
@@ -224,109 +303,7 @@ namespace SoundFlow.Modifiers
         /// <param name="sampleRate">The sample rate of the audio data.</param>
         public void UpdateCoefficients(EqualizerBand band, float sampleRate)
         {
-            float a;
-            var omega = 2 * (float)Math.PI * band.Frequency / sampleRate;
-            var sinOmega = (float)Math.Sin(omega);
-            var cosOmega = (float)Math.Cos(omega);
-            float alpha;
-
-            switch (band.Type)
-            {
-                case FilterType.Peaking:
-                    a = (float)Math.Pow(10, band.GainDb / 40);
-                    alpha = sinOmega / (2 * band.Q);
-
-                    _b0 = 1 + alpha * a;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1 - alpha * a;
-                    _a0 = 1 + alpha / a;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1 - alpha / a;
-                    break;
-                case FilterType.LowShelf:
-                    a = (float)Math.Pow(10, band.GainDb / 40);
-                    var sqrtA = (float)Math.Sqrt(a);
-                    alpha = sinOmega / 2 * (float)Math.Sqrt((a + 1 / a) * (1 / band.S - 1) + 2);
-
-                    _b0 = a * ((a + 1) - (a - 1) * cosOmega + 2 * sqrtA * alpha);
-                    _b1 = 2 * a * ((a - 1) - (a + 1) * cosOmega);
-                    _b2 = a * ((a + 1) - (a - 1) * cosOmega - 2 * sqrtA * alpha);
-                    _a0 = (a + 1) + (a - 1) * cosOmega + 2 * sqrtA * alpha;
-                    _a1 = -2 * ((a - 1) + (a + 1) * cosOmega);
-                    _a2 = (a + 1) + (a - 1) * cosOmega - 2 * sqrtA * alpha;
-                    break;
-                case FilterType.HighShelf:
-                    a = (float)Math.Pow(10, band.GainDb / 40);
-                    sqrtA = (float)Math.Sqrt(a);
-                    alpha = sinOmega / 2 * (float)Math.Sqrt((a + 1 / a) * (1 / band.S - 1) + 2);
-
-                    _b0 = a * ((a + 1) + (a - 1) * cosOmega + 2 * sqrtA * alpha);
-                    _b1 = -2 * a * ((a - 1) + (a + 1) * cosOmega);
-                    _b2 = a * ((a + 1) + (a - 1) * cosOmega - 2 * sqrtA * alpha);
-                    _a0 = (a + 1) - (a - 1) * cosOmega + 2 * sqrtA * alpha;
-                    _a1 = 2 * ((a - 1) - (a + 1) * cosOmega);
-                    _a2 = (a + 1) - (a - 1) * cosOmega - 2 * sqrtA * alpha;
-                    break;
-                case FilterType.LowPass:
-                    alpha = sinOmega / (2 * band.Q);
-
-                    _b0 = (1 - cosOmega) / 2;
-                    _b1 = 1 - cosOmega;
-                    _b2 = (1 - cosOmega) / 2;
-                    _a0 = 1 + alpha;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1 - alpha;
-                    break;
-                case FilterType.HighPass:
-                    alpha = sinOmega / (2 * band.Q);
-
-                    _b0 = (1 + cosOmega) / 2;
-                    _b1 = -(1 + cosOmega);
-                    _b2 = (1 + cosOmega) / 2;
-                    _a0 = 1 + alpha;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1 - alpha;
-                    break;
-                case FilterType.BandPass:
-                    alpha = sinOmega / (2 * band.Q);
-
-                    _b0 = alpha;
-                    _b1 = 0;
-                    _b2 = -alpha;
-                    _a0 = 1 + alpha;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1 - alpha;
-                    break;
-                case FilterType.Notch:
-                    alpha = sinOmega / (2 * band.Q);
-
-                    _b0 = 1;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1;
-                    _a0 = 1 + alpha;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1 - alpha;
-                    break;
-                case FilterType.AllPass:
-                    alpha = sinOmega / (2 * band.Q);
-
-                    _b0 = 1 - alpha;
-                    _b1 = -2 * cosOmega;
-                    _b2 = 1 + alpha;
-                    _a0 = 1 + alpha;
-                    _a1 = -2 * cosOmega;
-                    _a2 = 1 - alpha;
-                    break;
-                default:
-                    throw new NotImplementedException("Filter type not implemented");
-            }
-
-            // Normalize the coefficients
-            _b0 /= _a0;
-            _b1 /= _a0;
-            _b2 /= _a0;
-            _a1 /= _a0;
-            _a2 /= _a0;
+            _coefficients = band.GetCoefficients(sampleRate);
         }
 
         /// <summary>
@@ -336,15 +313,7 @@ namespace SoundFlow.Modifiers
         /// <returns>The filtered output sample.</returns>
         public float ProcessSample(float x)
         {
-            var y = _b0 * x + _b1 * _x1 + _b2 * _x2 - _a1 * _y1 - _a2 * _y2;
-
-            // Shift the data
-            _x2 = _x1;
-            _x1 = x;
-            _y2 = _y1;
-            _y1 = y;
-
-            return y;
+            return _coefficients.Process(x, ref _x1, ref _x2, ref _y1, ref _y2);
         }
     }
 }
\ No newline at end of file
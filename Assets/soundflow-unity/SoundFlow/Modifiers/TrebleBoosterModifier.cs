@@ -1,5 +1,5 @@
-﻿using SoundFlow.Abstracts;
-using SoundFlow.Structs;
+﻿using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 
 namespace SoundFlow.Modifiers
@@ -7,11 +7,10 @@ namespace SoundFlow.Modifiers
     /// <summary>
     /// Boosts treble frequencies using a resonant high-pass filter.
     /// </summary>
-    public class TrebleBoosterModifier : SoundModifier
+    public class TrebleBoosterModifier : BiquadModifier
     {
-        private readonly float[] _hpState;
-        private readonly float[] _previousInput;
-        private readonly AudioFormat _format;
+        private float _cutoff;
+        private float _boostGain;
 
         /// <summary>
         /// Initializes a new instance of the <see cref="TrebleBoosterModifier"/> class.
@@ -19,40 +18,45 @@ namespace SoundFlow.Modifiers
         /// <param name="format">The audio format to process.</param>
         /// <param name="cutoff">The cutoff frequency of the high-pass filter.</param>
         /// <param name="boostGain">The gain of the boost.</param>
-        public TrebleBoosterModifier(AudioFormat format, float cutoff = 4000f, float boostGain = 6f)
+        public TrebleBoosterModifier(AudioFormat format, float cutoff = 4000f, float boostGain = 6f) : base(format, 1)
         {
-            _format = format;
             Cutoff = Math.Min(20000, cutoff);
             BoostGain = MathF.Pow(10, boostGain / 20f);
-            _hpState = new float[format.Channels];
-            _previousInput = new float[format.Channels];
         }
 
         /// <summary>
         /// Gets or sets the gain of the treble boost.
         /// </summary>
-        public float BoostGain { get; set; }
+        public float BoostGain
+        {
+            get => _boostGain;
+            set
+            {
+                _boostGain = value;
+                InvalidateCoefficients();
+            }
+        }
 
         /// <summary>
         /// Gets or sets the cutoff frequency of the high-pass filter.
         /// </summary>
-        public float Cutoff { get; set; }
+        public float Cutoff
+        {
+            get => _cutoff;
+            set
+            {
+                _cutoff = value;
+                InvalidateCoefficients();
+            }
+        }
 
         /// <inheritdoc />
-        public override float ProcessSample(float sample, int channel)
+        protected override void UpdateCoefficients(BiquadCascade cascade)
         {
-            // 1-pole high-pass with resonance
-            var dt = _format.InverseSampleRate;
-            var rc = 1f / (2 * MathF.PI * Cutoff);
-            var alpha = rc / (rc + dt);
-
-            // High-pass filter
-            var hp = alpha * (_hpState[channel] + sample - _previousInput[channel]);
-            _hpState[channel] = hp;
-            _previousInput[channel] = sample;
-
-            // Boost and mix
-            return sample + hp * BoostGain;
+            // Dry signal plus a boosted 1-pole high-pass: H = 1 + g * alpha (1 - z^-1) / (1 - alpha z^-1).
+            var alpha = BiquadCoefficients.OnePoleHighPassAlpha(Format.SampleRate, _cutoff);
+            var boosted = _boostGain * alpha;
+            cascade.SetCoefficients(0, new BiquadCoefficients(1 + boosted, -(alpha + boosted), 0, -alpha, 0));
         }
     }
 }
\ No newline at end of file
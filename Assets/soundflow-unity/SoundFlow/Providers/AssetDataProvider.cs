@@ -2,10 +2,9 @@ using SoundFlow.Abstracts;
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
-using System.Collections.Generic;
 using System.IO;
-using System.Linq;
 
 namespace SoundFlow.Providers
 {
@@ -13,10 +12,15 @@ namespace SoundFlow.Providers
     /// <summary>
     ///     Provides audio data from a file or stream.
     /// </summary>
-    /// <remarks>Loads full audio directly to memory.</remarks>
-    public sealed class AssetDataProvider : ISoundDataProvider
+    /// <remarks>
+    ///     Loads full audio directly to memory. Providers created from a file path or a cache key share one decoded
+    ///     buffer through the <see cref="DecodedAssetCache"/>, so spawning many players of the same sound decodes it once.
+    ///     Players read the decoded buffer in place through <see cref="ISampleSpanSource"/>.
+    /// </remarks>
+    public sealed class AssetDataProvider : ISoundDataProvider, ISampleSpanSource
     {
-        private float[] _data;
+        private ReadOnlyMemory<float> _data;
+        private DecodedAsset? _cachedAsset;
         private int _samplePosition;
 
         /// <summary>
@@ -27,11 +31,13 @@ namespace SoundFlow.Providers
         /// <param name="format">The audio format containing channels and sample rate and sample format</param>
         public AssetDataProvider(AudioEngine engine, AudioFormat format, Stream stream)
         {
-            var decoder = engine.CreateDecoder(stream, format);
-            _data = Decode(decoder);
-            decoder.Dispose();
-            SampleRate = decoder.SampleRate;
-            Length = _data.Length;
+            Clock = new PositionClock(this);
+            using var decoder = engine.CreateDecoder(stream, format);
+            var asset = DecodedAsset.Decode(decoder);
+            _data = asset.Samples;
+            SampleFormat = asset.SampleFormat;
+            SampleRate = asset.SampleRate;
+            Length = asset.Length;
         }
 
         /// <summary>
@@ -45,6 +51,42 @@ namespace SoundFlow.Providers
         {
         }
 
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="AssetDataProvider" /> class that shares decoded
+        ///     samples with every other provider created for the same file and format.
+        /// </summary>
+        /// <param name="engine">The audio engine instance.</param>
+        /// <param name="format">The audio format containing channels and sample rate and sample format</param>
+        /// <param name="filePath">The path to the audio file. Only read when the file is not already cached.</param>
+        public AssetDataProvider(AudioEngine engine, AudioFormat format, string filePath)
+            : this(DecodedAssetCache.Acquire(engine, format, Path.GetFullPath(filePath),
+                () => new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.Read)), true)
+        {
+        }
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="AssetDataProvider" /> class that shares decoded
+        ///     samples with every other provider created for the same cache key and format.
+        /// </summary>
+        /// <param name="engine">The audio engine instance.</param>
+        /// <param name="format">The audio format containing channels and sample rate and sample format</param>
+        /// <param name="stream">The stream to read audio data from. Only read on a cache miss, and never disposed.</param>
+        /// <param name="cacheKey">A key that uniquely identifies the content of <paramref name="stream"/>.</param>
+        public AssetDataProvider(AudioEngine engine, AudioFormat format, Stream stream, string cacheKey)
+            : this(DecodedAssetCache.Acquire(engine, format, cacheKey, () => stream, disposeStream: false), true)
+        {
+        }
+
+        private AssetDataProvider(DecodedAsset asset, bool cached)
+        {
+            Clock = new PositionClock(this);
+            _cachedAsset = cached ? asset : null;
+            _data = asset.Samples;
+            SampleFormat = asset.SampleFormat;
+            SampleRate = asset.SampleRate;
+            Length = asset.Length;
+        }
+
         /// <inheritdoc />
         public int Position => _samplePosition;
 
@@ -67,68 +109,55 @@ namespace SoundFlow.Providers
         public event EventHandler<EventArgs>? EndOfStreamReached;
 
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
 
         /// <inheritdoc />
         public int ReadBytes(Span<float> buffer)
         {
             var samplesToRead = Math.Min(buffer.Length, _data.Length - _samplePosition);
-            _data.AsSpan(_samplePosition, samplesToRead).CopyTo(buffer);
+            _data.Span.Slice(_samplePosition, samplesToRead).CopyTo(buffer);
 
             _samplePosition += samplesToRead;
 
             if (_samplePosition >= _data.Length)
                 EndOfStreamReached?.Invoke(this, EventArgs.Empty);
 
-            PositionChanged?.Invoke(this, new PositionChangedEventArgs(_samplePosition));
+            Clock.Publish(_samplePosition, samplesToRead > 0);
 
             return samplesToRead;
         }
 
         /// <inheritdoc />
-        public void Seek(int sampleOffset)
-        {
-            _samplePosition = Math.Clamp(sampleOffset, 0, _data.Length);
-            PositionChanged?.Invoke(this, new PositionChangedEventArgs(_samplePosition));
-        }
+        public bool CanReadInPlace => !IsDisposed;
 
-        private float[] Decode(ISoundDecoder decoder)
+        /// <inheritdoc />
+        public ReadOnlySpan<float> PeekSamples(int sampleCount)
         {
-            SampleFormat = decoder.SampleFormat;
-            return decoder.Length > 0 ? DecodeKnownLength(decoder) : DecodeUnknownLength(decoder);
+            sampleCount = Math.Clamp(sampleCount, 0, _data.Length - _samplePosition);
+            return _data.Span.Slice(_samplePosition, sampleCount);
         }
 
-        private static float[] DecodeKnownLength(ISoundDecoder decoder)
+        /// <inheritdoc />
+        public void Advance(int sampleCount)
         {
-            var samples = new float[decoder.Length];
-            var read = decoder.Decode(samples);
-            if (read != decoder.Length)
-                throw new InvalidOperationException($"Decoding error: Read {read}, expected {decoder.Length} samples.");
-            return samples;
+            if (sampleCount <= 0) return;
+
+            _samplePosition = Math.Min(_samplePosition + sampleCount, _data.Length);
+            Clock.Publish(_samplePosition);
         }
 
-        private static float[] DecodeUnknownLength(ISoundDecoder decoder)
+        /// <inheritdoc />
+        public void Seek(int sampleOffset)
         {
-            const int blockSize = 22050;
-            var blocks = new List<float[]>();
-            int samplesRead;
-            do
-            {
-                var block = new float[blockSize * decoder.Channels];
-                samplesRead = decoder.Decode(block);
-                if (samplesRead > 0) blocks.Add(block);
-            } while (samplesRead == blockSize * decoder.Channels);
-
-            var totalSamples = blocks.Sum(block => block.Length);
-            var samples = new float[totalSamples];
-            var offset = 0;
-            foreach (var block in blocks)
-            {
-                block.CopyTo(samples, offset);
-                offset += block.Length;
-            }
-            return samples;
-
+            _samplePosition = Math.Clamp(sampleOffset, 0, _data.Length);
+            Clock.Publish(_samplePosition, false);
         }
 
         /// <inheritdoc />
@@ -136,8 +165,14 @@ namespace SoundFlow.Providers
         {
             if (IsDisposed) return;
 
-            // Dispose of _data
-            _data = null!;
+            // Drop the samples, handing a shared buffer back to the cache
+            _data = ReadOnlyMemory<float>.Empty;
+            if (_cachedAsset != null)
+            {
+                DecodedAssetCache.Release(_cachedAsset);
+                _cachedAsset = null;
+            }
+            Clock.Dispose();
             IsDisposed = true;
         }
 
@@ -2,10 +2,10 @@
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
-using System.Buffers;
-using System.Collections.Generic;
 using System.IO;
+using System.Threading;
 
 namespace SoundFlow.Providers
 {
@@ -14,10 +14,15 @@ namespace SoundFlow.Providers
     /// </summary>
     /// <remarks>
     ///     Efficiently handles large audio files by reading and decoding audio data in manageable chunks.
+    ///     By default chunks are decoded on demand inside <see cref="ReadBytes"/>. When a prefetch depth is given, a
+    ///     background thread keeps that much decoded audio ready ahead of the read position, so the audio thread only
+    ///     copies samples and never touches the decoder or the underlying stream.
     /// </remarks>
     public sealed class ChunkedDataProvider : ISoundDataProvider
     {
         private const int DefaultChunkSize = 220500; // Number of samples per channel (2205 ms at 44.1 kHz = 220500 samples = 10 second)
+        private const int ReadAheadBlocksPerPrefetch = 4;
+        private const int ReadAheadIdleWaitMilliseconds = 10;
 
         private readonly Stream _stream;
         private ISoundDecoder _decoder;
@@ -25,12 +30,28 @@ namespace SoundFlow.Providers
         private readonly AudioEngine _engine;
         private readonly AudioFormat _format;
 
-        private readonly Queue<float> _buffer = new();
+        private readonly SpscRingBuffer _buffer;
+        private readonly float[] _decodeBuffer;
         private bool _isEndOfStream;
         private int _samplePosition;
 
         private readonly object _lock = new();
 
+        // Read-ahead state. The worker owns the decoder and is the ring's producer; ReadBytes is its consumer.
+        // A seek bumps _seekGeneration; the worker repositions the decoder, records how far the consumer must skip
+        // (_flushMark) and then publishes _readyGeneration.
+        private readonly Thread? _readAheadThread;
+        private readonly AutoResetEvent? _readAheadSignal;
+        private volatile bool _stopReadAhead;
+        private int _seekGeneration;
+        private int _readyGeneration;
+        private int _appliedGeneration;
+        private int _endedGeneration = -1;
+        private int _pendingSeekOffset;
+        private readonly int _lowWaterMark;
+        private long _flushMark;
+        private long _starvationCount;
+
         /// <summary>
         ///     Initializes a new instance of the <see cref="ChunkedDataProvider" /> class.
         /// </summary>
@@ -38,24 +59,57 @@ namespace SoundFlow.Providers
         /// <param name="format">The audio format containing channels and sample rate and sample format</param>
         /// <param name="stream">The stream to read audio data from.</param>
         /// <param name="chunkSize">The number of samples to read in each chunk.</param>
-        public ChunkedDataProvider(AudioEngine engine, AudioFormat format, Stream stream, int chunkSize = DefaultChunkSize)
+        /// <param name="prefetchMilliseconds">
+        ///     The amount of decoded audio, in milliseconds, a background thread keeps ready ahead of the read position.
+        ///     Zero (the default) decodes synchronously inside <see cref="ReadBytes"/>.
+        /// </param>
+        public ChunkedDataProvider(AudioEngine engine, AudioFormat format, Stream stream, int chunkSize = DefaultChunkSize,
+            int prefetchMilliseconds = 0)
         {
             if (chunkSize <= 0)
                 throw new ArgumentOutOfRangeException(nameof(chunkSize), "Chunk size must be greater than zero.");
+            if (prefetchMilliseconds < 0)
+                throw new ArgumentOutOfRangeException(nameof(prefetchMilliseconds), "Prefetch depth cannot be negative.");
 
             _engine = engine;
             _format = format;
             _stream = stream ?? throw new ArgumentNullException(nameof(stream));
             _chunkSize = chunkSize;
+            Clock = new PositionClock(this);
 
             _decoder = _engine.CreateDecoder(_stream, format);
 
             SampleFormat = _decoder.SampleFormat;
             SampleRate = _decoder.SampleRate;
             CanSeek = _stream.CanSeek;
+            PrefetchMilliseconds = prefetchMilliseconds;
+
+            var channels = Math.Max(1, _decoder.Channels);
+            if (prefetchMilliseconds == 0)
+            {
+                _decodeBuffer = new float[_chunkSize * channels];
+                _buffer = new SpscRingBuffer(_decodeBuffer.Length);
+
+                // Begin prefetching data
+                FillBuffer();
+                return;
+            }
+
+            // Decode in blocks small enough that several fit in the prefetch window, so the worker tops it up steadily.
+            var prefetchFrames = Math.Max(1, (int)((long)SampleRate * prefetchMilliseconds / 1000));
+            var blockFrames = Math.Min(_chunkSize, Math.Max(1, prefetchFrames / ReadAheadBlocksPerPrefetch));
+            _decodeBuffer = new float[blockFrames * channels];
+            _buffer = new SpscRingBuffer(Math.Max(prefetchFrames * channels, _decodeBuffer.Length));
+            // The worker only decodes once a whole block fits, so waking it any earlier is wasted.
+            _lowWaterMark = _buffer.Capacity - _decodeBuffer.Length;
 
-            // Begin prefetching data
-            FillBuffer();
+            _readAheadSignal = new AutoResetEvent(false);
+            _readAheadThread = new Thread(ReadAheadLoop)
+            {
+                IsBackground = true,
+                Name = "SoundFlow ChunkedDataProvider Read-Ahead"
+            };
+            _readAheadThread.Start();
         }
 
         /// <summary>
@@ -65,22 +119,19 @@ namespace SoundFlow.Providers
         /// <param name="format">The audio format containing channels and sample rate and sample format</param>
         /// <param name="filePath">The path to the file to read audio data from.</param>
         /// <param name="chunkSize">The number of samples to read in each chunk.</param>
-        public ChunkedDataProvider(AudioEngine engine, AudioFormat format, string filePath, int chunkSize = DefaultChunkSize)
-            : this(engine, format, new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.Read), chunkSize)
+        /// <param name="prefetchMilliseconds">
+        ///     The amount of decoded audio, in milliseconds, a background thread keeps ready ahead of the read position.
+        ///     Zero (the default) decodes synchronously inside <see cref="ReadBytes"/>.
+        /// </param>
+        public ChunkedDataProvider(AudioEngine engine, AudioFormat format, string filePath, int chunkSize = DefaultChunkSize,
+            int prefetchMilliseconds = 0)
+            : this(engine, format, new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.Read), chunkSize,
+                prefetchMilliseconds)
         {
         }
 
         /// <inheritdoc />
-        public int Position
-        {
-            get
-            {
-                lock (_lock)
-                {
-                    return _samplePosition;
-                }
-            }
-        }
+        public int Position => Volatile.Read(ref _samplePosition);
 
         /// <inheritdoc />
         public int Length => _decoder.Length;
@@ -97,16 +148,41 @@ namespace SoundFlow.Providers
         /// <inheritdoc />
         public bool IsDisposed { get; private set; }
 
+        /// <summary>
+        ///     Gets the read-ahead depth in milliseconds, or zero if chunks are decoded synchronously.
+        /// </summary>
+        public int PrefetchMilliseconds { get; }
+
+        /// <summary>
+        ///     Gets the number of decoded samples currently waiting to be read.
+        /// </summary>
+        public int BufferedSamples => _buffer.Count;
+
+        /// <summary>
+        ///     Gets the number of times <see cref="ReadBytes"/> had to pad its output with silence because the
+        ///     read-ahead thread had not decoded enough audio yet. Always zero in synchronous mode.
+        /// </summary>
+        public long StarvationCount => Interlocked.Read(ref _starvationCount);
+
         /// <inheritdoc />
         public event EventHandler<EventArgs>? EndOfStreamReached;
 
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
 
         /// <inheritdoc />
         public int ReadBytes(Span<float> buffer)
         {
             if (IsDisposed) return 0;
+            if (_readAheadThread != null) return ReadFromReadAhead(buffer);
+
             var samplesRead = 0;
 
             lock (_lock)
@@ -133,24 +209,44 @@ namespace SoundFlow.Providers
                         }
                     }
 
-                    buffer[samplesRead++] = _buffer.Dequeue();
+                    samplesRead += _buffer.Read(buffer[samplesRead..]);
                 }
 
                 _samplePosition += samplesRead;
 
-                PositionChanged?.Invoke(this, new PositionChangedEventArgs(_samplePosition));
+                Clock.Publish(_samplePosition, samplesRead > 0);
             }
 
             return samplesRead;
         }
 
         /// <inheritdoc />
+        /// <remarks>
+        ///     With read-ahead enabled the seek is handed to the background thread, which discards any in-flight
+        ///     prefetch and repositions the decoder. Reads return silence until audio from the new position is ready.
+        /// </remarks>
         public void Seek(int sampleOffset)
         {
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
             if (!CanSeek)
                 throw new NotSupportedException("Seeking is not supported on the underlying stream or decoder.");
 
+            if (_readAheadThread != null)
+            {
+                sampleOffset = Math.Clamp(sampleOffset, 0, Length);
+
+                lock (_lock)
+                {
+                    Volatile.Write(ref _pendingSeekOffset, sampleOffset);
+                    Interlocked.Increment(ref _seekGeneration);
+                    Volatile.Write(ref _samplePosition, sampleOffset);
+                }
+
+                _readAheadSignal!.Set();
+                Clock.Publish(sampleOffset, false);
+                return;
+            }
+
             lock (_lock)
             {
                 // Clamp the sample offset to valid range
@@ -171,57 +267,171 @@ namespace SoundFlow.Providers
                 // Update the sample position
                 _samplePosition = sampleOffset;
 
-                PositionChanged?.Invoke(this, new PositionChangedEventArgs(_samplePosition));
+                Clock.Publish(_samplePosition, false);
 
                 // Refill the buffer from the new position
                 FillBuffer();
             }
         }
 
-        private void FillBuffer()
+        private int ReadFromReadAhead(Span<float> buffer)
         {
-            if (IsDisposed)
-                return;
+            var requested = Volatile.Read(ref _seekGeneration);
+            var ready = Volatile.Read(ref _readyGeneration);
+            if (ready != requested)
+            {
+                // A seek is still being serviced; whatever is buffered belongs to the old position.
+                buffer.Clear();
+                return buffer.Length;
+            }
 
-            var samplesToRead = _chunkSize * _decoder.Channels;
-            var buffer = ArrayPool<float>.Shared.Rent(samplesToRead);
+            if (ready != _appliedGeneration)
+            {
+                var stale = Volatile.Read(ref _flushMark) - _buffer.TotalRead;
+                if (stale > 0) _buffer.AdvanceRead((int)stale);
+                _appliedGeneration = ready;
+            }
 
-            try
+            // Sample the end flag before reading so every sample decoded ahead of it is visible.
+            var decoderEnded = Volatile.Read(ref _endedGeneration) == ready;
+            var buffered = _buffer.Count;
+            var samplesRead = _buffer.Read(buffer);
+
+            // A seek that raced with the copy may have landed before it; the samples belong to the old position,
+            // and the seek has already published its own.
+            if (Volatile.Read(ref _seekGeneration) != requested)
+            {
+                buffer.Clear();
+                _readAheadSignal!.Set();
+                return buffer.Length;
+            }
+
+            var samplesReturned = samplesRead;
+            var starved = samplesRead < buffer.Length && !(decoderEnded && _buffer.Count == 0);
+            if (starved)
+            {
+                buffer[samplesRead..].Clear();
+                samplesReturned = buffer.Length;
+                Interlocked.Increment(ref _starvationCount);
+            }
+
+            // Wake the worker only when this read made room for a block, not on every audio callback.
+            if (starved || (buffered > _lowWaterMark && buffered - samplesRead <= _lowWaterMark))
+                _readAheadSignal!.Set();
+
+            var position = Volatile.Read(ref _samplePosition) + samplesRead;
+            if (Volatile.Read(ref _seekGeneration) == requested)
             {
-                var samplesRead = _decoder.Decode(buffer);
+                Volatile.Write(ref _samplePosition, position);
+                Clock.Publish(position, samplesRead > 0);
+            }
+
+            if (samplesReturned < buffer.Length)
+                EndOfStreamReached?.Invoke(this, EventArgs.Empty);
+
+            return samplesReturned;
+        }
 
-                if (samplesRead > 0)
+        private void ReadAheadLoop()
+        {
+            var handledGeneration = 0;
+            var decoderEnded = false;
+
+            while (!_stopReadAhead)
+            {
+                var generation = Volatile.Read(ref _seekGeneration);
+                if (generation != handledGeneration)
                 {
-                    for (var i = 0; i < samplesRead; i++)
+                    var offset = Volatile.Read(ref _pendingSeekOffset);
+                    try
                     {
-                        _buffer.Enqueue(buffer[i]);
+                        _decoder.Dispose();
+                        _decoder = _engine.CreateDecoder(_stream, _format);
+                        _decoder.Seek(offset);
+                        decoderEnded = false;
                     }
+                    catch (Exception)
+                    {
+                        decoderEnded = true;
+                    }
+
+                    // Everything written so far predates the seek and must be skipped by the reader.
+                    Volatile.Write(ref _flushMark, _buffer.TotalWritten);
+                    Volatile.Write(ref _endedGeneration, decoderEnded ? generation : -1);
+                    Volatile.Write(ref _readyGeneration, generation);
+                    handledGeneration = generation;
+                    continue;
                 }
-                else
+
+                if (!decoderEnded && _buffer.FreeSpace >= _decodeBuffer.Length)
                 {
-                    _isEndOfStream = true;
+                    int samplesDecoded;
+                    try
+                    {
+                        samplesDecoded = _decoder.Decode(_decodeBuffer);
+                    }
+                    catch (Exception)
+                    {
+                        samplesDecoded = 0;
+                    }
+
+                    // A seek arrived mid-decode; drop the block and reposition first.
+                    if (Volatile.Read(ref _seekGeneration) != generation) continue;
+
+                    if (samplesDecoded > 0)
+                    {
+                        _buffer.Write(_decodeBuffer.AsSpan(0, samplesDecoded));
+                    }
+                    else
+                    {
+                        decoderEnded = true;
+                        Volatile.Write(ref _endedGeneration, generation);
+                    }
+
+                    continue;
                 }
-            }
-            finally
-            {
-                ArrayPool<float>.Shared.Return(buffer);
+
+                _readAheadSignal!.WaitOne(ReadAheadIdleWaitMilliseconds);
             }
         }
 
+        private void FillBuffer()
+        {
+            if (IsDisposed)
+                return;
+
+            // Only called once the ring has drained, so a whole chunk always fits.
+            var samplesRead = _decoder.Decode(_decodeBuffer);
+
+            if (samplesRead > 0)
+                _buffer.Write(_decodeBuffer.AsSpan(0, samplesRead));
+            else
+                _isEndOfStream = true;
+        }
+
         /// <inheritdoc />
         public void Dispose()
         {
             if (IsDisposed)
                 return;
 
+            if (_readAheadThread != null)
+            {
+                // The signal is left to the finalizer so a reader racing with Dispose never touches a disposed handle.
+                IsDisposed = true;
+                _stopReadAhead = true;
+                _readAheadSignal!.Set();
+                _readAheadThread.Join();
+            }
+
             lock (_lock)
             {
                 _decoder.Dispose();
                 _stream.Dispose();
-                _buffer.Clear();
+                Clock.Dispose();
 
                 IsDisposed = true;
             }
         }
     }
-}
\ No newline at end of file
+}
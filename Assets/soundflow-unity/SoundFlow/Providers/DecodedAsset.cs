@@ -0,0 +1,102 @@
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using System;
+
+namespace SoundFlow.Providers
+{
+    /// <summary>
+    ///     A fully decoded audio asset held by the <see cref="DecodedAssetCache"/> and shared by every
+    ///     <see cref="AssetDataProvider"/> that plays it.
+    /// </summary>
+    /// <remarks>
+    ///     The samples are exposed read-only. Each provider holds one reference, acquired from the cache and
+    ///     released on dispose; unreferenced assets stay cached until evicted by the memory budget.
+    /// </remarks>
+    public sealed class DecodedAsset
+    {
+        private const int InitialBlockFrames = 22050;
+
+        private readonly float[] _buffer;
+
+        // The cache entry that owns this asset, if it was handed out by the DecodedAssetCache.
+        internal object? CacheEntry;
+
+        internal DecodedAsset(float[] buffer, int length, SampleFormat sampleFormat, int sampleRate, int channels)
+        {
+            _buffer = buffer;
+            Length = length;
+            SampleFormat = sampleFormat;
+            SampleRate = sampleRate;
+            Channels = channels;
+        }
+
+        /// <summary>
+        ///     Gets the decoded interleaved samples.
+        /// </summary>
+        public ReadOnlyMemory<float> Samples => new(_buffer, 0, Length);
+
+        /// <summary>
+        ///     Gets the number of decoded samples.
+        /// </summary>
+        public int Length { get; }
+
+        /// <summary>
+        ///     Gets the sample format reported by the decoder.
+        /// </summary>
+        public SampleFormat SampleFormat { get; }
+
+        /// <summary>
+        ///     Gets the sample rate reported by the decoder.
+        /// </summary>
+        public int SampleRate { get; }
+
+        /// <summary>
+        ///     Gets the channel count reported by the decoder.
+        /// </summary>
+        public int Channels { get; }
+
+        /// <summary>
+        ///     Gets the number of bytes of sample memory held by this asset.
+        /// </summary>
+        public long SizeInBytes => (long)_buffer.Length * sizeof(float);
+
+        /// <summary>
+        ///     Decodes the whole stream of <paramref name="decoder"/> into a new asset.
+        /// </summary>
+        /// <param name="decoder">The decoder to drain.</param>
+        /// <returns>The decoded asset.</returns>
+        /// <remarks>
+        ///     Streams of known length are decoded into an exactly sized buffer. Otherwise samples are decoded straight
+        ///     into a single buffer that doubles as needed, and which is trimmed to the decoded length at the end so a
+        ///     cached asset never holds up to twice its size.
+        /// </remarks>
+        public static DecodedAsset Decode(ISoundDecoder decoder)
+        {
+            var channels = Math.Max(1, decoder.Channels);
+
+            if (decoder.Length > 0)
+            {
+                var samples = new float[decoder.Length];
+                var read = decoder.Decode(samples);
+                if (read != decoder.Length)
+                    throw new InvalidOperationException($"Decoding error: Read {read}, expected {decoder.Length} samples.");
+                return new DecodedAsset(samples, read, decoder.SampleFormat, decoder.SampleRate, channels);
+            }
+
+            var buffer = new float[InitialBlockFrames * channels];
+            var filled = 0;
+            int samplesRead;
+            while ((samplesRead = decoder.Decode(buffer.AsSpan(filled))) > 0)
+            {
+                filled += samplesRead;
+                if (filled == buffer.Length)
+                    Array.Resize(ref buffer, buffer.Length * 2);
+            }
+
+            if (filled < buffer.Length)
+                Array.Resize(ref buffer, filled);
+
+            return new DecodedAsset(buffer, filled, decoder.SampleFormat, decoder.SampleRate, channels);
+        }
+    }
+}
@@ -0,0 +1,226 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Enums;
+using SoundFlow.Structs;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+
+namespace SoundFlow.Providers
+{
+    /// <summary>
+    ///     A process-wide cache of fully decoded audio assets, keyed by source and target <see cref="AudioFormat"/>.
+    /// </summary>
+    /// <remarks>
+    ///     Assets are reference counted: each <see cref="Acquire"/> must be paired with a <see cref="Release"/>.
+    ///     Concurrent requests for the same asset decode it once. Assets no longer referenced stay cached in
+    ///     least-recently-used order and are evicted once the total cached size exceeds <see cref="MemoryBudgetBytes"/>.
+    ///     Assets still in use are never evicted, so the budget can be exceeded by live assets.
+    /// </remarks>
+    public static class DecodedAssetCache
+    {
+        private static readonly object Lock = new();
+        private static readonly Dictionary<CacheKey, Entry> Entries = new();
+        private static readonly LinkedList<Entry> Unreferenced = new();
+        private static long _memoryBudgetBytes = 64L * 1024 * 1024;
+        private static long _memoryUsageBytes;
+
+        /// <summary>
+        ///     Gets or sets the soft limit, in bytes, for decoded sample memory. Defaults to 64 MB.
+        ///     Lowering it evicts unreferenced assets immediately.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is negative.</exception>
+        public static long MemoryBudgetBytes
+        {
+            get => Interlocked.Read(ref _memoryBudgetBytes);
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value), "Memory budget cannot be negative.");
+
+                lock (Lock)
+                {
+                    _memoryBudgetBytes = value;
+                    TrimToBudget();
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Gets the number of bytes of decoded sample memory currently cached, including assets in use.
+        /// </summary>
+        public static long MemoryUsageBytes => Interlocked.Read(ref _memoryUsageBytes);
+
+        /// <summary>
+        ///     Gets the number of cached assets, including assets in use.
+        /// </summary>
+        public static int Count
+        {
+            get
+            {
+                lock (Lock)
+                {
+                    return Entries.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Gets a shared decoded asset, decoding it on a cache miss.
+        /// </summary>
+        /// <param name="engine">The audio engine used to create the decoder.</param>
+        /// <param name="format">The target audio format to decode to.</param>
+        /// <param name="sourceKey">A key that uniquely identifies the encoded source, such as its full file path.</param>
+        /// <param name="openStream">Opens the encoded source. Only called on a cache miss.</param>
+        /// <param name="disposeStream">Whether the stream returned by <paramref name="openStream"/> is disposed after decoding.</param>
+        /// <returns>The decoded asset. Pass it to <see cref="Release"/> once it is no longer used.</returns>
+        public static DecodedAsset Acquire(AudioEngine engine, AudioFormat format, string sourceKey, Func<Stream> openStream,
+            bool disposeStream = true)
+        {
+            if (engine == null) throw new ArgumentNullException(nameof(engine));
+            if (sourceKey == null) throw new ArgumentNullException(nameof(sourceKey));
+            if (openStream == null) throw new ArgumentNullException(nameof(openStream));
+
+            var key = new CacheKey(sourceKey, format);
+            Entry entry;
+
+            lock (Lock)
+            {
+                if (!Entries.TryGetValue(key, out entry!))
+                {
+                    entry = new Entry(key, () =>
+                    {
+                        var stream = openStream();
+                        try
+                        {
+                            using var decoder = engine.CreateDecoder(stream, format);
+                            return DecodedAsset.Decode(decoder);
+                        }
+                        finally
+                        {
+                            if (disposeStream) stream.Dispose();
+                        }
+                    });
+                    Entries.Add(key, entry);
+                }
+
+                entry.RefCount++;
+                if (entry.LruNode.List != null) Unreferenced.Remove(entry.LruNode);
+            }
+
+            DecodedAsset asset;
+            try
+            {
+                // Decoded outside the lock; concurrent callers for the same key wait on the same Lazy.
+                asset = entry.Asset.Value;
+            }
+            catch
+            {
+                lock (Lock)
+                {
+                    entry.RefCount--;
+                    if (Entries.TryGetValue(key, out var current) && current == entry) Entries.Remove(key);
+                }
+                throw;
+            }
+
+            lock (Lock)
+            {
+                if (!entry.Accounted && Entries.TryGetValue(key, out var current) && current == entry)
+                {
+                    entry.Accounted = true;
+                    asset.CacheEntry = entry;
+                    Interlocked.Add(ref _memoryUsageBytes, asset.SizeInBytes);
+                    TrimToBudget();
+                }
+            }
+
+            return asset;
+        }
+
+        /// <summary>
+        ///     Releases a reference obtained from <see cref="Acquire"/>.
+        /// </summary>
+        /// <param name="asset">The asset to release.</param>
+        public static void Release(DecodedAsset asset)
+        {
+            if (asset == null) throw new ArgumentNullException(nameof(asset));
+
+            lock (Lock)
+            {
+                if (asset.CacheEntry is not Entry entry || entry.RefCount == 0) return;
+
+                if (--entry.RefCount == 0)
+                {
+                    Unreferenced.AddFirst(entry.LruNode);
+                    TrimToBudget();
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Evicts every cached asset that is not currently in use.
+        /// </summary>
+        public static void Clear()
+        {
+            lock (Lock)
+            {
+                while (Unreferenced.Last != null) Evict(Unreferenced.Last.Value);
+            }
+        }
+
+        private static void TrimToBudget()
+        {
+            while (_memoryUsageBytes > _memoryBudgetBytes && Unreferenced.Last != null)
+                Evict(Unreferenced.Last.Value);
+        }
+
+        private static void Evict(Entry entry)
+        {
+            Unreferenced.Remove(entry.LruNode);
+            Entries.Remove(entry.Key);
+            if (entry.Accounted)
+                Interlocked.Add(ref _memoryUsageBytes, -entry.Asset.Value.SizeInBytes);
+        }
+
+        private sealed class Entry
+        {
+            public readonly CacheKey Key;
+            public readonly Lazy<DecodedAsset> Asset;
+            public readonly LinkedListNode<Entry> LruNode;
+            public int RefCount;
+            public bool Accounted;
+
+            public Entry(CacheKey key, Func<DecodedAsset> factory)
+            {
+                Key = key;
+                Asset = new Lazy<DecodedAsset>(factory, LazyThreadSafetyMode.ExecutionAndPublication);
+                LruNode = new LinkedListNode<Entry>(this);
+            }
+        }
+
+        private readonly struct CacheKey : IEquatable<CacheKey>
+        {
+            private readonly string _source;
+            private readonly SampleFormat _format;
+            private readonly int _channels;
+            private readonly int _sampleRate;
+
+            public CacheKey(string source, AudioFormat format)
+            {
+                _source = source;
+                _format = format.Format;
+                _channels = format.Channels;
+                _sampleRate = format.SampleRate;
+            }
+
+            public bool Equals(CacheKey other) =>
+                _format == other._format && _channels == other._channels && _sampleRate == other._sampleRate &&
+                string.Equals(_source, other._source, StringComparison.Ordinal);
+
+            public override bool Equals(object? obj) => obj is CacheKey other && Equals(other);
+
+            public override int GetHashCode() => HashCode.Combine(_source, (int)_format, _channels, _sampleRate);
+        }
+    }
+}
@@ -0,0 +1,291 @@
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Utils;
+using System;
+using System.Buffers.Binary;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+
+namespace SoundFlow.Providers
+{
+    /// <summary>
+    ///     Provides audio data from an uncompressed WAV or raw PCM file mapped into memory.
+    /// </summary>
+    /// <remarks>
+    ///     Samples are read straight from the operating system's page cache, so large files cost no managed heap and
+    ///     seeking is O(1). Only the sample data is mapped, not the header or trailing chunks. F32 data is copied
+    ///     straight from the mapping, or read in place through <see cref="ISampleSpanSource"/> and
+    ///     <see cref="GetFloatSpan"/>; integer formats are converted from the mapped view without any intermediate buffer.
+    /// </remarks>
+    public sealed unsafe class MemoryMappedDataProvider : ISoundDataProvider, ISampleSpanSource
+    {
+        private const ushort WaveFormatPcm = 1;
+        private const ushort WaveFormatIeeeFloat = 3;
+        private const ushort WaveFormatExtensible = 0xFFFE;
+
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly byte* _data;
+        private readonly int _bytesPerSample;
+        private int _position;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="MemoryMappedDataProvider" /> class from a WAV file.
+        /// </summary>
+        /// <param name="filePath">The path to an uncompressed PCM or IEEE float WAV file.</param>
+        /// <exception cref="InvalidDataException">Thrown if the file is not a supported WAV file.</exception>
+        public MemoryMappedDataProvider(string filePath)
+            : this(filePath, ReadWaveHeader(filePath))
+        {
+        }
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="MemoryMappedDataProvider" /> class from a headerless PCM file.
+        /// </summary>
+        /// <param name="filePath">The path to the raw PCM file.</param>
+        /// <param name="sampleFormat">The sample format of the PCM data.</param>
+        /// <param name="sampleRate">The sample rate of the PCM data.</param>
+        /// <param name="channels">The number of interleaved channels.</param>
+        /// <param name="dataOffset">The byte offset of the first sample in the file.</param>
+        public MemoryMappedDataProvider(string filePath, SampleFormat sampleFormat, int sampleRate, int channels, long dataOffset = 0)
+            : this(filePath, new PcmLayout(sampleFormat, sampleRate, channels, dataOffset,
+                new FileInfo(filePath).Length - dataOffset))
+        {
+        }
+
+        private MemoryMappedDataProvider(string filePath, PcmLayout layout)
+        {
+            Clock = new PositionClock(this);
+            if (layout.Format == SampleFormat.Unknown)
+                throw new ArgumentException("SampleFormat cannot be Unknown for MemoryMappedDataProvider.", nameof(layout));
+            if (layout.SampleRate <= 0)
+                throw new ArgumentOutOfRangeException(nameof(layout), "Sample rate must be positive.");
+            if (layout.Channels <= 0)
+                throw new ArgumentOutOfRangeException(nameof(layout), "Channel count must be positive.");
+            if (layout.DataOffset < 0 || layout.DataLength < 0)
+                throw new ArgumentOutOfRangeException(nameof(layout), "Data region lies outside the file.");
+
+            SampleFormat = layout.Format;
+            SampleRate = layout.SampleRate;
+            Channels = layout.Channels;
+            _bytesPerSample = layout.Format.GetBytesPerSample();
+
+            var samples = layout.DataLength / _bytesPerSample;
+            if (samples > int.MaxValue)
+                throw new NotSupportedException("Files with more than int.MaxValue samples are not supported.");
+            Length = (int)samples;
+
+            _file = MemoryMappedFile.CreateFromFile(filePath, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            // A size of 0 maps to the end of the file, so an empty data region maps the (never read) file start instead.
+            _view = layout.DataLength > 0
+                ? _file.CreateViewAccessor(layout.DataOffset, layout.DataLength, MemoryMappedFileAccess.Read)
+                : _file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+            byte* basePointer = null;
+            _view.SafeMemoryMappedViewHandle.AcquirePointer(ref basePointer);
+            _data = basePointer + _view.PointerOffset;
+        }
+
+        /// <inheritdoc />
+        public int Position => _position;
+
+        /// <inheritdoc />
+        public int Length { get; }
+
+        /// <inheritdoc />
+        public bool CanSeek => true;
+
+        /// <inheritdoc />
+        public SampleFormat SampleFormat { get; }
+
+        /// <inheritdoc />
+        public int SampleRate { get; }
+
+        /// <summary>
+        ///     Gets the number of interleaved channels in the file.
+        /// </summary>
+        public int Channels { get; }
+
+        /// <inheritdoc />
+        public bool IsDisposed { get; private set; }
+
+        /// <inheritdoc />
+        public event EventHandler<EventArgs>? EndOfStreamReached;
+
+        /// <inheritdoc />
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
+
+        /// <inheritdoc />
+        public int ReadBytes(Span<float> buffer)
+        {
+            if (IsDisposed) return 0;
+
+            var samplesToRead = Math.Min(buffer.Length, Length - _position);
+            if (samplesToRead <= 0)
+            {
+                EndOfStreamReached?.Invoke(this, EventArgs.Empty);
+                return 0;
+            }
+
+            var source = _data + (long)_position * _bytesPerSample;
+            if (SampleFormat == SampleFormat.F32)
+                new ReadOnlySpan<float>(source, samplesToRead).CopyTo(buffer);
+            else
+                DeviceBufferHelper.ConvertFromDeviceFormat((nint)source, buffer[..samplesToRead], samplesToRead, SampleFormat);
+
+            _position += samplesToRead;
+            Clock.Publish(_position);
+            return samplesToRead;
+        }
+
+        /// <summary>
+        ///     Gets a read-only span directly over the mapped samples of an F32 file.
+        /// </summary>
+        /// <param name="sampleOffset">The first sample of the span.</param>
+        /// <param name="sampleCount">The number of samples. Clamped to the end of the data.</param>
+        /// <returns>A span over the mapping, valid until the provider is disposed.</returns>
+        /// <exception cref="InvalidOperationException">Thrown if the file is not 32-bit float.</exception>
+        public ReadOnlySpan<float> GetFloatSpan(int sampleOffset, int sampleCount)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            if (SampleFormat != SampleFormat.F32)
+                throw new InvalidOperationException($"Direct float access requires F32 data, but the file is {SampleFormat}.");
+
+            sampleOffset = Math.Clamp(sampleOffset, 0, Length);
+            sampleCount = Math.Clamp(sampleCount, 0, Length - sampleOffset);
+            return new ReadOnlySpan<float>(_data + (long)sampleOffset * sizeof(float), sampleCount);
+        }
+
+        /// <inheritdoc />
+        public bool CanReadInPlace => SampleFormat == SampleFormat.F32 && !IsDisposed;
+
+        /// <inheritdoc />
+        public ReadOnlySpan<float> PeekSamples(int sampleCount)
+        {
+            if (!CanReadInPlace) return ReadOnlySpan<float>.Empty;
+
+            sampleCount = Math.Clamp(sampleCount, 0, Length - _position);
+            return new ReadOnlySpan<float>(_data + (long)_position * sizeof(float), sampleCount);
+        }
+
+        /// <inheritdoc />
+        public void Advance(int sampleCount)
+        {
+            if (IsDisposed || sampleCount <= 0) return;
+
+            _position = Math.Min(_position + sampleCount, Length);
+            Clock.Publish(_position);
+        }
+
+        /// <inheritdoc />
+        public void Seek(int sampleOffset)
+        {
+            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+            _position = Math.Clamp(sampleOffset, 0, Length);
+            Clock.Publish(_position, false);
+        }
+
+        /// <inheritdoc />
+        public void Dispose()
+        {
+            if (IsDisposed) return;
+
+            IsDisposed = true;
+            _view.SafeMemoryMappedViewHandle.ReleasePointer();
+            _view.Dispose();
+            _file.Dispose();
+            Clock.Dispose();
+        }
+
+        /// <summary>
+        ///     Parses the RIFF header of a WAV file and locates its sample data.
+        /// </summary>
+        private static PcmLayout ReadWaveHeader(string filePath)
+        {
+            using var stream = new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.Read);
+            Span<byte> header = stackalloc byte[12];
+            if (stream.Read(header) != header.Length ||
+                BinaryPrimitives.ReadUInt32BigEndian(header) != 0x52494646 || // "RIFF"
+                BinaryPrimitives.ReadUInt32BigEndian(header[8..]) != 0x57415645) // "WAVE"
+                throw new InvalidDataException("The file is not a RIFF/WAVE file.");
+
+            var format = SampleFormat.Unknown;
+            int sampleRate = 0, channels = 0;
+            Span<byte> chunkHeader = stackalloc byte[8];
+            Span<byte> fmt = stackalloc byte[40];
+
+            while (stream.Read(chunkHeader) == chunkHeader.Length)
+            {
+                var chunkId = BinaryPrimitives.ReadUInt32BigEndian(chunkHeader);
+                long chunkSize = BinaryPrimitives.ReadUInt32LittleEndian(chunkHeader[4..]);
+                var chunkStart = stream.Position;
+
+                if (chunkId == 0x666D7420) // "fmt "
+                {
+                    var fmtLength = (int)Math.Min(chunkSize, fmt.Length);
+                    if (fmtLength < 16 || stream.Read(fmt[..fmtLength]) != fmtLength)
+                        throw new InvalidDataException("The WAV fmt chunk is truncated.");
+
+                    var formatTag = BinaryPrimitives.ReadUInt16LittleEndian(fmt);
+                    channels = BinaryPrimitives.ReadUInt16LittleEndian(fmt[2..]);
+                    sampleRate = BinaryPrimitives.ReadInt32LittleEndian(fmt[4..]);
+                    var bitsPerSample = BinaryPrimitives.ReadUInt16LittleEndian(fmt[14..]);
+
+                    // WAVE_FORMAT_EXTENSIBLE carries the real format tag in the first two bytes of its sub-format GUID.
+                    if (formatTag == WaveFormatExtensible && fmtLength >= 26)
+                        formatTag = BinaryPrimitives.ReadUInt16LittleEndian(fmt[24..]);
+
+                    format = (formatTag, bitsPerSample) switch
+                    {
+                        (WaveFormatPcm, 8) => SampleFormat.U8,
+                        (WaveFormatPcm, 16) => SampleFormat.S16,
+                        (WaveFormatPcm, 24) => SampleFormat.S24,
+                        (WaveFormatPcm, 32) => SampleFormat.S32,
+                        (WaveFormatIeeeFloat, 32) => SampleFormat.F32,
+                        _ => throw new InvalidDataException(
+                            $"Unsupported WAV encoding (format tag {formatTag}, {bitsPerSample} bits). Only uncompressed PCM and 32-bit float are supported.")
+                    };
+                }
+                else if (chunkId == 0x64617461) // "data"
+                {
+                    if (format == SampleFormat.Unknown)
+                        throw new InvalidDataException("The WAV data chunk precedes its fmt chunk.");
+
+                    // Streaming writers may leave the size unset; clamp to what is actually in the file.
+                    var dataLength = Math.Min(chunkSize, stream.Length - chunkStart);
+                    return new PcmLayout(format, sampleRate, channels, chunkStart, dataLength);
+                }
+
+                // Chunks are padded to an even number of bytes.
+                stream.Position = chunkStart + chunkSize + (chunkSize & 1);
+            }
+
+            throw new InvalidDataException("The WAV file has no data chunk.");
+        }
+
+        private readonly struct PcmLayout
+        {
+            public readonly SampleFormat Format;
+            public readonly int SampleRate;
+            public readonly int Channels;
+            public readonly long DataOffset;
+            public readonly long DataLength;
+
+            public PcmLayout(SampleFormat format, int sampleRate, int channels, long dataOffset, long dataLength)
+            {
+                Format = format;
+                SampleRate = sampleRate;
+                Channels = channels;
+                DataOffset = dataOffset;
+                DataLength = dataLength;
+            }
+        }
+    }
+}
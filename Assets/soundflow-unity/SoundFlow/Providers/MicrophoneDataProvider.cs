@@ -1,34 +1,113 @@
 using SoundFlow.Abstracts.Devices;
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
+using SoundFlow.Utils;
 using System;
-using System.Collections.Concurrent;
+using System.Threading;
 
 namespace SoundFlow.Providers
 {
 
+    /// <summary>
+    ///     Defines what a <see cref="MicrophoneDataProvider"/> does with captured samples when its ring is full.
+    /// </summary>
+    public enum MicrophoneOverflowBehavior
+    {
+        /// <summary>
+        ///     Overwrite the oldest unread samples, so the reader always gets the most recent audio. This is the default behavior.
+        /// </summary>
+        OverwriteOldest,
+
+        /// <summary>
+        ///     Wait, for at most the duration of the incoming block, for the reader to make room, then drop the
+        ///     samples that still do not fit.
+        /// </summary>
+        Block
+    }
+
     /// <summary>
     /// Provides audio data from a microphone by subscribing to a specific capture device.
     /// </summary>
+    /// <remarks>
+    ///     Captured samples go into a fixed-capacity ring allocated by the constructor, so neither the capture callback
+    ///     nor <see cref="ReadBytes"/> allocates. The capture callback is the only writer and <see cref="ReadBytes"/> the
+    ///     only reader; neither takes a lock. With <see cref="MicrophoneOverflowBehavior.OverwriteOldest"/> the writer
+    ///     never waits: a reader that falls a full ring behind detects the overwrite and resumes from the oldest intact
+    ///     sample.
+    ///     <para>
+    ///     A latency target turns the ring into a jitter buffer: reads return silence until the target is buffered,
+    ///     and whenever more than twice the target builds up (clock drift between the capture and playback devices)
+    ///     the oldest audio is trimmed back to the target. Capture-to-playback latency is then bounded, and
+    ///     <see cref="LatencyMilliseconds"/>, <see cref="UnderrunCount"/>, <see cref="DroppedSamples"/> and
+    ///     <see cref="TrimmedSamples"/> show how the buffer behaves.
+    ///     </para>
+    /// </remarks>
     public class MicrophoneDataProvider : ISoundDataProvider
     {
+        private const int DefaultCapacityMilliseconds = 500;
+
         private readonly AudioDevice _captureDevice;
-        private readonly ConcurrentQueue<float[]> _bufferQueue = new();
-        private readonly int _bufferSize;
+        private readonly MicrophoneOverflowBehavior _overflowBehavior;
+        private readonly int _channels;
         private bool _isCapturing;
-        private float[]? _currentBuffer;
-        private int _currentBufferIndex;
+
+        // Ring of monotonic sample counters. The capture callback owns _writeIndex and _reserveIndex, ReadBytes owns
+        // _readIndex. The writer moves _reserveIndex past a block before copying it and _writeIndex after, so a
+        // reader can tell whether samples it copied were overwritten in the meantime.
+        private readonly float[] _ring;
+        private readonly int _mask;
+        private readonly int _usableCapacity;
+        private long _writeIndex;
+        private long _reserveIndex;
+        private long _readIndex;
+
+        private readonly int _targetSamples;
+        private bool _priming;
+
+        private long _droppedSamples;
+        private long _trimmedSamples;
+        private long _underrunCount;
+        private int _peakBufferedSamples;
 
         /// <summary>
         /// Initializes a new instance of the <see cref="MicrophoneDataProvider"/> class.
         /// </summary>
         /// <param name="captureDevice">The capture device to source audio from.</param>
-        /// <param name="bufferSize">The size of internal audio buffers in samples.</param>
-        public MicrophoneDataProvider(AudioDevice captureDevice, int bufferSize = 8)
+        /// <param name="bufferSize">
+        ///     The minimum number of samples the capture ring holds. The ring always holds at least 500 ms and four
+        ///     times the latency target.
+        /// </param>
+        /// <param name="targetLatencyMilliseconds">
+        ///     The amount of audio, in milliseconds, to keep buffered between capture and <see cref="ReadBytes"/>.
+        ///     Zero (the default) disables the jitter buffer: reads return whatever has been captured.
+        /// </param>
+        /// <param name="overflowBehavior">What to do with captured samples when the ring is full.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="bufferSize"/> or <paramref name="targetLatencyMilliseconds"/> is negative.</exception>
+        public MicrophoneDataProvider(AudioDevice captureDevice, int bufferSize = 8, int targetLatencyMilliseconds = 0,
+            MicrophoneOverflowBehavior overflowBehavior = MicrophoneOverflowBehavior.OverwriteOldest)
         {
+            if (bufferSize < 0)
+                throw new ArgumentOutOfRangeException(nameof(bufferSize), "Buffer size cannot be negative.");
+            if (targetLatencyMilliseconds < 0)
+                throw new ArgumentOutOfRangeException(nameof(targetLatencyMilliseconds), "Latency target cannot be negative.");
+
             _captureDevice = captureDevice;
-            _bufferSize = bufferSize;
+            _overflowBehavior = overflowBehavior;
             SampleRate = captureDevice.Format.SampleRate;
+            Clock = new PositionClock(this);
+            TargetLatencyMilliseconds = targetLatencyMilliseconds;
+
+            _channels = Math.Max(1, captureDevice.Format.Channels);
+            var samplesPerMillisecond = (long)SampleRate * _channels / 1000.0;
+            _targetSamples = (int)(targetLatencyMilliseconds * samplesPerMillisecond) / _channels * _channels;
+            _priming = _targetSamples > 0;
+
+            var minimumCapacity = Math.Max(bufferSize, Math.Max((int)(DefaultCapacityMilliseconds * samplesPerMillisecond), 4 * _targetSamples));
+            var capacity = 1;
+            while (capacity < minimumCapacity) capacity <<= 1;
+            _ring = new float[capacity];
+            _mask = capacity - 1;
+            _usableCapacity = capacity / _channels * _channels;
 
             switch (captureDevice)
             {
@@ -59,11 +138,60 @@ namespace SoundFlow.Providers
         /// <inheritdoc />
         public bool IsDisposed { get; private set; }
 
+        /// <summary>
+        ///     Gets the jitter buffer target in milliseconds, or zero if the jitter buffer is disabled.
+        /// </summary>
+        public int TargetLatencyMilliseconds { get; }
+
+        /// <summary>
+        ///     Gets the number of samples the capture ring can hold before the overflow behavior applies.
+        /// </summary>
+        public int Capacity => _usableCapacity;
+
+        /// <summary>
+        ///     Gets the number of captured samples waiting to be read.
+        /// </summary>
+        public int BufferedSamples => (int)Math.Min(_usableCapacity, Volatile.Read(ref _writeIndex) - Volatile.Read(ref _readIndex));
+
+        /// <summary>
+        ///     Gets the audio currently buffered between capture and <see cref="ReadBytes"/>, in milliseconds.
+        /// </summary>
+        public double LatencyMilliseconds => BufferedSamples * 1000.0 / ((double)SampleRate * _channels);
+
+        /// <summary>
+        ///     Gets the highest number of samples buffered at the start of a read since the last <see cref="ResetStatistics"/>.
+        /// </summary>
+        public int PeakBufferedSamples => Volatile.Read(ref _peakBufferedSamples);
+
+        /// <summary>
+        ///     Gets the number of reads that found too little audio and were padded with silence, including reads
+        ///     spent re-filling the jitter buffer.
+        /// </summary>
+        public long UnderrunCount => Interlocked.Read(ref _underrunCount);
+
+        /// <summary>
+        ///     Gets the number of captured samples lost because the ring was full: overwritten before they were read, or
+        ///     dropped after a <see cref="MicrophoneOverflowBehavior.Block"/> wait timed out.
+        /// </summary>
+        public long DroppedSamples => Interlocked.Read(ref _droppedSamples);
+
+        /// <summary>
+        ///     Gets the number of samples discarded by the jitter buffer to bring latency back to the target.
+        /// </summary>
+        public long TrimmedSamples => Interlocked.Read(ref _trimmedSamples);
+
         /// <inheritdoc />
         public event EventHandler<EventArgs>? EndOfStreamReached;
 
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
 
         /// <summary>
         ///     Starts capturing audio data from the microphone.
@@ -79,6 +207,7 @@ namespace SoundFlow.Providers
 
         /// <summary>
         ///     Stops capturing audio data from the microphone.
+        ///     Samples already captured can still be read.
         /// </summary>
         public void StopCapture()
         {
@@ -86,88 +215,146 @@ namespace SoundFlow.Providers
 
             _isCapturing = false;
 
-            if (_currentBuffer != null && _currentBufferIndex > 0)
-            {
-                // Create a new array with the actual data length
-                var remainingBuffer = new float[_currentBufferIndex];
-                Array.Copy(_currentBuffer, remainingBuffer, _currentBufferIndex);
-                _bufferQueue.Enqueue(remainingBuffer);
-                _currentBuffer = null;
-                _currentBufferIndex = 0;
-            }
-
             EndOfStreamReached?.Invoke(this, EventArgs.Empty);
         }
 
+        /// <summary>
+        ///     Resets the peak, underrun, dropped and trimmed counters.
+        /// </summary>
+        public void ResetStatistics()
+        {
+            Volatile.Write(ref _peakBufferedSamples, 0);
+            Interlocked.Exchange(ref _underrunCount, 0);
+            Interlocked.Exchange(ref _droppedSamples, 0);
+            Interlocked.Exchange(ref _trimmedSamples, 0);
+        }
+
         private void OnAudioDataReceived(Span<float> samples, Capability capability)
         {
             if (!_isCapturing || capability != Capability.Record || IsDisposed)
                 return;
 
-            var samplesRemaining = samples.Length;
-            var samplesReadPosition = 0;
+            ReadOnlySpan<float> block = samples[..(samples.Length / _channels * _channels)];
+            var write = _writeIndex;
 
-            while (samplesRemaining > 0)
+            if (_overflowBehavior == MicrophoneOverflowBehavior.Block)
             {
-                // Create a new buffer if the current one is null
-                if (_currentBuffer == null)
+                var free = _usableCapacity - (int)(write - Volatile.Read(ref _readIndex));
+                if (free < block.Length)
                 {
-                    _currentBuffer = new float[_bufferSize];
-                    _currentBufferIndex = 0;
+                    // Wait for the reader for at most as long as this block takes to capture.
+                    var deadline = Environment.TickCount + Math.Max(1, (int)((long)block.Length * 1000 / ((long)SampleRate * _channels)));
+                    var spinner = new SpinWait();
+                    while (free < block.Length && !IsDisposed && Environment.TickCount - deadline < 0)
+                    {
+                        spinner.SpinOnce();
+                        free = _usableCapacity - (int)(write - Volatile.Read(ref _readIndex));
+                    }
+
+                    if (free < block.Length)
+                    {
+                        var kept = Math.Max(0, free) / _channels * _channels;
+                        Interlocked.Add(ref _droppedSamples, block.Length - kept);
+                        block = block[..kept];
+                    }
                 }
+            }
+            else if (block.Length > _usableCapacity)
+            {
+                // Only the newest ring's worth can survive; skip the rest without copying it. The reader counts
+                // the skipped samples as dropped when it finds itself lapped.
+                var skipped = block.Length - _usableCapacity;
+                block = block[skipped..];
+                write += skipped;
+            }
 
-                var spaceLeftInBuffer = _bufferSize - _currentBufferIndex;
-                var samplesToCopy = Math.Min(samplesRemaining, spaceLeftInBuffer);
+            if (block.IsEmpty)
+            {
+                Volatile.Write(ref _writeIndex, write);
+                return;
+            }
 
-                samples.Slice(samplesReadPosition, samplesToCopy).CopyTo(_currentBuffer.AsSpan(_currentBufferIndex));
+            // Announce the overwrite before touching the samples, so a concurrent reader can detect it.
+            Interlocked.Exchange(ref _reserveIndex, write + block.Length);
 
-                _currentBufferIndex += samplesToCopy;
-                samplesReadPosition += samplesToCopy;
-                samplesRemaining -= samplesToCopy;
+            var start = (int)(write & _mask);
+            var firstLength = Math.Min(block.Length, _ring.Length - start);
+            block[..firstLength].CopyTo(_ring.AsSpan(start));
+            block[firstLength..].CopyTo(_ring);
 
-                // Enqueue the buffer if it's full
-                if (_currentBufferIndex == _bufferSize)
-                {
-                    _bufferQueue.Enqueue(_currentBuffer);
-                    _currentBuffer = null; // Reset the current buffer
-                }
-            }
+            Volatile.Write(ref _writeIndex, write + block.Length);
         }
 
         /// <inheritdoc />
         public int ReadBytes(Span<float> buffer)
         {
             if (IsDisposed) return 0;
-            var bytesCopied = 0;
 
-            while (bytesCopied < buffer.Length && _bufferQueue.TryDequeue(out var audioData))
+            var read = _readIndex;
+            var write = Volatile.Read(ref _writeIndex);
+            var available = write - read;
+
+            if (available > _usableCapacity)
             {
-                var remainingBufferSpace = buffer.Length - bytesCopied;
-                var bytesToCopy = Math.Min(remainingBufferSpace, audioData.Length);
+                // The writer lapped us; resume from the oldest sample still in the ring.
+                Interlocked.Add(ref _droppedSamples, available - _usableCapacity);
+                read = write - _usableCapacity;
+                available = _usableCapacity;
+            }
 
-                audioData.AsSpan(0, bytesToCopy).CopyTo(buffer[bytesCopied..]);
+            if (available > _peakBufferedSamples)
+                Volatile.Write(ref _peakBufferedSamples, (int)available);
 
-                bytesCopied += bytesToCopy;
-                Position += bytesToCopy;
+            if (_targetSamples > 0)
+            {
+                if (_priming && available >= _targetSamples)
+                    _priming = false;
 
-                // If audioData has more data than the remaining buffer space, requeue the remaining portion
-                if (audioData.Length > bytesToCopy)
+                if (!_priming && available > 2 * (long)_targetSamples)
                 {
-                    var remainingAudioData = audioData.AsSpan(bytesToCopy).ToArray();
-                    _bufferQueue.Enqueue(remainingAudioData);
+                    var trimmed = available - _targetSamples;
+                    Interlocked.Add(ref _trimmedSamples, trimmed);
+                    read += trimmed;
+                    available = _targetSamples;
                 }
             }
 
-            // If we've copied less than the buffer length, it means the queue is empty
-            if (bytesCopied < buffer.Length)
+            var toCopy = _priming ? 0 : (int)Math.Min(buffer.Length, available);
+            if (toCopy > 0)
+            {
+                var start = (int)(read & _mask);
+                var firstLength = Math.Min(toCopy, _ring.Length - start);
+                _ring.AsSpan(start, firstLength).CopyTo(buffer);
+                _ring.AsSpan(0, toCopy - firstLength).CopyTo(buffer[firstLength..]);
+
+                // If the writer started overwriting the copied range while we read it, the head of the copy is torn:
+                // silence it and count it as dropped.
+                Interlocked.MemoryBarrier();
+                var overwritten = Volatile.Read(ref _reserveIndex) - _ring.Length - read;
+                if (overwritten > 0)
+                {
+                    var torn = (int)Math.Min(toCopy, overwritten);
+                    buffer[..torn].Clear();
+                    Interlocked.Add(ref _droppedSamples, torn);
+                }
+
+                read += toCopy;
+                Position += toCopy;
+            }
+
+            Volatile.Write(ref _readIndex, read);
+
+            // If we've copied less than the buffer length, it means the ring is empty
+            if (toCopy < buffer.Length)
             {
-                // Optionally fill the remainder of the buffer with silence or a default value
-                buffer[bytesCopied..].Clear(); // Fill with silence
-                bytesCopied = buffer.Length; // Indicate that the buffer is "full" even though it's silence
+                // Fill the remainder of the buffer with silence and re-fill the jitter buffer before playing again.
+                buffer[toCopy..].Clear(); // Fill with silence
+                Interlocked.Increment(ref _underrunCount);
+                if (_targetSamples > 0) _priming = true;
             }
 
-            PositionChanged?.Invoke(this, new PositionChangedEventArgs(Position));
-            return bytesCopied;
+            Clock.Publish(Position, toCopy > 0);
+            return buffer.Length; // Indicate that the buffer is "full" even though it may be partly silence
         }
 
         /// <inheritdoc />
@@ -178,7 +365,6 @@ namespace SoundFlow.Providers
         {
             if (IsDisposed) return;
             StopCapture();
-            _bufferQueue.Clear();
             switch (_captureDevice)
             {
                 case AudioCaptureDevice audioCaptureDevice:
@@ -188,7 +374,8 @@ namespace SoundFlow.Providers
                     fullDuplexDevice.OnAudioProcessed -= OnAudioDataReceived;
                     break;
             }
+            Clock.Dispose();
             IsDisposed = true;
         }
     }
-}
\ No newline at end of file
+}
@@ -1,8 +1,8 @@
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
-using System.Collections.Generic;
 using System.Threading;
 
 namespace SoundFlow.Providers
@@ -33,16 +33,30 @@ namespace SoundFlow.Providers
     ///     Provides audio data from an in-memory queue that is fed samples externally.
     ///     This provider is ideal for scenarios where audio data is generated or received in chunks.
     /// </summary>
+    /// <remarks>
+    ///     Samples are stored in lock-free <see cref="SpscRingBuffer"/> segments, so <see cref="ReadBytes"/> never blocks
+    ///     on the producer. <see cref="AddSamples"/>, <see cref="Reset"/> and <see cref="CompleteAdding"/> are intended to
+    ///     be called from a single producer thread, and <see cref="ReadBytes"/> from a single consumer (usually the audio thread).
+    /// </remarks>
     public class QueueDataProvider : ISoundDataProvider
     {
-        private readonly object _lock = new();
-        private readonly Queue<float> _sampleQueue = new();
+        private const int DefaultSegmentCapacity = 16384;
+
         private readonly int? _maxSamples;
         private readonly QueueFullBehavior _fullBehavior;
 
-        private bool _isAddingCompleted;
+        // Producer writes to _tail and links a larger segment when it fills up (unbounded mode only).
+        // Consumer reads from _head and moves on once it is drained and a newer segment exists.
+        private Segment _head;
+        private Segment _tail;
+        private Segment? _pendingHead;
+        private int _resetGeneration;
+
+        private volatile bool _isAddingCompleted;
+        private volatile bool _isDisposed;
         private bool _endOfStreamFired;
         private long _totalSamplesEnqueued;
+        private int _position;
 
         /// <summary>
         ///     Initializes a new instance of the <see cref="QueueDataProvider" /> class.
@@ -65,16 +79,22 @@ namespace SoundFlow.Providers
             if (!maxSamples.HasValue && fullBehavior != QueueFullBehavior.Throw)
                 throw new ArgumentException("QueueFullBehavior cannot be set to Block or Drop for a queue with no sample limit.", nameof(fullBehavior));
 
+            if (maxSamples <= 0)
+                throw new ArgumentOutOfRangeException(nameof(maxSamples), "Maximum sample count must be positive.");
+
             SampleRate = format.SampleRate;
             SampleFormat = format.Format;
+            Clock = new PositionClock(this);
             _maxSamples = maxSamples;
             _fullBehavior = fullBehavior;
+
+            _head = _tail = CreateInitialSegment();
         }
 
         #region Properties
 
         /// <inheritdoc />
-        public int Position { get; private set; }
+        public int Position => Volatile.Read(ref _position);
 
         /// <inheritdoc />
         public int Length => -1; // Length is unknown as it's a queue.
@@ -89,7 +109,7 @@ namespace SoundFlow.Providers
         public int SampleRate { get; }
 
         /// <inheritdoc />
-        public bool IsDisposed { get; private set; }
+        public bool IsDisposed => _isDisposed;
 
         /// <summary>
         ///     Gets the number of samples currently available in the queue.
@@ -98,26 +118,17 @@ namespace SoundFlow.Providers
         {
             get
             {
-                lock (_lock)
-                {
-                    return _sampleQueue.Count;
-                }
+                var count = 0;
+                for (var segment = Volatile.Read(ref _pendingHead) ?? Volatile.Read(ref _head); segment != null; segment = segment.Next)
+                    count += segment.Ring.Count;
+                return count;
             }
         }
 
         /// <summary>
         ///     Gets the total number of samples enqueued so far.
         /// </summary>
-        public long TotalSamplesEnqueued
-        {
-            get
-            {
-                lock (_lock)
-                {
-                    return _totalSamplesEnqueued;
-                }
-            }
-        }
+        public long TotalSamplesEnqueued => Volatile.Read(ref _totalSamplesEnqueued);
 
         #endregion
 
@@ -127,7 +138,14 @@ namespace SoundFlow.Providers
         public event EventHandler<EventArgs>? EndOfStreamReached;
 
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
 
         #endregion
 
@@ -141,12 +159,12 @@ namespace SoundFlow.Providers
             if (samples.IsEmpty) return;
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
 
-            lock (_lock)
-            {
-                if (_isAddingCompleted)
-                    throw new InvalidOperationException("Cannot add samples after CompleteAdding has been called.");
+            if (_isAddingCompleted)
+                throw new InvalidOperationException("Cannot add samples after CompleteAdding has been called.");
 
-                if (_maxSamples.HasValue && _sampleQueue.Count + samples.Length > _maxSamples.Value)
+            if (_maxSamples.HasValue)
+            {
+                if (Volatile.Read(ref _tail).Ring.Count + samples.Length > _maxSamples.Value)
                 {
                     switch (_fullBehavior)
                     {
@@ -157,69 +175,80 @@ namespace SoundFlow.Providers
                             return; // Silently drop the samples and return.
 
                         case QueueFullBehavior.Block:
-                            // Block until space is available for the entire sample block.
-                            while (!IsDisposed && _sampleQueue.Count + samples.Length > _maxSamples.Value)
+                            // Wait for the consumer to free enough space for the entire sample block.
+                            // The consumer never takes a lock, so this only ever stalls the producer.
+                            var generation = Volatile.Read(ref _resetGeneration);
+                            var spinner = new SpinWait();
+                            while (!_isDisposed && generation == Volatile.Read(ref _resetGeneration) &&
+                                   Volatile.Read(ref _tail).Ring.Count + samples.Length > _maxSamples.Value)
                             {
-                                Monitor.Wait(_lock);
+                                if (spinner.NextSpinWillYield) Thread.Sleep(1);
+                                else spinner.SpinOnce();
                             }
-                            // Re-check disposed status after waking up.
-                            //ObjectDisposedException.ThrowIf(IsDisposed, this);
+                            if (_isDisposed) return;
                             break;
                     }
                 }
 
-                foreach (var sample in samples)
+                // Bounded mode has a single segment with capacity >= maxSamples, so this always fits.
+                _tail.Ring.Write(samples);
+            }
+            else
+            {
+                var written = _tail.Ring.Write(samples);
+                while (written < samples.Length)
                 {
-                    _sampleQueue.Enqueue(sample);
+                    // Grow by linking a larger segment; the old one is never written again once Next is published.
+                    var remaining = samples.Length - written;
+                    var next = new Segment(Math.Max(_tail.Ring.Capacity * 2, remaining));
+                    written += next.Ring.Write(samples[written..]);
+                    Volatile.Write(ref _tail.Next, next);
+                    Volatile.Write(ref _tail, next);
                 }
-                _totalSamplesEnqueued += samples.Length;
             }
+
+            Volatile.Write(ref _totalSamplesEnqueued, _totalSamplesEnqueued + samples.Length);
         }
 
         /// <inheritdoc />
         public int ReadBytes(Span<float> buffer)
         {
-            if (IsDisposed || buffer.IsEmpty) return 0;
+            if (_isDisposed || buffer.IsEmpty) return 0;
 
+            var pending = Interlocked.Exchange(ref _pendingHead, null);
+            if (pending != null)
+            {
+                _head = pending;
+                _endOfStreamFired = false;
+            }
+
+            // Read the completion flag first so every sample added before it is visible below.
+            var addingCompleted = _isAddingCompleted;
             var samplesRead = 0;
-            var shouldFireEndOfStream = false;
-            var spaceWasFreed = false;
 
-            lock (_lock)
+            while (true)
             {
-                for (var i = 0; i < buffer.Length; i++)
-                {
-                    if (_sampleQueue.TryDequeue(out var sample))
-                    {
-                        buffer[i] = sample;
-                        samplesRead++;
-                    }
-                    else
-                    {
-                        break; // Queue is empty.
-                    }
-                }
+                samplesRead += _head.Ring.Read(buffer[samplesRead..]);
+                if (samplesRead == buffer.Length) break;
 
-                if (samplesRead > 0)
-                {
-                    Position += samplesRead;
-                    spaceWasFreed = true;
-                }
+                // Next must be read before re-checking Count: the producer finishes writing a segment before linking its successor.
+                var next = Volatile.Read(ref _head.Next);
+                if (next == null || _head.Ring.Count > 0) break;
+                _head = next;
+            }
 
-                if (_sampleQueue.Count == 0 && _isAddingCompleted && !_endOfStreamFired)
-                {
-                    shouldFireEndOfStream = true;
-                    _endOfStreamFired = true;
-                }
+            if (samplesRead > 0)
+                Volatile.Write(ref _position, _position + samplesRead);
 
-                // If space was freed, notify any waiting producer threads.
-                if (spaceWasFreed)
-                {
-                    Monitor.PulseAll(_lock);
-                }
+            var shouldFireEndOfStream = false;
+            if (addingCompleted && !_endOfStreamFired && _head.Ring.Count == 0 && Volatile.Read(ref _head.Next) == null)
+            {
+                shouldFireEndOfStream = true;
+                _endOfStreamFired = true;
             }
 
-            if (samplesRead > 0) PositionChanged?.Invoke(this, new PositionChangedEventArgs(Position));
+            // Published on empty reads too, so a starved queue reads as stalled rather than still playing.
+            Clock.Publish(_position, samplesRead > 0);
 
             if (shouldFireEndOfStream) EndOfStreamReached?.Invoke(this, EventArgs.Empty);
 
@@ -230,35 +259,30 @@ namespace SoundFlow.Providers
         ///     Resets the provider to its initial state, clearing the sample queue and resetting the position.
         ///     This allows the instance to be reused. Any threads blocked in <see cref="AddSamples"/> will be unblocked.
         /// </summary>
+        /// <remarks>
+        ///     The consumer switches to the fresh queue on its next <see cref="ReadBytes"/> call, so the audio thread is never locked out.
+        /// </remarks>
         public void Reset()
         {
             //ObjectDisposedException.ThrowIf(IsDisposed, this);
 
-            lock (_lock)
-            {
-                _sampleQueue.Clear();
-                Position = 0;
-                _totalSamplesEnqueued = 0;
-                _isAddingCompleted = false;
-                _endOfStreamFired = false;
+            var fresh = CreateInitialSegment();
+            Volatile.Write(ref _tail, fresh);
+            Volatile.Write(ref _pendingHead, fresh);
+            Volatile.Write(ref _position, 0);
+            Volatile.Write(ref _totalSamplesEnqueued, 0);
+            _isAddingCompleted = false;
+            Clock.Publish(0, false);
 
-                // Wake up any threads that were blocked, as the queue is now empty.
-                Monitor.PulseAll(_lock);
-            }
+            // Wake up any threads that were blocked, as the queue is now empty.
+            Interlocked.Increment(ref _resetGeneration);
         }
 
         /// <summary>
         ///     Marks the end of sample addition, indicating that the producer is finished adding samples.
         ///     Any threads blocked in <see cref="ReadBytes"/> will be unblocked.
         /// </summary>
-        public void CompleteAdding()
-        {
-            lock (_lock)
-            {
-                _isAddingCompleted = true;
-                Monitor.PulseAll(_lock);
-            }
-        }
+        public void CompleteAdding() => _isAddingCompleted = true;
 
         /// <inheritdoc />
         public void Seek(int offset) => throw new InvalidOperationException("Seeking is not supported by the QueueDataProvider.");
@@ -266,20 +290,22 @@ namespace SoundFlow.Providers
         /// <inheritdoc />
         public void Dispose()
         {
-            if (IsDisposed) return;
+            if (_isDisposed) return;
 
-            lock (_lock)
-            {
-                if (IsDisposed) return;
+            _isDisposed = true;
 
-                IsDisposed = true;
-                _sampleQueue.Clear();
+            EndOfStreamReached = null;
+            Clock.Dispose();
+        }
 
-                Monitor.PulseAll(_lock);
-            }
+        private Segment CreateInitialSegment() => new(_maxSamples ?? DefaultSegmentCapacity);
 
-            EndOfStreamReached = null;
-            PositionChanged = null;
+        private sealed class Segment
+        {
+            public readonly SpscRingBuffer Ring;
+            public Segment? Next;
+
+            public Segment(int capacity) => Ring = new SpscRingBuffer(capacity);
         }
     }
 }
\ No newline at end of file
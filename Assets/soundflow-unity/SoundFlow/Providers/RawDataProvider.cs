@@ -26,6 +26,7 @@ namespace SoundFlow.Providers
 
         public RawDataProvider(float[] rawSamples)
         {
+            Clock = new PositionClock(this);
             _floatData = rawSamples ?? throw new ArgumentNullException(nameof(rawSamples));
             _sampleFormat = SampleFormat.F32;
             SampleRate = 48000; // Assume default, as there's no other info
@@ -33,6 +34,7 @@ namespace SoundFlow.Providers
 
         public RawDataProvider(Stream pcmStream, SampleFormat sampleFormat, int sampleRate, int channels)
         {
+            Clock = new PositionClock(this);
             _pcmStream = pcmStream ?? throw new ArgumentNullException(nameof(pcmStream));
             _sampleFormat = sampleFormat != SampleFormat.Unknown ? sampleFormat
                 : throw new ArgumentException("SampleFormat cannot be Unknown for RawDataProvider when using a stream.", nameof(sampleFormat));
@@ -41,6 +43,7 @@ namespace SoundFlow.Providers
 
         public RawDataProvider(byte[] rawBytes, SampleFormat sampleFormat, int sampleRate, int channels)
         {
+            Clock = new PositionClock(this);
             _byteArray = rawBytes ?? throw new ArgumentNullException(nameof(rawBytes));
             _sampleFormat = sampleFormat != SampleFormat.Unknown ? sampleFormat
                 : throw new ArgumentException("SampleFormat cannot be Unknown for RawDataProvider when using a byte array.", nameof(sampleFormat));
@@ -49,6 +52,7 @@ namespace SoundFlow.Providers
 
         public RawDataProvider(int[] rawSamples, int sampleRate, int channels)
         {
+            Clock = new PositionClock(this);
             _intArray = rawSamples ?? throw new ArgumentNullException(nameof(rawSamples));
             _sampleFormat = SampleFormat.S32;
             SampleRate = sampleRate;
@@ -56,6 +60,7 @@ namespace SoundFlow.Providers
 
         public RawDataProvider(short[] rawSamples, int sampleRate, int channels)
         {
+            Clock = new PositionClock(this);
             _shortData = rawSamples ?? throw new ArgumentNullException(nameof(rawSamples));
             _sampleFormat = SampleFormat.S16;
             SampleRate = sampleRate;
@@ -84,7 +89,14 @@ namespace SoundFlow.Providers
         public event EventHandler<EventArgs>? EndOfStreamReached;
 
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
 
         /// <inheritdoc />
         /// <exception cref="ObjectDisposedException">Thrown if the provider has been disposed.</exception>
@@ -96,12 +108,13 @@ namespace SoundFlow.Providers
 
             if (samplesActuallyRead == 0)
             {
+                Clock.Publish(_position, false);
                 EndOfStreamReached?.Invoke(this, EventArgs.Empty);
                 return 0;
             }
 
             _position += samplesActuallyRead;
-            PositionChanged?.Invoke(this, new PositionChangedEventArgs(_position));
+            Clock.Publish(_position);
             return samplesActuallyRead;
         }
 
@@ -127,7 +140,7 @@ namespace SoundFlow.Providers
             }
 
             _position = sampleOffset;
-            PositionChanged?.Invoke(this, new PositionChangedEventArgs(_position));
+            Clock.Publish(_position, false);
         }
 
         /// <summary>
@@ -138,6 +151,7 @@ namespace SoundFlow.Providers
             if (IsDisposed) return;
 
             _pcmStream?.Dispose();
+            Clock.Dispose();
             IsDisposed = true;
             GC.SuppressFinalize(this);
         }
@@ -2,6 +2,7 @@ using SoundFlow.Abstracts;
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
 using SoundFlow.Structs;
+using SoundFlow.Utils;
 using System;
 using System.IO;
 
@@ -24,6 +25,7 @@ namespace SoundFlow.Providers
         public StreamDataProvider(AudioEngine engine, AudioFormat format, Stream stream)
         {
             _stream = stream ?? throw new ArgumentNullException(nameof(stream));
+            Clock = new PositionClock(this);
             _decoder = engine.CreateDecoder(stream, format);
             SampleRate = _decoder.SampleRate;
 
@@ -53,7 +55,14 @@ namespace SoundFlow.Providers
         public event EventHandler<EventArgs>? EndOfStreamReached;
 
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
+        {
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
+        }
 
         /// <inheritdoc />
         public int ReadBytes(Span<float> buffer)
@@ -61,6 +70,7 @@ namespace SoundFlow.Providers
             if (IsDisposed) return 0;
             var count = _decoder.Decode(buffer);
             Position += count;
+            Clock.Publish(Position, count > 0);
             return count;
         }
 
@@ -78,7 +88,7 @@ namespace SoundFlow.Providers
             _decoder.Seek(sampleOffset);
             Position = sampleOffset;
 
-            PositionChanged?.Invoke(this, new PositionChangedEventArgs(Position));
+            Clock.Publish(Position, false);
         }
 
         /// <inheritdoc />
@@ -87,6 +97,7 @@ namespace SoundFlow.Providers
             if (IsDisposed) return;
             _decoder.Dispose();
             _stream.Dispose();
+            Clock.Dispose();
             IsDisposed = true;
         }
     }
@@ -0,0 +1,80 @@
+using SoundFlow.Abstracts.Devices;
+using SoundFlow.Enums;
+using System.Collections.Generic;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// Audio callback statistics of one device, as captured by <see cref="SoundFlow.Abstracts.AudioEngine.GetPerformanceSnapshot"/>.
+    /// </summary>
+    public readonly struct DevicePerformance
+    {
+        internal DevicePerformance(AudioDevice device, TimingStats callbackTime, double budgetMilliseconds,
+            TimingStats callbackJitter, long deadlineMisses, long lateCallbacks, long[] loadHistogram)
+        {
+            Device = device;
+            Name = device.Info?.Name ?? "Default Device";
+            Capability = device.Capability;
+            CallbackTime = callbackTime;
+            BudgetMilliseconds = budgetMilliseconds;
+            CallbackJitter = callbackJitter;
+            DeadlineMisses = deadlineMisses;
+            LateCallbacks = lateCallbacks;
+            LoadHistogram = loadHistogram;
+        }
+
+        /// <summary>
+        /// Gets the device.
+        /// </summary>
+        public AudioDevice Device { get; }
+
+        /// <summary>
+        /// Gets the device name.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets whether the device plays or captures.
+        /// </summary>
+        public Capability Capability { get; }
+
+        /// <summary>
+        /// Gets the callback durations.
+        /// </summary>
+        public TimingStats CallbackTime { get; }
+
+        /// <summary>
+        /// Gets the sum of the period budgets (the duration of the audio processed) of all measured callbacks, in milliseconds.
+        /// </summary>
+        public double BudgetMilliseconds { get; }
+
+        /// <summary>
+        /// Gets the average callback duration as a fraction of its period budget.
+        /// </summary>
+        public double MeanLoad => BudgetMilliseconds > 0 ? CallbackTime.TotalMilliseconds / BudgetMilliseconds : 0;
+
+        /// <summary>
+        /// Gets how far each callback started from one period after the previous one. A large maximum means the
+        /// backend delivers callbacks in bursts, which eats into the headroom the device buffer gives.
+        /// </summary>
+        public TimingStats CallbackJitter { get; }
+
+        /// <summary>
+        /// Gets the number of callbacks that took longer than their period budget. On a playback device each one risks
+        /// an underrun; on a capture device, an overrun.
+        /// </summary>
+        public long DeadlineMisses { get; }
+
+        /// <summary>
+        /// Gets the number of callbacks that started more than one and a half periods after the previous one: the
+        /// device ran dry (playback underrun) or dropped input (capture overrun), whatever the cause.
+        /// </summary>
+        public long LateCallbacks { get; }
+
+        /// <summary>
+        /// Gets the callback load histogram. Bucket <c>i</c> counts callbacks whose duration was between
+        /// <c>10 * i</c>% and <c>10 * (i + 1)</c>% of their period budget; the last bucket counts everything from 200% up.
+        /// </summary>
+        public IReadOnlyList<long> LoadHistogram { get; }
+    }
+}
@@ -0,0 +1,32 @@
+using SoundFlow.Abstracts;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// Processing time of one modifier on a graph node, as captured by <see cref="AudioEngine.GetPerformanceSnapshot"/>.
+    /// </summary>
+    public readonly struct ModifierPerformance
+    {
+        internal ModifierPerformance(SoundModifier modifier)
+        {
+            Modifier = modifier;
+            Name = modifier.Name;
+            ProcessTime = modifier.ProcessTime;
+        }
+
+        /// <summary>
+        /// Gets the modifier.
+        /// </summary>
+        public SoundModifier Modifier { get; }
+
+        /// <summary>
+        /// Gets the modifier name.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets the time spent in the modifier's <see cref="SoundModifier.Process"/>.
+        /// </summary>
+        public TimingStats ProcessTime { get; }
+    }
+}
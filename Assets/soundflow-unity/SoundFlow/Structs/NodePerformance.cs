@@ -0,0 +1,60 @@
+using SoundFlow.Abstracts;
+using System.Collections.Generic;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// Render timings of one graph node, as captured by <see cref="AudioEngine.GetPerformanceSnapshot"/>.
+    /// </summary>
+    public readonly struct NodePerformance
+    {
+        internal NodePerformance(SoundComponent component, int depth, IReadOnlyList<ModifierPerformance> modifiers,
+            long providerStarvations)
+        {
+            Component = component;
+            Name = component.Name;
+            Depth = depth;
+            InclusiveTime = component.InclusiveTime;
+            ExclusiveTime = component.ExclusiveTime;
+            Modifiers = modifiers;
+            ProviderStarvations = providerStarvations;
+        }
+
+        /// <summary>
+        /// Gets the component.
+        /// </summary>
+        public SoundComponent Component { get; }
+
+        /// <summary>
+        /// Gets the component name.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets the depth of the node below its device's master mixer, which is at depth zero.
+        /// </summary>
+        public int Depth { get; }
+
+        /// <summary>
+        /// Gets the time spent rendering the node, including its inputs and children.
+        /// </summary>
+        public TimingStats InclusiveTime { get; }
+
+        /// <summary>
+        /// Gets the time spent rendering the node itself: generating audio, running modifiers and analyzers and mixing
+        /// into the parent. A mixer that renders branches in parallel also counts the time it waits for them.
+        /// </summary>
+        public TimingStats ExclusiveTime { get; }
+
+        /// <summary>
+        /// Gets the processing time of each of the node's modifiers.
+        /// </summary>
+        public IReadOnlyList<ModifierPerformance> Modifiers { get; }
+
+        /// <summary>
+        /// Gets the number of reads the node's data provider padded with silence because audio was not ready in time,
+        /// or -1 if the node has no provider that counts them.
+        /// </summary>
+        public long ProviderStarvations { get; }
+    }
+}
@@ -0,0 +1,27 @@
+using System.Collections.Generic;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// A point-in-time copy of an engine's performance statistics, returned by
+    /// <see cref="SoundFlow.Abstracts.AudioEngine.GetPerformanceSnapshot"/>.
+    /// </summary>
+    public readonly struct PerformanceSnapshot
+    {
+        internal PerformanceSnapshot(IReadOnlyList<DevicePerformance> devices, IReadOnlyList<NodePerformance> nodes)
+        {
+            Devices = devices;
+            Nodes = nodes;
+        }
+
+        /// <summary>
+        /// Gets the callback statistics of every active device.
+        /// </summary>
+        public IReadOnlyList<DevicePerformance> Devices { get; }
+
+        /// <summary>
+        /// Gets the render timings of every node reachable from a playback device's master mixer, depth first.
+        /// </summary>
+        public IReadOnlyList<NodePerformance> Nodes { get; }
+    }
+}
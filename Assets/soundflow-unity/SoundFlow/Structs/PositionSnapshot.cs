@@ -0,0 +1,73 @@
+using System;
+using System.Diagnostics;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// A position published by a <see cref="Utils.PositionClock"/> together with the moment it was published.
+    /// </summary>
+    public readonly struct PositionSnapshot
+    {
+        /// <summary>
+        /// How far <see cref="EstimatePosition"/> extrapolates past the last publication at most, so a clock whose
+        /// device has stopped calling back freezes instead of running ahead.
+        /// </summary>
+        public static readonly TimeSpan MaxExtrapolation = TimeSpan.FromMilliseconds(100);
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PositionSnapshot"/> struct.
+        /// </summary>
+        /// <param name="position">The position in samples.</param>
+        /// <param name="timestamp">The <see cref="Stopwatch"/> timestamp of the position.</param>
+        /// <param name="isAdvancing">Whether the position was moving forward when it was published.</param>
+        public PositionSnapshot(long position, long timestamp, bool isAdvancing)
+        {
+            Position = position;
+            Timestamp = timestamp;
+            IsAdvancing = isAdvancing;
+        }
+
+        /// <summary>
+        /// Gets the position in samples.
+        /// </summary>
+        public long Position { get; }
+
+        /// <summary>
+        /// Gets the <see cref="Stopwatch"/> timestamp at which the position was reached on the audio thread.
+        /// </summary>
+        public long Timestamp { get; }
+
+        /// <summary>
+        /// Gets a value indicating whether playback was advancing the position when it was published, as opposed
+        /// to a seek or pause setting it.
+        /// </summary>
+        public bool IsAdvancing { get; }
+
+        /// <summary>
+        /// Gets the time elapsed since the position was published.
+        /// </summary>
+        public TimeSpan Age => TimeSpan.FromSeconds((Stopwatch.GetTimestamp() - Timestamp) / (double)Stopwatch.Frequency);
+
+        /// <summary>
+        /// Estimates the current position by extrapolating from the published one, for smooth scrubbers and
+        /// lip-sync between the block-sized steps in which audio threads advance.
+        /// </summary>
+        /// <param name="samplesPerSecond">
+        /// The rate at which the position advances while playing, in the same samples as <see cref="Position"/>,
+        /// e.g. sample rate times channels for interleaved positions.
+        /// </param>
+        /// <returns>
+        /// The published position plus the samples played since, for at most <see cref="MaxExtrapolation"/>; or the
+        /// published position if it was not advancing.
+        /// </returns>
+        public double EstimatePosition(double samplesPerSecond)
+        {
+            if (!IsAdvancing || samplesPerSecond <= 0) return Position;
+            var elapsed = (Stopwatch.GetTimestamp() - Timestamp) / (double)Stopwatch.Frequency;
+            return Position + Math.Clamp(elapsed, 0, MaxExtrapolation.TotalSeconds) * samplesPerSecond;
+        }
+
+        /// <inheritdoc />
+        public override string ToString() => $"{Position} samples{(IsAdvancing ? "" : " (stopped)")}, {Age.TotalMilliseconds:F1} ms ago";
+    }
+}
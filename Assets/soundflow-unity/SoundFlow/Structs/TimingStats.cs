@@ -0,0 +1,49 @@
+using System.Diagnostics;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// Accumulated timings of a piece of audio-thread work, as captured by performance monitoring.
+    /// </summary>
+    public readonly struct TimingStats
+    {
+        internal TimingStats(long count, long totalTicks, long maxTicks, long lastTicks)
+        {
+            Count = count;
+            TotalMilliseconds = ToMilliseconds(totalTicks);
+            MaxMilliseconds = ToMilliseconds(maxTicks);
+            LastMilliseconds = ToMilliseconds(lastTicks);
+        }
+
+        /// <summary>
+        /// Gets the number of measured runs.
+        /// </summary>
+        public long Count { get; }
+
+        /// <summary>
+        /// Gets the total time of all measured runs, in milliseconds.
+        /// </summary>
+        public double TotalMilliseconds { get; }
+
+        /// <summary>
+        /// Gets the longest measured run, in milliseconds.
+        /// </summary>
+        public double MaxMilliseconds { get; }
+
+        /// <summary>
+        /// Gets the most recent measured run, in milliseconds.
+        /// </summary>
+        public double LastMilliseconds { get; }
+
+        /// <summary>
+        /// Gets the average run, in milliseconds.
+        /// </summary>
+        public double MeanMilliseconds => Count > 0 ? TotalMilliseconds / Count : 0;
+
+        /// <inheritdoc />
+        public override string ToString() =>
+            $"{Count} runs, mean {MeanMilliseconds:F3} ms, max {MaxMilliseconds:F3} ms";
+
+        private static double ToMilliseconds(long ticks) => ticks * 1000.0 / Stopwatch.Frequency;
+    }
+}
@@ -0,0 +1,41 @@
+using System;
+
+namespace SoundFlow.Structs
+{
+    /// <summary>
+    /// Identifies one voice started on a <see cref="SoundFlow.Components.VoicePool"/>.
+    /// </summary>
+    /// <remarks>
+    /// Handles are never reused, so a handle to a voice that has finished or been stolen simply stops matching;
+    /// commands sent through it are ignored. The default value is an invalid handle.
+    /// </remarks>
+    public readonly struct VoiceHandle : IEquatable<VoiceHandle>
+    {
+        internal VoiceHandle(long id)
+        {
+            Id = id;
+        }
+
+        /// <summary>
+        /// Gets the unique id of the voice.
+        /// </summary>
+        public long Id { get; }
+
+        /// <summary>
+        /// Gets a value indicating whether the handle was returned by a successful play call.
+        /// </summary>
+        public bool IsValid => Id != 0;
+
+        /// <inheritdoc />
+        public bool Equals(VoiceHandle other) => Id == other.Id;
+
+        /// <inheritdoc />
+        public override bool Equals(object? obj) => obj is VoiceHandle other && Equals(other);
+
+        /// <inheritdoc />
+        public override int GetHashCode() => Id.GetHashCode();
+
+        /// <inheritdoc />
+        public override string ToString() => $"Voice {Id}";
+    }
+}
@@ -0,0 +1,618 @@
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A cascade of biquad sections applied to several independent lanes at once, such as the channels of an
+    /// interleaved buffer or the channels of several voices packed side by side.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Coefficients and filter state are stored as structure-of-arrays, indexed by <c>stage * Lanes + lane</c>, so
+    /// consecutive lanes of one stage sit next to each other in memory. Lanes are processed in groups of
+    /// <see cref="Vector{T}.Count"/> with one SIMD register per coefficient and state variable.
+    /// </para>
+    /// <para>
+    /// Lanes left over, which for mono and stereo is every lane, are vectorized across frames instead: each
+    /// section keeps its block form, the response of <see cref="Vector{T}.Count"/> outputs to as many inputs and
+    /// to the four state values, so a block of frames costs one vector multiply-add per input and per state value
+    /// rather than a serial recursion per frame. The state enters the block form as levels and differences, which
+    /// keeps it within a few roundings of the recursion, and sections with poles very close to z = 1, such as
+    /// sub-bass filters and shelves, keep the recursion. The block forms are recomputed after a coefficient change,
+    /// without allocating; frames inside a ramp, the frames after the last whole block, and every lane when SIMD is
+    /// unavailable, use the scalar recursion.
+    /// </para>
+    /// <para>
+    /// A cascade can run fewer lanes than it was created with: <see cref="Process(Span{float}, int)"/> filters
+    /// the first lanes of a buffer with that many channels, so owners can size it once for the largest channel
+    /// count they expect and never reallocate it on the audio thread.
+    /// </para>
+    /// <para>
+    /// Coefficient changes can be ramped: <see cref="SetCoefficients(int, BiquadCoefficients)"/> sets a target and
+    /// the coefficients move linearly towards it over <see cref="SmoothingSamples"/> frames, so parameter
+    /// automation neither recomputes the filter design per sample nor clicks. Each frame's coefficients are
+    /// computed from the start of the ramp rather than accumulated, so they stay on the line. The cascade is not
+    /// thread-safe; owners apply parameter changes on the audio thread between blocks.
+    /// </para>
+    /// </remarks>
+    public sealed class BiquadCascade
+    {
+        // Magnitudes below this are flushed to zero after each block so decaying tails never turn denormal.
+        private const float DenormalThreshold = 1e-20f;
+
+        private const int CoefficientCount = 5; // b0, b1, b2, a1, a2
+        private const int StateCount = 4; // x1, x2, y1, y2
+
+        // Sections whose denominator at z = 1, 1 + a1 + a2, is smaller than this (poles below roughly 200 Hz at
+        // 48 kHz) always run the scalar recursion.
+        private const float BlockFormPoleMargin = 1e-3f;
+
+        /// <summary>
+        /// The lane count the built-in filters preallocate, enough for 7.1 audio.
+        /// </summary>
+        public const int DefaultLaneCapacity = 8;
+
+        // Each array holds one plane of Stages * Lanes values per coefficient or state variable.
+        private readonly float[] _coefficients;
+        private readonly float[] _targets;
+        private readonly float[] _steps;
+        private readonly float[] _state;
+        private readonly int _planeSize;
+        private int _smoothingSamples;
+        private int _rampLength;
+        private int _rampRemaining;
+
+        // Block forms for frame-vectorized lanes, BlockFormSize floats per section and lane: the impulse response
+        // padded with Vector<float>.Count - 1 leading zeros, then the responses to x1, x2, y1 and y2.
+        private readonly float[]? _blockForms;
+        private readonly bool[]? _blockFormUsable;
+        private bool _blockFormsValid;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BiquadCascade"/> class with every section set to
+        /// <see cref="BiquadCoefficients.Identity"/>.
+        /// </summary>
+        /// <param name="lanes">The number of independent lanes, e.g. the channel count of an interleaved buffer.</param>
+        /// <param name="stages">The number of biquad sections applied in series to each lane.</param>
+        /// <param name="smoothingSamples">The number of frames over which coefficient changes are ramped.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="lanes"/> is not positive or <paramref name="stages"/> is negative.</exception>
+        public BiquadCascade(int lanes, int stages, int smoothingSamples = 0)
+        {
+            if (lanes <= 0)
+                throw new ArgumentOutOfRangeException(nameof(lanes), "A cascade needs at least one lane.");
+            if (stages < 0)
+                throw new ArgumentOutOfRangeException(nameof(stages), "Stage count cannot be negative.");
+
+            Lanes = lanes;
+            Stages = stages;
+            SmoothingSamples = smoothingSamples;
+            _planeSize = lanes * stages;
+            _coefficients = new float[_planeSize * CoefficientCount];
+            _targets = new float[_planeSize * CoefficientCount];
+            _steps = new float[_planeSize * CoefficientCount];
+            _state = new float[_planeSize * StateCount];
+
+            // Identity sections: b0 = 1, everything else 0.
+            _coefficients.AsSpan(0, _planeSize).Fill(1f);
+            _targets.AsSpan(0, _planeSize).Fill(1f);
+
+            if (Vector.IsHardwareAccelerated)
+            {
+                _blockForms = new float[_planeSize * BlockFormSize];
+                _blockFormUsable = new bool[_planeSize];
+            }
+        }
+
+        private static int BlockFormSize => 6 * Vector<float>.Count;
+
+        /// <summary>
+        /// Gets the ramp length used by the built-in filters and modifiers for parameter changes: 5 ms.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        public static int GetDefaultSmoothingSamples(int sampleRate) => Math.Max(1, sampleRate / 200);
+
+        /// <summary>
+        /// Gets the number of independent lanes.
+        /// </summary>
+        public int Lanes { get; }
+
+        /// <summary>
+        /// Gets the number of biquad sections applied to each lane.
+        /// </summary>
+        public int Stages { get; }
+
+        /// <summary>
+        /// Gets or sets the number of frames over which coefficient changes are interpolated. Zero applies changes
+        /// at the start of the next block.
+        /// </summary>
+        public int SmoothingSamples
+        {
+            get => _smoothingSamples;
+            set => _smoothingSamples = Math.Max(0, value);
+        }
+
+        /// <summary>
+        /// Gets whether a coefficient ramp is still in progress.
+        /// </summary>
+        public bool IsSmoothing => _rampRemaining > 0;
+
+        /// <summary>
+        /// Sets the coefficients of one section on every lane.
+        /// </summary>
+        /// <param name="stage">The section index.</param>
+        /// <param name="coefficients">The new coefficients.</param>
+        public void SetCoefficients(int stage, BiquadCoefficients coefficients)
+        {
+            for (var lane = 0; lane < Lanes; lane++)
+                SetTarget(Index(stage, lane), coefficients);
+            BeginRamp();
+        }
+
+        /// <summary>
+        /// Sets the coefficients of one section on a single lane.
+        /// </summary>
+        /// <param name="stage">The section index.</param>
+        /// <param name="lane">The lane index.</param>
+        /// <param name="coefficients">The new coefficients.</param>
+        public void SetCoefficients(int stage, int lane, BiquadCoefficients coefficients)
+        {
+            SetTarget(Index(stage, lane), coefficients);
+            BeginRamp();
+        }
+
+        /// <summary>
+        /// Gets the coefficients a section is moving towards (or holding, once any ramp has finished).
+        /// </summary>
+        /// <param name="stage">The section index.</param>
+        /// <param name="lane">The lane index.</param>
+        public BiquadCoefficients GetCoefficients(int stage, int lane)
+        {
+            var index = Index(stage, lane);
+            return new BiquadCoefficients(_targets[index], _targets[_planeSize + index],
+                _targets[2 * _planeSize + index], _targets[3 * _planeSize + index], _targets[4 * _planeSize + index]);
+        }
+
+        /// <summary>
+        /// Clears the filter state of every section and lane, and jumps any ramp in progress to its target.
+        /// </summary>
+        public void Reset()
+        {
+            Array.Clear(_state, 0, _state.Length);
+            FinishRamp();
+        }
+
+        /// <summary>
+        /// Filters lane-interleaved frames in place: frame <c>f</c> holds lanes <c>0..Lanes-1</c> at
+        /// <c>buffer[f * Lanes + lane]</c>, exactly like an interleaved multichannel buffer.
+        /// </summary>
+        /// <param name="buffer">The samples to filter. Must hold a whole number of frames.</param>
+        /// <exception cref="ArgumentException">Thrown if the buffer length is not a multiple of <see cref="Lanes"/>.</exception>
+        public void Process(Span<float> buffer) => Process(buffer, Lanes);
+
+        /// <summary>
+        /// Filters frames of <paramref name="lanes"/> interleaved lanes in place through lanes
+        /// <c>0..lanes-1</c> of the cascade. The state of the lanes above is left alone.
+        /// </summary>
+        /// <param name="buffer">The samples to filter. Must hold a whole number of frames.</param>
+        /// <param name="lanes">The number of lanes in each frame, at most <see cref="Lanes"/>.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="lanes"/> is not between 1 and <see cref="Lanes"/>.</exception>
+        /// <exception cref="ArgumentException">Thrown if the buffer length is not a multiple of <paramref name="lanes"/>.</exception>
+        public void Process(Span<float> buffer, int lanes)
+        {
+            if (lanes <= 0 || lanes > Lanes)
+                throw new ArgumentOutOfRangeException(nameof(lanes), "Lane count must be between 1 and the cascade's lane count.");
+            if (buffer.Length % lanes != 0)
+                throw new ArgumentException("The buffer must contain a whole number of frames.", nameof(buffer));
+
+            var frames = buffer.Length / lanes;
+            if (frames == 0 || Stages == 0) return;
+
+            var rampFrames = Math.Min(frames, _rampRemaining);
+            var width = Vector<float>.Count;
+            var vectorLanes = Vector.IsHardwareAccelerated ? lanes / width * width : 0;
+            var blockLanes = _blockForms != null && frames - rampFrames >= width;
+            if (blockLanes && vectorLanes < lanes && !_blockFormsValid)
+                BuildBlockForms();
+
+            for (var stage = 0; stage < Stages; stage++)
+            {
+                var lane = 0;
+                for (; lane < vectorLanes; lane += width)
+                    ProcessVector(buffer, lanes, frames, rampFrames, stage, lane);
+                for (; lane < lanes; lane++)
+                {
+                    if (blockLanes && _blockFormUsable![stage * Lanes + lane])
+                        ProcessBlocks(buffer, lanes, frames, rampFrames, stage, lane);
+                    else
+                        ProcessScalar(buffer, lanes, frames, rampFrames, stage, lane);
+                }
+            }
+
+            _rampRemaining -= rampFrames;
+            if (rampFrames > 0 && _rampRemaining == 0)
+                FinishRamp();
+        }
+
+        /// <summary>
+        /// Filters a single sample of one lane through every section. Intended for callers that cannot work on
+        /// blocks; any coefficient ramp in progress is completed first, since it is defined per frame.
+        /// </summary>
+        /// <param name="sample">The input sample.</param>
+        /// <param name="lane">The lane the sample belongs to.</param>
+        /// <returns>The filtered sample.</returns>
+        public float ProcessSample(float sample, int lane)
+        {
+            if ((uint)lane >= (uint)Lanes)
+                throw new ArgumentOutOfRangeException(nameof(lane));
+            if (_rampRemaining > 0)
+                FinishRamp();
+
+            for (var stage = 0; stage < Stages; stage++)
+            {
+                var i = stage * Lanes + lane;
+                var y = _coefficients[i] * sample + _coefficients[_planeSize + i] * _state[i] +
+                        _coefficients[2 * _planeSize + i] * _state[_planeSize + i] -
+                        _coefficients[3 * _planeSize + i] * _state[2 * _planeSize + i] -
+                        _coefficients[4 * _planeSize + i] * _state[3 * _planeSize + i];
+                _state[_planeSize + i] = _state[i];
+                _state[i] = sample;
+                _state[3 * _planeSize + i] = _state[2 * _planeSize + i];
+                _state[2 * _planeSize + i] = y;
+                sample = y;
+            }
+
+            return sample;
+        }
+
+        private void ProcessScalar(Span<float> buffer, int stride, int frames, int rampFrames, int stage, int lane)
+        {
+            var p = _planeSize;
+            var index = stage * Lanes + lane;
+            var s = _state;
+
+            // Without ramp frames of its own while a ramp is pending, this is the tail of a block whose ramp ended
+            // earlier in it: the ramp's targets apply, though FinishRamp has not copied them yet.
+            var c = rampFrames == 0 && _rampRemaining > 0 ? _targets : _coefficients;
+
+            float b0 = c[index], b1 = c[p + index], b2 = c[2 * p + index], a1 = c[3 * p + index], a2 = c[4 * p + index];
+            float x1 = s[index], x2 = s[p + index], y1 = s[2 * p + index], y2 = s[3 * p + index];
+
+            var i = lane;
+            var f = 0;
+
+            if (rampFrames > 0)
+            {
+                // Each frame's coefficients are computed from the ramp start, so they do not drift from the line.
+                var d = _steps;
+                float db0 = d[index], db1 = d[p + index], db2 = d[2 * p + index], da1 = d[3 * p + index], da2 = d[4 * p + index];
+                float sb0 = b0, sb1 = b1, sb2 = b2, sa1 = a1, sa2 = a2;
+                var elapsed = _rampLength - _rampRemaining;
+                for (; f < rampFrames; f++, i += stride)
+                {
+                    float t = elapsed + f + 1;
+                    b0 = sb0 + t * db0;
+                    b1 = sb1 + t * db1;
+                    b2 = sb2 + t * db2;
+                    a1 = sa1 + t * da1;
+                    a2 = sa2 + t * da2;
+
+                    var x = buffer[i];
+                    var y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+                    x2 = x1;
+                    x1 = x;
+                    y2 = y1;
+                    y1 = y;
+                    buffer[i] = y;
+                }
+
+                // A ramp that ends inside the block holds its target for the rest of it.
+                if (f < frames)
+                {
+                    var g = _targets;
+                    b0 = g[index];
+                    b1 = g[p + index];
+                    b2 = g[2 * p + index];
+                    a1 = g[3 * p + index];
+                    a2 = g[4 * p + index];
+                }
+            }
+
+            for (; f < frames; f++, i += stride)
+            {
+                var x = buffer[i];
+                var y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+                x2 = x1;
+                x1 = x;
+                y2 = y1;
+                y1 = y;
+                buffer[i] = y;
+            }
+
+            s[index] = FlushDenormal(x1);
+            s[p + index] = FlushDenormal(x2);
+            s[2 * p + index] = FlushDenormal(y1);
+            s[3 * p + index] = FlushDenormal(y2);
+        }
+
+        private unsafe void ProcessVector(Span<float> buffer, int stride, int frames, int rampFrames, int stage, int lane)
+        {
+            var p = _planeSize;
+            var index = stage * Lanes + lane;
+            var c = _coefficients.AsSpan();
+            var s = _state.AsSpan();
+
+            var b0 = Load(c, index);
+            var b1 = Load(c, p + index);
+            var b2 = Load(c, 2 * p + index);
+            var a1 = Load(c, 3 * p + index);
+            var a2 = Load(c, 4 * p + index);
+            var x1 = Load(s, index);
+            var x2 = Load(s, p + index);
+            var y1 = Load(s, 2 * p + index);
+            var y2 = Load(s, 3 * p + index);
+
+            var f = 0;
+
+            // Frames are strided, so samples are addressed by pointer rather than through a cast span; each lane group
+            // reads Vector<float>.Count consecutive floats of a frame.
+            fixed (float* samples = buffer)
+            {
+                var frame = samples + lane;
+
+                if (rampFrames > 0)
+                {
+                    var d = _steps.AsSpan();
+                    var db0 = Load(d, index);
+                    var db1 = Load(d, p + index);
+                    var db2 = Load(d, 2 * p + index);
+                    var da1 = Load(d, 3 * p + index);
+                    var da2 = Load(d, 4 * p + index);
+                    var sb0 = b0;
+                    var sb1 = b1;
+                    var sb2 = b2;
+                    var sa1 = a1;
+                    var sa2 = a2;
+                    var elapsed = _rampLength - _rampRemaining;
+                    for (; f < rampFrames; f++, frame += stride)
+                    {
+                        var t = new Vector<float>(elapsed + f + 1);
+                        b0 = sb0 + t * db0;
+                        b1 = sb1 + t * db1;
+                        b2 = sb2 + t * db2;
+                        a1 = sa1 + t * da1;
+                        a2 = sa2 + t * da2;
+
+                        var x = *(Vector<float>*)frame;
+                        var y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+                        x2 = x1;
+                        x1 = x;
+                        y2 = y1;
+                        y1 = y;
+                        *(Vector<float>*)frame = y;
+                    }
+
+                    if (f < frames)
+                    {
+                        var g = _targets.AsSpan();
+                        b0 = Load(g, index);
+                        b1 = Load(g, p + index);
+                        b2 = Load(g, 2 * p + index);
+                        a1 = Load(g, 3 * p + index);
+                        a2 = Load(g, 4 * p + index);
+                    }
+                }
+
+                for (; f < frames; f++, frame += stride)
+                {
+                    var x = *(Vector<float>*)frame;
+                    var y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+                    x2 = x1;
+                    x1 = x;
+                    y2 = y1;
+                    y1 = y;
+                    *(Vector<float>*)frame = y;
+                }
+            }
+
+            Store(s, index, FlushDenormal(x1));
+            Store(s, p + index, FlushDenormal(x2));
+            Store(s, 2 * p + index, FlushDenormal(y1));
+            Store(s, 3 * p + index, FlushDenormal(y2));
+        }
+
+        /// <summary>
+        /// Filters one lane of one section a block of <see cref="Vector{T}.Count"/> frames at a time through its
+        /// block form. The ramp, if any, and the frames after the last whole block run through the scalar recursion.
+        /// </summary>
+        private void ProcessBlocks(Span<float> buffer, int stride, int frames, int rampFrames, int stage, int lane)
+        {
+            var width = Vector<float>.Count;
+            if (rampFrames > 0)
+            {
+                ProcessScalar(buffer.Slice(0, rampFrames * stride), stride, rampFrames, rampFrames, stage, lane);
+                buffer = buffer.Slice(rampFrames * stride);
+                frames -= rampFrames;
+            }
+
+            var p = _planeSize;
+            var index = stage * Lanes + lane;
+            var s = _state;
+            float x1 = s[index], x2 = s[p + index], y1 = s[2 * p + index], y2 = s[3 * p + index];
+
+            var form = _blockForms.AsSpan(index * BlockFormSize, BlockFormSize);
+            var responses = MemoryMarshal.Cast<float, Vector<float>>(form.Slice(2 * width, 4 * width));
+            Span<float> block = stackalloc float[width];
+
+            var blocks = frames / width;
+            var i = lane;
+            for (var b = 0; b < blocks; b++)
+            {
+                for (var k = 0; k < width; k++)
+                    block[k] = buffer[i + k * stride];
+
+                // Two accumulators halve the dependency chain through the adds. The state enters as a level and a
+                // difference, so poles near z = 1 do not cancel large terms against each other.
+                var even = responses[0] * x1 + responses[2] * y1;
+                var odd = responses[1] * (x2 - x1) + responses[3] * (y2 - y1);
+                for (var j = 0; j < width; j += 2)
+                {
+                    even += Load(form, width - 1 - j) * block[j];
+                    odd += Load(form, width - 2 - j) * block[j + 1];
+                }
+
+                x1 = block[width - 1];
+                x2 = block[width - 2];
+                var y = even + odd;
+                Store(block, 0, y);
+                y1 = block[width - 1];
+                y2 = block[width - 2];
+
+                for (var k = 0; k < width; k++)
+                    buffer[i + k * stride] = block[k];
+                i += width * stride;
+            }
+
+            s[index] = x1;
+            s[p + index] = x2;
+            s[2 * p + index] = y1;
+            s[3 * p + index] = y2;
+
+            var done = blocks * width;
+            if (done < frames)
+                ProcessScalar(buffer.Slice(done * stride), stride, frames - done, 0, stage, lane);
+            else
+                FlushState(index);
+        }
+
+        /// <summary>
+        /// Computes the block form of every section and lane from the target coefficients, which are the ones in
+        /// use once a ramp ending in this block has finished.
+        /// </summary>
+        private void BuildBlockForms()
+        {
+            var width = Vector<float>.Count;
+            var p = _planeSize;
+            var c = _targets;
+            for (var index = 0; index < p; index++)
+            {
+                float b0 = c[index], b1 = c[p + index], b2 = c[2 * p + index], a1 = c[3 * p + index], a2 = c[4 * p + index];
+                var form = _blockForms.AsSpan(index * BlockFormSize, BlockFormSize);
+                form.Clear();
+
+                // Block forms of sections with poles this close to z = 1 lose precision the recursion keeps.
+                _blockFormUsable![index] = Math.Abs(1f + a1 + a2) >= BlockFormPoleMargin;
+                if (!_blockFormUsable[index]) continue;
+
+                // form[width - 1 + n] is the response at frame n to an impulse at frame 0.
+                Respond(form.Slice(width - 1, width), b0, b1, b2, a1, a2, 1f, 0f, 0f, 0f, 0f);
+                // The state responses are to x1 = x2 = 1, x2 = 1, y1 = y2 = 1 and y2 = 1, matching how ProcessBlocks
+                // splits the state into levels and differences.
+                Respond(form.Slice(2 * width, width), b0, b1, b2, a1, a2, 0f, 1f, 1f, 0f, 0f);
+                Respond(form.Slice(3 * width, width), b0, b1, b2, a1, a2, 0f, 0f, 1f, 0f, 0f);
+                Respond(form.Slice(4 * width, width), b0, b1, b2, a1, a2, 0f, 0f, 0f, 1f, 1f);
+                Respond(form.Slice(5 * width, width), b0, b1, b2, a1, a2, 0f, 0f, 0f, 0f, 1f);
+            }
+
+            _blockFormsValid = true;
+        }
+
+        /// <summary>
+        /// Runs one section from the given state over an input that is <paramref name="impulse"/> at frame 0 and
+        /// silent after, writing the output into <paramref name="output"/>. Accumulates in double.
+        /// </summary>
+        private static void Respond(Span<float> output, double b0, double b1, double b2, double a1, double a2,
+            double impulse, double x1, double x2, double y1, double y2)
+        {
+            for (var n = 0; n < output.Length; n++)
+            {
+                var x = n == 0 ? impulse : 0.0;
+                var y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+                x2 = x1;
+                x1 = x;
+                y2 = y1;
+                y1 = y;
+                output[n] = (float)y;
+            }
+        }
+
+        private void FlushState(int index)
+        {
+            var p = _planeSize;
+            for (var k = 0; k < StateCount; k++)
+                _state[k * p + index] = FlushDenormal(_state[k * p + index]);
+        }
+
+        private int Index(int stage, int lane)
+        {
+            if ((uint)stage >= (uint)Stages)
+                throw new ArgumentOutOfRangeException(nameof(stage));
+            if ((uint)lane >= (uint)Lanes)
+                throw new ArgumentOutOfRangeException(nameof(lane));
+            return stage * Lanes + lane;
+        }
+
+        private void SetTarget(int index, BiquadCoefficients coefficients)
+        {
+            var p = _planeSize;
+            _targets[index] = coefficients.B0;
+            _targets[p + index] = coefficients.B1;
+            _targets[2 * p + index] = coefficients.B2;
+            _targets[3 * p + index] = coefficients.A1;
+            _targets[4 * p + index] = coefficients.A2;
+        }
+
+        /// <summary>
+        /// Restarts the ramp from the current coefficients towards the targets of every section, so a change made
+        /// mid-ramp continues smoothly from wherever the previous ramp had got to.
+        /// </summary>
+        private void BeginRamp()
+        {
+            if (_smoothingSamples == 0)
+            {
+                FinishRamp();
+                return;
+            }
+
+            // The coefficients hold the start of a ramp in progress; move them to where it has got to first.
+            var elapsed = _rampLength - _rampRemaining;
+            if (_rampRemaining > 0 && elapsed > 0)
+            {
+                for (var k = 0; k < _coefficients.Length; k++)
+                    _coefficients[k] += elapsed * _steps[k];
+            }
+
+            var inverse = 1f / _smoothingSamples;
+            for (var k = 0; k < _coefficients.Length; k++)
+                _steps[k] = (_targets[k] - _coefficients[k]) * inverse;
+            _rampLength = _smoothingSamples;
+            _rampRemaining = _smoothingSamples;
+            _blockFormsValid = false;
+        }
+
+        private void FinishRamp()
+        {
+            _targets.AsSpan().CopyTo(_coefficients);
+            _rampRemaining = 0;
+            _blockFormsValid = false;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<float> Load(Span<float> span, int offset) =>
+            MemoryMarshal.Read<Vector<float>>(MemoryMarshal.AsBytes(span.Slice(offset, Vector<float>.Count)));
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void Store(Span<float> span, int offset, Vector<float> value) =>
+            MemoryMarshal.Write(MemoryMarshal.AsBytes(span.Slice(offset, Vector<float>.Count)), ref value);
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static float FlushDenormal(float value) => MathF.Abs(value) < DenormalThreshold ? 0f : value;
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<float> FlushDenormal(Vector<float> value) =>
+            Vector.ConditionalSelect(Vector.LessThan(Vector.Abs(value), new Vector<float>(DenormalThreshold)),
+                Vector<float>.Zero, value);
+    }
+}
@@ -0,0 +1,241 @@
+using System;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// Normalized coefficients of a direct form I biquad section:
+    /// <c>y[n] = B0 x[n] + B1 x[n-1] + B2 x[n-2] - A1 y[n-1] - A2 y[n-2]</c>.
+    /// </summary>
+    /// <remarks>
+    /// The second-order designs follow the RBJ audio EQ cookbook. Frequencies are clamped just inside
+    /// <c>(0, sampleRate / 2)</c> so out-of-range parameters cannot produce an unstable section.
+    /// </remarks>
+    public readonly struct BiquadCoefficients
+    {
+        /// <summary>The feed-forward coefficient for the current input.</summary>
+        public readonly float B0;
+
+        /// <summary>The feed-forward coefficient for the previous input.</summary>
+        public readonly float B1;
+
+        /// <summary>The feed-forward coefficient for the input two samples back.</summary>
+        public readonly float B2;
+
+        /// <summary>The feedback coefficient for the previous output.</summary>
+        public readonly float A1;
+
+        /// <summary>The feedback coefficient for the output two samples back.</summary>
+        public readonly float A2;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BiquadCoefficients"/> struct from coefficients already
+        /// normalized by a0.
+        /// </summary>
+        public BiquadCoefficients(float b0, float b1, float b2, float a1, float a2)
+        {
+            B0 = b0;
+            B1 = b1;
+            B2 = b2;
+            A1 = a1;
+            A2 = a2;
+        }
+
+        /// <summary>
+        /// Gets a section that passes its input through unchanged.
+        /// </summary>
+        public static BiquadCoefficients Identity => new BiquadCoefficients(1f, 0f, 0f, 0f, 0f);
+
+        /// <summary>
+        /// Creates a second-order low-pass section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The cutoff frequency in Hertz.</param>
+        /// <param name="q">The quality factor.</param>
+        public static BiquadCoefficients LowPass(float sampleRate, float frequency, float q)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var alpha = sin / (2 * q);
+            return Normalize((1 - cos) / 2, 1 - cos, (1 - cos) / 2, 1 + alpha, -2 * cos, 1 - alpha);
+        }
+
+        /// <summary>
+        /// Creates a second-order high-pass section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The cutoff frequency in Hertz.</param>
+        /// <param name="q">The quality factor.</param>
+        public static BiquadCoefficients HighPass(float sampleRate, float frequency, float q)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var alpha = sin / (2 * q);
+            return Normalize((1 + cos) / 2, -(1 + cos), (1 + cos) / 2, 1 + alpha, -2 * cos, 1 - alpha);
+        }
+
+        /// <summary>
+        /// Creates a band-pass section with a constant 0 dB peak gain.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The center frequency in Hertz.</param>
+        /// <param name="q">The quality factor.</param>
+        public static BiquadCoefficients BandPass(float sampleRate, float frequency, float q)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var alpha = sin / (2 * q);
+            return Normalize(alpha, 0, -alpha, 1 + alpha, -2 * cos, 1 - alpha);
+        }
+
+        /// <summary>
+        /// Creates a notch section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The center frequency in Hertz.</param>
+        /// <param name="q">The quality factor.</param>
+        public static BiquadCoefficients Notch(float sampleRate, float frequency, float q)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var alpha = sin / (2 * q);
+            return Normalize(1, -2 * cos, 1, 1 + alpha, -2 * cos, 1 - alpha);
+        }
+
+        /// <summary>
+        /// Creates an all-pass section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The center frequency in Hertz.</param>
+        /// <param name="q">The quality factor.</param>
+        public static BiquadCoefficients AllPass(float sampleRate, float frequency, float q)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var alpha = sin / (2 * q);
+            return Normalize(1 - alpha, -2 * cos, 1 + alpha, 1 + alpha, -2 * cos, 1 - alpha);
+        }
+
+        /// <summary>
+        /// Creates a peaking EQ section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The center frequency in Hertz.</param>
+        /// <param name="gainDb">The boost or cut at the center frequency, in decibels.</param>
+        /// <param name="q">The quality factor.</param>
+        public static BiquadCoefficients Peaking(float sampleRate, float frequency, float gainDb, float q)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var a = MathF.Pow(10, gainDb / 40);
+            var alpha = sin / (2 * q);
+            return Normalize(1 + alpha * a, -2 * cos, 1 - alpha * a, 1 + alpha / a, -2 * cos, 1 - alpha / a);
+        }
+
+        /// <summary>
+        /// Creates a low-shelf section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The shelf midpoint frequency in Hertz.</param>
+        /// <param name="gainDb">The shelf gain in decibels.</param>
+        /// <param name="slope">The shelf slope; 1 is the steepest slope without overshoot.</param>
+        public static BiquadCoefficients LowShelf(float sampleRate, float frequency, float gainDb, float slope)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var a = MathF.Pow(10, gainDb / 40);
+            var beta = 2 * MathF.Sqrt(a) * ShelfAlpha(sin, a, slope);
+            return Normalize(
+                a * ((a + 1) - (a - 1) * cos + beta),
+                2 * a * ((a - 1) - (a + 1) * cos),
+                a * ((a + 1) - (a - 1) * cos - beta),
+                (a + 1) + (a - 1) * cos + beta,
+                -2 * ((a - 1) + (a + 1) * cos),
+                (a + 1) + (a - 1) * cos - beta);
+        }
+
+        /// <summary>
+        /// Creates a high-shelf section.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The shelf midpoint frequency in Hertz.</param>
+        /// <param name="gainDb">The shelf gain in decibels.</param>
+        /// <param name="slope">The shelf slope; 1 is the steepest slope without overshoot.</param>
+        public static BiquadCoefficients HighShelf(float sampleRate, float frequency, float gainDb, float slope)
+        {
+            Prepare(sampleRate, frequency, out var sin, out var cos);
+            var a = MathF.Pow(10, gainDb / 40);
+            var beta = 2 * MathF.Sqrt(a) * ShelfAlpha(sin, a, slope);
+            return Normalize(
+                a * ((a + 1) + (a - 1) * cos + beta),
+                -2 * a * ((a - 1) + (a + 1) * cos),
+                a * ((a + 1) + (a - 1) * cos - beta),
+                (a + 1) - (a - 1) * cos + beta,
+                2 * ((a - 1) - (a + 1) * cos),
+                (a + 1) - (a - 1) * cos - beta);
+        }
+
+        /// <summary>
+        /// Creates a first-order (RC) low-pass section: <c>y[n] = y[n-1] + alpha (x[n] - y[n-1])</c>.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The cutoff frequency in Hertz.</param>
+        public static BiquadCoefficients OnePoleLowPass(float sampleRate, float frequency)
+        {
+            var alpha = OnePoleLowPassAlpha(sampleRate, frequency);
+            return new BiquadCoefficients(alpha, 0, 0, alpha - 1, 0);
+        }
+
+        /// <summary>
+        /// Creates a first-order (RC) high-pass section: <c>y[n] = alpha (y[n-1] + x[n] - x[n-1])</c>.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <param name="frequency">The cutoff frequency in Hertz.</param>
+        public static BiquadCoefficients OnePoleHighPass(float sampleRate, float frequency)
+        {
+            var alpha = OnePoleHighPassAlpha(sampleRate, frequency);
+            return new BiquadCoefficients(alpha, -alpha, 0, -alpha, 0);
+        }
+
+        /// <summary>
+        /// Gets the smoothing factor of a first-order RC low-pass filter.
+        /// </summary>
+        public static float OnePoleLowPassAlpha(float sampleRate, float frequency)
+        {
+            var dt = 1f / sampleRate;
+            var rc = 1f / (2 * MathF.PI * frequency);
+            return dt / (rc + dt);
+        }
+
+        /// <summary>
+        /// Gets the smoothing factor of a first-order RC high-pass filter.
+        /// </summary>
+        public static float OnePoleHighPassAlpha(float sampleRate, float frequency)
+        {
+            var dt = 1f / sampleRate;
+            var rc = 1f / (2 * MathF.PI * frequency);
+            return rc / (rc + dt);
+        }
+
+        /// <summary>
+        /// Evaluates one sample through this section given its delay state.
+        /// </summary>
+        public float Process(float x, ref float x1, ref float x2, ref float y1, ref float y2)
+        {
+            var y = B0 * x + B1 * x1 + B2 * x2 - A1 * y1 - A2 * y2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            return y;
+        }
+
+        private static void Prepare(float sampleRate, float frequency, out float sin, out float cos)
+        {
+            if (sampleRate <= 0)
+                throw new ArgumentOutOfRangeException(nameof(sampleRate), "Sample rate must be positive.");
+
+            var omega = 2 * MathF.PI * Math.Clamp(frequency, 1e-3f, sampleRate * 0.4999f) / sampleRate;
+            sin = MathF.Sin(omega);
+            cos = MathF.Cos(omega);
+        }
+
+        private static float ShelfAlpha(float sin, float a, float slope) =>
+            sin / 2 * MathF.Sqrt((a + 1 / a) * (1 / slope - 1) + 2);
+
+        private static BiquadCoefficients Normalize(float b0, float b1, float b2, float a0, float a1, float a2) =>
+            new BiquadCoefficients(b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0);
+    }
+}
@@ -0,0 +1,165 @@
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// Allocation-free statistics of a device's audio callbacks, measured against each callback's period budget.
+    /// </summary>
+    /// <remarks>
+    /// The budget of a callback is the duration of the frames it processes. Load is the callback duration divided by
+    /// that budget and is histogrammed in <see cref="BucketWidth"/> steps, with the last bucket collecting every
+    /// callback at or above <see cref="HistogramBuckets"/> - 1 steps. Written by the device's callback thread only.
+    /// </remarks>
+    internal sealed class CallbackMonitor
+    {
+        /// <summary>
+        /// The number of load histogram buckets.
+        /// </summary>
+        public const int HistogramBuckets = 21;
+
+        /// <summary>
+        /// The load range covered by one histogram bucket (10% of the period budget).
+        /// </summary>
+        public const double BucketWidth = 0.1;
+
+        // A callback that starts this many periods after the previous one means the device ran dry (or overflowed).
+        private const double LateCallbackPeriods = 1.5;
+
+        private readonly long[] _histogram = new long[HistogramBuckets];
+        private readonly TimingCounter _duration = new();
+        private readonly TimingCounter _jitter = new();
+        private long _deadlineMisses;
+        private long _lateCallbacks;
+        private long _budgetTicks;
+        private long _lastStart;
+        private long _lastBudget;
+        private long _peakDuration;
+        private long _peakJitter;
+        private uint _periodFrames;
+        private volatile bool _isWatched;
+
+        /// <summary>
+        /// Gets the callback durations.
+        /// </summary>
+        public TimingCounter Duration => _duration;
+
+        /// <summary>
+        /// Gets how far each callback started from one period after the previous one.
+        /// </summary>
+        public TimingCounter Jitter => _jitter;
+
+        /// <summary>
+        /// Gets or sets the number of frames of the latest callback, or 0 before the first. Written by every
+        /// callback, whether it is timed or not.
+        /// </summary>
+        public uint PeriodFrames
+        {
+            get => Volatile.Read(ref _periodFrames);
+            set => Volatile.Write(ref _periodFrames, value);
+        }
+
+        /// <summary>
+        /// Gets or sets whether the callbacks are timed even while the engine's performance monitoring is off, as
+        /// they are while an adaptive latency controller watches the device.
+        /// </summary>
+        public bool IsWatched
+        {
+            get => _isWatched;
+            set => _isWatched = value;
+        }
+
+        /// <summary>
+        /// Gets the number of callbacks that took longer than their period budget.
+        /// </summary>
+        public long DeadlineMisses => Interlocked.Read(ref _deadlineMisses);
+
+        /// <summary>
+        /// Gets the number of callbacks that started more than one and a half periods after the previous one.
+        /// </summary>
+        public long LateCallbacks => Interlocked.Read(ref _lateCallbacks);
+
+        /// <summary>
+        /// Gets the sum of the period budgets of all measured callbacks, in ticks.
+        /// </summary>
+        public long BudgetTicks => Interlocked.Read(ref _budgetTicks);
+
+        /// <summary>
+        /// Records one callback.
+        /// </summary>
+        /// <param name="start">The <see cref="Stopwatch"/> timestamp at which the callback started.</param>
+        /// <param name="end">The <see cref="Stopwatch"/> timestamp at which the callback returned.</param>
+        /// <param name="frames">The number of frames the callback processed.</param>
+        /// <param name="sampleRate">The device sample rate.</param>
+        public void Record(long start, long end, uint frames, int sampleRate)
+        {
+            if (sampleRate <= 0 || frames == 0) return;
+
+            var budget = (long)((double)frames * Stopwatch.Frequency / sampleRate);
+            var duration = end - start;
+            _duration.Record(duration);
+            if (duration > Volatile.Read(ref _peakDuration)) Volatile.Write(ref _peakDuration, duration);
+
+            var bucket = budget > 0 ? (int)(duration / (budget * BucketWidth)) : HistogramBuckets - 1;
+            Interlocked.Increment(ref _histogram[Math.Min(Math.Max(bucket, 0), HistogramBuckets - 1)]);
+            Interlocked.Add(ref _budgetTicks, budget);
+
+            if (duration > budget)
+                Interlocked.Increment(ref _deadlineMisses);
+
+            if (_lastStart != 0)
+            {
+                var interval = start - _lastStart;
+                var jitter = Math.Abs(interval - _lastBudget);
+                _jitter.Record(jitter);
+                if (jitter > Volatile.Read(ref _peakJitter)) Volatile.Write(ref _peakJitter, jitter);
+                if (interval > _lastBudget * LateCallbackPeriods)
+                    Interlocked.Increment(ref _lateCallbacks);
+            }
+
+            _lastStart = start;
+            _lastBudget = budget;
+        }
+
+        /// <summary>
+        /// Returns the longest callback and the largest jitter since the previous call, and starts a new window.
+        /// Unlike <see cref="Reset"/>, leaves the accumulated statistics alone.
+        /// </summary>
+        /// <param name="durationTicks">The longest callback duration, in <see cref="Stopwatch"/> ticks.</param>
+        /// <param name="jitterTicks">The largest start jitter, in <see cref="Stopwatch"/> ticks.</param>
+        public void TakePeaks(out long durationTicks, out long jitterTicks)
+        {
+            durationTicks = Interlocked.Exchange(ref _peakDuration, 0);
+            jitterTicks = Interlocked.Exchange(ref _peakJitter, 0);
+        }
+
+        /// <summary>
+        /// Copies the load histogram.
+        /// </summary>
+        /// <param name="destination">A span of at least <see cref="HistogramBuckets"/> elements.</param>
+        public void CopyHistogram(Span<long> destination)
+        {
+            for (var i = 0; i < HistogramBuckets; i++)
+                destination[i] = Interlocked.Read(ref _histogram[i]);
+        }
+
+        /// <summary>
+        /// Clears all statistics. The next callback is never counted as late.
+        /// </summary>
+        public void Reset()
+        {
+            for (var i = 0; i < HistogramBuckets; i++)
+                Interlocked.Exchange(ref _histogram[i], 0);
+
+            _duration.Reset();
+            _jitter.Reset();
+            Interlocked.Exchange(ref _deadlineMisses, 0);
+            Interlocked.Exchange(ref _lateCallbacks, 0);
+            Interlocked.Exchange(ref _budgetTicks, 0);
+            Interlocked.Exchange(ref _peakDuration, 0);
+            Interlocked.Exchange(ref _peakJitter, 0);
+            _lastStart = 0;
+        }
+    }
+}
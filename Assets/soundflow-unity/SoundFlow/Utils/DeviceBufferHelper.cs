@@ -1,5 +1,7 @@
 ﻿using System;
+using System.Numerics;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using SoundFlow.Enums;
 
 namespace SoundFlow.Utils
@@ -8,31 +10,62 @@ namespace SoundFlow.Utils
     /// Provides static methods for converting audio buffers between the internal 32-bit float format
     /// and various device-specific PCM formats.
     /// </summary>
-    public static class DeviceBufferHelper
+    /// <remarks>
+    /// Conversions run as <see cref="Vector{T}"/> kernels when the runtime accelerates them, with a scalar tail,
+    /// and fall back to tight pointer loops otherwise. Down-conversions to 8/16/24-bit can optionally add
+    /// triangular (TPDF) dither of ±1 LSB to decorrelate quantization error from the signal.
+    /// </remarks>
+    public static unsafe class DeviceBufferHelper
     {
+        private const float S16Scale = short.MaxValue;
+        private const float S24Scale = 8388607f;
+        private const float S32Scale = int.MaxValue; // Rounds to 2^31, so products are clamped below.
+        private const float S32MaxFloat = 2147483520f; // Largest float below 2^31.
+
+        [ThreadStatic] private static uint _ditherState;
+
+        /// <summary>
+        /// Gets or sets whether <see cref="ConvertToDeviceFormat(Span{float}, nint, int, SampleFormat)"/> applies
+        /// TPDF dither when converting to U8, S16 or S24. Off by default.
+        /// </summary>
+        public static bool DitherDownConversions { get; set; }
+
+        /// <summary>
+        /// Dispatches conversion from a float buffer to the appropriate device format.
+        /// </summary>
+        public static void ConvertToDeviceFormat(Span<float> source, nint destination, int length, SampleFormat format) =>
+            ConvertToDeviceFormat(source, destination, length, format, DitherDownConversions);
+
         /// <summary>
         /// Dispatches conversion from a float buffer to the appropriate device format.
         /// </summary>
-        public static void ConvertToDeviceFormat(Span<float> source, nint destination, int length, SampleFormat format)
+        /// <param name="source">The float samples to convert. Cleared after conversion.</param>
+        /// <param name="destination">The native buffer to write the converted samples to.</param>
+        /// <param name="length">The number of samples to convert.</param>
+        /// <param name="format">The device sample format.</param>
+        /// <param name="dither">Whether to apply TPDF dither when reducing to 8, 16 or 24 bits.</param>
+        public static void ConvertToDeviceFormat(Span<float> source, nint destination, int length, SampleFormat format, bool dither)
         {
             switch (format)
             {
                 case SampleFormat.S16:
-                    ConvertFloatTo<short>(source, destination, length);
+                    ConvertFloatToS16(source[..length], (short*)destination, dither);
                     break;
                 case SampleFormat.S32:
-                    ConvertFloatTo<int>(source, destination, length);
+                    ConvertFloatToS32(source[..length], (int*)destination);
                     break;
                 case SampleFormat.U8:
-                    ConvertFloatTo<byte>(source, destination, length);
+                    ConvertFloatToU8(source[..length], (byte*)destination, dither);
                     break;
                 case SampleFormat.S24:
-                    ConvertFloatToS24(source, destination, length);
+                    ConvertFloatToS24(source[..length], (byte*)destination, dither);
                     break;
                 case SampleFormat.F32:
-                    break; // F32 is the source format, no conversion needed.
+                    return; // F32 is the source format, no conversion needed.
                 default: throw new NotSupportedException($"Sample format {format} is not supported for output conversion.");
             }
+
+            source[..length].Clear();
         }
 
         /// <summary>
@@ -43,16 +76,16 @@ namespace SoundFlow.Utils
             switch (format)
             {
                 case SampleFormat.S16:
-                    ConvertFrom<short>(source, destination, length);
+                    ConvertS16ToFloat((short*)source, destination[..length]);
                     break;
                 case SampleFormat.S32:
-                    ConvertFrom<int>(source, destination, length);
+                    ConvertS32ToFloat((int*)source, destination[..length]);
                     break;
                 case SampleFormat.U8:
-                    ConvertFrom<byte>(source, destination, length);
+                    ConvertU8ToFloat((byte*)source, destination[..length]);
                     break;
                 case SampleFormat.S24:
-                    ConvertFromS24(source, destination, length);
+                    ConvertS24ToFloat((byte*)source, destination[..length]);
                     break;
                 case SampleFormat.F32:
                     // For F32, we just copy the data.
@@ -62,132 +95,344 @@ namespace SoundFlow.Utils
             }
         }
 
-        #region Generic Conversion Methods
+        #region Float To Device
 
         /// <summary>
-        /// Converts a buffer of float samples to a specified integer PCM format and writes to a native memory location.
+        /// Converts float samples to signed 16-bit PCM.
         /// </summary>
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private static void ConvertFloatTo<T>(Span<float> floatBuffer, nint output, int length) where T : unmanaged
+        private static void ConvertFloatToS16(ReadOnlySpan<float> source, short* output, bool dither)
         {
-            if (typeof(T) == typeof(byte))
+            var i = 0;
+            var state = dither ? BeginDither() : 0u;
+            Span<float> noise = stackalloc float[Vector<float>.Count];
+
+            if (Vector.IsHardwareAccelerated && source.Length >= Vector<short>.Count)
             {
-                var byteSpan = Extensions.GetSpan<byte>(output, length);
-                for (var i = 0; i < length; i++)
+                var min = new Vector<float>(-1f);
+                var max = new Vector<float>(1f);
+                var scale = new Vector<float>(S16Scale);
+                var lower = new Vector<float>(short.MinValue);
+                var upper = new Vector<float>(short.MaxValue);
+                var floatVectors = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var outVectors = new Span<Vector<short>>(output, source.Length / Vector<short>.Count);
+
+                for (var v = 0; v < outVectors.Length; v++)
                 {
-                    var clipped = Math.Clamp(floatBuffer[i], -1f, 1f);
-                    byteSpan[i] = (byte)((clipped * 127.5f) + 127.5f); // Scale [-1,1] to [0,255]
+                    var lo = Vector.Min(Vector.Max(floatVectors[2 * v], min), max) * scale;
+                    var hi = Vector.Min(Vector.Max(floatVectors[2 * v + 1], min), max) * scale;
+                    if (dither)
+                    {
+                        lo = Vector.Min(Vector.Max(lo + NextTpdf(ref state, noise), lower), upper);
+                        hi = Vector.Min(Vector.Max(hi + NextTpdf(ref state, noise), lower), upper);
+                    }
+
+                    outVectors[v] = Vector.Narrow(Vector.ConvertToInt32(lo), Vector.ConvertToInt32(hi));
                 }
+
+                i = outVectors.Length * Vector<short>.Count;
             }
-            else if (typeof(T) == typeof(short))
+
+            for (; i < source.Length; i++)
             {
-                var shortSpan = Extensions.GetSpan<short>(output, length);
-                for (var i = 0; i < length; i++)
+                var scaled = Math.Clamp(source[i], -1f, 1f) * S16Scale;
+                if (dither) scaled = Math.Clamp(scaled + NextTpdf(ref state), short.MinValue, short.MaxValue);
+                output[i] = (short)scaled;
+            }
+
+            if (dither) _ditherState = state;
+        }
+
+        /// <summary>
+        /// Converts float samples to signed 32-bit PCM.
+        /// </summary>
+        private static void ConvertFloatToS32(ReadOnlySpan<float> source, int* output)
+        {
+            var i = 0;
+
+            if (Vector.IsHardwareAccelerated && source.Length >= Vector<int>.Count)
+            {
+                var min = new Vector<float>(-1f);
+                var max = new Vector<float>(1f);
+                var scale = new Vector<float>(S32Scale);
+                var upper = new Vector<float>(S32MaxFloat);
+                var floatVectors = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var outVectors = new Span<Vector<int>>(output, floatVectors.Length);
+
+                for (var v = 0; v < outVectors.Length; v++)
                 {
-                    var clipped = Math.Clamp(floatBuffer[i], -1f, 1f);
-                    shortSpan[i] = (short)(clipped * short.MaxValue);
+                    var scaled = Vector.Min(Vector.Min(Vector.Max(floatVectors[v], min), max) * scale, upper);
+                    outVectors[v] = Vector.ConvertToInt32(scaled);
                 }
+
+                i = outVectors.Length * Vector<int>.Count;
             }
-            else if (typeof(T) == typeof(int))
+
+            const double doubleScale = int.MaxValue;
+            for (; i < source.Length; i++)
+                output[i] = (int)(Math.Clamp(source[i], -1f, 1f) * doubleScale);
+        }
+
+        /// <summary>
+        /// Converts float samples to unsigned 8-bit PCM.
+        /// </summary>
+        private static void ConvertFloatToU8(ReadOnlySpan<float> source, byte* output, bool dither)
+        {
+            var i = 0;
+            var state = dither ? BeginDither() : 0u;
+            Span<float> noise = stackalloc float[Vector<float>.Count];
+
+            if (Vector.IsHardwareAccelerated && source.Length >= Vector<byte>.Count)
             {
-                var intSpan = Extensions.GetSpan<int>(output, length);
-                const double scale = int.MaxValue;
-                for (var i = 0; i < length; i++)
+                var min = new Vector<float>(-1f);
+                var max = new Vector<float>(1f);
+                var half = new Vector<float>(127.5f);
+                var upper = new Vector<float>(255f);
+                var floatVectors = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var outVectors = new Span<Vector<byte>>(output, source.Length / Vector<byte>.Count);
+
+                for (var v = 0; v < outVectors.Length; v++)
                 {
-                    var clipped = Math.Clamp(floatBuffer[i], -1f, 1f);
-                    intSpan[i] = (int)(clipped * scale);
+                    var b = 4 * v;
+                    var q0 = QuantizeU8(floatVectors[b], dither, ref state, noise, min, max, half, upper);
+                    var q1 = QuantizeU8(floatVectors[b + 1], dither, ref state, noise, min, max, half, upper);
+                    var q2 = QuantizeU8(floatVectors[b + 2], dither, ref state, noise, min, max, half, upper);
+                    var q3 = QuantizeU8(floatVectors[b + 3], dither, ref state, noise, min, max, half, upper);
+
+                    var s01 = Vector.AsVectorUInt16(Vector.Narrow(q0, q1));
+                    var s23 = Vector.AsVectorUInt16(Vector.Narrow(q2, q3));
+                    outVectors[v] = Vector.Narrow(s01, s23);
                 }
+
+                i = outVectors.Length * Vector<byte>.Count;
             }
-            else
+
+            for (; i < source.Length; i++)
             {
-                throw new NotSupportedException($"Unsupported output format: {typeof(T)}");
+                var scaled = (Math.Clamp(source[i], -1f, 1f) * 127.5f) + 127.5f; // Scale [-1,1] to [0,255]
+                if (dither) scaled = Math.Clamp(scaled + NextTpdf(ref state), 0f, 255f);
+                output[i] = (byte)scaled;
             }
 
-            floatBuffer.Clear();
+            if (dither) _ditherState = state;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<int> QuantizeU8(Vector<float> sample, bool dither, ref uint state, Span<float> noise,
+            Vector<float> min, Vector<float> max, Vector<float> half, Vector<float> upper)
+        {
+            var scaled = Vector.Min(Vector.Max(sample, min), max) * half + half;
+            if (dither) scaled = Vector.Min(Vector.Max(scaled + NextTpdf(ref state, noise), Vector<float>.Zero), upper);
+            return Vector.ConvertToInt32(scaled);
         }
 
         /// <summary>
-        /// Converts a native buffer from a specified integer PCM format to a buffer of float samples.
+        /// Converts float samples to packed little-endian 24-bit PCM.
         /// </summary>
-        [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        private static void ConvertFrom<T>(nint input, Span<float> floatBuffer, int length) where T : unmanaged
+        private static void ConvertFloatToS24(ReadOnlySpan<float> source, byte* output, bool dither)
         {
-            if (typeof(T) == typeof(byte))
+            var state = dither ? BeginDither() : 0u;
+            var i = 0;
+
+            // Four samples pack into exactly three 32-bit words.
+            for (; i + 4 <= source.Length; i += 4, output += 12)
             {
-                var byteSpan = Extensions.GetSpan<byte>(input, length);
-                const float scale = 1f / 128f;
-                for (var i = 0; i < length; i++)
-                {
-                    int originalSample = byteSpan[i];
-                    Random random = new Random();
-                    var dither = ((float)random.NextDouble() - (float)random.NextDouble());
-                    var ditheredSample = originalSample != 0 ? originalSample + dither : originalSample;
-                    floatBuffer[i] = (ditheredSample - 128f) * scale;
-                }
+                var s0 = QuantizeS24(source[i], dither, ref state);
+                var s1 = QuantizeS24(source[i + 1], dither, ref state);
+                var s2 = QuantizeS24(source[i + 2], dither, ref state);
+                var s3 = QuantizeS24(source[i + 3], dither, ref state);
+
+                var words = new Span<byte>(output, 12);
+                var w0 = (uint)(s0 & 0xFFFFFF) | ((uint)s1 << 24);
+                var w1 = ((uint)(s1 >> 8) & 0xFFFF) | ((uint)s2 << 16);
+                var w2 = ((uint)(s2 >> 16) & 0xFF) | ((uint)s3 << 8);
+                MemoryMarshal.Write(words, ref w0);
+                MemoryMarshal.Write(words[4..], ref w1);
+                MemoryMarshal.Write(words[8..], ref w2);
             }
-            else if (typeof(T) == typeof(short))
+
+            for (; i < source.Length; i++, output += 3)
             {
-                var shortSpan = Extensions.GetSpan<short>(input, length);
-                const float scale = 1f / 32767f;
-                for (var i = 0; i < length; i++)
-                {
-                    floatBuffer[i] = shortSpan[i] * scale;
-                }
+                var sample24 = QuantizeS24(source[i], dither, ref state);
+                output[0] = (byte)sample24;
+                output[1] = (byte)(sample24 >> 8);
+                output[2] = (byte)(sample24 >> 16);
             }
-            else if (typeof(T) == typeof(int))
+
+            if (dither) _ditherState = state;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static int QuantizeS24(float sample, bool dither, ref uint state)
+        {
+            var scaled = Math.Clamp(sample, -1f, 1f) * S24Scale;
+            if (dither) scaled = Math.Clamp(scaled + NextTpdf(ref state), -8388608f, S24Scale);
+            return (int)scaled;
+        }
+
+        #endregion
+
+        #region Device To Float
+
+        /// <summary>
+        /// Converts signed 16-bit PCM to float samples.
+        /// </summary>
+        private static void ConvertS16ToFloat(short* input, Span<float> destination)
+        {
+            const float scale = 1f / 32767f;
+            var i = 0;
+
+            if (Vector.IsHardwareAccelerated && destination.Length >= Vector<short>.Count)
             {
-                var intSpan = Extensions.GetSpan<int>(input, length);
-                const double scale = 1.0 / 2147483647.0;
-                for (var i = 0; i < length; i++)
+                var scaleVector = new Vector<float>(scale);
+                var inVectors = new ReadOnlySpan<Vector<short>>(input, destination.Length / Vector<short>.Count);
+                var outVectors = MemoryMarshal.Cast<float, Vector<float>>(destination);
+
+                for (var v = 0; v < inVectors.Length; v++)
                 {
-                    floatBuffer[i] = (float)(intSpan[i] * scale);
+                    Vector.Widen(inVectors[v], out var lo, out var hi);
+                    outVectors[2 * v] = Vector.ConvertToSingle(lo) * scaleVector;
+                    outVectors[2 * v + 1] = Vector.ConvertToSingle(hi) * scaleVector;
                 }
+
+                i = inVectors.Length * Vector<short>.Count;
             }
-            else
+
+            for (; i < destination.Length; i++)
+                destination[i] = input[i] * scale;
+        }
+
+        /// <summary>
+        /// Converts signed 32-bit PCM to float samples.
+        /// </summary>
+        private static void ConvertS32ToFloat(int* input, Span<float> destination)
+        {
+            var i = 0;
+
+            if (Vector.IsHardwareAccelerated && destination.Length >= Vector<int>.Count)
             {
-                throw new NotSupportedException($"Unsupported input format: {typeof(T)}");
+                var scaleVector = new Vector<float>((float)(1.0 / 2147483647.0));
+                var inVectors = new ReadOnlySpan<Vector<int>>(input, destination.Length / Vector<int>.Count);
+                var outVectors = MemoryMarshal.Cast<float, Vector<float>>(destination);
+
+                for (var v = 0; v < inVectors.Length; v++)
+                    outVectors[v] = Vector.ConvertToSingle(inVectors[v]) * scaleVector;
+
+                i = inVectors.Length * Vector<int>.Count;
             }
+
+            const double scale = 1.0 / 2147483647.0;
+            for (; i < destination.Length; i++)
+                destination[i] = (float)(input[i] * scale);
         }
 
         /// <summary>
-        /// Converts a buffer of float samples to 24-bit PCM format, packing them into a native byte buffer.
+        /// Converts unsigned 8-bit PCM to float samples.
         /// </summary>
-        private static void ConvertFloatToS24(Span<float> floatBuffer, nint output, int length)
+        private static void ConvertU8ToFloat(byte* input, Span<float> destination)
         {
-            var outputSpan = Extensions.GetSpan<byte>(output, length * 3);
-            for (int i = 0, j = 0; i < length; i++, j += 3)
+            const float scale = 1f / 128f;
+            var i = 0;
+
+            if (Vector.IsHardwareAccelerated && destination.Length >= Vector<byte>.Count)
             {
-                var clipped = Math.Clamp(floatBuffer[i], -1f, 1f);
-                var sample24 = (int)(clipped * 8388607);
+                var scaleVector = new Vector<float>(scale);
+                var offset = new Vector<float>(128f);
+                var inVectors = new ReadOnlySpan<Vector<byte>>(input, destination.Length / Vector<byte>.Count);
+                var outVectors = MemoryMarshal.Cast<float, Vector<float>>(destination);
+
+                for (var v = 0; v < inVectors.Length; v++)
+                {
+                    Vector.Widen(inVectors[v], out var lo16, out var hi16);
+                    Vector.Widen(lo16, out var w0, out var w1);
+                    Vector.Widen(hi16, out var w2, out var w3);
+
+                    var o = 4 * v;
+                    outVectors[o] = (Vector.ConvertToSingle(Vector.AsVectorInt32(w0)) - offset) * scaleVector;
+                    outVectors[o + 1] = (Vector.ConvertToSingle(Vector.AsVectorInt32(w1)) - offset) * scaleVector;
+                    outVectors[o + 2] = (Vector.ConvertToSingle(Vector.AsVectorInt32(w2)) - offset) * scaleVector;
+                    outVectors[o + 3] = (Vector.ConvertToSingle(Vector.AsVectorInt32(w3)) - offset) * scaleVector;
+                }
 
-                outputSpan[j] = (byte)sample24;
-                outputSpan[j + 1] = (byte)(sample24 >> 8);
-                outputSpan[j + 2] = (byte)(sample24 >> 16);
+                i = inVectors.Length * Vector<byte>.Count;
             }
 
-            floatBuffer.Clear();
+            for (; i < destination.Length; i++)
+                destination[i] = (input[i] - 128f) * scale;
         }
 
         /// <summary>
-        /// Converts a native 24-bit PCM byte buffer to a buffer of float samples.
+        /// Converts packed little-endian 24-bit PCM to float samples.
         /// </summary>
-        private static void ConvertFromS24(nint input, Span<float> floatBuffer, int length)
+        private static void ConvertS24ToFloat(byte* input, Span<float> destination)
         {
-            var inputSpan = Extensions.GetSpan<byte>(input, length * 3);
             const float scale = 1f / 8388607f;
-            for (int i = 0, j = 0; i < length; i++, j += 3)
-            {
-                // Reconstruct the 24-bit sample from three bytes (little-endian)
-                var sample24 = (inputSpan[j]) | (inputSpan[j + 1] << 8) | (inputSpan[j + 2] << 16);
+            var i = 0;
 
-                // Sign-extend if the 24th bit is set
-                if ((sample24 & 0x800000) != 0)
-                    sample24 |= unchecked((int)0xFF000000);
+            // Read each sample as an unaligned 32-bit word and sign-extend the low 24 bits; the final sample is
+            // read byte-wise so we never touch memory past the end of the buffer.
+            for (; i < destination.Length - 1; i++, input += 3)
+                destination[i] = ((int)(MemoryMarshal.Read<uint>(new ReadOnlySpan<byte>(input, 4)) << 8) >> 8) * scale;
 
-                floatBuffer[i] = sample24 * scale;
+            for (; i < destination.Length; i++, input += 3)
+            {
+                // Reconstruct the 24-bit sample from three bytes (little-endian), sign-extending the 24th bit
+                var sample24 = (input[0] | (input[1] << 8) | (input[2] << 16)) << 8 >> 8;
+                destination[i] = sample24 * scale;
             }
         }
 
         #endregion
+
+        #region Dither
+
+        /// <summary>
+        /// Returns the calling thread's dither generator state, seeding it on first use. Converters advance a local
+        /// copy and store it back when done, so the noise runs on from one buffer to the next.
+        /// </summary>
+        private static uint BeginDither()
+        {
+            var state = _ditherState;
+            return state != 0 ? state : (uint)Environment.TickCount | 1u;
+        }
+
+        /// <summary>
+        /// Returns one sample of TPDF noise in LSB units, in the range (-1, 1): the difference of two uniforms.
+        /// </summary>
+        /// <remarks>
+        /// Drawn straight from the xorshift generator, so it needs no table and does not repeat within its period of
+        /// 2^32 - 1 draws. The two 16-bit halves of one draw serve as the two uniforms, which halves the serial
+        /// generator work per sample; 16 bits is far finer than the quantizer step the noise is there to smear.
+        /// </remarks>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static float NextTpdf(ref uint state)
+        {
+            var x = NextRandom(ref state);
+            return ((int)(x >> 16) - (int)(x & 0xFFFF)) * (1f / 65536f);
+        }
+
+        /// <summary>
+        /// Returns a vector of TPDF noise, generated through <paramref name="noise"/>, which holds one vector of floats.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector<float> NextTpdf(ref uint state, Span<float> noise)
+        {
+            for (var k = 0; k < noise.Length; k++)
+                noise[k] = NextTpdf(ref state);
+            return new Vector<float>(noise);
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static uint NextRandom(ref uint state)
+        {
+            // xorshift32
+            var x = state;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state = x;
+            return x;
+        }
+
+        #endregion
     }
-}
\ No newline at end of file
+}
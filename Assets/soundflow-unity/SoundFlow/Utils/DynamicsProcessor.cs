@@ -0,0 +1,477 @@
+using SoundFlow.Enums;
+using System;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A feed-forward compressor that works on whole blocks of interleaved samples, with per-channel or linked
+    /// detection and optional lookahead.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// A block runs as a few passes over one scratch buffer: detector levels in dBFS, the attack/release envelope,
+    /// the target gain from the static curve, gain smoothing, and finally the gain applied to the (delayed) audio.
+    /// The level, curve and apply passes are vectorized and use <see cref="FastMath"/> instead of <c>Log10</c> and
+    /// <c>Pow</c>; only the two one-pole followers run sample by sample. Attack and release coefficients are
+    /// computed when a parameter changes, not per sample.
+    /// </para>
+    /// <para>
+    /// Parameters may be set from any thread and take effect at the start of the next block. Processing itself is
+    /// not thread-safe and belongs on the audio thread.
+    /// </para>
+    /// </remarks>
+    public sealed class DynamicsProcessor
+    {
+        // Detector levels are floored here (-120 dBFS) so silence neither produces -inf nor sticks the envelope.
+        private const float LevelFloor = 1e-6f;
+        private const float LevelFloorDb = -120f;
+
+        private float _thresholdDb;
+        private float _ratio = 1f;
+        private float _attackMs;
+        private float _releaseMs;
+        private float _kneeDb;
+        private float _makeupGainDb;
+        private float _lookaheadMs;
+        private DynamicsLinking _linking;
+        private volatile bool _parametersChanged = true;
+
+        // Derived at the block boundary from the parameters above.
+        private float _attackCoefficient;
+        private float _releaseCoefficient;
+        private float _thresholdDbApplied;
+        private float _makeupOctaves;
+        private float _hardSlopeOctaves;
+        private float _kneeScaleOctaves;
+        private float _inverseKnee;
+        private DynamicsLinking _linkingApplied;
+
+        private int _channels;
+        private float[] _envelope = Array.Empty<float>();
+        private float[] _gain = Array.Empty<float>();
+        private float[] _work = Array.Empty<float>();
+        private float[] _swap = Array.Empty<float>();
+
+        // Lookahead: the last LookaheadFrames frames of input, interleaved, read and overwritten in place.
+        private float[] _delay = Array.Empty<float>();
+        private int _delayPosition;
+        private int _lookaheadFrames;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="DynamicsProcessor"/> class.
+        /// </summary>
+        /// <param name="sampleRate">The sample rate in Hertz.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="sampleRate"/> is not positive.</exception>
+        public DynamicsProcessor(int sampleRate)
+        {
+            if (sampleRate <= 0)
+                throw new ArgumentOutOfRangeException(nameof(sampleRate), "Sample rate must be positive.");
+
+            SampleRate = sampleRate;
+        }
+
+        /// <summary>
+        /// Gets the sample rate in Hertz.
+        /// </summary>
+        public int SampleRate { get; }
+
+        /// <summary>
+        /// Gets or sets the threshold level in dBFS (-inf to 0).
+        /// </summary>
+        public float ThresholdDb
+        {
+            get => _thresholdDb;
+            set => Set(ref _thresholdDb, value);
+        }
+
+        /// <summary>
+        /// Gets or sets the compression ratio (1:1 to inf:1). Ratios below 1 are treated as 1:1.
+        /// </summary>
+        public float Ratio
+        {
+            get => _ratio;
+            set => Set(ref _ratio, value);
+        }
+
+        /// <summary>
+        /// Gets or sets the attack time in milliseconds.
+        /// </summary>
+        public float AttackMs
+        {
+            get => _attackMs;
+            set => Set(ref _attackMs, value);
+        }
+
+        /// <summary>
+        /// Gets or sets the release time in milliseconds.
+        /// </summary>
+        public float ReleaseMs
+        {
+            get => _releaseMs;
+            set => Set(ref _releaseMs, value);
+        }
+
+        /// <summary>
+        /// Gets or sets the knee radius in dB. A knee radius of 0 is a hard knee.
+        /// </summary>
+        public float KneeDb
+        {
+            get => _kneeDb;
+            set => Set(ref _kneeDb, value);
+        }
+
+        /// <summary>
+        /// Gets or sets the make-up gain in dB.
+        /// </summary>
+        public float MakeupGainDb
+        {
+            get => _makeupGainDb;
+            set => Set(ref _makeupGainDb, value);
+        }
+
+        /// <summary>
+        /// Gets or sets how far ahead the detector looks, in milliseconds. The audio is delayed by the same amount
+        /// so gain reduction is already in place when a transient arrives. Changing it clears the delay line.
+        /// </summary>
+        public float LookaheadMs
+        {
+            get => _lookaheadMs;
+            set => Set(ref _lookaheadMs, Math.Max(0f, value));
+        }
+
+        /// <summary>
+        /// Gets the delay added by <see cref="LookaheadMs"/>, in frames.
+        /// </summary>
+        public int LookaheadFrames => (int)(_lookaheadMs * 0.001f * SampleRate);
+
+        /// <summary>
+        /// Gets or sets whether the channels share one detector and gain or each have their own.
+        /// </summary>
+        public DynamicsLinking Linking
+        {
+            get => _linking;
+            set
+            {
+                _linking = value;
+                _parametersChanged = true;
+            }
+        }
+
+        /// <summary>
+        /// Clears the envelope, the gain and the lookahead delay line.
+        /// </summary>
+        public void Reset()
+        {
+            _envelope.AsSpan().Fill(LevelFloorDb);
+            _gain.AsSpan().Fill(1f);
+            Array.Clear(_delay, 0, _delay.Length);
+            _delayPosition = 0;
+        }
+
+        /// <summary>
+        /// Compresses a block of interleaved samples in place.
+        /// </summary>
+        /// <param name="buffer">The samples to process. Must hold a whole number of frames.</param>
+        /// <param name="channels">The number of interleaved channels.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="channels"/> is not positive.</exception>
+        /// <exception cref="ArgumentException">Thrown if the buffer length is not a multiple of <paramref name="channels"/>.</exception>
+        public void Process(Span<float> buffer, int channels)
+        {
+            if (channels <= 0)
+                throw new ArgumentOutOfRangeException(nameof(channels), "Channel count must be positive.");
+            if (buffer.Length % channels != 0)
+                throw new ArgumentException("The buffer must contain a whole number of frames.", nameof(buffer));
+
+            EnsureChannels(channels);
+            ApplyParameters();
+            if (buffer.IsEmpty) return;
+
+            var frames = buffer.Length / channels;
+            var linked = _linkingApplied == DynamicsLinking.Linked && channels > 1;
+            var lanes = linked ? 1 : channels;
+            var count = frames * lanes;
+            if (_work.Length < buffer.Length)
+            {
+                _work = new float[buffer.Length];
+                _swap = new float[buffer.Length];
+            }
+
+            var work = _work.AsSpan(0, count);
+            if (linked)
+            {
+                for (int f = 0, i = 0; f < frames; f++)
+                {
+                    var peak = MathF.Abs(buffer[i++]);
+                    for (var c = 1; c < channels; c++)
+                        peak = MathF.Max(peak, MathF.Abs(buffer[i++]));
+                    work[f] = peak;
+                }
+
+                ComputeLevels(work, work);
+            }
+            else
+            {
+                ComputeLevels(buffer, work);
+            }
+
+            for (var lane = 0; lane < lanes; lane++)
+                FollowEnvelope(work, lane, lanes, lane);
+
+            ComputeTargetGains(work);
+
+            for (var lane = 0; lane < lanes; lane++)
+                SmoothGain(work, lane, lanes, lane);
+
+            if (_lookaheadFrames > 0)
+                Delay(buffer);
+
+            if (linked)
+            {
+                for (int f = 0, i = 0; f < frames; f++)
+                {
+                    var gain = work[f];
+                    for (var c = 0; c < channels; c++)
+                        buffer[i++] *= gain;
+                }
+            }
+            else
+            {
+                SampleMath.Multiply(buffer, work);
+            }
+        }
+
+        /// <summary>
+        /// Compresses a single sample. Intended for callers that cannot work on blocks; in
+        /// <see cref="DynamicsLinking.Linked"/> mode the channels share one detector fed one sample at a time.
+        /// </summary>
+        /// <param name="sample">The input sample.</param>
+        /// <param name="channel">The channel the sample belongs to. The lookahead delay advances after the last channel of a frame.</param>
+        /// <returns>The processed sample.</returns>
+        public float ProcessSample(float sample, int channel)
+        {
+            if (channel < 0)
+                throw new ArgumentOutOfRangeException(nameof(channel));
+
+            EnsureChannels(Math.Max(_channels, channel + 1));
+            ApplyParameters();
+
+            var lane = _linkingApplied == DynamicsLinking.Linked ? 0 : channel;
+            Span<float> level = stackalloc float[1];
+            level[0] = FastMath.DecibelsPerOctave * FastMath.Log2(MathF.Max(MathF.Abs(sample), LevelFloor));
+            FollowEnvelope(level, 0, 1, lane);
+            ComputeTargetGains(level);
+            SmoothGain(level, 0, 1, lane);
+
+            if (_lookaheadFrames > 0)
+            {
+                var index = _delayPosition + channel;
+                (sample, _delay[index]) = (_delay[index], sample);
+                if (channel == _channels - 1)
+                    _delayPosition = (_delayPosition + _channels) % _delay.Length;
+            }
+
+            return sample * level[0];
+        }
+
+        private void Set(ref float field, float value)
+        {
+            field = value;
+            _parametersChanged = true;
+        }
+
+        private void EnsureChannels(int channels)
+        {
+            if (channels == _channels) return;
+
+            // Channels that remain keep their detector state; the delay line's layout changes, so it starts over.
+            var kept = Math.Min(_channels, channels);
+            var envelope = new float[channels];
+            var gain = new float[channels];
+            envelope.AsSpan(kept).Fill(LevelFloorDb);
+            gain.AsSpan(kept).Fill(1f);
+            _envelope.AsSpan(0, kept).CopyTo(envelope);
+            _gain.AsSpan(0, kept).CopyTo(gain);
+
+            _channels = channels;
+            _envelope = envelope;
+            _gain = gain;
+            _delay = new float[_lookaheadFrames * channels];
+            _delayPosition = 0;
+        }
+
+        private void ApplyParameters()
+        {
+            if (!_parametersChanged) return;
+
+            // Cleared before reading, so a change made meanwhile is picked up at the next block.
+            _parametersChanged = false;
+
+            _attackCoefficient = TimeCoefficient(_attackMs);
+            _releaseCoefficient = TimeCoefficient(_releaseMs);
+            _thresholdDbApplied = _thresholdDb;
+            _makeupOctaves = _makeupGainDb / FastMath.DecibelsPerOctave;
+
+            var slope = float.IsPositiveInfinity(_ratio) ? 1f : _ratio > 1f ? (_ratio - 1f) / _ratio : 0f;
+            _hardSlopeOctaves = slope / FastMath.DecibelsPerOctave;
+            if (_kneeDb > 0f)
+            {
+                // Logarithmic soft knee: slope * knee * log10(1 + overshoot / knee), expressed in octaves of gain.
+                _kneeScaleOctaves = slope * _kneeDb * 0.30103f / FastMath.DecibelsPerOctave;
+                _inverseKnee = 1f / _kneeDb;
+            }
+            else
+            {
+                _kneeScaleOctaves = 0f;
+                _inverseKnee = 0f;
+            }
+
+            if (_linkingApplied != _linking)
+            {
+                _linkingApplied = _linking;
+                _envelope.AsSpan().Fill(LevelFloorDb);
+                _gain.AsSpan().Fill(1f);
+            }
+
+            var lookahead = LookaheadFrames;
+            if (lookahead != _lookaheadFrames)
+            {
+                _lookaheadFrames = lookahead;
+                _delay = new float[lookahead * _channels];
+                _delayPosition = 0;
+            }
+        }
+
+        private float TimeCoefficient(float milliseconds) =>
+            milliseconds > 0f ? MathF.Exp(-1f / (milliseconds * 0.001f * SampleRate)) : 0f;
+
+        /// <summary>
+        /// Writes the level of each sample in dBFS, floored at -120 dBFS. <paramref name="source"/> and
+        /// <paramref name="destination"/> may be the same span.
+        /// </summary>
+        private static void ComputeLevels(ReadOnlySpan<float> source, Span<float> destination)
+        {
+            var i = 0;
+            if (Vector.IsHardwareAccelerated)
+            {
+                var floor = new Vector<float>(LevelFloor);
+                var scale = new Vector<float>(FastMath.DecibelsPerOctave);
+                var src = MemoryMarshal.Cast<float, Vector<float>>(source[..destination.Length]);
+                var dst = MemoryMarshal.Cast<float, Vector<float>>(destination);
+                for (var v = 0; v < dst.Length; v++)
+                    dst[v] = scale * FastMath.Log2(Vector.Max(Vector.Abs(src[v]), floor));
+                i = dst.Length * Vector<float>.Count;
+            }
+
+            for (; i < destination.Length; i++)
+                destination[i] = FastMath.DecibelsPerOctave * FastMath.Log2(MathF.Max(MathF.Abs(source[i]), LevelFloor));
+        }
+
+        /// <summary>
+        /// Replaces the levels of one lane with the attack/release envelope that follows them.
+        /// </summary>
+        private void FollowEnvelope(Span<float> levels, int offset, int stride, int lane)
+        {
+            var attack = _attackCoefficient;
+            var release = _releaseCoefficient;
+            var envelope = _envelope[lane];
+
+            for (var i = offset; i < levels.Length; i += stride)
+            {
+                var level = levels[i];
+                envelope = level + (level > envelope ? attack : release) * (envelope - level);
+                levels[i] = envelope;
+            }
+
+            _envelope[lane] = envelope;
+        }
+
+        /// <summary>
+        /// Replaces envelope levels with the linear gain the static curve asks for, make-up included.
+        /// </summary>
+        private void ComputeTargetGains(Span<float> envelopes)
+        {
+            var threshold = _thresholdDbApplied;
+            var makeup = _makeupOctaves;
+            var softKnee = _inverseKnee > 0f;
+            var i = 0;
+
+            if (Vector.IsHardwareAccelerated)
+            {
+                var vThreshold = new Vector<float>(threshold);
+                var vMakeup = new Vector<float>(makeup);
+                var vHardSlope = new Vector<float>(_hardSlopeOctaves);
+                var vKneeScale = new Vector<float>(_kneeScaleOctaves);
+                var vInverseKnee = new Vector<float>(_inverseKnee);
+                var values = MemoryMarshal.Cast<float, Vector<float>>(envelopes);
+
+                for (var v = 0; v < values.Length; v++)
+                {
+                    var overshoot = Vector.Max(values[v] - vThreshold, Vector<float>.Zero);
+                    var reduction = softKnee
+                        ? vKneeScale * FastMath.Log2(Vector<float>.One + overshoot * vInverseKnee)
+                        : vHardSlope * overshoot;
+                    values[v] = FastMath.Exp2(vMakeup - reduction);
+                }
+
+                i = values.Length * Vector<float>.Count;
+            }
+
+            for (; i < envelopes.Length; i++)
+            {
+                var overshoot = MathF.Max(envelopes[i] - threshold, 0f);
+                var reduction = softKnee
+                    ? _kneeScaleOctaves * FastMath.Log2(1f + overshoot * _inverseKnee)
+                    : _hardSlopeOctaves * overshoot;
+                envelopes[i] = FastMath.Exp2(makeup - reduction);
+            }
+        }
+
+        /// <summary>
+        /// Replaces the target gains of one lane with the smoothed gain: falling at the attack rate, rising at the
+        /// release rate.
+        /// </summary>
+        private void SmoothGain(Span<float> targets, int offset, int stride, int lane)
+        {
+            var attack = _attackCoefficient;
+            var release = _releaseCoefficient;
+            var gain = _gain[lane];
+
+            for (var i = offset; i < targets.Length; i += stride)
+            {
+                var target = targets[i];
+                gain = target + (target < gain ? attack : release) * (gain - target);
+                targets[i] = gain;
+            }
+
+            _gain[lane] = gain;
+        }
+
+        /// <summary>
+        /// Swaps the block with the delay line, so the buffer holds the audio from <see cref="LookaheadFrames"/>
+        /// frames earlier and the delay line the newest input.
+        /// </summary>
+        private void Delay(Span<float> buffer)
+        {
+            var position = _delayPosition;
+            for (var offset = 0; offset < buffer.Length;)
+            {
+                var count = Math.Min(buffer.Length - offset, _delay.Length - position);
+                var block = buffer.Slice(offset, count);
+                var stored = _delay.AsSpan(position, count);
+                var swap = _swap.AsSpan(0, count);
+
+                block.CopyTo(swap);
+                stored.CopyTo(block);
+                swap.CopyTo(stored);
+
+                offset += count;
+                position += count;
+                if (position == _delay.Length) position = 0;
+            }
+
+            _delayPosition = position;
+        }
+    }
+}
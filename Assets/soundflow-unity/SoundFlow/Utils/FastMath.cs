@@ -0,0 +1,96 @@
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// Polynomial approximations of <c>log2</c> and <c>exp2</c> for level and gain computations, in scalar and
+    /// <see cref="Vector{T}"/> form.
+    /// </summary>
+    /// <remarks>
+    /// Both split the argument into exponent and mantissa through the float bit layout and fit the mantissa with a
+    /// cubic that is exact at the octave boundaries, so the curves stay continuous across octaves. <see cref="Log2(float)"/>
+    /// is within 1.5e-4 (under 0.001 dB) and <see cref="Exp2(float)"/> within 6e-6 relative error. Inputs are not
+    /// validated: <c>Log2</c> expects positive normal values and <c>Exp2</c> clamps to [-126, 126].
+    /// </remarks>
+    public static class FastMath
+    {
+        /// <summary>
+        /// Decibels per doubling of amplitude, <c>20 * log10(2)</c>.
+        /// </summary>
+        public const float DecibelsPerOctave = 6.0205999f;
+
+        // log2(1 + t) ~= t + t (1 - t) (L0 + L1 t + L2 t^2) on [0, 1).
+        private const float L0 = 0.43807325f, L1 = -0.23669342f, L2 = 0.08030730f;
+
+        // 2^t ~= 1 + t + t (1 - t) (E0 + E1 t + E2 t^2) on [0, 1).
+        private const float E0 = -0.30700434f, E1 = -0.06543875f, E2 = -0.01368647f;
+
+        private const int ExponentMask = 0x7F800000;
+        private const int MantissaMask = 0x007FFFFF;
+        private const int OneBits = 0x3F800000;
+        private const float InverseMantissaScale = 1f / (1 << 23);
+
+        /// <summary>
+        /// Approximates the base-2 logarithm of a positive value.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static float Log2(float value)
+        {
+            var bits = BitConverter.SingleToInt32Bits(value);
+            var exponent = ((bits & ExponentMask) >> 23) - 127;
+            var t = BitConverter.Int32BitsToSingle((bits & MantissaMask) | OneBits) - 1f;
+            return exponent + t + t * (1f - t) * (L0 + t * (L1 + t * L2));
+        }
+
+        /// <summary>
+        /// Approximates the base-2 logarithm of each lane of a vector of positive values.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Vector<float> Log2(Vector<float> value)
+        {
+            var bits = Vector.AsVectorInt32(value);
+
+            // The masked exponent field is E * 2^23 with E < 256, so it converts to float exactly.
+            var exponent = Vector.ConvertToSingle(bits & new Vector<int>(ExponentMask)) * new Vector<float>(InverseMantissaScale) -
+                           new Vector<float>(127f);
+            var one = Vector<float>.One;
+            var t = Vector.AsVectorSingle((bits & new Vector<int>(MantissaMask)) | new Vector<int>(OneBits)) - one;
+            var poly = new Vector<float>(L0) + t * (new Vector<float>(L1) + t * new Vector<float>(L2));
+            return exponent + t + t * (one - t) * poly;
+        }
+
+        /// <summary>
+        /// Approximates <c>2^value</c>.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static float Exp2(float value)
+        {
+            // Clamped so the exponent field stays normal.
+            value = Math.Clamp(value, -126f, 126f);
+            var exponent = (int)MathF.Floor(value);
+            var t = value - exponent;
+            var scale = BitConverter.Int32BitsToSingle((exponent + 127) << 23);
+            return scale * (1f + t + t * (1f - t) * (E0 + t * (E1 + t * E2)));
+        }
+
+        /// <summary>
+        /// Approximates <c>2^value</c> for each lane of a vector.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Vector<float> Exp2(Vector<float> value)
+        {
+            value = Vector.Min(Vector.Max(value, new Vector<float>(-126f)), new Vector<float>(126f));
+
+            // Conversion truncates towards zero; step negative non-integers down one to get the floor.
+            var exponent = Vector.ConvertToInt32(value);
+            exponent += Vector.GreaterThan(Vector.ConvertToSingle(exponent), value);
+            var t = value - Vector.ConvertToSingle(exponent);
+            var scale = Vector.AsVectorSingle((exponent + new Vector<int>(127)) * new Vector<int>(1 << 23));
+            var one = Vector<float>.One;
+            var poly = new Vector<float>(E0) + t * (new Vector<float>(E1) + t * new Vector<float>(E2));
+            return scale * (one + t + t * (one - t) * poly);
+        }
+    }
+}
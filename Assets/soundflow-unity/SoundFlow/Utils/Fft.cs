@@ -0,0 +1,157 @@
+using System;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// An in-place radix-2 complex FFT of a fixed power-of-two size, on split real and imaginary float arrays.
+    /// </summary>
+    /// <remarks>
+    /// Twiddle factors and the bit-reversal permutation are computed once by the constructor, so transforms do not
+    /// allocate. Each stage keeps its twiddles contiguous, which lets the butterflies of every stage wider than a
+    /// vector run on <see cref="Vector{T}"/> lanes. An instance holds no per-transform state and may be shared by
+    /// threads that use their own buffers.
+    /// </remarks>
+    public sealed class Fft
+    {
+        private readonly int[] _bitReverse;
+
+        // Per stage of half-size m (1, 2, 4, ...), the m twiddles exp(-i*pi*k/m) packed one stage after another,
+        // starting at offset m - 1.
+        private readonly float[] _twiddleReal;
+        private readonly float[] _twiddleImag;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="Fft"/> class.
+        /// </summary>
+        /// <param name="size">The transform size. Must be a power of two, at least 2.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if size is not a power of two of at least 2.</exception>
+        public Fft(int size)
+        {
+            if (size < 2 || (size & (size - 1)) != 0)
+                throw new ArgumentOutOfRangeException(nameof(size), "FFT size must be a power of two of at least 2.");
+
+            Size = size;
+
+            var bits = 0;
+            while (1 << bits < size) bits++;
+            _bitReverse = new int[size];
+            for (var i = 0; i < size; i++)
+            {
+                var reversed = 0;
+                for (var b = 0; b < bits; b++)
+                    reversed |= ((i >> b) & 1) << (bits - 1 - b);
+                _bitReverse[i] = reversed;
+            }
+
+            _twiddleReal = new float[size - 1];
+            _twiddleImag = new float[size - 1];
+            for (var m = 1; m < size; m <<= 1)
+            {
+                for (var k = 0; k < m; k++)
+                {
+                    var angle = -Math.PI * k / m;
+                    _twiddleReal[m - 1 + k] = (float)Math.Cos(angle);
+                    _twiddleImag[m - 1 + k] = (float)Math.Sin(angle);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the transform size.
+        /// </summary>
+        public int Size { get; }
+
+        /// <summary>
+        /// Replaces the signal in <paramref name="real"/> and <paramref name="imag"/> with its spectrum.
+        /// </summary>
+        /// <param name="real">The real parts, <see cref="Size"/> long.</param>
+        /// <param name="imag">The imaginary parts, <see cref="Size"/> long.</param>
+        /// <exception cref="ArgumentException">Thrown if either span is not <see cref="Size"/> long.</exception>
+        public void Forward(Span<float> real, Span<float> imag) => Transform(real, imag, false);
+
+        /// <summary>
+        /// Replaces the spectrum in <paramref name="real"/> and <paramref name="imag"/> with its signal, scaled by
+        /// 1 / <see cref="Size"/> so that <see cref="Forward"/> followed by <see cref="Inverse"/> is the identity.
+        /// </summary>
+        /// <param name="real">The real parts, <see cref="Size"/> long.</param>
+        /// <param name="imag">The imaginary parts, <see cref="Size"/> long.</param>
+        /// <exception cref="ArgumentException">Thrown if either span is not <see cref="Size"/> long.</exception>
+        public void Inverse(Span<float> real, Span<float> imag)
+        {
+            Transform(real, imag, true);
+            var scale = 1f / Size;
+            SampleMath.Scale(real, scale);
+            SampleMath.Scale(imag, scale);
+        }
+
+        private void Transform(Span<float> real, Span<float> imag, bool inverse)
+        {
+            if (real.Length != Size || imag.Length != Size)
+                throw new ArgumentException("Buffers must be exactly the FFT size long.");
+
+            for (var i = 0; i < Size; i++)
+            {
+                var j = _bitReverse[i];
+                if (j <= i) continue;
+                (real[i], real[j]) = (real[j], real[i]);
+                (imag[i], imag[j]) = (imag[j], imag[i]);
+            }
+
+            // The inverse uses conjugate twiddles.
+            var sign = inverse ? -1f : 1f;
+            var vectorWidth = Vector.IsHardwareAccelerated ? Vector<float>.Count : int.MaxValue;
+
+            for (var m = 1; m < Size; m <<= 1)
+            {
+                var twiddleReal = new ReadOnlySpan<float>(_twiddleReal, m - 1, m);
+                var twiddleImag = new ReadOnlySpan<float>(_twiddleImag, m - 1, m);
+
+                for (var start = 0; start < Size; start += m << 1)
+                {
+                    var aRe = real.Slice(start, m);
+                    var aIm = imag.Slice(start, m);
+                    var bRe = real.Slice(start + m, m);
+                    var bIm = imag.Slice(start + m, m);
+
+                    var k = 0;
+                    if (m >= vectorWidth)
+                    {
+                        var vSign = new Vector<float>(sign);
+                        var wr = MemoryMarshal.Cast<float, Vector<float>>(twiddleReal);
+                        var wi = MemoryMarshal.Cast<float, Vector<float>>(twiddleImag);
+                        var ar = MemoryMarshal.Cast<float, Vector<float>>(aRe);
+                        var ai = MemoryMarshal.Cast<float, Vector<float>>(aIm);
+                        var br = MemoryMarshal.Cast<float, Vector<float>>(bRe);
+                        var bi = MemoryMarshal.Cast<float, Vector<float>>(bIm);
+                        for (var v = 0; v < wr.Length; v++)
+                        {
+                            var twi = wi[v] * vSign;
+                            var tr = br[v] * wr[v] - bi[v] * twi;
+                            var ti = br[v] * twi + bi[v] * wr[v];
+                            br[v] = ar[v] - tr;
+                            bi[v] = ai[v] - ti;
+                            ar[v] += tr;
+                            ai[v] += ti;
+                        }
+
+                        k = wr.Length * Vector<float>.Count;
+                    }
+
+                    for (; k < m; k++)
+                    {
+                        var wr = twiddleReal[k];
+                        var wi = twiddleImag[k] * sign;
+                        var tr = bRe[k] * wr - bIm[k] * wi;
+                        var ti = bRe[k] * wi + bIm[k] * wr;
+                        bRe[k] = aRe[k] - tr;
+                        bIm[k] = aIm[k] - ti;
+                        aRe[k] += tr;
+                        aIm[k] += ti;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,156 @@
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A registry of items that a background thread visits at a fixed interval, for the deferred work that must
+    /// stay off the audio thread: analysis passes, position notifications and latency evaluation.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Items are kept in a copy-on-write array, so registering or unregistering one never blocks a pass in
+    /// progress; a pass already under way may still visit an item once after it was unregistered. The thread runs
+    /// below normal priority, starts with the first registration and exits once the registry has stayed empty for
+    /// <see cref="IdleMilliseconds"/>, so an unused worker holds no thread.
+    /// </para>
+    /// <para>
+    /// An exception thrown by the work for one item is passed to the error handler, if any, and otherwise
+    /// ignored; the other items keep running. The registry holds strong references: owners must unregister their
+    /// items, or they stay alive and keep being visited.
+    /// </para>
+    /// </remarks>
+    /// <typeparam name="T">The type of the registered items.</typeparam>
+    internal sealed class PeriodicWorker<T> where T : class
+    {
+        /// <summary>
+        /// How long the thread keeps running with nothing registered before it exits.
+        /// </summary>
+        public const int IdleMilliseconds = 1000;
+
+        private readonly object _lock = new();
+        private readonly string _name;
+        private readonly int _intervalMilliseconds;
+        private readonly Action<T, long> _work;
+        private readonly Action<T, Exception>? _onError;
+        private volatile T[] _items = Array.Empty<T>();
+        private bool _isRunning;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PeriodicWorker{T}"/> class. No thread is started until the
+        /// first item is registered.
+        /// </summary>
+        /// <param name="name">The name given to the worker thread.</param>
+        /// <param name="intervalMilliseconds">The pause between two passes over the items.</param>
+        /// <param name="work">The work done for each item, given the <see cref="Stopwatch"/> timestamp of the pass.</param>
+        /// <param name="onError">Called on the worker thread when the work for an item throws.</param>
+        public PeriodicWorker(string name, int intervalMilliseconds, Action<T, long> work, Action<T, Exception>? onError = null)
+        {
+            _name = name;
+            _intervalMilliseconds = intervalMilliseconds;
+            _work = work;
+            _onError = onError;
+        }
+
+        /// <summary>
+        /// Adds an item to the set visited by the worker, starting the thread if needed. Has no effect if the item
+        /// is already registered.
+        /// </summary>
+        public void Register(T item)
+        {
+            lock (_lock)
+            {
+                var current = _items;
+                if (Array.IndexOf(current, item) >= 0) return;
+
+                var updated = new T[current.Length + 1];
+                current.CopyTo(updated, 0);
+                updated[current.Length] = item;
+                _items = updated;
+
+                if (_isRunning) return;
+                _isRunning = true;
+                new Thread(WorkerLoop)
+                {
+                    IsBackground = true,
+                    Priority = ThreadPriority.BelowNormal,
+                    Name = _name
+                }.Start();
+            }
+        }
+
+        /// <summary>
+        /// Removes an item from the set visited by the worker. A pass already in progress may still visit it once.
+        /// </summary>
+        public void Unregister(T item)
+        {
+            lock (_lock)
+            {
+                var current = _items;
+                var index = Array.IndexOf(current, item);
+                if (index < 0) return;
+
+                var updated = new T[current.Length - 1];
+                Array.Copy(current, 0, updated, 0, index);
+                Array.Copy(current, index + 1, updated, index, current.Length - index - 1);
+                _items = updated;
+            }
+        }
+
+        private void WorkerLoop()
+        {
+            var idleSince = 0L;
+            while (true)
+            {
+                var now = Stopwatch.GetTimestamp();
+                var items = _items;
+                if (items.Length == 0)
+                {
+                    if (idleSince == 0)
+                    {
+                        idleSince = now;
+                    }
+                    else if ((now - idleSince) * 1000 >= IdleMilliseconds * Stopwatch.Frequency)
+                    {
+                        // Registering under the same lock either sees this thread still running or starts a new one.
+                        lock (_lock)
+                        {
+                            if (_items.Length == 0)
+                            {
+                                _isRunning = false;
+                                return;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    idleSince = 0;
+                }
+
+                foreach (var item in items)
+                {
+                    try
+                    {
+                        _work(item, now);
+                    }
+                    catch (Exception e)
+                    {
+                        // A failing item must not stop the work for every other one.
+                        try
+                        {
+                            _onError?.Invoke(item, e);
+                        }
+                        catch (Exception)
+                        {
+                            // Nor may its error handler.
+                        }
+                    }
+                }
+
+                Thread.Sleep(_intervalMilliseconds);
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+using SoundFlow.Interfaces;
+using SoundFlow.Structs;
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A lock-free, allocation-free position counter that audio threads publish to and any thread can poll, with
+    /// optional throttled change notifications raised off the audio thread.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each publication stores the position with the <see cref="Stopwatch"/> timestamp at which it was reached.
+    /// The two are guarded by a sequence counter: writers make it odd while they update, and <see cref="Read"/>
+    /// retries until it sees the same even value before and after, so a reader never observes a position with
+    /// another publication's timestamp. A seek made on another thread while the audio thread publishes only has
+    /// the two writers take turns; neither blocks on a lock.
+    /// </para>
+    /// <para>
+    /// <see cref="Changed"/> is raised on a shared background thread, at most once per
+    /// <see cref="NotificationIntervalMilliseconds"/> and only when the position has been published since the last
+    /// notification. Publishing never runs subscriber code, and costs nothing extra while nobody is subscribed.
+    /// While it has subscribers the clock is referenced by that thread, so it is not collected until the last
+    /// handler is removed or the clock is disposed.
+    /// </para>
+    /// </remarks>
+    public sealed class PositionClock : IDisposable
+    {
+        private static readonly PeriodicWorker<PositionClock> Notifier =
+            new("SoundFlow Position Notifier", 10, (clock, now) => clock.NotifyIfChanged(now));
+
+        private readonly object _sender;
+        private readonly object _subscriptionLock = new();
+        private EventHandler<PositionChangedEventArgs>? _changed;
+        private int _notificationIntervalMilliseconds = 50;
+
+        private long _sequence;
+        private long _position;
+        private long _timestamp;
+        private long _isAdvancing;
+
+        // Only touched by the notification thread.
+        private long _notifiedSequence;
+        private long _lastNotificationTimestamp;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PositionClock"/> class.
+        /// </summary>
+        /// <param name="sender">The object passed as the sender of <see cref="Changed"/>, usually the owner.</param>
+        /// <exception cref="ArgumentNullException">Thrown if sender is null.</exception>
+        public PositionClock(object sender)
+        {
+            _sender = sender ?? throw new ArgumentNullException(nameof(sender));
+            _timestamp = Stopwatch.GetTimestamp();
+        }
+
+        /// <summary>
+        /// Gets the last published position, without its timestamp.
+        /// </summary>
+        public long Position => Interlocked.Read(ref _position);
+
+        /// <summary>
+        /// Gets or sets the minimum time between two <see cref="Changed"/> notifications, in milliseconds.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if the value is not positive.</exception>
+        public int NotificationIntervalMilliseconds
+        {
+            get => Volatile.Read(ref _notificationIntervalMilliseconds);
+            set
+            {
+                if (value <= 0)
+                    throw new ArgumentOutOfRangeException(nameof(value), "Notification interval must be positive.");
+                Volatile.Write(ref _notificationIntervalMilliseconds, value);
+            }
+        }
+
+        /// <summary>
+        /// Raised on a background thread when the position has changed, at most once per
+        /// <see cref="NotificationIntervalMilliseconds"/>. Intermediate positions are coalesced into the latest.
+        /// Remove the handler, or dispose the clock, when done: the notification thread keeps a subscribed clock,
+        /// its owner and its handlers alive.
+        /// </summary>
+        public event EventHandler<PositionChangedEventArgs>? Changed
+        {
+            add
+            {
+                lock (_subscriptionLock)
+                {
+                    var wasEmpty = _changed == null;
+                    _changed += value;
+                    if (wasEmpty && _changed != null)
+                        Notifier.Register(this);
+                }
+            }
+            remove
+            {
+                lock (_subscriptionLock)
+                {
+                    _changed -= value;
+                    if (_changed == null)
+                        Notifier.Unregister(this);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Publishes a new position, stamped with the current time. Safe to call on the audio thread.
+        /// </summary>
+        /// <param name="position">The new position in samples.</param>
+        /// <param name="isAdvancing">
+        /// True when playback moved the position forward; false when a seek, pause or stop set it, which stops
+        /// <see cref="PositionSnapshot.EstimatePosition"/> from extrapolating.
+        /// </param>
+        public void Publish(long position, bool isAdvancing = true)
+        {
+            var timestamp = Stopwatch.GetTimestamp();
+
+            var spinner = new SpinWait();
+            var sequence = Volatile.Read(ref _sequence);
+            while ((sequence & 1) != 0 || Interlocked.CompareExchange(ref _sequence, sequence + 1, sequence) != sequence)
+            {
+                spinner.SpinOnce();
+                sequence = Volatile.Read(ref _sequence);
+            }
+
+            Interlocked.Exchange(ref _position, position);
+            Interlocked.Exchange(ref _timestamp, timestamp);
+            Interlocked.Exchange(ref _isAdvancing, isAdvancing ? 1 : 0);
+            Volatile.Write(ref _sequence, sequence + 2);
+        }
+
+        /// <summary>
+        /// Reads the last published position together with its timestamp. Never blocks the publisher.
+        /// </summary>
+        public PositionSnapshot Read()
+        {
+            var spinner = new SpinWait();
+            while (true)
+            {
+                var before = Volatile.Read(ref _sequence);
+                if ((before & 1) == 0)
+                {
+                    var position = Interlocked.Read(ref _position);
+                    var timestamp = Interlocked.Read(ref _timestamp);
+                    var isAdvancing = Interlocked.Read(ref _isAdvancing) != 0;
+                    if (Volatile.Read(ref _sequence) == before)
+                        return new PositionSnapshot(position, timestamp, isAdvancing);
+                }
+
+                spinner.SpinOnce();
+            }
+        }
+
+        /// <summary>
+        /// Removes every <see cref="Changed"/> handler. The clock can still be published to and read.
+        /// </summary>
+        public void Dispose()
+        {
+            lock (_subscriptionLock)
+            {
+                _changed = null;
+                Notifier.Unregister(this);
+            }
+        }
+
+        /// <summary>
+        /// Raises <see cref="Changed"/> if the position was published since the last notification and the
+        /// notification interval has elapsed. Called by the notification thread only.
+        /// </summary>
+        private void NotifyIfChanged(long now)
+        {
+            var sequence = Volatile.Read(ref _sequence) & ~1L;
+            if (sequence == _notifiedSequence) return;
+            if ((now - _lastNotificationTimestamp) * 1000 < NotificationIntervalMilliseconds * Stopwatch.Frequency) return;
+
+            var snapshot = Read();
+            _notifiedSequence = sequence;
+            _lastNotificationTimestamp = now;
+
+            var position = (int)Math.Clamp(snapshot.Position, int.MinValue, int.MaxValue);
+            _changed?.Invoke(_sender, new PositionChangedEventArgs(position, snapshot));
+        }
+    }
+}
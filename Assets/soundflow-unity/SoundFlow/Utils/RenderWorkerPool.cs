@@ -0,0 +1,154 @@
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A unit of render work that any number of threads may help drain concurrently.
+    /// </summary>
+    internal interface IRenderWorkItem
+    {
+        /// <summary>
+        /// Claims and runs pending tasks until none are left. Called by the submitting thread and by every woken
+        /// worker; implementations hand out each task exactly once.
+        /// </summary>
+        void RunPending();
+    }
+
+    /// <summary>
+    /// A process-wide set of long-lived, above-normal-priority worker threads that help the audio thread render.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// One work item runs at a time. The submitting thread always takes part in draining it, so work never waits on
+    /// a worker being scheduled; workers that wake late simply find nothing left to claim. A second submitter that
+    /// finds the pool busy (for example a nested mixer rendered by a worker) runs its own work inline.
+    /// </para>
+    /// <para>
+    /// Items are announced by bumping a generation counter. After each item a worker spins on it for a quarter longer
+    /// than the gap since the previous item, but at most <see cref="MaxSpinMicroseconds"/>. Items that follow each
+    /// other closely, such as the parallel mixers of one block, are then picked up without a lock or a system call,
+    /// while between device blocks the helpers park instead of keeping cores busy. Parked workers wait on a
+    /// semaphore, which the submitter only touches when one of them is parked.
+    /// </para>
+    /// <para>
+    /// Workers run above normal priority rather than at the highest, so busy or spinning helpers cannot starve the
+    /// audio thread or the rest of the application.
+    /// </para>
+    /// </remarks>
+    internal sealed class RenderWorkerPool
+    {
+        /// <summary>
+        /// The longest a worker spins waiting for the next item before it parks.
+        /// </summary>
+        public const int MaxSpinMicroseconds = 1000;
+
+        private static readonly Lazy<RenderWorkerPool> SharedPool =
+            new(() => new RenderWorkerPool(Environment.ProcessorCount - 1));
+
+        private readonly SemaphoreSlim _park;
+        private volatile IRenderWorkItem? _current;
+        private int _busy;
+        private int _generation;
+        private int _parked;
+
+        private RenderWorkerPool(int workerCount)
+        {
+            WorkerCount = Math.Max(0, workerCount);
+            _park = new SemaphoreSlim(0);
+
+            for (var i = 0; i < WorkerCount; i++)
+            {
+                new Thread(WorkerLoop)
+                {
+                    IsBackground = true,
+                    Priority = ThreadPriority.AboveNormal,
+                    Name = $"SoundFlow Render Worker {i + 1}"
+                }.Start();
+            }
+        }
+
+        /// <summary>
+        /// Gets the shared pool, sized to one worker per core besides the audio thread.
+        /// </summary>
+        public static RenderWorkerPool Shared => SharedPool.Value;
+
+        /// <summary>
+        /// Gets the number of worker threads.
+        /// </summary>
+        public int WorkerCount { get; }
+
+        /// <summary>
+        /// Publishes <paramref name="item"/> to the workers and wakes up to <paramref name="helpers"/> parked ones.
+        /// </summary>
+        /// <param name="item">The work to share.</param>
+        /// <param name="helpers">The number of workers worth waking.</param>
+        /// <returns>False if another item is already running; the caller should then run its work alone.</returns>
+        public bool TryBegin(IRenderWorkItem item, int helpers)
+        {
+            if (WorkerCount == 0 || Interlocked.CompareExchange(ref _busy, 1, 0) != 0)
+                return false;
+
+            _current = item;
+            Interlocked.Increment(ref _generation);
+
+            // Spinning workers have already seen the new generation; only parked ones need the semaphore.
+            if (helpers > 0 && Volatile.Read(ref _parked) > 0)
+            {
+                var parked = Interlocked.Exchange(ref _parked, 0);
+                var wake = Math.Min(parked, helpers);
+                if (parked > wake) Interlocked.Add(ref _parked, parked - wake);
+                if (wake > 0) _park.Release(wake);
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Withdraws the item published by a successful <see cref="TryBegin"/>.
+        /// </summary>
+        public void End()
+        {
+            _current = null;
+            Volatile.Write(ref _busy, 0);
+        }
+
+        private void WorkerLoop()
+        {
+            var maxSpinTicks = MaxSpinMicroseconds * Stopwatch.Frequency / 1_000_000;
+            var seen = Volatile.Read(ref _generation);
+            var lastItem = Stopwatch.GetTimestamp();
+            var spinTicks = 0L;
+
+            while (true)
+            {
+                var spinUntil = Stopwatch.GetTimestamp() + spinTicks;
+                var spins = 0;
+                while (Volatile.Read(ref _generation) == seen)
+                {
+                    if (Stopwatch.GetTimestamp() < spinUntil)
+                    {
+                        // Yield now and then so threads sharing this core are not starved by the spin.
+                        if (++spins % 8 == 0) Thread.Yield();
+                        else Thread.SpinWait(32);
+                        continue;
+                    }
+
+                    // The submitter bumps the generation before reading the parked count, so checking it again
+                    // after registering as parked cannot miss a wake.
+                    Interlocked.Increment(ref _parked);
+                    if (Volatile.Read(ref _generation) == seen) _park.Wait();
+                    spinUntil = 0;
+                }
+
+                seen = Volatile.Read(ref _generation);
+                var now = Stopwatch.GetTimestamp();
+                spinTicks = Math.Min(maxSpinTicks, (now - lastItem) * 5 / 4);
+                lastItem = now;
+
+                _current?.RunPending();
+            }
+        }
+    }
+}
@@ -0,0 +1,350 @@
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// Span-based SIMD kernels for mixing and gain on float sample buffers.
+    /// </summary>
+    /// <remarks>
+    /// All kernels operate directly on the spans through <see cref="MemoryMarshal.Cast{TFrom,TTo}(Span{TFrom})"/>
+    /// reinterpretation, with a scalar tail, and never allocate. Interleaved per-channel gains are expanded into a
+    /// repeating vector pattern so any channel count stays on the vector path.
+    /// </remarks>
+    public static class SampleMath
+    {
+        // Longest repeating gain pattern (in floats) kept on the stack; larger layouts use the scalar path.
+        private const int MaxPatternLength = 512;
+
+        /// <summary>
+        /// Adds <paramref name="source"/> into <paramref name="destination"/>.
+        /// </summary>
+        /// <exception cref="ArgumentException">Thrown if the spans differ in length.</exception>
+        public static void Add(ReadOnlySpan<float> source, Span<float> destination)
+        {
+            if (source.Length != destination.Length)
+                throw new ArgumentException("Source and destination buffers must have the same length.");
+
+            var i = 0;
+            if (Vector.IsHardwareAccelerated)
+            {
+                var src = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var dst = MemoryMarshal.Cast<float, Vector<float>>(destination);
+                for (var v = 0; v < dst.Length; v++)
+                    dst[v] += src[v];
+                i = dst.Length * Vector<float>.Count;
+            }
+
+            for (; i < source.Length; i++)
+                destination[i] += source[i];
+        }
+
+        /// <summary>
+        /// Multiplies every sample in <paramref name="buffer"/> by <paramref name="gain"/>.
+        /// </summary>
+        public static void Scale(Span<float> buffer, float gain)
+        {
+            var i = 0;
+            if (Vector.IsHardwareAccelerated)
+            {
+                var g = new Vector<float>(gain);
+                var vectors = MemoryMarshal.Cast<float, Vector<float>>(buffer);
+                for (var v = 0; v < vectors.Length; v++)
+                    vectors[v] *= g;
+                i = vectors.Length * Vector<float>.Count;
+            }
+
+            for (; i < buffer.Length; i++)
+                buffer[i] *= gain;
+        }
+
+        /// <summary>
+        /// Multiplies every sample in <paramref name="buffer"/> by the gain at the same index in <paramref name="gains"/>.
+        /// </summary>
+        /// <exception cref="ArgumentException">Thrown if the spans differ in length.</exception>
+        public static void Multiply(Span<float> buffer, ReadOnlySpan<float> gains)
+        {
+            if (buffer.Length != gains.Length)
+                throw new ArgumentException("Buffer and gains must have the same length.");
+
+            var i = 0;
+            if (Vector.IsHardwareAccelerated)
+            {
+                var g = MemoryMarshal.Cast<float, Vector<float>>(gains);
+                var vectors = MemoryMarshal.Cast<float, Vector<float>>(buffer);
+                for (var v = 0; v < vectors.Length; v++)
+                    vectors[v] *= g[v];
+                i = vectors.Length * Vector<float>.Count;
+            }
+
+            for (; i < buffer.Length; i++)
+                buffer[i] *= gains[i];
+        }
+
+        /// <summary>
+        /// Computes <c>destination += source * gain</c>.
+        /// </summary>
+        /// <exception cref="ArgumentException">Thrown if the spans differ in length.</exception>
+        public static void MultiplyAdd(ReadOnlySpan<float> source, float gain, Span<float> destination)
+        {
+            if (source.Length != destination.Length)
+                throw new ArgumentException("Source and destination buffers must have the same length.");
+
+            var i = 0;
+            if (Vector.IsHardwareAccelerated)
+            {
+                var g = new Vector<float>(gain);
+                var src = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var dst = MemoryMarshal.Cast<float, Vector<float>>(destination);
+                for (var v = 0; v < dst.Length; v++)
+                    dst[v] += src[v] * g;
+                i = dst.Length * Vector<float>.Count;
+            }
+
+            for (; i < source.Length; i++)
+                destination[i] += source[i] * gain;
+        }
+
+        /// <summary>
+        /// Computes <c>destination += source * gain</c> with the gain moving linearly from <paramref name="startGain"/>
+        /// at the first sample towards <paramref name="endGain"/>, reaching it one sample past the end so the next
+        /// block can continue at <paramref name="endGain"/> without a step.
+        /// </summary>
+        /// <exception cref="ArgumentException">Thrown if the spans differ in length.</exception>
+        public static void MultiplyAddRamp(ReadOnlySpan<float> source, float startGain, float endGain, Span<float> destination)
+        {
+            if (source.Length != destination.Length)
+                throw new ArgumentException("Source and destination buffers must have the same length.");
+            if (source.IsEmpty) return;
+
+            var step = (endGain - startGain) / source.Length;
+            var i = 0;
+            if (Vector.IsHardwareAccelerated && source.Length >= Vector<float>.Count)
+            {
+                Span<float> lanes = stackalloc float[Vector<float>.Count];
+                for (var k = 0; k < lanes.Length; k++)
+                    lanes[k] = startGain + step * k;
+
+                var g = MemoryMarshal.Cast<float, Vector<float>>(lanes)[0];
+                var advance = new Vector<float>(step * Vector<float>.Count);
+                var src = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var dst = MemoryMarshal.Cast<float, Vector<float>>(destination);
+                for (var v = 0; v < dst.Length; v++)
+                {
+                    dst[v] += src[v] * g;
+                    g += advance;
+                }
+                i = dst.Length * Vector<float>.Count;
+            }
+
+            for (; i < source.Length; i++)
+                destination[i] += source[i] * (startGain + step * i);
+        }
+
+        /// <summary>
+        /// Multiplies each interleaved channel of <paramref name="buffer"/> by its own gain.
+        /// </summary>
+        /// <param name="buffer">Interleaved samples.</param>
+        /// <param name="channelGains">One gain per channel; its length is the channel count.</param>
+        public static void Scale(Span<float> buffer, ReadOnlySpan<float> channelGains)
+        {
+            var channels = ValidateChannelGains(channelGains);
+            if (channels == 1)
+            {
+                Scale(buffer, channelGains[0]);
+                return;
+            }
+
+            var i = 0;
+            var patternLength = GetPatternLength(channels, buffer.Length);
+            if (patternLength > 0)
+            {
+                Span<float> pattern = stackalloc float[patternLength];
+                FillPattern(channelGains, pattern);
+                var gains = MemoryMarshal.Cast<float, Vector<float>>(pattern);
+                var buf = MemoryMarshal.Cast<float, Vector<float>>(buffer);
+                var blocks = buffer.Length / pattern.Length;
+                for (int b = 0, v = 0; b < blocks; b++)
+                    for (var p = 0; p < gains.Length; p++, v++)
+                        buf[v] *= gains[p];
+                i = blocks * pattern.Length;
+            }
+
+            // i is always a multiple of the channel count here, so the tail starts on channel 0.
+            for (var c = 0; i < buffer.Length; i++)
+            {
+                buffer[i] *= channelGains[c];
+                if (++c == channels) c = 0;
+            }
+        }
+
+        /// <summary>
+        /// Computes <c>destination += source * gain[channel]</c> over interleaved samples in a single pass.
+        /// </summary>
+        /// <param name="source">Interleaved source samples.</param>
+        /// <param name="channelGains">One gain per channel; its length is the channel count.</param>
+        /// <param name="destination">Interleaved samples to accumulate into.</param>
+        /// <exception cref="ArgumentException">Thrown if the sample spans differ in length.</exception>
+        public static void MultiplyAdd(ReadOnlySpan<float> source, ReadOnlySpan<float> channelGains, Span<float> destination)
+        {
+            if (source.Length != destination.Length)
+                throw new ArgumentException("Source and destination buffers must have the same length.");
+
+            var channels = ValidateChannelGains(channelGains);
+            if (channels == 1)
+            {
+                MultiplyAdd(source, channelGains[0], destination);
+                return;
+            }
+
+            var i = 0;
+            var patternLength = GetPatternLength(channels, source.Length);
+            if (patternLength > 0)
+            {
+                Span<float> pattern = stackalloc float[patternLength];
+                FillPattern(channelGains, pattern);
+                var gains = MemoryMarshal.Cast<float, Vector<float>>(pattern);
+                var src = MemoryMarshal.Cast<float, Vector<float>>(source);
+                var dst = MemoryMarshal.Cast<float, Vector<float>>(destination);
+                var blocks = source.Length / pattern.Length;
+                for (int b = 0, v = 0; b < blocks; b++)
+                    for (var p = 0; p < gains.Length; p++, v++)
+                        dst[v] += src[v] * gains[p];
+                i = blocks * pattern.Length;
+            }
+
+            for (var c = 0; i < source.Length; i++)
+            {
+                destination[i] += source[i] * channelGains[c];
+                if (++c == channels) c = 0;
+            }
+        }
+
+        /// <summary>
+        /// Scales each interleaved channel of <paramref name="buffer"/> in place and accumulates the result into
+        /// <paramref name="destination"/>, in a single pass over both buffers.
+        /// </summary>
+        /// <param name="buffer">Interleaved samples, left holding the scaled signal.</param>
+        /// <param name="channelGains">One gain per channel; its length is the channel count.</param>
+        /// <param name="destination">Interleaved samples to accumulate into.</param>
+        /// <exception cref="ArgumentException">Thrown if the sample spans differ in length.</exception>
+        public static void ScaleAndAdd(Span<float> buffer, ReadOnlySpan<float> channelGains, Span<float> destination)
+        {
+            if (buffer.Length != destination.Length)
+                throw new ArgumentException("Source and destination buffers must have the same length.");
+
+            var channels = ValidateChannelGains(channelGains);
+
+            var i = 0;
+            var patternLength = GetPatternLength(channels, buffer.Length);
+            if (patternLength > 0)
+            {
+                Span<float> pattern = stackalloc float[patternLength];
+                FillPattern(channelGains, pattern);
+                var gains = MemoryMarshal.Cast<float, Vector<float>>(pattern);
+                var buf = MemoryMarshal.Cast<float, Vector<float>>(buffer);
+                var dst = MemoryMarshal.Cast<float, Vector<float>>(destination);
+                var blocks = buffer.Length / pattern.Length;
+                for (int b = 0, v = 0; b < blocks; b++)
+                {
+                    for (var p = 0; p < gains.Length; p++, v++)
+                    {
+                        var scaled = buf[v] * gains[p];
+                        buf[v] = scaled;
+                        dst[v] += scaled;
+                    }
+                }
+                i = blocks * pattern.Length;
+            }
+
+            for (var c = 0; i < buffer.Length; i++)
+            {
+                var scaled = buffer[i] * channelGains[c];
+                buffer[i] = scaled;
+                destination[i] += scaled;
+                if (++c == channels) c = 0;
+            }
+        }
+
+        /// <summary>
+        /// Mixes interleaved audio through a gain matrix: for each frame,
+        /// <c>destination[out] += sum over in of source[in] * matrix[out * sourceChannels + in]</c>.
+        /// </summary>
+        /// <param name="source">Interleaved source samples with <paramref name="sourceChannels"/> channels.</param>
+        /// <param name="sourceChannels">The number of source channels.</param>
+        /// <param name="destination">Interleaved destination samples with <paramref name="destinationChannels"/> channels.</param>
+        /// <param name="destinationChannels">The number of destination channels.</param>
+        /// <param name="matrix">Row-major gains, one row of <paramref name="sourceChannels"/> per destination channel.</param>
+        /// <exception cref="ArgumentException">Thrown if the matrix or buffers do not match the channel layout.</exception>
+        public static void MixMatrix(ReadOnlySpan<float> source, int sourceChannels, Span<float> destination,
+            int destinationChannels, ReadOnlySpan<float> matrix)
+        {
+            if (sourceChannels <= 0 || destinationChannels <= 0)
+                throw new ArgumentException("Channel counts must be positive.");
+            if (matrix.Length < sourceChannels * destinationChannels)
+                throw new ArgumentException("The matrix must hold sourceChannels * destinationChannels gains.", nameof(matrix));
+
+            var frames = Math.Min(source.Length / sourceChannels, destination.Length / destinationChannels);
+
+            if (sourceChannels == 1)
+            {
+                for (var f = 0; f < frames; f++)
+                {
+                    var s = source[f];
+                    var outFrame = destination.Slice(f * destinationChannels, destinationChannels);
+                    for (var o = 0; o < destinationChannels; o++)
+                        outFrame[o] += s * matrix[o];
+                }
+                return;
+            }
+
+            for (var f = 0; f < frames; f++)
+            {
+                var inFrame = source.Slice(f * sourceChannels, sourceChannels);
+                var outFrame = destination.Slice(f * destinationChannels, destinationChannels);
+                for (var o = 0; o < destinationChannels; o++)
+                {
+                    var row = matrix.Slice(o * sourceChannels, sourceChannels);
+                    var sum = 0f;
+                    for (var c = 0; c < sourceChannels; c++)
+                        sum += inFrame[c] * row[c];
+                    outFrame[o] += sum;
+                }
+            }
+        }
+
+        private static int ValidateChannelGains(ReadOnlySpan<float> channelGains)
+        {
+            if (channelGains.IsEmpty)
+                throw new ArgumentException("At least one channel gain is required.", nameof(channelGains));
+            return channelGains.Length;
+        }
+
+        /// <summary>
+        /// Gets the length of a gain pattern that repeats the channel gains over whole vectors, i.e. the least common
+        /// multiple of the channel count and the vector width, or zero if the vector path does not apply.
+        /// </summary>
+        private static int GetPatternLength(int channels, int sampleCount)
+        {
+            if (!Vector.IsHardwareAccelerated) return 0;
+            var patternLength = LeastCommonMultiple(channels, Vector<float>.Count);
+            return patternLength <= MaxPatternLength && sampleCount >= patternLength ? patternLength : 0;
+        }
+
+        private static void FillPattern(ReadOnlySpan<float> channelGains, Span<float> pattern)
+        {
+            for (var k = 0; k < pattern.Length; k++)
+                pattern[k] = channelGains[k % channelGains.Length];
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static int LeastCommonMultiple(int a, int b)
+        {
+            int x = a, y = b;
+            while (y != 0) (x, y) = (y, x % y);
+            return a / x * b;
+        }
+    }
+}
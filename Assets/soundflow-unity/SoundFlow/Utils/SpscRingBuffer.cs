@@ -0,0 +1,205 @@
+using System;
+using System.Threading;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A lock-free, fixed-capacity ring buffer of float samples for exactly one producer thread and one consumer thread.
+    /// </summary>
+    /// <remarks>
+    /// The producer only advances the write index and the consumer only advances the read index, so neither side
+    /// ever blocks or waits on the other. Writes and reads are bulk span copies (at most two per call, one on each side
+    /// of the wrap point). Members are annotated with the side that may call them; calling a producer member from
+    /// the consumer thread, or vice versa, is not supported.
+    /// </remarks>
+    public sealed class SpscRingBuffer
+    {
+        private readonly float[] _buffer;
+        private readonly int _mask;
+
+        // Monotonic sample counters. The producer owns _writeIndex and the consumer owns _readIndex.
+        private long _writeIndex;
+        private long _readIndex;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="SpscRingBuffer"/> class.
+        /// </summary>
+        /// <param name="minimumCapacity">The minimum number of samples the buffer can hold. Rounded up to a power of two.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="minimumCapacity"/> is not positive or too large.</exception>
+        public SpscRingBuffer(int minimumCapacity)
+        {
+            if (minimumCapacity <= 0 || minimumCapacity > 1 << 30)
+                throw new ArgumentOutOfRangeException(nameof(minimumCapacity), "Capacity must be between 1 and 2^30 samples.");
+
+            var capacity = 1;
+            while (capacity < minimumCapacity) capacity <<= 1;
+
+            _buffer = new float[capacity];
+            _mask = capacity - 1;
+        }
+
+        /// <summary>
+        /// Gets the number of samples the buffer can hold.
+        /// </summary>
+        public int Capacity => _buffer.Length;
+
+        /// <summary>
+        /// Gets the number of samples available for reading. Safe to query from any thread.
+        /// </summary>
+        public int Count => (int)(Volatile.Read(ref _writeIndex) - Volatile.Read(ref _readIndex));
+
+        /// <summary>
+        /// Gets the number of samples that can be written without overwriting unread data. Safe to query from any thread.
+        /// </summary>
+        public int FreeSpace => _buffer.Length - Count;
+
+        /// <summary>
+        /// Gets the total number of samples written since construction. Safe to query from any thread.
+        /// </summary>
+        public long TotalWritten => Volatile.Read(ref _writeIndex);
+
+        /// <summary>
+        /// Gets the total number of samples read or skipped since construction. Safe to query from any thread.
+        /// </summary>
+        public long TotalRead => Volatile.Read(ref _readIndex);
+
+        #region Producer
+
+        /// <summary>
+        /// Writes as many samples as fit into the buffer. Producer only.
+        /// </summary>
+        /// <param name="samples">The samples to write.</param>
+        /// <returns>The number of samples written, which may be less than the length of <paramref name="samples"/>.</returns>
+        public int Write(ReadOnlySpan<float> samples)
+        {
+            GetWriteSegments(out var first, out var second);
+
+            var count = Math.Min(samples.Length, first.Length + second.Length);
+            if (count == 0) return 0;
+
+            var firstCount = Math.Min(count, first.Length);
+            samples[..firstCount].CopyTo(first);
+            if (count > firstCount)
+                samples[firstCount..count].CopyTo(second);
+
+            AdvanceWrite(count);
+            return count;
+        }
+
+        /// <summary>
+        /// Writes all samples, or none if they do not fit. Producer only.
+        /// </summary>
+        /// <param name="samples">The samples to write.</param>
+        /// <returns>True if the samples were written.</returns>
+        public bool TryWrite(ReadOnlySpan<float> samples)
+        {
+            if (samples.Length > FreeSpace) return false;
+            Write(samples);
+            return true;
+        }
+
+        /// <summary>
+        /// Gets the free regions of the buffer so data can be produced into it in place. Producer only.
+        /// Call <see cref="AdvanceWrite"/> to publish what was written.
+        /// </summary>
+        /// <param name="first">The free region starting at the write position.</param>
+        /// <param name="second">The free region after the wrap point, possibly empty.</param>
+        public void GetWriteSegments(out Span<float> first, out Span<float> second)
+        {
+            var write = _writeIndex;
+            var free = _buffer.Length - (int)(write - Volatile.Read(ref _readIndex));
+            var start = (int)(write & _mask);
+            var firstLength = Math.Min(free, _buffer.Length - start);
+
+            first = _buffer.AsSpan(start, firstLength);
+            second = _buffer.AsSpan(0, free - firstLength);
+        }
+
+        /// <summary>
+        /// Publishes samples written through <see cref="GetWriteSegments"/>. Producer only.
+        /// </summary>
+        /// <param name="count">The number of samples written.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="count"/> exceeds the free space.</exception>
+        public void AdvanceWrite(int count)
+        {
+            if (count < 0 || count > FreeSpace)
+                throw new ArgumentOutOfRangeException(nameof(count));
+
+            Volatile.Write(ref _writeIndex, _writeIndex + count);
+        }
+
+        #endregion
+
+        #region Consumer
+
+        /// <summary>
+        /// Reads up to <paramref name="destination"/>.Length samples. Consumer only.
+        /// </summary>
+        /// <param name="destination">The span to copy samples into.</param>
+        /// <returns>The number of samples read.</returns>
+        public int Read(Span<float> destination)
+        {
+            GetReadSegments(out var first, out var second);
+
+            var count = Math.Min(destination.Length, first.Length + second.Length);
+            if (count == 0) return 0;
+
+            var firstCount = Math.Min(count, first.Length);
+            first[..firstCount].CopyTo(destination);
+            if (count > firstCount)
+                second[..(count - firstCount)].CopyTo(destination[firstCount..]);
+
+            AdvanceRead(count);
+            return count;
+        }
+
+        /// <summary>
+        /// Reads exactly <paramref name="destination"/>.Length samples, or nothing if fewer are available. Consumer only.
+        /// </summary>
+        /// <param name="destination">The span to copy samples into.</param>
+        /// <returns>True if the span was filled.</returns>
+        public bool TryRead(Span<float> destination)
+        {
+            if (destination.Length > Count) return false;
+            Read(destination);
+            return true;
+        }
+
+        /// <summary>
+        /// Gets the readable regions of the buffer so data can be consumed in place. Consumer only.
+        /// Call <see cref="AdvanceRead"/> to release what was consumed.
+        /// </summary>
+        /// <param name="first">The readable region starting at the read position.</param>
+        /// <param name="second">The readable region after the wrap point, possibly empty.</param>
+        public void GetReadSegments(out ReadOnlySpan<float> first, out ReadOnlySpan<float> second)
+        {
+            var read = _readIndex;
+            var available = (int)(Volatile.Read(ref _writeIndex) - read);
+            var start = (int)(read & _mask);
+            var firstLength = Math.Min(available, _buffer.Length - start);
+
+            first = _buffer.AsSpan(start, firstLength);
+            second = _buffer.AsSpan(0, available - firstLength);
+        }
+
+        /// <summary>
+        /// Releases samples consumed through <see cref="GetReadSegments"/>, or discards unread samples. Consumer only.
+        /// </summary>
+        /// <param name="count">The number of samples to release.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="count"/> exceeds the available samples.</exception>
+        public void AdvanceRead(int count)
+        {
+            if (count < 0 || count > Count)
+                throw new ArgumentOutOfRangeException(nameof(count));
+
+            Volatile.Write(ref _readIndex, _readIndex + count);
+        }
+
+        /// <summary>
+        /// Discards everything currently readable. Consumer only.
+        /// </summary>
+        public void Clear() => Volatile.Write(ref _readIndex, Volatile.Read(ref _writeIndex));
+
+        #endregion
+    }
+}
@@ -0,0 +1,56 @@
+using SoundFlow.Structs;
+using System;
+using System.Threading;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// An allocation-free accumulator of <see cref="System.Diagnostics.Stopwatch"/> tick durations.
+    /// </summary>
+    /// <remarks>
+    /// Written by one thread at a time (the thread rendering the owner) and read from any thread. A snapshot taken
+    /// while a run is being recorded may mix that run into some fields but not others.
+    /// </remarks>
+    internal sealed class TimingCounter
+    {
+        /// <summary>
+        /// The time spent in nested nodes of the node currently being rendered on this thread, used to derive
+        /// exclusive times from inclusive ones.
+        /// </summary>
+        [ThreadStatic] internal static long ChildTicks;
+
+        private long _count;
+        private long _totalTicks;
+        private long _maxTicks;
+        private long _lastTicks;
+
+        /// <summary>
+        /// Adds one run.
+        /// </summary>
+        public void Record(long ticks)
+        {
+            if (ticks < 0) ticks = 0;
+            Volatile.Write(ref _lastTicks, ticks);
+            if (ticks > _maxTicks) Volatile.Write(ref _maxTicks, ticks);
+            Volatile.Write(ref _totalTicks, _totalTicks + ticks);
+            Volatile.Write(ref _count, _count + 1);
+        }
+
+        /// <summary>
+        /// Gets the accumulated timings.
+        /// </summary>
+        public TimingStats Snapshot() => new(Volatile.Read(ref _count), Volatile.Read(ref _totalTicks),
+            Volatile.Read(ref _maxTicks), Volatile.Read(ref _lastTicks));
+
+        /// <summary>
+        /// Clears the accumulated timings.
+        /// </summary>
+        public void Reset()
+        {
+            Volatile.Write(ref _count, 0);
+            Volatile.Write(ref _totalTicks, 0);
+            Volatile.Write(ref _maxTicks, 0);
+            Volatile.Write(ref _lastTicks, 0);
+        }
+    }
+}
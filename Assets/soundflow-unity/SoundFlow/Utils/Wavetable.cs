@@ -0,0 +1,161 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Utils
+{
+    /// <summary>
+    /// A band-limited, mip-mapped wavetable of one periodic waveform.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Level <c>k</c> holds the waveform summed from its first <c>1024 &gt;&gt; k</c> harmonics, so a player picks
+    /// the level with <see cref="GetLevel"/> from its phase increment and never produces partials above Nyquist.
+    /// Each level is <see cref="TableSize"/> samples plus one guard sample repeating the first, so linear
+    /// interpolation never wraps. Tables are built once per process with an inverse <see cref="Fft"/> of the
+    /// harmonic series, on first use of each shared instance, and are read-only afterwards, so any number of
+    /// voices and threads can share them.
+    /// </para>
+    /// <para>
+    /// Phases are in cycles, in [0, 1).
+    /// </para>
+    /// </remarks>
+    public sealed class Wavetable
+    {
+        /// <summary>
+        /// The number of samples in one cycle of every level.
+        /// </summary>
+        public const int TableSize = 4096;
+
+        // Samples between the starts of consecutive levels in Samples.
+        internal const int LevelStride = TableSize + 1;
+
+        // Harmonics in level 0. The table oversamples its highest partial four times, which keeps linear
+        // interpolation error low.
+        private const int MaxHarmonics = TableSize / 4;
+
+        private static readonly Lazy<Wavetable> SharedSine = new(() => new Wavetable(1, 1, SineHarmonic));
+        private static readonly Lazy<Wavetable> SharedSawtooth = new(() => Build(SawtoothHarmonic));
+        private static readonly Lazy<Wavetable> SharedSquare = new(() => Build(SquareHarmonic));
+        private static readonly Lazy<Wavetable> SharedTriangle = new(() => Build(TriangleHarmonic));
+
+        private Wavetable(int levels, int maxHarmonics, Func<int, (float Cos, float Sin)> harmonic)
+        {
+            LevelCount = levels;
+            Samples = new float[levels * LevelStride];
+
+            var fft = new Fft(TableSize);
+            var real = new float[TableSize];
+            var imag = new float[TableSize];
+            for (var level = 0; level < levels; level++)
+            {
+                Array.Clear(real, 0, real.Length);
+                Array.Clear(imag, 0, imag.Length);
+
+                // A partial a cos(n x) + b sin(n x) is the conjugate pair (a - ib) N/2 at bin n and (a + ib) N/2 at -n.
+                for (var n = 1; n <= maxHarmonics >> level; n++)
+                {
+                    var (a, b) = harmonic(n);
+                    real[n] = real[TableSize - n] = a * TableSize / 2f;
+                    imag[n] = -b * TableSize / 2f;
+                    imag[TableSize - n] = b * TableSize / 2f;
+                }
+
+                fft.Inverse(real, imag);
+                var table = Samples.AsSpan(level * LevelStride, LevelStride);
+                real.AsSpan().CopyTo(table);
+                table[TableSize] = table[0];
+            }
+
+            // The shared tables live as long as the process, so they are pinned once for pointer reads.
+            GCHandle.Alloc(Samples, GCHandleType.Pinned);
+            Address = Marshal.UnsafeAddrOfPinnedArrayElement(Samples, 0);
+        }
+
+        /// <summary>
+        /// Gets the shared sine table. It has a single level.
+        /// </summary>
+        public static Wavetable Sine => SharedSine.Value;
+
+        /// <summary>
+        /// Gets the shared rising sawtooth table, from -1 at phase 0 to 1 at the end of the cycle.
+        /// </summary>
+        public static Wavetable Sawtooth => SharedSawtooth.Value;
+
+        /// <summary>
+        /// Gets the shared square table: 1 for the first half of the cycle, -1 for the second.
+        /// </summary>
+        public static Wavetable Square => SharedSquare.Value;
+
+        /// <summary>
+        /// Gets the shared triangle table, from 1 at phase 0 down to -1 at half a cycle.
+        /// </summary>
+        public static Wavetable Triangle => SharedTriangle.Value;
+
+        /// <summary>
+        /// Gets the number of levels.
+        /// </summary>
+        public int LevelCount { get; }
+
+        // Every level, LevelStride apart, and the address of the first one.
+        internal float[] Samples { get; }
+        internal nint Address { get; }
+
+        /// <summary>
+        /// Gets the samples of one level: <see cref="TableSize"/> samples and a guard sample equal to the first.
+        /// </summary>
+        /// <param name="level">The level index.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="level"/> is not a valid level.</exception>
+        public ReadOnlySpan<float> GetLevelSamples(int level)
+        {
+            if ((uint)level >= (uint)LevelCount)
+                throw new ArgumentOutOfRangeException(nameof(level));
+            return Samples.AsSpan(level * LevelStride, LevelStride);
+        }
+
+        /// <summary>
+        /// Gets the level whose partials all stay below Nyquist at the given phase increment.
+        /// </summary>
+        /// <param name="increment">The phase advance per sample in cycles, i.e. frequency over sample rate.</param>
+        public int GetLevel(float increment)
+        {
+            // Level k is safe while (MaxHarmonics >> k) * increment <= 0.5.
+            var level = 0;
+            var limit = 0.5f / Math.Max(increment, 1e-9f);
+            while (level < LevelCount - 1 && MaxHarmonics >> level > limit)
+                level++;
+            return level;
+        }
+
+        /// <summary>
+        /// Reads one level at a phase with linear interpolation.
+        /// </summary>
+        /// <param name="level">The level, from <see cref="GetLevel"/>.</param>
+        /// <param name="phase">The phase in cycles, in [0, 1).</param>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public float Read(int level, float phase)
+        {
+            var position = phase * TableSize;
+            // Rounding can land a wrapped phase on exactly 1; the guard sample covers the last index.
+            var index = Math.Min((int)position, TableSize - 1);
+            var offset = level * LevelStride + index;
+            var a = Samples[offset];
+            return a + (position - index) * (Samples[offset + 1] - a);
+        }
+
+        private static Wavetable Build(Func<int, (float Cos, float Sin)> harmonic)
+        {
+            var levels = 0;
+            while (MaxHarmonics >> levels > 0) levels++;
+            return new Wavetable(levels, MaxHarmonics, harmonic);
+        }
+
+        private static (float, float) SineHarmonic(int n) => (0f, n == 1 ? 1f : 0f);
+
+        private static (float, float) SawtoothHarmonic(int n) => (0f, -2f / (MathF.PI * n));
+
+        private static (float, float) SquareHarmonic(int n) => (0f, n % 2 == 1 ? 4f / (MathF.PI * n) : 0f);
+
+        private static (float, float) TriangleHarmonic(int n) => (n % 2 == 1 ? 8f / (MathF.PI * MathF.PI * n * n) : 0f, 0f);
+    }
+}
@@ -0,0 +1,55 @@
+using System.Collections.Generic;
+using UnityEngine;
+
+namespace SoundFlow.Providers
+{
+    /// <summary>
+    /// The reference-counted sample buffers behind <see cref="UnityAudioClipMode.Shared"/> providers, one per clip.
+    /// </summary>
+    internal static class UnityAudioClipCache
+    {
+        private sealed class Entry
+        {
+            public Entry(float[] samples) => Samples = samples;
+
+            public float[] Samples { get; }
+            public int References { get; set; }
+        }
+
+        private static readonly Dictionary<AudioClip, Entry> Entries = new();
+
+        /// <summary>
+        /// Returns the samples of <paramref name="clip"/>, copying them on first use. Must be called on the main
+        /// thread, as it may read the clip. Every call must be balanced by <see cref="Release"/>.
+        /// </summary>
+        public static float[] Acquire(AudioClip clip)
+        {
+            lock (Entries)
+            {
+                if (!Entries.TryGetValue(clip, out var entry))
+                {
+                    var samples = new float[clip.samples * clip.channels];
+                    clip.GetData(samples, 0);
+                    entry = new Entry(samples);
+                    Entries.Add(clip, entry);
+                }
+
+                entry.References++;
+                return entry.Samples;
+            }
+        }
+
+        /// <summary>
+        /// Drops one reference to the samples of <paramref name="clip"/>, freeing them with the last one.
+        /// Safe to call from any thread.
+        /// </summary>
+        public static void Release(AudioClip clip)
+        {
+            lock (Entries)
+            {
+                if (Entries.TryGetValue(clip, out var entry) && --entry.References == 0)
+                    Entries.Remove(clip);
+            }
+        }
+    }
+}
@@ -0,0 +1,26 @@
+namespace SoundFlow.Providers
+{
+    /// <summary>
+    /// Describes how a <see cref="UnityAudioClipProvider"/> gets the samples of its clip.
+    /// </summary>
+    public enum UnityAudioClipMode
+    {
+        /// <summary>
+        /// The whole clip is copied into a buffer owned by the provider when it is created.
+        /// </summary>
+        Preload,
+
+        /// <summary>
+        /// The whole clip is copied once into a buffer shared by every shared-mode provider of the same clip,
+        /// and released when the last of them is disposed.
+        /// </summary>
+        Shared,
+
+        /// <summary>
+        /// Only two short windows around the play position are held. The main thread refills them with
+        /// <c>AudioClip.GetData</c> every frame, so creating the provider neither allocates the whole clip nor
+        /// stalls to copy it.
+        /// </summary>
+        Streaming
+    }
+}
@@ -1,6 +1,8 @@
 using SoundFlow.Enums;
 using SoundFlow.Interfaces;
+using SoundFlow.Utils;
 using System;
+using System.Threading;
 using UnityEngine;
 
 namespace SoundFlow.Providers
@@ -8,51 +10,111 @@ namespace SoundFlow.Providers
     /// <summary>
     /// Provides audio data from a Unity AudioClip.
     /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The provider must be created on the main thread. In <see cref="UnityAudioClipMode.Preload"/> and
+    /// <see cref="UnityAudioClipMode.Shared"/> mode the whole clip is copied at that point; shared providers of the
+    /// same clip reuse one copy.
+    /// </para>
+    /// <para>
+    /// In <see cref="UnityAudioClipMode.Streaming"/> mode the provider holds two windows of the clip. The main thread
+    /// keeps the window at the play position and the one after it loaded; reads that find their window missing,
+    /// such as right after a seek, return silence without advancing until it arrives. The clip's samples must be
+    /// readable through <c>AudioClip.GetData</c>, so its load type cannot be Streaming.
+    /// </para>
+    /// </remarks>
     public sealed class UnityAudioClipProvider : ISoundDataProvider
     {
+        /// <summary>
+        /// The default length of each window in <see cref="UnityAudioClipMode.Streaming"/> mode, in milliseconds.
+        /// </summary>
+        public const int DefaultStreamingWindowMilliseconds = 250;
+
         private readonly AudioClip _audioClip;
-        private readonly float[] _audioData;
+        private readonly float[]? _audioData;
+        private readonly int _length;
+        private readonly int _sampleRate;
         private int _position;
 
+        // Streaming mode: two window buffers, and the index of the window each one holds (-1 while empty or being
+        // refilled). Window n covers samples [n * _windowSamples, (n + 1) * _windowSamples) and lives in slot n & 1.
+        private readonly float[][]? _windows;
+        private readonly int[]? _windowIndex;
+        private readonly int _windowSamples;
+        private readonly int _channels;
+
         /// <inheritdoc />
         public event EventHandler<EventArgs>? EndOfStreamReached;
         /// <inheritdoc />
-        public event EventHandler<PositionChangedEventArgs>? PositionChanged;
-
-        /// <inheritdoc />
-        public int Position
+        public event EventHandler<PositionChangedEventArgs>? PositionChanged
         {
-            get => _position;
-            private set
-            {
-                if (_position == value) return;
-                _position = value;
-                PositionChanged?.Invoke(this, new PositionChangedEventArgs(value));
-            }
+            add => Clock.Changed += value;
+            remove => Clock.Changed -= value;
         }
 
         /// <inheritdoc />
-        public int Length => _audioData.Length;
+        public PositionClock Clock { get; }
+
+        /// <inheritdoc />
+        public int Position => Volatile.Read(ref _position);
+
+        /// <inheritdoc />
+        public int Length => _length;
         /// <inheritdoc />
         public bool CanSeek => true;
         /// <inheritdoc />
         public SampleFormat SampleFormat => SampleFormat.F32;
         /// <inheritdoc />
-        public int SampleRate => _audioClip.frequency;
+        public int SampleRate => _sampleRate;
         /// <inheritdoc />
         public bool IsDisposed { get; private set; }
 
         /// <summary>
-        /// Initializes a new instance of the <see cref="UnityAudioClipProvider"/> class.
+        /// Gets how this provider gets the samples of its clip.
+        /// </summary>
+        public UnityAudioClipMode Mode { get; }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="UnityAudioClipProvider"/> class. Must be called on the main thread.
         /// </summary>
         /// <param name="audioClip">The Unity AudioClip to provide data from.</param>
-        public UnityAudioClipProvider(AudioClip audioClip)
+        /// <param name="mode">How to get the clip's samples.</param>
+        /// <param name="streamingWindowMilliseconds">The length of each window in <see cref="UnityAudioClipMode.Streaming"/> mode.</param>
+        /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="streamingWindowMilliseconds"/> is not positive.</exception>
+        public UnityAudioClipProvider(AudioClip audioClip, UnityAudioClipMode mode = UnityAudioClipMode.Preload,
+            int streamingWindowMilliseconds = DefaultStreamingWindowMilliseconds)
         {
             _audioClip = audioClip ?? throw new ArgumentNullException(nameof(audioClip));
+            if (streamingWindowMilliseconds <= 0)
+                throw new ArgumentOutOfRangeException(nameof(streamingWindowMilliseconds), "Window length must be positive.");
 
-            // Preload audio data into memory
-            _audioData = new float[_audioClip.samples * _audioClip.channels];
-            _audioClip.GetData(_audioData, 0);
+            Clock = new PositionClock(this);
+            Mode = mode;
+
+            // Read once here: AudioClip properties are only safe to touch from the main thread.
+            _channels = _audioClip.channels;
+            _sampleRate = _audioClip.frequency;
+            _length = _audioClip.samples * _channels;
+
+            switch (mode)
+            {
+                case UnityAudioClipMode.Shared:
+                    _audioData = UnityAudioClipCache.Acquire(_audioClip);
+                    break;
+                case UnityAudioClipMode.Streaming:
+                    var windowFrames = Math.Max(1, (int)((long)_sampleRate * streamingWindowMilliseconds / 1000));
+                    _windowSamples = windowFrames * _channels;
+                    _windows = new[] { new float[_windowSamples], new float[_windowSamples] };
+                    _windowIndex = new[] { -1, -1 };
+                    Pump();
+                    UnityAudioClipStreamer.Register(this);
+                    break;
+                default:
+                    // Preload audio data into memory
+                    _audioData = new float[_length];
+                    _audioClip.GetData(_audioData, 0);
+                    break;
+            }
         }
 
         /// <inheritdoc />
@@ -60,17 +122,33 @@ namespace SoundFlow.Providers
         {
             if (IsDisposed) return 0;
 
-            var available = Length - Position;
+            var available = Length - _position;
             var count = Math.Min(buffer.Length, available);
 
-            if (count > 0)
+            if (_windows != null)
             {
-                _audioData.AsSpan(Position, count).CopyTo(buffer);
-                Position += count;
+                var read = ReadWindows(buffer[..Math.Max(0, count)]);
+                if (read < count)
+                {
+                    // The window has not been loaded yet: play silence in place rather than end the stream.
+                    buffer[read..].Clear();
+                    Volatile.Write(ref _position, _position + read);
+                    Clock.Publish(_position, read > 0);
+                    return buffer.Length;
+                }
             }
+            else if (count > 0)
+            {
+                _audioData.AsSpan(_position, count).CopyTo(buffer);
+            }
+
+            if (count > 0)
+                Volatile.Write(ref _position, _position + count);
+
+            Clock.Publish(_position, count > 0);
 
             // Check if we've reached the end
-            if (Position >= Length)
+            if (_position >= Length)
             {
                 EndOfStreamReached?.Invoke(this, EventArgs.Empty);
             }
@@ -78,6 +156,66 @@ namespace SoundFlow.Providers
             return count;
         }
 
+        /// <summary>
+        /// Copies from the loaded windows, stopping at the first window that is missing or was refilled mid-copy.
+        /// </summary>
+        private int ReadWindows(Span<float> buffer)
+        {
+            var read = 0;
+            while (read < buffer.Length)
+            {
+                var position = _position + read;
+                var window = position / _windowSamples;
+                var slot = window & 1;
+                if (Volatile.Read(ref _windowIndex![slot]) != window) break;
+
+                var offset = position - window * _windowSamples;
+                var count = Math.Min(buffer.Length - read, _windowSamples - offset);
+                _windows![slot].AsSpan(offset, count).CopyTo(buffer[read..]);
+
+                // Only a seek can make the main thread reuse a slot being read; the copy is then discarded. The
+                // barrier keeps the sample loads above from moving past the re-check on weakly ordered CPUs. A slot
+                // refilled twice back to the same window during the copy holds the same samples, so that passes.
+                Interlocked.MemoryBarrier();
+                if (Volatile.Read(ref _windowIndex[slot]) != window) break;
+                read += count;
+            }
+
+            return read;
+        }
+
+        /// <summary>
+        /// Loads the window at the play position and the one after it, if they are not loaded yet. Only does work in
+        /// <see cref="UnityAudioClipMode.Streaming"/> mode, and must be called on the main thread.
+        /// </summary>
+        /// <remarks>
+        /// Called every frame in play mode. Call it yourself outside play mode, or right after seeking to
+        /// avoid waiting a frame for the new window.
+        /// </remarks>
+        public void Pump()
+        {
+            if (IsDisposed || _windows == null) return;
+
+            var window = Volatile.Read(ref _position) / _windowSamples;
+            LoadWindow(window);
+            LoadWindow(window + 1);
+        }
+
+        private void LoadWindow(int window)
+        {
+            var start = window * _windowSamples;
+            if (start >= _length) return;
+
+            var slot = window & 1;
+            if (Volatile.Read(ref _windowIndex![slot]) == window) return;
+
+            // Invalidate first so a reader racing with the refill discards what it copied. A full fence, so none
+            // of the sample stores below become visible before the invalidation does.
+            Interlocked.Exchange(ref _windowIndex[slot], -1);
+            _audioClip.GetData(_windows![slot], start / _channels);
+            Volatile.Write(ref _windowIndex[slot], window);
+        }
+
         /// <inheritdoc />
         public void Seek(int sampleOffset)
         {
@@ -85,7 +223,8 @@ namespace SoundFlow.Providers
             if (sampleOffset < 0 || sampleOffset > Length)
                 throw new ArgumentOutOfRangeException(nameof(sampleOffset), "Seek position is outside the valid range.");
 
-            Position = sampleOffset;
+            Volatile.Write(ref _position, sampleOffset);
+            Clock.Publish(sampleOffset, false);
         }
 
         /// <inheritdoc />
@@ -93,7 +232,12 @@ namespace SoundFlow.Providers
         {
             if (IsDisposed) return;
             IsDisposed = true;
+            Clock.Dispose();
             // Note: We don't own the AudioClip, so we don't dispose it
+            if (Mode == UnityAudioClipMode.Shared)
+                UnityAudioClipCache.Release(_audioClip);
+            else if (Mode == UnityAudioClipMode.Streaming)
+                UnityAudioClipStreamer.Unregister(this);
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,67 @@
+using System;
+using System.Threading;
+using UnityEngine;
+
+namespace SoundFlow.Providers
+{
+    /// <summary>
+    /// A hidden object that refills the windows of every streaming <see cref="UnityAudioClipProvider"/> once per
+    /// frame on the main thread.
+    /// </summary>
+    /// <remarks>
+    /// It is created with the first streaming provider and survives scene loads. Providers are kept in a
+    /// copy-on-write array swapped with compare-and-exchange, so disposing one from the audio thread never takes a
+    /// lock or waits for a frame in progress. Outside play mode Unity does not update it; call <see cref="UnityAudioClipProvider.Pump"/> instead.
+    /// </remarks>
+    internal sealed class UnityAudioClipStreamer : MonoBehaviour
+    {
+        private static UnityAudioClipProvider[] _providers = Array.Empty<UnityAudioClipProvider>();
+        private static UnityAudioClipStreamer? _instance;
+
+        /// <summary>
+        /// Adds a provider to the set refilled every frame. Must be called on the main thread.
+        /// </summary>
+        public static void Register(UnityAudioClipProvider provider)
+        {
+            while (true)
+            {
+                var current = Volatile.Read(ref _providers);
+                var updated = new UnityAudioClipProvider[current.Length + 1];
+                current.CopyTo(updated, 0);
+                updated[current.Length] = provider;
+                if (Interlocked.CompareExchange(ref _providers, updated, current) == current) break;
+            }
+
+            if (_instance != null) return;
+
+            var host = new GameObject("SoundFlow Clip Streamer") { hideFlags = HideFlags.HideAndDontSave };
+            if (Application.isPlaying) DontDestroyOnLoad(host);
+            _instance = host.AddComponent<UnityAudioClipStreamer>();
+        }
+
+        /// <summary>
+        /// Removes a provider from the set refilled every frame. Lock-free, so it is safe to call from any thread,
+        /// the audio thread included.
+        /// </summary>
+        public static void Unregister(UnityAudioClipProvider provider)
+        {
+            while (true)
+            {
+                var current = Volatile.Read(ref _providers);
+                var index = Array.IndexOf(current, provider);
+                if (index < 0) return;
+
+                var updated = new UnityAudioClipProvider[current.Length - 1];
+                Array.Copy(current, 0, updated, 0, index);
+                Array.Copy(current, index + 1, updated, index, current.Length - index - 1);
+                if (Interlocked.CompareExchange(ref _providers, updated, current) == current) return;
+            }
+        }
+
+        private void Update()
+        {
+            foreach (var provider in Volatile.Read(ref _providers))
+                provider.Pump();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+using System;
+
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// A named benchmark whose state is only built when it is selected to run.
+    /// </summary>
+    internal sealed class BenchmarkDefinition
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BenchmarkDefinition"/> class.
+        /// </summary>
+        /// <param name="name">The stable name results are keyed by, as <c>Group/Case</c>.</param>
+        /// <param name="create">Builds the benchmark state. May throw if a native library is missing.</param>
+        public BenchmarkDefinition(string name, Func<BenchmarkCase> create)
+        {
+            Name = name;
+            Create = create;
+        }
+
+        /// <summary>
+        /// Gets the stable name results are keyed by. Renaming a benchmark breaks comparison with older results.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets the factory that builds the benchmark state.
+        /// </summary>
+        public Func<BenchmarkCase> Create { get; }
+    }
+
+    /// <summary>
+    /// The state of one benchmark: an operation that processes a fixed number of samples, and the resources it uses.
+    /// </summary>
+    internal sealed class BenchmarkCase : IDisposable
+    {
+        private readonly IDisposable[] _resources;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BenchmarkCase"/> class.
+        /// </summary>
+        /// <param name="samplesPerOperation">The number of samples, across all channels, one operation processes.</param>
+        /// <param name="operation">The measured operation. It must leave the state ready for the next call.</param>
+        /// <param name="resources">Resources disposed once the benchmark has run.</param>
+        public BenchmarkCase(int samplesPerOperation, Action operation, params IDisposable[] resources)
+        {
+            if (samplesPerOperation <= 0)
+                throw new ArgumentOutOfRangeException(nameof(samplesPerOperation), "An operation must process samples.");
+
+            SamplesPerOperation = samplesPerOperation;
+            Operation = operation ?? throw new ArgumentNullException(nameof(operation));
+            _resources = resources;
+        }
+
+        /// <summary>
+        /// Gets the number of samples, across all channels, one operation processes.
+        /// </summary>
+        public int SamplesPerOperation { get; }
+
+        /// <summary>
+        /// Gets the measured operation.
+        /// </summary>
+        public Action Operation { get; }
+
+        /// <inheritdoc />
+        public void Dispose()
+        {
+            foreach (var resource in _resources)
+                resource.Dispose();
+        }
+    }
+}
@@ -0,0 +1,206 @@
+using SoundFlow.Enums;
+using SoundFlow.Structs;
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// The fixed format, block size and deterministic test signals every benchmark uses, so that results stay
+    /// comparable between runs and commits.
+    /// </summary>
+    internal static class BenchmarkAudio
+    {
+        /// <summary>
+        /// The sample rate of the benchmark format.
+        /// </summary>
+        public const int SampleRate = 48000;
+
+        /// <summary>
+        /// The channel count of the benchmark format.
+        /// </summary>
+        public const int Channels = 2;
+
+        /// <summary>
+        /// The frames per channel in one block, a typical device period.
+        /// </summary>
+        public const int BlockFrames = 512;
+
+        /// <summary>
+        /// The interleaved samples in one block.
+        /// </summary>
+        public const int BlockSamples = BlockFrames * Channels;
+
+        /// <summary>
+        /// The seed of every generated signal.
+        /// </summary>
+        public const int Seed = 1234;
+
+        /// <summary>
+        /// The benchmark format: 48 kHz stereo 32-bit float.
+        /// </summary>
+        public static readonly AudioFormat Format = new()
+        {
+            Format = SampleFormat.F32,
+            Channels = Channels,
+            SampleRate = SampleRate
+        };
+
+        /// <summary>
+        /// Generates interleaved stereo programme material: two tones and noise under a slow amplitude envelope,
+        /// so dynamics and filters see both level changes and broadband content.
+        /// </summary>
+        /// <param name="seconds">The length of the signal.</param>
+        /// <param name="sampleRate">The sample rate of the signal.</param>
+        /// <param name="seed">The noise seed; different seeds give uncorrelated voices.</param>
+        public static float[] Music(double seconds, int sampleRate = SampleRate, int seed = Seed)
+        {
+            var frames = (int)(seconds * sampleRate);
+            var signal = new float[frames * Channels];
+            var random = new Random(seed);
+            var phaseOffset = random.NextDouble() * Math.PI * 2;
+
+            for (var frame = 0; frame < frames; frame++)
+            {
+                var t = (double)frame / sampleRate;
+                var envelope = 0.55 + 0.45 * Math.Sin(2 * Math.PI * 0.5 * t + phaseOffset);
+                var tones = 0.35 * Math.Sin(2 * Math.PI * 220 * t) + 0.2 * Math.Sin(2 * Math.PI * 1375 * t + phaseOffset);
+                for (var channel = 0; channel < Channels; channel++)
+                {
+                    var noise = (random.NextDouble() * 2 - 1) * 0.15;
+                    signal[frame * Channels + channel] = (float)(envelope * (tones + noise));
+                }
+            }
+
+            return signal;
+        }
+
+        /// <summary>
+        /// Converts float samples to 16-bit PCM.
+        /// </summary>
+        public static short[] ToPcm16(float[] samples)
+        {
+            var pcm = new short[samples.Length];
+            for (var i = 0; i < samples.Length; i++)
+                pcm[i] = (short)Math.Round(Math.Clamp(samples[i], -1f, 1f) * short.MaxValue);
+            return pcm;
+        }
+
+        /// <summary>
+        /// Encodes interleaved float samples as a 16-bit PCM WAV file.
+        /// </summary>
+        public static byte[] Wave(float[] samples, int sampleRate = SampleRate, int channels = Channels)
+        {
+            var pcm = MemoryMarshal.AsBytes(ToPcm16(samples).AsSpan());
+            using var stream = new MemoryStream(44 + pcm.Length);
+            using (var writer = new BinaryWriter(stream, System.Text.Encoding.ASCII, leaveOpen: true))
+            {
+                writer.Write("RIFF".ToCharArray());
+                writer.Write(36 + pcm.Length);
+                writer.Write("WAVE".ToCharArray());
+                writer.Write("fmt ".ToCharArray());
+                writer.Write(16);
+                writer.Write((short)1);
+                writer.Write((short)channels);
+                writer.Write(sampleRate);
+                writer.Write(sampleRate * channels * sizeof(short));
+                writer.Write((short)(channels * sizeof(short)));
+                writer.Write((short)16);
+                writer.Write("data".ToCharArray());
+                writer.Write(pcm.Length);
+                writer.Write(pcm);
+            }
+
+            return stream.ToArray();
+        }
+    }
+
+    /// <summary>
+    /// Hands out consecutive blocks of a signal, wrapping at its end, so a benchmark processes fresh input on every
+    /// operation instead of feeding its own output back in.
+    /// </summary>
+    internal sealed class BlockSource
+    {
+        private readonly float[] _signal;
+        private int _position;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="BlockSource"/> class.
+        /// </summary>
+        public BlockSource(float[] signal) => _signal = signal;
+
+        /// <summary>
+        /// Copies the next <paramref name="block"/>.Length samples of the signal into <paramref name="block"/>.
+        /// </summary>
+        public void Fill(Span<float> block)
+        {
+            var written = 0;
+            while (written < block.Length)
+            {
+                var count = Math.Min(block.Length - written, _signal.Length - _position);
+                _signal.AsSpan(_position, count).CopyTo(block[written..]);
+                written += count;
+                _position += count;
+                if (_position == _signal.Length) _position = 0;
+            }
+        }
+    }
+
+    /// <summary>
+    /// An unmanaged buffer released on dispose, standing in for a device buffer.
+    /// </summary>
+    internal sealed class NativeBuffer : IDisposable
+    {
+        /// <summary>
+        /// Allocates <paramref name="bytes"/> bytes of unmanaged memory.
+        /// </summary>
+        public NativeBuffer(int bytes) => Pointer = Marshal.AllocHGlobal(bytes);
+
+        /// <summary>
+        /// Gets the start of the buffer.
+        /// </summary>
+        public IntPtr Pointer { get; private set; }
+
+        /// <inheritdoc />
+        public void Dispose()
+        {
+            if (Pointer == IntPtr.Zero) return;
+            Marshal.FreeHGlobal(Pointer);
+            Pointer = IntPtr.Zero;
+        }
+    }
+
+    /// <summary>
+    /// A temporary file deleted on dispose.
+    /// </summary>
+    internal sealed class TemporaryFile : IDisposable
+    {
+        /// <summary>
+        /// Writes <paramref name="contents"/> to a new temporary file.
+        /// </summary>
+        public TemporaryFile(byte[] contents, string extension)
+        {
+            Path = System.IO.Path.Combine(System.IO.Path.GetTempPath(), $"soundflow-bench-{Guid.NewGuid():N}{extension}");
+            File.WriteAllBytes(Path, contents);
+        }
+
+        /// <summary>
+        /// Gets the path of the file.
+        /// </summary>
+        public string Path { get; }
+
+        /// <inheritdoc />
+        public void Dispose()
+        {
+            try
+            {
+                File.Delete(Path);
+            }
+            catch (IOException)
+            {
+                // A mapping that is still open on some platforms keeps the file; the temp directory reclaims it.
+            }
+        }
+    }
+}
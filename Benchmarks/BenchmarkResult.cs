@@ -0,0 +1,58 @@
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// The outcome of running one benchmark.
+    /// </summary>
+    internal sealed class BenchmarkResult
+    {
+        /// <summary>
+        /// Gets or sets the benchmark name.
+        /// </summary>
+        public string Name { get; set; } = "";
+
+        /// <summary>
+        /// Gets or sets the number of samples one operation processes.
+        /// </summary>
+        public int SamplesPerOperation { get; set; }
+
+        /// <summary>
+        /// Gets or sets the median time per sample over all rounds, in nanoseconds.
+        /// </summary>
+        public double NanosecondsPerSample { get; set; }
+
+        /// <summary>
+        /// Gets or sets the fastest round's time per sample, in nanoseconds.
+        /// </summary>
+        public double MinNanosecondsPerSample { get; set; }
+
+        /// <summary>
+        /// Gets or sets the median time per operation, in nanoseconds.
+        /// </summary>
+        public double NanosecondsPerOperation { get; set; }
+
+        /// <summary>
+        /// Gets or sets the bytes allocated by the benchmark thread per operation.
+        /// </summary>
+        public double BytesPerOperation { get; set; }
+
+        /// <summary>
+        /// Gets or sets the number of generation 0 collections during the measured rounds.
+        /// </summary>
+        public int Gen0Collections { get; set; }
+
+        /// <summary>
+        /// Gets or sets why the benchmark produced no measurement, or null if it ran.
+        /// </summary>
+        public string? Status { get; set; }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether the benchmark failed rather than being skipped.
+        /// </summary>
+        public bool Failed { get; set; }
+
+        /// <summary>
+        /// Gets a value indicating whether the benchmark produced a measurement.
+        /// </summary>
+        public bool HasMeasurement => Status == null;
+    }
+}
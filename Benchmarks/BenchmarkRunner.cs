@@ -0,0 +1,122 @@
+using System;
+using System.Diagnostics;
+
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// Measurement settings shared by every benchmark of a run.
+    /// </summary>
+    internal sealed class BenchmarkOptions
+    {
+        /// <summary>
+        /// Gets or sets how long each benchmark runs before measuring, in milliseconds.
+        /// </summary>
+        public int WarmupMilliseconds { get; set; } = 250;
+
+        /// <summary>
+        /// Gets or sets the number of measured rounds. The reported time is the median round.
+        /// </summary>
+        public int Rounds { get; set; } = 9;
+
+        /// <summary>
+        /// Gets or sets the approximate length of one round, in milliseconds.
+        /// </summary>
+        public int RoundMilliseconds { get; set; } = 100;
+    }
+
+    /// <summary>
+    /// Runs benchmarks on the calling thread.
+    /// </summary>
+    /// <remarks>
+    /// Warm-up doubles as calibration: it counts how many operations fit in the warm-up period and sizes every round
+    /// to take about <see cref="BenchmarkOptions.RoundMilliseconds"/>. Allocations are counted on the calling thread
+    /// only, so work handed to background threads (render workers, read-ahead) is timed but its allocations are not.
+    /// </remarks>
+    internal static class BenchmarkRunner
+    {
+        /// <summary>
+        /// Builds, measures and disposes the benchmark defined by <paramref name="definition"/>.
+        /// </summary>
+        public static BenchmarkResult Run(BenchmarkDefinition definition, BenchmarkOptions options)
+        {
+            var result = new BenchmarkResult { Name = definition.Name };
+
+            BenchmarkCase benchmark;
+            try
+            {
+                benchmark = definition.Create();
+            }
+            catch (Exception e) when (NativeLibraries.IsMissing(e, out var reason))
+            {
+                result.Status = $"skipped: {reason}";
+                return result;
+            }
+            catch (Exception e)
+            {
+                result.Status = $"failed: {e.GetType().Name}: {e.Message}";
+                result.Failed = true;
+                return result;
+            }
+
+            try
+            {
+                Measure(benchmark, options, result);
+            }
+            catch (Exception e)
+            {
+                result.Status = $"failed: {e.GetType().Name}: {e.Message}";
+                result.Failed = true;
+            }
+            finally
+            {
+                benchmark.Dispose();
+            }
+
+            return result;
+        }
+
+        private static void Measure(BenchmarkCase benchmark, BenchmarkOptions options, BenchmarkResult result)
+        {
+            var operation = benchmark.Operation;
+
+            var warmup = Stopwatch.StartNew();
+            long warmupOperations = 0;
+            do
+            {
+                operation();
+                warmupOperations++;
+            } while (warmup.ElapsedMilliseconds < options.WarmupMilliseconds);
+
+            var batch = Math.Max(1L,
+                (long)(warmupOperations * (double)options.RoundMilliseconds / warmup.Elapsed.TotalMilliseconds));
+
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            GC.Collect();
+
+            var rounds = new double[Math.Max(1, options.Rounds)];
+            var gen0Before = GC.CollectionCount(0);
+            var allocatedBefore = GC.GetAllocatedBytesForCurrentThread();
+
+            for (var round = 0; round < rounds.Length; round++)
+            {
+                var start = Stopwatch.GetTimestamp();
+                for (var i = 0L; i < batch; i++)
+                    operation();
+                var elapsed = Stopwatch.GetTimestamp() - start;
+                rounds[round] = elapsed * (1e9 / Stopwatch.Frequency) / batch;
+            }
+
+            var allocated = GC.GetAllocatedBytesForCurrentThread() - allocatedBefore;
+            result.Gen0Collections = GC.CollectionCount(0) - gen0Before;
+
+            Array.Sort(rounds);
+            var median = rounds[rounds.Length / 2];
+            result.SamplesPerOperation = benchmark.SamplesPerOperation;
+            result.NanosecondsPerOperation = median;
+            result.NanosecondsPerSample = median / benchmark.SamplesPerOperation;
+            result.MinNanosecondsPerSample = rounds[0] / benchmark.SamplesPerOperation;
+            result.BytesPerOperation = allocated / ((double)batch * rounds.Length);
+        }
+    }
+}
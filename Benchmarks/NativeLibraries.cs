@@ -0,0 +1,78 @@
+using System;
+using System.IO;
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// Resolves the native libraries of the SoundFlow bindings to the prebuilt plugins shipped under
+    /// <c>Assets/soundflow-unity/Plugins</c>, so the native benchmarks need no installation step.
+    /// </summary>
+    internal static class NativeLibraries
+    {
+        /// <summary>
+        /// Gets the plugin directory for the current operating system and architecture.
+        /// </summary>
+        public static string PluginDirectory { get; } = Path.Combine(GetPluginsRoot(), GetPlatformFolder());
+
+        /// <summary>
+        /// Installs the resolver for this assembly. Must be called before any native binding is used.
+        /// </summary>
+        public static void Register() => NativeLibrary.SetDllImportResolver(typeof(NativeLibraries).Assembly, Resolve);
+
+        /// <summary>
+        /// Returns true if <paramref name="exception"/>, or an exception it wraps, means that a native library or
+        /// one of its entry points could not be loaded.
+        /// </summary>
+        /// <param name="exception">The exception to inspect.</param>
+        /// <param name="reason">The first line of the loader's message, if the library is missing.</param>
+        public static bool IsMissing(Exception exception, out string reason)
+        {
+            for (var e = exception; e != null; e = e.InnerException)
+            {
+                if (e is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+                {
+                    reason = e.Message.Split('\n')[0].Trim();
+                    return true;
+                }
+            }
+
+            reason = "";
+            return false;
+        }
+
+        private static IntPtr Resolve(string libraryName, Assembly assembly, DllImportSearchPath? searchPath)
+        {
+            // Android-style names such as "miniaudio.so" carry their suffix already.
+            var name = Path.GetFileNameWithoutExtension(libraryName);
+            var fileName = RuntimeInformation.IsOSPlatform(OSPlatform.Windows) ? $"{name}.dll"
+                : RuntimeInformation.IsOSPlatform(OSPlatform.OSX) ? $"lib{name}.dylib"
+                : $"lib{name}.so";
+
+            // Load by path so the loader's own error, such as a missing dependency, surfaces in the exception.
+            var path = Path.Combine(PluginDirectory, fileName);
+            return File.Exists(path) ? NativeLibrary.Load(path) : IntPtr.Zero;
+        }
+
+        private static string GetPluginsRoot()
+        {
+            foreach (var attribute in typeof(NativeLibraries).Assembly.GetCustomAttributes<AssemblyMetadataAttribute>())
+            {
+                if (attribute.Key == "SoundFlowPlugins" && attribute.Value != null)
+                    return attribute.Value;
+            }
+
+            return AppContext.BaseDirectory;
+        }
+
+        private static string GetPlatformFolder()
+        {
+            var os = RuntimeInformation.IsOSPlatform(OSPlatform.Windows) ? "Win"
+                : RuntimeInformation.IsOSPlatform(OSPlatform.OSX) ? "macOS"
+                : "Linux";
+            var architecture = RuntimeInformation.ProcessArchitecture == Architecture.Arm64 ? "arm64" : "x86_64";
+            return Path.Combine(os, architecture);
+        }
+    }
+}
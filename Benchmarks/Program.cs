@@ -0,0 +1,148 @@
+using SoundFlow.Benchmarks.Suites;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using System.Numerics;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// Command-line entry point. See README.md for usage.
+    /// </summary>
+    internal static class Program
+    {
+        private const string Usage =
+            "Usage: dotnet run -c Release -- [options]\n" +
+            "  --filter <text>     Run only benchmarks whose name contains <text>; may be repeated.\n" +
+            "  --list              List benchmark names and exit.\n" +
+            "  --csv <path>        Also write the results to a CSV file.\n" +
+            "  --baseline <path>   Compare against a CSV written by an earlier run.\n" +
+            "  --rounds <n>        Measured rounds per benchmark (default 9).\n" +
+            "  --round-ms <ms>     Approximate length of one round (default 100).\n" +
+            "  --warmup-ms <ms>    Warm-up before measuring (default 250).";
+
+        private static int Main(string[] args)
+        {
+            var options = new BenchmarkOptions();
+            var filters = new List<string>();
+            string? csvPath = null, baselinePath = null;
+            var list = false;
+
+            try
+            {
+                for (var i = 0; i < args.Length; i++)
+                {
+                    switch (args[i])
+                    {
+                        case "--filter": filters.Add(Value(args, ref i)); break;
+                        case "--list": list = true; break;
+                        case "--csv": csvPath = Value(args, ref i); break;
+                        case "--baseline": baselinePath = Value(args, ref i); break;
+                        case "--rounds": options.Rounds = PositiveInt(args, ref i); break;
+                        case "--round-ms": options.RoundMilliseconds = PositiveInt(args, ref i); break;
+                        case "--warmup-ms": options.WarmupMilliseconds = PositiveInt(args, ref i); break;
+                        case "--help":
+                        case "-h":
+                            Console.WriteLine(Usage);
+                            return 0;
+                        default: throw new ArgumentException($"Unknown option '{args[i]}'.");
+                    }
+                }
+            }
+            catch (ArgumentException e)
+            {
+                Console.Error.WriteLine(e.Message);
+                Console.Error.WriteLine(Usage);
+                return 2;
+            }
+
+            var selected = Catalog()
+                .Where(d => filters.Count == 0 ||
+                            filters.Any(f => d.Name.IndexOf(f, StringComparison.OrdinalIgnoreCase) >= 0))
+                .ToList();
+
+            if (list)
+            {
+                foreach (var definition in selected)
+                    Console.WriteLine(definition.Name);
+                return 0;
+            }
+
+            if (selected.Count == 0)
+            {
+                Console.Error.WriteLine("No benchmark matches the filter.");
+                return 2;
+            }
+
+            var baseline = baselinePath != null ? ResultWriter.ReadBaseline(baselinePath) : null;
+
+            NativeLibraries.Register();
+            Thread.CurrentThread.Priority = ThreadPriority.Highest;
+
+            var environment = DescribeEnvironment(options);
+            foreach (var line in environment)
+                Console.WriteLine(line);
+            Console.WriteLine();
+
+            var nameWidth = selected.Max(d => d.Name.Length);
+            ResultWriter.WriteTableHeader(Console.Out, nameWidth, baseline != null);
+
+            var results = new List<BenchmarkResult>();
+            foreach (var definition in selected)
+            {
+                var result = BenchmarkRunner.Run(definition, options);
+                results.Add(result);
+                ResultWriter.WriteTableRow(Console.Out, result, nameWidth, baseline);
+            }
+
+            if (csvPath != null)
+                ResultWriter.WriteCsv(csvPath, environment, results);
+
+            return results.Any(r => r.Failed) ? 1 : 0;
+        }
+
+        /// <summary>
+        /// Every benchmark, in a fixed order. Names are the keys results are compared by across commits.
+        /// </summary>
+        private static IEnumerable<BenchmarkDefinition> Catalog() =>
+            ModifierSuite.Definitions()
+                .Concat(MixerSuite.Definitions())
+                .Concat(SurroundSuite.Definitions())
+                .Concat(OscillatorSuite.Definitions())
+                .Concat(ConversionSuite.Definitions())
+                .Concat(TimeStretchSuite.Definitions())
+                .Concat(DecoderSuite.Definitions())
+                .Concat(ProviderSuite.Definitions())
+                .Concat(ApmSuite.Definitions());
+
+        private static string[] DescribeEnvironment(BenchmarkOptions options) => new[]
+        {
+            $"SoundFlow benchmarks, {DateTime.UtcNow:yyyy-MM-dd HH:mm} UTC",
+            $"{RuntimeInformation.FrameworkDescription}, {RuntimeInformation.OSDescription}, " +
+            $"{RuntimeInformation.ProcessArchitecture}, {Environment.ProcessorCount} logical processors",
+            $"Vector<float>.Count = {Vector<float>.Count}, hardware accelerated = {Vector.IsHardwareAccelerated}",
+            $"Format {BenchmarkAudio.SampleRate} Hz, {BenchmarkAudio.Channels} channels, " +
+            $"{BenchmarkAudio.BlockFrames} frames per block; {options.Rounds} rounds of ~{options.RoundMilliseconds} ms " +
+            $"after {options.WarmupMilliseconds} ms warm-up; times are medians"
+        };
+
+        private static string Value(string[] args, ref int index)
+        {
+            if (index + 1 >= args.Length)
+                throw new ArgumentException($"Option '{args[index]}' requires a value.");
+            return args[++index];
+        }
+
+        private static int PositiveInt(string[] args, ref int index)
+        {
+            var option = args[index];
+            if (!int.TryParse(Value(args, ref index), NumberStyles.Integer, CultureInfo.InvariantCulture, out var value) ||
+                value <= 0)
+                throw new ArgumentException($"Option '{option}' requires a positive integer.");
+            return value;
+        }
+    }
+}
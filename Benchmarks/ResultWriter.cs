@@ -0,0 +1,138 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+
+namespace SoundFlow.Benchmarks
+{
+    /// <summary>
+    /// Prints results as a table and reads and writes them as CSV, so runs at two commits can be compared.
+    /// </summary>
+    /// <remarks>
+    /// The CSV has one row per benchmark keyed by its name; lines starting with <c>#</c> record the environment the
+    /// run was made in and are ignored when a file is read back as a baseline.
+    /// </remarks>
+    internal static class ResultWriter
+    {
+        private const string CsvHeader = "benchmark,samples_per_op,ns_per_sample,ns_per_sample_min,ns_per_op,bytes_per_op,gen0,status";
+
+        private static readonly CultureInfo Invariant = CultureInfo.InvariantCulture;
+
+        /// <summary>
+        /// Writes the column headings of the result table.
+        /// </summary>
+        public static void WriteTableHeader(TextWriter writer, int nameWidth, bool hasBaseline)
+        {
+            writer.WriteLine(FormattableString.Invariant(
+                $"{"Benchmark".PadRight(nameWidth)} {"samples/op",10} {"ns/sample",10} {"min",10} {"ns/op",12} {"B/op",10}") +
+                (hasBaseline ? $" {"vs base",9}" : ""));
+        }
+
+        /// <summary>
+        /// Writes one row of the result table, with the change against <paramref name="baseline"/> if it has the benchmark.
+        /// </summary>
+        public static void WriteTableRow(TextWriter writer, BenchmarkResult result, int nameWidth,
+            IReadOnlyDictionary<string, double>? baseline)
+        {
+            var name = result.Name.PadRight(nameWidth);
+            if (!result.HasMeasurement)
+            {
+                writer.WriteLine($"{name} {result.Status}");
+                return;
+            }
+
+            var line = FormattableString.Invariant(
+                $"{name} {result.SamplesPerOperation,10} {result.NanosecondsPerSample,10:F3} {result.MinNanosecondsPerSample,10:F3} {result.NanosecondsPerOperation,12:F0} {result.BytesPerOperation,10:F1}");
+
+            if (baseline != null)
+            {
+                line += baseline.TryGetValue(result.Name, out var previous) && previous > 0
+                    ? FormattableString.Invariant($" {(result.NanosecondsPerSample / previous - 1) * 100,8:+0.0;-0.0}%")
+                    : $" {"new",9}";
+            }
+
+            writer.WriteLine(line);
+        }
+
+        /// <summary>
+        /// Writes <paramref name="results"/> to a CSV file, preceded by the environment description.
+        /// </summary>
+        public static void WriteCsv(string path, IEnumerable<string> environment, IEnumerable<BenchmarkResult> results)
+        {
+            var directory = Path.GetDirectoryName(Path.GetFullPath(path));
+            if (!string.IsNullOrEmpty(directory))
+                Directory.CreateDirectory(directory);
+
+            using var writer = new StreamWriter(path);
+            foreach (var line in environment)
+                writer.WriteLine($"# {line}");
+            writer.WriteLine(CsvHeader);
+
+            foreach (var result in results)
+            {
+                writer.WriteLine(string.Join(",",
+                    Quote(result.Name),
+                    result.SamplesPerOperation.ToString(Invariant),
+                    result.HasMeasurement ? result.NanosecondsPerSample.ToString("R", Invariant) : "",
+                    result.HasMeasurement ? result.MinNanosecondsPerSample.ToString("R", Invariant) : "",
+                    result.HasMeasurement ? result.NanosecondsPerOperation.ToString("R", Invariant) : "",
+                    result.HasMeasurement ? result.BytesPerOperation.ToString("R", Invariant) : "",
+                    result.Gen0Collections.ToString(Invariant),
+                    Quote(result.Status ?? "")));
+            }
+        }
+
+        /// <summary>
+        /// Reads the median ns/sample of every measured benchmark from a CSV written by <see cref="WriteCsv"/>.
+        /// </summary>
+        /// <exception cref="InvalidDataException">Thrown if the file is not a benchmark result file.</exception>
+        public static Dictionary<string, double> ReadBaseline(string path)
+        {
+            var baseline = new Dictionary<string, double>(StringComparer.Ordinal);
+            var lines = File.ReadLines(path).Where(l => l.Length > 0 && l[0] != '#').ToList();
+            if (lines.Count == 0 || lines[0] != CsvHeader)
+                throw new InvalidDataException($"'{path}' is not a benchmark result file.");
+
+            foreach (var line in lines.Skip(1))
+            {
+                var fields = SplitCsv(line);
+                if (fields.Count >= 3 && double.TryParse(fields[2], NumberStyles.Float, Invariant, out var nanoseconds))
+                    baseline[fields[0]] = nanoseconds;
+            }
+
+            return baseline;
+        }
+
+        private static string Quote(string value) =>
+            value.IndexOfAny(new[] { ',', '"' }) < 0 ? value : $"\"{value.Replace("\"", "\"\"")}\"";
+
+        private static List<string> SplitCsv(string line)
+        {
+            var fields = new List<string>();
+            var field = new System.Text.StringBuilder();
+            var quoted = false;
+
+            for (var i = 0; i < line.Length; i++)
+            {
+                var c = line[i];
+                if (quoted)
+                {
+                    if (c != '"') field.Append(c);
+                    else if (i + 1 < line.Length && line[i + 1] == '"') field.Append(line[++i]);
+                    else quoted = false;
+                }
+                else if (c == '"') quoted = true;
+                else if (c == ',')
+                {
+                    fields.Add(field.ToString());
+                    field.Clear();
+                }
+                else field.Append(c);
+            }
+
+            fields.Add(field.ToString());
+            return fields;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+using SoundFlow.Backends.Offline;
+using SoundFlow.Extensions.WebRtc.Apm;
+using SoundFlow.Extensions.WebRtc.Apm.Modifiers;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// The WebRTC APM frame path: <see cref="WebRtcApmModifier"/> chunking device blocks into 10 ms frames, running
+    /// them through the native module and writing the result back, one block per operation. Skipped when the native
+    /// webrtc-apm library is missing.
+    /// </summary>
+    /// <remarks>
+    /// The block of 512 frames is deliberately not a multiple of the 480-frame APM frame, so the ring buffering
+    /// between the two is part of the measurement. The echo-cancelling case also queues a far-end reference block
+    /// per operation.
+    /// </remarks>
+    internal static class ApmSuite
+    {
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            yield return Apm("WebRtcApm/NS", false, device => new WebRtcApmModifier(device, nsEnabled: true));
+            yield return Apm("WebRtcApm/AEC+NS+AGC2+HPF", true, device => new WebRtcApmModifier(device,
+                aecEnabled: true, nsEnabled: true, agc2Enabled: true, hpfEnabled: true));
+        }
+
+        private static BenchmarkDefinition Apm(string name, bool farEnd,
+            Func<SoundFlow.Abstracts.Devices.AudioDevice, WebRtcApmModifier> create) =>
+            new(name, () =>
+            {
+                // The modifier swallows native initialization failures and passes audio through, so probe the
+                // library first to skip rather than measure a pass-through.
+                new AudioProcessingModule().Dispose();
+
+                var engine = new OfflineEngine();
+                var device = engine.InitializeCaptureDevice(null, BenchmarkAudio.Format);
+                var modifier = create(device);
+
+                var nearEnd = new BlockSource(BenchmarkAudio.Music(2));
+                var reference = new BlockSource(BenchmarkAudio.Music(2, seed: BenchmarkAudio.Seed + 1));
+                var block = new float[BenchmarkAudio.BlockSamples];
+                var referenceBlock = new float[BenchmarkAudio.BlockSamples];
+
+                return new BenchmarkCase(block.Length, () =>
+                {
+                    if (farEnd)
+                    {
+                        reference.Fill(referenceBlock);
+                        modifier.EnqueueFarend(referenceBlock);
+                    }
+
+                    nearEnd.Fill(block);
+                    modifier.Process(block, BenchmarkAudio.Channels);
+                }, modifier, engine);
+            });
+    }
+}
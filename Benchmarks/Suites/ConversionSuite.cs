@@ -0,0 +1,60 @@
+using SoundFlow.Enums;
+using SoundFlow.Utils;
+using System.Collections.Generic;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// <see cref="DeviceBufferHelper"/> sample-format conversions between the float mix buffer and a native device
+    /// buffer, one block per operation, in both directions and, for the integer formats that support it, dithered.
+    /// </summary>
+    /// <remarks>
+    /// <see cref="DeviceBufferHelper.ConvertToDeviceFormat(System.Span{float}, nint, int, SampleFormat, bool)"/>
+    /// clears its source, so the to-device cases copy the block in first, as a device callback would after mixing.
+    /// </remarks>
+    internal static class ConversionSuite
+    {
+        private static readonly SampleFormat[] Formats =
+            { SampleFormat.U8, SampleFormat.S16, SampleFormat.S24, SampleFormat.S32, SampleFormat.F32 };
+
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            foreach (var format in Formats)
+            {
+                yield return ToDevice(format, false);
+                if (format is SampleFormat.U8 or SampleFormat.S16 or SampleFormat.S24)
+                    yield return ToDevice(format, true);
+                yield return FromDevice(format);
+            }
+        }
+
+        private static BenchmarkDefinition ToDevice(SampleFormat format, bool dither) =>
+            new($"Conversion/{format} to device" + (dither ? " dithered" : ""), () =>
+            {
+                var source = new BlockSource(BenchmarkAudio.Music(1));
+                var block = new float[BenchmarkAudio.BlockSamples];
+                var native = new NativeBuffer(block.Length * sizeof(int));
+
+                return new BenchmarkCase(block.Length, () =>
+                {
+                    source.Fill(block);
+                    DeviceBufferHelper.ConvertToDeviceFormat(block, native.Pointer, block.Length, format, dither);
+                }, native);
+            });
+
+        private static BenchmarkDefinition FromDevice(SampleFormat format) =>
+            new($"Conversion/{format} from device", () =>
+            {
+                var block = new float[BenchmarkAudio.BlockSamples];
+                var native = new NativeBuffer(block.Length * sizeof(int));
+
+                // Fill the device buffer with real samples in its own format.
+                new BlockSource(BenchmarkAudio.Music(1)).Fill(block);
+                DeviceBufferHelper.ConvertToDeviceFormat(block, native.Pointer, block.Length, format, false);
+
+                return new BenchmarkCase(block.Length,
+                    () => DeviceBufferHelper.ConvertFromDeviceFormat(native.Pointer, block, block.Length, format),
+                    native);
+            });
+    }
+}
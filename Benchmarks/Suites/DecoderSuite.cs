@@ -0,0 +1,36 @@
+using SoundFlow.Backends.MiniAudio;
+using SoundFlow.Enums;
+using System.Collections.Generic;
+using System.IO;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// <see cref="MiniAudioDecoder.Decode"/> of an in-memory 16-bit WAV file to float, one block per operation, both
+    /// at the file's own rate and resampled from 44.1 kHz. Skipped when the native miniaudio library is missing.
+    /// </summary>
+    internal static class DecoderSuite
+    {
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            yield return Decode("WAV S16 48k to F32 48k", BenchmarkAudio.SampleRate);
+            yield return Decode("WAV S16 44.1k to F32 48k", 44100);
+        }
+
+        private static BenchmarkDefinition Decode(string name, int fileSampleRate) =>
+            new($"MiniAudioDecoder/{name}", () =>
+            {
+                var wave = BenchmarkAudio.Wave(BenchmarkAudio.Music(4, fileSampleRate), fileSampleRate);
+                var stream = new MemoryStream(wave, false);
+                var decoder = new MiniAudioDecoder(stream, SampleFormat.F32, BenchmarkAudio.Channels,
+                    BenchmarkAudio.SampleRate);
+                var block = new float[BenchmarkAudio.BlockSamples];
+
+                return new BenchmarkCase(block.Length, () =>
+                {
+                    if (decoder.Decode(block) < block.Length)
+                        decoder.Seek(0);
+                }, decoder, stream);
+            });
+    }
+}
@@ -0,0 +1,60 @@
+using SoundFlow.Backends.Offline;
+using SoundFlow.Components;
+using SoundFlow.Providers;
+using System.Collections.Generic;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// <see cref="Mixer"/> fan-in: a master mixer summing 8, 64 or 256 looping <see cref="SoundPlayer"/> voices,
+    /// rendered one device block per operation through an <see cref="OfflineEngine"/>.
+    /// </summary>
+    /// <remarks>
+    /// Times are per output sample, so they grow with the voice count. Voices cycle through eight differently seeded
+    /// signals started at staggered positions, so the inputs are not all served from the same cache lines. The
+    /// parallel variants render with <see cref="Mixer.ParallelRendering"/>; their worker threads' allocations are not
+    /// counted.
+    /// </remarks>
+    internal static class MixerSuite
+    {
+        private const int DistinctSignals = 8;
+
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            foreach (var voices in new[] { 8, 64, 256 })
+            {
+                yield return FanIn(voices, false);
+                yield return FanIn(voices, true);
+            }
+        }
+
+        private static BenchmarkDefinition FanIn(int voices, bool parallel) =>
+            new($"Mixer/{voices} voices" + (parallel ? " parallel" : ""), () =>
+            {
+                var format = BenchmarkAudio.Format;
+                var engine = new OfflineEngine();
+                var device = engine.CreatePlaybackDevice(format, BenchmarkAudio.BlockFrames);
+
+                var signals = new float[DistinctSignals][];
+                for (var i = 0; i < signals.Length; i++)
+                    signals[i] = BenchmarkAudio.Music(2, seed: BenchmarkAudio.Seed + i);
+
+                for (var voice = 0; voice < voices; voice++)
+                {
+                    var signal = signals[voice % DistinctSignals];
+                    var provider = new RawDataProvider(signal);
+                    provider.Seek(voice * 997 * BenchmarkAudio.Channels % signal.Length);
+
+                    var player = new SoundPlayer(engine, format, provider) { IsLooping = true, Volume = 1f / voices };
+                    player.Play();
+                    device.MasterMixer.AddComponent(player);
+                }
+
+                device.MasterMixer.ParallelRendering = parallel;
+                device.Start();
+
+                var output = new float[BenchmarkAudio.BlockSamples];
+                return new BenchmarkCase(output.Length, () => device.Render(output), engine);
+            });
+    }
+}
@@ -0,0 +1,67 @@
+using SoundFlow.Abstracts;
+using SoundFlow.Enums;
+using SoundFlow.Modifiers;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// Every built-in <see cref="SoundModifier"/>, one stereo block per operation through its public
+    /// <see cref="SoundModifier.Process"/> entry point.
+    /// </summary>
+    /// <remarks>
+    /// Each operation first copies a fresh block of programme material into the buffer, so feedback effects never
+    /// run on their own output. The copy costs well under a nanosecond per sample and is the same for every commit.
+    /// </remarks>
+    internal static class ModifierSuite
+    {
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            var format = BenchmarkAudio.Format;
+
+            yield return Modifier("AlgorithmicReverb", () => new AlgorithmicReverbModifier(format));
+            yield return Modifier("BassBooster", () => new BassBoosterModifier(format));
+            yield return Modifier("Chorus", () => new ChorusModifier(format));
+            yield return Modifier("Compressor", () => new CompressorModifier(format, -18f, 4f, 5f, 80f, 6f, 3f));
+            yield return Modifier("Compressor per-channel", () => new CompressorModifier(format, -18f, 4f, 5f, 80f, 6f, 3f)
+                { Linking = DynamicsLinking.PerChannel });
+            yield return Modifier("Compressor lookahead", () => new CompressorModifier(format, -18f, 4f, 5f, 80f, 6f, 3f)
+                { LookaheadMs = 5f });
+            yield return Modifier("Delay", () => new DelayModifier(format, 12000));
+            yield return Modifier("FrequencyBand", () => new FrequencyBandModifier(format, 200f, 4000f));
+            yield return Modifier("HighPass", () => new HighPassModifier(format, 120f));
+            yield return Modifier("LowPass", () => new LowPassModifier(format, 6000f));
+            yield return Modifier("MultiChannelChorus",
+                () => new MultiChannelChorusModifier(format, 0.5f, 2048, (200f, 0.5f, 0.3f), (300f, 0.7f, 0.3f)));
+            yield return Modifier("ParametricEqualizer", () =>
+            {
+                var equalizer = new ParametricEqualizer(format);
+                equalizer.AddBands(new[]
+                {
+                    new EqualizerBand(FilterType.LowShelf, 100f, 3f, 0.7f),
+                    new EqualizerBand(FilterType.Peaking, 400f, -2f, 1.0f),
+                    new EqualizerBand(FilterType.Peaking, 1500f, 2f, 1.2f),
+                    new EqualizerBand(FilterType.Peaking, 5000f, -3f, 2.0f),
+                    new EqualizerBand(FilterType.HighShelf, 10000f, 2f, 0.7f)
+                });
+                return equalizer;
+            });
+            yield return Modifier("TrebleBooster", () => new TrebleBoosterModifier(format));
+        }
+
+        private static BenchmarkDefinition Modifier(string name, Func<SoundModifier> create) =>
+            new($"Modifier/{name}", () =>
+            {
+                var modifier = create();
+                var source = new BlockSource(BenchmarkAudio.Music(2));
+                var block = new float[BenchmarkAudio.BlockSamples];
+
+                return new BenchmarkCase(block.Length, () =>
+                {
+                    source.Fill(block);
+                    modifier.Process(block, BenchmarkAudio.Channels);
+                });
+            });
+    }
+}
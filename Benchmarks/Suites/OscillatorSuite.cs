@@ -0,0 +1,58 @@
+using SoundFlow.Backends.Offline;
+using SoundFlow.Components;
+using System.Collections.Generic;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// Synthesis: 64 sawtooth voices rendered as separate <see cref="Oscillator"/> components under a mixer, and as
+    /// one <see cref="OscillatorBank"/>, one device block per operation through an <see cref="OfflineEngine"/>.
+    /// </summary>
+    internal static class OscillatorSuite
+    {
+        private const int Voices = 64;
+
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            yield return new BenchmarkDefinition($"Oscillator/{Voices} components", () =>
+            {
+                var format = BenchmarkAudio.Format;
+                var engine = new OfflineEngine();
+                var device = engine.CreatePlaybackDevice(format, BenchmarkAudio.BlockFrames);
+                for (var voice = 0; voice < Voices; voice++)
+                {
+                    device.MasterMixer.AddComponent(new Oscillator(engine, format)
+                    {
+                        Type = Oscillator.WaveformType.Sawtooth, Frequency = Pitch(voice), Amplitude = 1f / Voices
+                    });
+                }
+
+                device.Start();
+                var output = new float[BenchmarkAudio.BlockSamples];
+                return new BenchmarkCase(output.Length, () => device.Render(output), engine);
+            });
+
+            yield return new BenchmarkDefinition($"Oscillator/{Voices}-voice bank", () =>
+            {
+                var format = BenchmarkAudio.Format;
+                var engine = new OfflineEngine();
+                var device = engine.CreatePlaybackDevice(format, BenchmarkAudio.BlockFrames);
+                var bank = new OscillatorBank(engine, format, Voices);
+                for (var voice = 0; voice < Voices; voice++)
+                {
+                    bank.SetWaveform(voice, Oscillator.WaveformType.Sawtooth);
+                    bank.SetFrequency(voice, Pitch(voice));
+                    bank.SetAmplitude(voice, 1f / Voices);
+                }
+
+                device.MasterMixer.AddComponent(bank);
+                device.Start();
+                var output = new float[BenchmarkAudio.BlockSamples];
+                return new BenchmarkCase(output.Length, () => device.Render(output), engine);
+            });
+        }
+
+        // Spread over five octaves from A1, so voices use most of the table levels.
+        private static float Pitch(int voice) => 55f * (float)System.Math.Pow(2.0, voice * 5.0 / Voices);
+    }
+}
@@ -0,0 +1,108 @@
+using SoundFlow.Backends.Offline;
+using SoundFlow.Backends.Offline.Devices;
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Providers;
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// <see cref="ISoundDataProvider.ReadBytes"/> of every built-in provider, one block per operation.
+    /// </summary>
+    /// <remarks>
+    /// Finite providers are rewound when they reach their end, so a run measures steady-state reads plus the
+    /// occasional seek. The queue and microphone providers are fed one block before each read, so their cases
+    /// include the producer side. Providers that decode through miniaudio are skipped when it is missing.
+    /// </remarks>
+    internal static class ProviderSuite
+    {
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            yield return new BenchmarkDefinition("Provider/RawDataProvider F32",
+                () => Read(new RawDataProvider(BenchmarkAudio.Music(2))));
+            yield return new BenchmarkDefinition("Provider/RawDataProvider S16",
+                () => Read(new RawDataProvider(BenchmarkAudio.ToPcm16(BenchmarkAudio.Music(2)),
+                    BenchmarkAudio.SampleRate, BenchmarkAudio.Channels)));
+
+            yield return new BenchmarkDefinition("Provider/MemoryMappedDataProvider S16", () =>
+            {
+                var file = new TemporaryFile(BenchmarkAudio.Wave(BenchmarkAudio.Music(2)), ".wav");
+                return Read(new MemoryMappedDataProvider(file.Path), file);
+            });
+
+            yield return new BenchmarkDefinition("Provider/StreamDataProvider", () =>
+            {
+                var engine = new OfflineEngine();
+                var stream = new MemoryStream(BenchmarkAudio.Wave(BenchmarkAudio.Music(2)), false);
+                return Read(new StreamDataProvider(engine, BenchmarkAudio.Format, stream), stream, engine);
+            });
+
+            yield return new BenchmarkDefinition("Provider/AssetDataProvider", () =>
+            {
+                var engine = new OfflineEngine();
+                return Read(new AssetDataProvider(engine, BenchmarkAudio.Format, BenchmarkAudio.Wave(BenchmarkAudio.Music(2))),
+                    engine);
+            });
+
+            yield return new BenchmarkDefinition("Provider/ChunkedDataProvider", () =>
+            {
+                var engine = new OfflineEngine();
+                var stream = new MemoryStream(BenchmarkAudio.Wave(BenchmarkAudio.Music(2)), false);
+                return Read(new ChunkedDataProvider(engine, BenchmarkAudio.Format, stream), stream, engine);
+            });
+
+            yield return new BenchmarkDefinition("Provider/QueueDataProvider", () =>
+            {
+                var provider = new QueueDataProvider(BenchmarkAudio.Format);
+                var source = new BlockSource(BenchmarkAudio.Music(1));
+                var block = new float[BenchmarkAudio.BlockSamples];
+
+                return new BenchmarkCase(block.Length, () =>
+                {
+                    source.Fill(block);
+                    provider.AddSamples(block);
+                    provider.ReadBytes(block);
+                }, provider);
+            });
+
+            yield return new BenchmarkDefinition("Provider/MicrophoneDataProvider", () =>
+            {
+                var engine = new OfflineEngine();
+                var device = (OfflineCaptureDevice)engine.InitializeCaptureDevice(null, BenchmarkAudio.Format,
+                    new OfflineDeviceConfig { BlockSize = BenchmarkAudio.BlockFrames });
+                device.Start();
+
+                var provider = new MicrophoneDataProvider(device);
+                provider.StartCapture();
+
+                var source = new BlockSource(BenchmarkAudio.Music(1));
+                var captured = new float[BenchmarkAudio.BlockSamples];
+                var block = new float[BenchmarkAudio.BlockSamples];
+
+                return new BenchmarkCase(block.Length, () =>
+                {
+                    source.Fill(captured);
+                    device.Capture(captured);
+                    provider.ReadBytes(block);
+                }, provider, engine);
+            });
+        }
+
+        private static BenchmarkCase Read(ISoundDataProvider provider, params IDisposable[] resources)
+        {
+            var block = new float[BenchmarkAudio.BlockSamples];
+            var owned = new IDisposable[resources.Length + 1];
+            owned[0] = provider;
+            resources.CopyTo(owned, 1);
+
+            return new BenchmarkCase(block.Length, () =>
+            {
+                if (provider.ReadBytes(block) < block.Length && provider.Position >= provider.Length)
+                    provider.Seek(0);
+            }, owned);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+using SoundFlow.Backends.Offline;
+using SoundFlow.Components;
+using SoundFlow.Providers;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// <see cref="SurroundPlayer"/> spatialization: 8 or 32 looping sources on a 5.1 or 7.1 virtual speaker layout,
+    /// mixed into the stereo device one block per operation through an <see cref="OfflineEngine"/>.
+    /// </summary>
+    /// <remarks>
+    /// Each source moves its listener every block, so every operation also pays for the gain matrix refresh and the
+    /// ramp towards it.
+    /// </remarks>
+    internal static class SurroundSuite
+    {
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            foreach (var configuration in new[]
+                         { SurroundPlayer.SpeakerConfiguration.Surround51, SurroundPlayer.SpeakerConfiguration.Surround71 })
+            {
+                foreach (var sources in new[] { 8, 32 })
+                    yield return Sources(configuration, sources);
+            }
+        }
+
+        private static BenchmarkDefinition Sources(SurroundPlayer.SpeakerConfiguration configuration, int sources) =>
+            new($"Surround/{sources} sources {(configuration == SurroundPlayer.SpeakerConfiguration.Surround51 ? "5.1" : "7.1")}", () =>
+            {
+                var format = BenchmarkAudio.Format;
+                var engine = new OfflineEngine();
+                var device = engine.CreatePlaybackDevice(format, BenchmarkAudio.BlockFrames);
+                var signal = BenchmarkAudio.Music(2);
+
+                var players = new SurroundPlayer[sources];
+                for (var i = 0; i < sources; i++)
+                {
+                    var provider = new RawDataProvider(signal);
+                    provider.Seek(i * 997 * BenchmarkAudio.Channels % signal.Length);
+
+                    var player = new SurroundPlayer(engine, format, provider)
+                        { IsLooping = true, Volume = 1f / sources, SpeakerConfig = configuration };
+                    player.Play();
+                    device.MasterMixer.AddComponent(player);
+                    players[i] = player;
+                }
+
+                device.Start();
+
+                var output = new float[BenchmarkAudio.BlockSamples];
+                var block = 0;
+                return new BenchmarkCase(output.Length, () =>
+                {
+                    var offset = 0.1f * (block++ & 7);
+                    foreach (var player in players)
+                        player.ListenerPosition = new Vector2(offset, -offset);
+                    device.Render(output);
+                }, engine);
+            });
+    }
+}
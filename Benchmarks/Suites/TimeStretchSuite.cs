@@ -0,0 +1,37 @@
+using SoundFlow.Abstracts;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace SoundFlow.Benchmarks.Suites
+{
+    /// <summary>
+    /// <see cref="WsolaTimeStretcher"/> at slowed and sped-up rates, one block of input per operation.
+    /// </summary>
+    /// <remarks>
+    /// Times are per input sample. The output buffer holds everything one block can produce at the slowest rate,
+    /// so every call drains the stretcher and consumes its whole input, as playback does in steady state.
+    /// </remarks>
+    internal static class TimeStretchSuite
+    {
+        public static IEnumerable<BenchmarkDefinition> Definitions()
+        {
+            foreach (var speed in new[] { 0.5f, 0.8f, 1.25f, 2f })
+                yield return Stretch(speed);
+        }
+
+        private static BenchmarkDefinition Stretch(float speed) =>
+            new($"WsolaTimeStretcher/speed {speed.ToString("0.00", CultureInfo.InvariantCulture)}", () =>
+            {
+                var stretcher = new WsolaTimeStretcher(BenchmarkAudio.Channels, speed);
+                var source = new BlockSource(BenchmarkAudio.Music(2));
+                var input = new float[BenchmarkAudio.BlockSamples];
+                var output = new float[BenchmarkAudio.BlockSamples * 8];
+
+                return new BenchmarkCase(input.Length, () =>
+                {
+                    source.Fill(input);
+                    stretcher.Process(input, output, out _, out _);
+                });
+            });
+    }
+}
@@ -0,0 +1,32 @@
+using System;
+
+// The SoundFlow sources reference a handful of Unity types. These stand-ins let them compile on plain .NET.
+
+namespace AOT
+{
+    /// <summary>
+    /// Stand-in for Unity's IL2CPP marker on native callbacks; plain .NET needs no marker.
+    /// </summary>
+    [AttributeUsage(AttributeTargets.Method)]
+    internal sealed class MonoPInvokeCallbackAttribute : Attribute
+    {
+        public MonoPInvokeCallbackAttribute(Type type)
+        {
+        }
+    }
+}
+
+namespace UnityEngine
+{
+    /// <summary>
+    /// Stand-in for Unity's console logger, writing to the standard error stream so it never mixes with results.
+    /// </summary>
+    internal static class Debug
+    {
+        public static void Log(object message) => Console.Error.WriteLine(message);
+
+        public static void LogWarning(object message) => Console.Error.WriteLine(message);
+
+        public static void LogError(object message) => Console.Error.WriteLine(message);
+    }
+}
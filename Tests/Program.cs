@@ -0,0 +1,108 @@
+using SoundFlow.Tests.Suites;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+
+namespace SoundFlow.Tests
+{
+    /// <summary>
+    /// Command-line entry point. See README.md for usage.
+    /// </summary>
+    internal static class Program
+    {
+        private const string Usage =
+            "Usage: dotnet run -c Release -- [options]\n" +
+            "  --filter <text>     Run only tests whose name contains <text>; may be repeated.\n" +
+            "  --list              List test names and exit.";
+
+        private static int Main(string[] args)
+        {
+            var filters = new List<string>();
+            var list = false;
+
+            try
+            {
+                for (var i = 0; i < args.Length; i++)
+                {
+                    switch (args[i])
+                    {
+                        case "--filter": filters.Add(Value(args, ref i)); break;
+                        case "--list": list = true; break;
+                        case "--help":
+                        case "-h":
+                            Console.WriteLine(Usage);
+                            return 0;
+                        default: throw new ArgumentException($"Unknown option '{args[i]}'.");
+                    }
+                }
+            }
+            catch (ArgumentException e)
+            {
+                Console.Error.WriteLine(e.Message);
+                Console.Error.WriteLine(Usage);
+                return 2;
+            }
+
+            var selected = Catalog()
+                .Where(t => filters.Count == 0 ||
+                            filters.Any(f => t.Name.IndexOf(f, StringComparison.OrdinalIgnoreCase) >= 0))
+                .ToList();
+
+            if (list)
+            {
+                foreach (var test in selected)
+                    Console.WriteLine(test.Name);
+                return 0;
+            }
+
+            if (selected.Count == 0)
+            {
+                Console.Error.WriteLine("No test matches the filter.");
+                return 2;
+            }
+
+            var failed = 0;
+            foreach (var test in selected)
+            {
+                var stopwatch = Stopwatch.StartNew();
+                try
+                {
+                    test.Run();
+                    Console.WriteLine($"pass  {test.Name} ({stopwatch.ElapsedMilliseconds} ms)");
+                }
+                catch (Exception e)
+                {
+                    failed++;
+                    Console.WriteLine($"FAIL  {test.Name}");
+                    Console.WriteLine($"      {(e is AssertionException ? e.Message : e.ToString())}");
+                }
+            }
+
+            Console.WriteLine();
+            Console.WriteLine($"{selected.Count - failed} passed, {failed} failed.");
+            return failed > 0 ? 1 : 0;
+        }
+
+        /// <summary>
+        /// Every test, in a fixed order.
+        /// </summary>
+        private static IEnumerable<TestCase> Catalog() =>
+            BiquadCascadeTests.Cases()
+                .Concat(ResamplerTests.Cases())
+                .Concat(FftTests.Cases())
+                .Concat(RingBufferTests.Cases())
+                .Concat(DynamicsTests.Cases())
+                .Concat(RenderPlanTests.Cases())
+                .Concat(DecodedAssetTests.Cases())
+                .Concat(DitherTests.Cases())
+                .Concat(WsolaTests.Cases());
+
+        private static string Value(string[] args, ref int index)
+        {
+            if (index + 1 >= args.Length)
+                throw new ArgumentException($"Option '{args[index]}' requires a value.");
+            return args[++index];
+        }
+    }
+}
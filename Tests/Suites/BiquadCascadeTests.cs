@@ -0,0 +1,226 @@
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// <see cref="BiquadCascade.Process(Span{float}, int)"/> against a per-sample reference recursion, through its
+    /// vector, block-form and scalar paths, including coefficient ramps that end in the middle of a block.
+    /// </summary>
+    /// <remarks>
+    /// Both the cascade and a float reference are compared with the same recursion run in double: the cascade may
+    /// round differently from the float recursion, but must not lose more than a few roundings on it. The sections
+    /// include sub-bass designs with poles close to z = 1, where precision is hardest to keep.
+    /// </remarks>
+    internal static class BiquadCascadeTests
+    {
+        private const float SampleRate = 48000f;
+        private const int Stages = 2;
+        private const int RampFrames = 240;
+
+        public static IEnumerable<TestCase> Cases()
+        {
+            foreach (var lanes in new[] { 1, 2, 3, 9 })
+                yield return new TestCase($"BiquadCascade/matches reference, {lanes} lanes", () => MatchesReference(lanes));
+            yield return new TestCase("BiquadCascade/ramp stays on the line", RampStaysOnLine);
+        }
+
+        private static void MatchesReference(int lanes)
+        {
+            var designs = new[]
+            {
+                (BiquadCoefficients.LowPass(SampleRate, 30f, 10f), BiquadCoefficients.LowPass(SampleRate, 60f, 4f)),
+                (BiquadCoefficients.LowShelf(SampleRate, 80f, 12f, 1f), BiquadCoefficients.HighPass(SampleRate, 20f, 0.7071f)),
+                (BiquadCoefficients.Peaking(SampleRate, 1000f, 9f, 2f), BiquadCoefficients.HighPass(SampleRate, 300f, 0.7071f)),
+                (BiquadCoefficients.LowPass(SampleRate, 5000f, 0.7071f), BiquadCoefficients.Peaking(SampleRate, 300f, -6f, 8f))
+            };
+
+            // Each lane and stage gets its own design, and moves to a second one part-way through.
+            var start = new BiquadCoefficients[Stages, lanes];
+            var end = new BiquadCoefficients[Stages, lanes];
+            for (var stage = 0; stage < Stages; stage++)
+            for (var lane = 0; lane < lanes; lane++)
+            {
+                var (first, second) = designs[(stage * 3 + lane) % designs.Length];
+                start[stage, lane] = first;
+                end[stage, lane] = second;
+            }
+
+            var cascade = new BiquadCascade(lanes, Stages);
+            for (var stage = 0; stage < Stages; stage++)
+            for (var lane = 0; lane < lanes; lane++)
+                cascade.SetCoefficients(stage, lane, start[stage, lane]);
+            cascade.SmoothingSamples = RampFrames;
+
+            var reference = new Reference(lanes, start);
+            var random = new Random(lanes);
+            var blockFrames = new[] { 512, 100, 100, 100, 67, 7, 300, 512, 512, 33 };
+            var rampStarted = false;
+
+            double cascadeError = 0, referenceError = 0;
+            foreach (var frames in blockFrames)
+            {
+                // The ramp starts at the third block and ends 40 frames into the fifth, which has a partial vector left over.
+                if (!rampStarted && reference.Frame >= 612)
+                {
+                    for (var stage = 0; stage < Stages; stage++)
+                    for (var lane = 0; lane < lanes; lane++)
+                        cascade.SetCoefficients(stage, lane, end[stage, lane]);
+                    reference.Ramp(end);
+                    rampStarted = true;
+                }
+
+                var buffer = new float[frames * lanes];
+                for (var i = 0; i < buffer.Length; i++)
+                    buffer[i] = (float)(random.NextDouble() * 2 - 1) * 0.5f;
+
+                var expected = reference.Process(buffer, out var floatReference);
+                cascade.Process(buffer, lanes);
+
+                for (var i = 0; i < buffer.Length; i++)
+                {
+                    cascadeError = Math.Max(cascadeError, Math.Abs(buffer[i] - expected[i]));
+                    referenceError = Math.Max(referenceError, Math.Abs(floatReference[i] - expected[i]));
+                }
+            }
+
+            Assert.True(!cascade.IsSmoothing, "the ramp has finished");
+            Assert.True(cascadeError <= 3 * referenceError + 1e-6,
+                $"error {cascadeError:E2} against the double recursion, float recursion {referenceError:E2}");
+        }
+
+        /// <summary>
+        /// A ramp run one frame per block reaches exactly the same output as one run in a single block, and both
+        /// follow the double-precision line within rounding.
+        /// </summary>
+        private static void RampStaysOnLine()
+        {
+            var from = new[,] { { BiquadCoefficients.LowPass(SampleRate, 200f, 0.7071f) } };
+            var to = new[,] { { BiquadCoefficients.LowPass(SampleRate, 8000f, 2f) } };
+
+            var input = new float[RampFrames + 16];
+            var random = new Random(5);
+            for (var i = 0; i < input.Length; i++)
+                input[i] = (float)(random.NextDouble() * 2 - 1) * 0.5f;
+
+            var whole = Ramped(from, to, input, input.Length);
+            var framewise = Ramped(from, to, input, 1);
+            for (var i = 0; i < input.Length; i++)
+                Assert.Near(whole[i], framewise[i], 1e-7, $"frame {i}, one frame per block");
+
+            var reference = new Reference(1, from);
+            reference.Ramp(to);
+            var expected = reference.Process(input, out _);
+            for (var i = 0; i < input.Length; i++)
+                Assert.Near(expected[i], whole[i], 2e-6, $"frame {i} against the double ramp");
+        }
+
+        private static float[] Ramped(BiquadCoefficients[,] from, BiquadCoefficients[,] to, float[] input, int blockFrames)
+        {
+            var cascade = new BiquadCascade(1, 1);
+            cascade.SetCoefficients(0, from[0, 0]);
+            cascade.SmoothingSamples = RampFrames;
+            cascade.SetCoefficients(0, to[0, 0]);
+
+            var output = (float[])input.Clone();
+            for (var offset = 0; offset < output.Length; offset += blockFrames)
+                cascade.Process(output.AsSpan(offset, Math.Min(blockFrames, output.Length - offset)));
+            return output;
+        }
+
+        /// <summary>
+        /// The recursion the cascade implements, per lane and per frame, in double and in float side by side. A ramp
+        /// sets frame k of RampFrames to start + k * (target - start) / RampFrames.
+        /// </summary>
+        private sealed class Reference
+        {
+            private readonly int _lanes;
+            private readonly BiquadCoefficients[,] _start;
+            private BiquadCoefficients[,] _target;
+            private readonly double[,,] _state;
+            private readonly float[,,] _floatState;
+            private int _rampFrame = RampFrames;
+
+            public Reference(int lanes, BiquadCoefficients[,] coefficients)
+            {
+                _lanes = lanes;
+                _start = (BiquadCoefficients[,])coefficients.Clone();
+                _target = coefficients;
+                _state = new double[coefficients.GetLength(0), lanes, 4];
+                _floatState = new float[coefficients.GetLength(0), lanes, 4];
+            }
+
+            public int Frame { get; private set; }
+
+            public void Ramp(BiquadCoefficients[,] target)
+            {
+                _target = target;
+                _rampFrame = 0;
+            }
+
+            public double[] Process(float[] input, out float[] floatOutput)
+            {
+                var output = new double[input.Length];
+                floatOutput = new float[input.Length];
+                var frames = input.Length / _lanes;
+                for (var f = 0; f < frames; f++, Frame++)
+                {
+                    var inRamp = _rampFrame < RampFrames;
+                    if (inRamp) _rampFrame++;
+                    double t = (double)_rampFrame / RampFrames;
+                    float steps = _rampFrame;
+
+                    for (var lane = 0; lane < _lanes; lane++)
+                    {
+                        double x = input[f * _lanes + lane];
+                        var xf = input[f * _lanes + lane];
+                        for (var stage = 0; stage < _state.GetLength(0); stage++)
+                        {
+                            var s = _start[stage, lane];
+                            var e = _target[stage, lane];
+
+                            // Coefficients the way each precision computes them.
+                            double b0 = s.B0 + t * (e.B0 - (double)s.B0), b1 = s.B1 + t * (e.B1 - (double)s.B1),
+                                b2 = s.B2 + t * (e.B2 - (double)s.B2), a1 = s.A1 + t * (e.A1 - (double)s.A1),
+                                a2 = s.A2 + t * (e.A2 - (double)s.A2);
+                            float fb0 = e.B0, fb1 = e.B1, fb2 = e.B2, fa1 = e.A1, fa2 = e.A2;
+                            if (inRamp)
+                            {
+                                fb0 = s.B0 + steps * ((e.B0 - s.B0) / RampFrames);
+                                fb1 = s.B1 + steps * ((e.B1 - s.B1) / RampFrames);
+                                fb2 = s.B2 + steps * ((e.B2 - s.B2) / RampFrames);
+                                fa1 = s.A1 + steps * ((e.A1 - s.A1) / RampFrames);
+                                fa2 = s.A2 + steps * ((e.A2 - s.A2) / RampFrames);
+                            }
+
+                            var y = b0 * x + b1 * _state[stage, lane, 0] + b2 * _state[stage, lane, 1] -
+                                    a1 * _state[stage, lane, 2] - a2 * _state[stage, lane, 3];
+                            _state[stage, lane, 1] = _state[stage, lane, 0];
+                            _state[stage, lane, 0] = x;
+                            _state[stage, lane, 3] = _state[stage, lane, 2];
+                            _state[stage, lane, 2] = y;
+                            x = y;
+
+                            var yf = fb0 * xf + fb1 * _floatState[stage, lane, 0] + fb2 * _floatState[stage, lane, 1] -
+                                     fa1 * _floatState[stage, lane, 2] - fa2 * _floatState[stage, lane, 3];
+                            _floatState[stage, lane, 1] = _floatState[stage, lane, 0];
+                            _floatState[stage, lane, 0] = xf;
+                            _floatState[stage, lane, 3] = _floatState[stage, lane, 2];
+                            _floatState[stage, lane, 2] = yf;
+                            xf = yf;
+                        }
+
+                        output[f * _lanes + lane] = x;
+                        floatOutput[f * _lanes + lane] = xf;
+                    }
+
+                    if (_rampFrame == RampFrames)
+                        Array.Copy(_target, _start, _target.Length);
+                }
+
+                return output;
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+using SoundFlow.Enums;
+using SoundFlow.Interfaces;
+using SoundFlow.Providers;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// <see cref="DecodedAsset.Decode"/> for streams of known and unknown length: every sample in order, and no more
+    /// memory reported, and so charged to the cache budget, than the decoded samples need.
+    /// </summary>
+    internal static class DecodedAssetTests
+    {
+        public static IEnumerable<TestCase> Cases()
+        {
+            foreach (var samples in new[] { 1000, 44100, 50001, 176400 })
+            {
+                yield return new TestCase($"DecodedAsset/known length, {samples} samples", () => Decodes(samples, true));
+                yield return new TestCase($"DecodedAsset/unknown length, {samples} samples", () => Decodes(samples, false));
+            }
+        }
+
+        private static void Decodes(int samples, bool lengthKnown)
+        {
+            var asset = DecodedAsset.Decode(new CountingDecoder(samples, lengthKnown));
+
+            Assert.Equal(samples, asset.Length, "length");
+            Assert.Equal((long)samples * sizeof(float), asset.SizeInBytes, "size in bytes");
+
+            var span = asset.Samples.Span;
+            for (var i = 0; i < span.Length; i++)
+                Assert.Equal((float)i, span[i], $"sample {i}");
+        }
+
+        /// <summary>
+        /// A stereo decoder whose samples count up from 0, with its length either reported or hidden as 0.
+        /// </summary>
+        private sealed class CountingDecoder : ISoundDecoder
+        {
+            private readonly int _total;
+            private readonly bool _lengthKnown;
+            private int _position;
+
+            public CountingDecoder(int total, bool lengthKnown)
+            {
+                _total = total;
+                _lengthKnown = lengthKnown;
+            }
+
+            public bool IsDisposed { get; private set; }
+            public int Length => _lengthKnown ? _total : 0;
+            public SampleFormat SampleFormat => SampleFormat.F32;
+            public int Channels => 2;
+            public int SampleRate => 44100;
+
+            public event EventHandler<EventArgs>? EndOfStreamReached;
+
+            public bool Seek(int offset)
+            {
+                _position = Math.Min(offset, _total);
+                return true;
+            }
+
+            public int Decode(Span<float> samples)
+            {
+                var count = Math.Min(samples.Length, _total - _position);
+                for (var i = 0; i < count; i++)
+                    samples[i] = _position + i;
+                _position += count;
+
+                if (count == 0)
+                    EndOfStreamReached?.Invoke(this, EventArgs.Empty);
+                return count;
+            }
+
+            public void Dispose() => IsDisposed = true;
+        }
+    }
+}
@@ -0,0 +1,132 @@
+using SoundFlow.Enums;
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// The TPDF dither of <see cref="DeviceBufferHelper.ConvertToDeviceFormat(Span{float}, nint, int, SampleFormat, bool)"/>:
+    /// its statistics, that it does not repeat from one buffer to the next, and that it allocates nothing.
+    /// </summary>
+    /// <remarks>
+    /// Conversion truncates, so a dithered level x (in LSB) comes out with mean x - 1/2 and an error variance of 1/4:
+    /// 1/6 from the triangular noise plus 1/12 from the quantizer.
+    /// </remarks>
+    internal static unsafe class DitherTests
+    {
+        public static IEnumerable<TestCase> Cases()
+        {
+            foreach (var format in new[] { SampleFormat.U8, SampleFormat.S16, SampleFormat.S24 })
+                yield return new TestCase($"Dither/statistics {format}", () => Statistics(format));
+            yield return new TestCase("Dither/no repetition across buffers", NoRepetition);
+            yield return new TestCase("Dither/no allocation", NoAllocation);
+        }
+
+        private static void Statistics(SampleFormat format)
+        {
+            const int count = 1 << 16;
+
+            foreach (var fraction in new[] { 0.1, 0.4, 0.75 })
+            {
+                // A level just above 20 LSB, expressed in the format's own scale.
+                var level = 20 + fraction;
+                var source = new float[count];
+                Array.Fill(source, (float)(format == SampleFormat.U8 ? (level - 127.5) / 127.5 : level / Scale(format)));
+
+                var codes = Convert(source, format);
+                double sum = 0, squares = 0;
+                foreach (var code in codes)
+                {
+                    var error = code - (level - 0.5);
+                    sum += error;
+                    squares += error * error;
+                }
+
+                var mean = sum / count;
+                Assert.Near(0, mean, 0.01, $"mean error at {fraction} LSB");
+                Assert.Near(0.25, squares / count - mean * mean, 0.01, $"error variance at {fraction} LSB");
+            }
+        }
+
+        private static void NoRepetition()
+        {
+            // Two consecutive buffers must not reuse the same noise, shifted or not.
+            const int count = 16384;
+            var source = new float[count];
+            Array.Fill(source, (float)(20.5 / short.MaxValue));
+
+            var first = Convert(source, SampleFormat.S16);
+            var second = Convert(source, SampleFormat.S16);
+
+            for (var shift = -(count - 256); shift <= count - 256; shift++)
+            {
+                var repeated = true;
+                for (var i = Math.Max(0, -shift); repeated && i < count && i + shift < count; i++)
+                    repeated = first[i + shift] == second[i];
+
+                Assert.True(!repeated, $"second buffer repeats the first at shift {shift}");
+            }
+        }
+
+        private static void NoAllocation()
+        {
+            var source = new float[48000 * 2];
+            for (var i = 0; i < source.Length; i++)
+                source[i] = (float)Math.Sin(i * 0.01) * 0.5f;
+            var destination = new byte[source.Length * 4];
+
+            // A fresh thread, like a device's audio thread, including its first and largest buffer.
+            var allocated = new long[3];
+            var formats = new[] { SampleFormat.U8, SampleFormat.S16, SampleFormat.S24 };
+            var copies = new[] { (float[])source.Clone(), (float[])source.Clone(), (float[])source.Clone() };
+            var thread = new Thread(() =>
+            {
+                fixed (byte* output = destination)
+                {
+                    for (var f = 0; f < formats.Length; f++)
+                    {
+                        var before = GC.GetAllocatedBytesForCurrentThread();
+                        // Conversion clears its input, so each format gets a fresh, preallocated copy.
+                        DeviceBufferHelper.ConvertToDeviceFormat(copies[f], (nint)output, source.Length, formats[f], true);
+                        allocated[f] = GC.GetAllocatedBytesForCurrentThread() - before;
+                    }
+                }
+            });
+            thread.Start();
+            thread.Join();
+
+            for (var f = 0; f < formats.Length; f++)
+                Assert.Equal(0L, allocated[f], $"bytes allocated for {formats[f]}");
+        }
+
+        private static double Scale(SampleFormat format) => format == SampleFormat.S16 ? short.MaxValue : 8388607.0;
+
+        /// <summary>
+        /// Converts a copy of <paramref name="source"/> with dither, as conversion clears its input, and returns the
+        /// integer codes.
+        /// </summary>
+        private static int[] Convert(float[] source, SampleFormat format)
+        {
+            var width = format == SampleFormat.U8 ? 1 : format == SampleFormat.S16 ? 2 : 3;
+            var bytes = new byte[source.Length * width];
+            fixed (byte* output = bytes)
+                DeviceBufferHelper.ConvertToDeviceFormat((float[])source.Clone(), (nint)output, source.Length, format, true);
+
+            var codes = new int[source.Length];
+            for (var i = 0; i < codes.Length; i++)
+            {
+                var o = i * width;
+                codes[i] = width switch
+                {
+                    1 => bytes[o],
+                    2 => (short)(bytes[o] | (bytes[o + 1] << 8)),
+                    _ => (bytes[o] | (bytes[o + 1] << 8) | (bytes[o + 2] << 16)) << 8 >> 8
+                };
+            }
+
+            return codes;
+        }
+    }
+}
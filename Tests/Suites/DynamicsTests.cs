@@ -0,0 +1,174 @@
+using SoundFlow.Enums;
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// <see cref="DynamicsProcessor"/> settles on the same static gain curve as the per-sample compressor it
+    /// replaced, for hard and soft knees, and treats linked and per-channel detection as documented.
+    /// </summary>
+    /// <remarks>
+    /// The reference is the former <c>CompressorModifier.ProcessSample</c>, kept here for one channel. A
+    /// constant-magnitude input lets both envelopes settle on the input level, so the steady-state gains differ only by
+    /// the processor's fast log and exp approximations.
+    /// </remarks>
+    internal static class DynamicsTests
+    {
+        private const int SampleRate = 48000;
+        private const int Block = 512;
+
+        public static IEnumerable<TestCase> Cases()
+        {
+            yield return GainCurve("hard knee", -20f, 4f, 0f, 0f);
+            yield return GainCurve("soft knee", -24f, 3f, 6f, 3f);
+            yield return GainCurve("limiter", -6f, float.PositiveInfinity, 0f, 0f);
+            yield return new TestCase("DynamicsProcessor/linked stereo", LinkedStereo);
+            yield return new TestCase("DynamicsProcessor/per-channel stereo", PerChannelStereo);
+        }
+
+        private static TestCase GainCurve(string name, float thresholdDb, float ratio, float kneeDb, float makeupDb) =>
+            new($"DynamicsProcessor/gain curve {name}", () =>
+            {
+                for (var levelDb = -60f; levelDb <= 0f; levelDb += 3f)
+                {
+                    var processor = new DynamicsProcessor(SampleRate)
+                    {
+                        ThresholdDb = thresholdDb,
+                        Ratio = ratio,
+                        KneeDb = kneeDb,
+                        MakeupGainDb = makeupDb,
+                        AttackMs = 1f,
+                        ReleaseMs = 20f
+                    };
+                    var reference = new LegacyCompressor(thresholdDb, ratio, 1f, 20f, kneeDb, makeupDb);
+
+                    var amplitude = MathF.Pow(10f, levelDb / 20f);
+                    var buffer = new float[Block];
+                    float referenceOutput = 0;
+                    for (var block = 0; block < SampleRate / Block; block++)
+                    {
+                        for (var i = 0; i < Block; i++)
+                        {
+                            // A square wave: full-scale transitions, constant magnitude.
+                            buffer[i] = i % 2 == 0 ? amplitude : -amplitude;
+                            referenceOutput = reference.ProcessSample(buffer[i]);
+                        }
+
+                        processor.Process(buffer, 1);
+                    }
+
+                    var gainDb = TestSignals.ToDb(Math.Abs(buffer[Block - 1]) / amplitude);
+                    var referenceGainDb = TestSignals.ToDb(Math.Abs(referenceOutput) / amplitude);
+                    Assert.Near(referenceGainDb, gainDb, 0.05,
+                        $"gain in dB at {levelDb.ToString("0", CultureInfo.InvariantCulture)} dBFS");
+                }
+            });
+
+        /// <summary>
+        /// Linked detection follows the louder channel and applies one gain to both.
+        /// </summary>
+        private static void LinkedStereo()
+        {
+            var processor = new DynamicsProcessor(SampleRate)
+            {
+                ThresholdDb = -20f, Ratio = 4f, AttackMs = 1f, ReleaseMs = 20f, Linking = DynamicsLinking.Linked
+            };
+
+            var buffer = Settle(processor, loud: 0.5f, quiet: 0.01f);
+            var loudGain = Math.Abs(buffer[Block * 2 - 2]) / 0.5;
+            var quietGain = Math.Abs(buffer[Block * 2 - 1]) / 0.01;
+            Assert.Near(loudGain, quietGain, 1e-4, "both channels get the same gain");
+            Assert.Below(0.5, loudGain, "the louder channel drives the reduction");
+        }
+
+        /// <summary>
+        /// Per-channel detection compresses the loud channel and leaves the quiet one below the threshold untouched.
+        /// </summary>
+        private static void PerChannelStereo()
+        {
+            var processor = new DynamicsProcessor(SampleRate)
+            {
+                ThresholdDb = -20f, Ratio = 4f, AttackMs = 1f, ReleaseMs = 20f, Linking = DynamicsLinking.PerChannel
+            };
+
+            var buffer = Settle(processor, loud: 0.5f, quiet: 0.01f);
+            Assert.Below(0.5, Math.Abs(buffer[Block * 2 - 2]) / 0.5, "the loud channel is compressed");
+            Assert.Near(1.0, Math.Abs(buffer[Block * 2 - 1]) / 0.01, 1e-3, "the quiet channel is unchanged");
+        }
+
+        private static float[] Settle(DynamicsProcessor processor, float loud, float quiet)
+        {
+            var buffer = new float[Block * 2];
+            for (var block = 0; block < SampleRate / Block; block++)
+            {
+                for (var f = 0; f < Block; f++)
+                {
+                    var sign = f % 2 == 0 ? 1f : -1f;
+                    buffer[f * 2] = sign * loud;
+                    buffer[f * 2 + 1] = sign * quiet;
+                }
+
+                processor.Process(buffer, 2);
+            }
+
+            return buffer;
+        }
+
+        /// <summary>
+        /// The per-sample compressor <see cref="DynamicsProcessor"/> replaced, for one channel.
+        /// </summary>
+        private sealed class LegacyCompressor
+        {
+            private readonly float _thresholdDb;
+            private readonly float _ratio;
+            private readonly float _attackMs;
+            private readonly float _releaseMs;
+            private readonly float _kneeDb;
+            private readonly float _makeupGainDb;
+            private float _envelope;
+            private float _gain = 1f;
+
+            public LegacyCompressor(float thresholdDb, float ratio, float attackMs, float releaseMs, float kneeDb, float makeupGainDb)
+            {
+                _thresholdDb = thresholdDb;
+                _ratio = ratio;
+                _attackMs = attackMs;
+                _releaseMs = releaseMs;
+                _kneeDb = kneeDb;
+                _makeupGainDb = makeupGainDb;
+            }
+
+            public float ProcessSample(float sample)
+            {
+                var sampleDb = 20f * MathF.Log10(MathF.Abs(sample));
+
+                var alphaA = MathF.Exp(-1f / (_attackMs * 0.001f * SampleRate));
+                var alphaR = MathF.Exp(-1f / (_releaseMs * 0.001f * SampleRate));
+
+                _envelope = sampleDb > _envelope
+                    ? alphaA * _envelope + (1 - alphaA) * sampleDb
+                    : alphaR * _envelope + (1 - alphaR) * sampleDb;
+
+                var overshootDb = _envelope - _thresholdDb;
+                var reductionDb = 0f;
+                if (overshootDb > 0)
+                {
+                    // (ratio - 1) / ratio, written so an infinite ratio gives 1 rather than NaN.
+                    var slope = 1 - 1 / _ratio;
+                    reductionDb = _kneeDb > 0
+                        ? slope * _kneeDb * MathF.Log10(1 + overshootDb / _kneeDb)
+                        : overshootDb * slope;
+                }
+
+                var targetGain = MathF.Pow(10, (-reductionDb + _makeupGainDb) / 20f);
+                var alpha = reductionDb == 0 ? alphaR : alphaA;
+                _gain = alpha * _gain + (1 - alpha) * targetGain;
+
+                return sample * _gain;
+            }
+        }
+    }
+}
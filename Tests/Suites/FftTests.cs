@@ -0,0 +1,116 @@
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// <see cref="Fft"/> against a direct DFT, and <see cref="Fft.Forward"/> followed by <see cref="Fft.Inverse"/>
+    /// as the identity for every size from 2 to 8192.
+    /// </summary>
+    internal static class FftTests
+    {
+        public static IEnumerable<TestCase> Cases()
+        {
+            yield return new TestCase("Fft/round trip", RoundTrip);
+            yield return new TestCase("Fft/matches direct DFT", MatchesDirectDft);
+            yield return new TestCase("Fft/rejects other sizes", RejectsOtherSizes);
+        }
+
+        private static void RoundTrip()
+        {
+            var random = new Random(1);
+            for (var size = 2; size <= 8192; size <<= 1)
+            {
+                var fft = new Fft(size);
+                var real = new float[size];
+                var imag = new float[size];
+                for (var i = 0; i < size; i++)
+                {
+                    real[i] = (float)(random.NextDouble() * 2 - 1);
+                    imag[i] = (float)(random.NextDouble() * 2 - 1);
+                }
+
+                var originalReal = (float[])real.Clone();
+                var originalImag = (float[])imag.Clone();
+                fft.Forward(real, imag);
+                fft.Inverse(real, imag);
+
+                // Rounding grows with the number of stages, log2(size).
+                var tolerance = 2e-7 * Math.Log(size, 2) * 4;
+                for (var i = 0; i < size; i++)
+                {
+                    Assert.Near(originalReal[i], real[i], tolerance, $"size {size}, real {i}");
+                    Assert.Near(originalImag[i], imag[i], tolerance, $"size {size}, imaginary {i}");
+                }
+            }
+        }
+
+        private static void MatchesDirectDft()
+        {
+            var random = new Random(2);
+            foreach (var size in new[] { 2, 8, 64, 512 })
+            {
+                var fft = new Fft(size);
+                var real = new float[size];
+                var imag = new float[size];
+                for (var i = 0; i < size; i++)
+                {
+                    real[i] = (float)(random.NextDouble() * 2 - 1);
+                    imag[i] = (float)(random.NextDouble() * 2 - 1);
+                }
+
+                var expectedReal = new double[size];
+                var expectedImag = new double[size];
+                for (var k = 0; k < size; k++)
+                for (var n = 0; n < size; n++)
+                {
+                    var angle = -2 * Math.PI * k * n / size;
+                    expectedReal[k] += real[n] * Math.Cos(angle) - imag[n] * Math.Sin(angle);
+                    expectedImag[k] += real[n] * Math.Sin(angle) + imag[n] * Math.Cos(angle);
+                }
+
+                fft.Forward(real, imag);
+
+                // Relative to the spectrum of unit-range noise, whose magnitude grows with sqrt(size).
+                var tolerance = 1e-5 * Math.Sqrt(size);
+                for (var k = 0; k < size; k++)
+                {
+                    Assert.Near(expectedReal[k], real[k], tolerance, $"size {size}, real bin {k}");
+                    Assert.Near(expectedImag[k], imag[k], tolerance, $"size {size}, imaginary bin {k}");
+                }
+            }
+        }
+
+        private static void RejectsOtherSizes()
+        {
+            foreach (var size in new[] { 0, 1, 3, 100 })
+            {
+                var threw = false;
+                try
+                {
+                    _ = new Fft(size);
+                }
+                catch (ArgumentOutOfRangeException)
+                {
+                    threw = true;
+                }
+
+                Assert.True(threw, $"size {size} is rejected");
+            }
+
+            var fft = new Fft(16);
+            var wrongLength = false;
+            try
+            {
+                fft.Forward(new float[8], new float[16]);
+            }
+            catch (ArgumentException)
+            {
+                wrongLength = true;
+            }
+
+            Assert.True(wrongLength, "a buffer of the wrong length is rejected");
+        }
+    }
+}
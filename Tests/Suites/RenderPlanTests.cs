@@ -0,0 +1,137 @@
+using SoundFlow.Backends.Offline;
+using SoundFlow.Backends.Offline.Devices;
+using SoundFlow.Components;
+using SoundFlow.Enums;
+using SoundFlow.Modifiers;
+using SoundFlow.Structs;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// <see cref="Abstracts.SoundComponent.CompiledRendering"/> against the recursive render path for a graph of nested
+    /// mixers, connected inputs and modifiers, and the plan's scratch buffers against the device's block size.
+    /// </summary>
+    /// <remarks>
+    /// Each case builds the same graph twice, on two offline devices, and renders one through its plan and the other
+    /// recursively. Oscillators and delays are deterministic, so the two must agree sample for sample.
+    /// </remarks>
+    internal static class RenderPlanTests
+    {
+        private static readonly AudioFormat Format = new()
+        {
+            SampleRate = 48000,
+            Channels = 2,
+            Format = SampleFormat.F32
+        };
+
+        public static IEnumerable<TestCase> Cases()
+        {
+            yield return new TestCase("RenderPlan/matches recursive rendering", MatchesRecursive);
+            yield return new TestCase("RenderPlan/device block fits the scratch", DeviceBlockFits);
+            yield return new TestCase("RenderPlan/larger blocks render in sub-blocks", LargerBlocksSplit);
+        }
+
+        private static void MatchesRecursive()
+        {
+            var recursive = CreateDevice(512, false);
+            var compiled = CreateDevice(512, true);
+
+            var expected = new float[512 * Format.Channels];
+            var actual = new float[expected.Length];
+            for (var block = 0; block < 20; block++)
+            {
+                recursive.Render(expected);
+                compiled.Render(actual);
+                AssertSame(expected, actual, $"block {block}");
+            }
+        }
+
+        private static void DeviceBlockFits()
+        {
+            // Twice the default scratch capacity, so a plan sized only by default would need to grow.
+            var recursive = CreateDevice(4096, false);
+            var compiled = CreateDevice(4096, true);
+
+            var expected = new float[4096 * Format.Channels];
+            var actual = new float[expected.Length];
+            for (var block = 0; block < 2; block++)
+            {
+                // The recursive device renders first, so shared tables are built before the compiled one is measured.
+                recursive.Render(expected);
+                var before = GC.GetAllocatedBytesForCurrentThread();
+                compiled.Render(actual);
+                Assert.Equal(0L, GC.GetAllocatedBytesForCurrentThread() - before, $"bytes allocated by block {block}");
+                AssertSame(expected, actual, $"block {block}");
+            }
+        }
+
+        private static void LargerBlocksSplit()
+        {
+            var recursive = CreateDevice(256, false);
+            var compiled = CreateDevice(256, true);
+
+            // Bypass the device's own blocking, so the plan sees a block several times its scratch capacity.
+            var expected = new float[6000 * Format.Channels];
+            var actual = new float[expected.Length];
+            for (var pass = 0; pass < 3; pass++)
+            {
+                Array.Clear(expected, 0, expected.Length);
+                Array.Clear(actual, 0, actual.Length);
+                recursive.MasterMixer.Process(expected, Format.Channels);
+
+                var before = GC.GetAllocatedBytesForCurrentThread();
+                compiled.MasterMixer.Process(actual, Format.Channels);
+                Assert.Equal(0L, GC.GetAllocatedBytesForCurrentThread() - before, $"bytes allocated by pass {pass}");
+
+                AssertSame(expected, actual, $"pass {pass}");
+            }
+        }
+
+        /// <summary>
+        /// Builds the test graph on a new offline device: a master mixer with a delay, an oscillator driven through a
+        /// connected input, and a sub-mixer holding a filtered oscillator and a further nested mixer.
+        /// </summary>
+        private static OfflinePlaybackDevice CreateDevice(int blockSize, bool compiled)
+        {
+            var engine = new OfflineEngine();
+            var device = engine.CreatePlaybackDevice(Format, blockSize);
+            var master = device.MasterMixer;
+
+            var lead = new Oscillator(engine, Format) { Frequency = 220f, Type = Oscillator.WaveformType.Sawtooth };
+            lead.ConnectInput(new Oscillator(engine, Format) { Frequency = 1000f });
+            lead.Pan = 0.3f;
+            master.AddComponent(lead);
+
+            var sub = new Mixer(engine, Format) { Volume = 0.7f };
+            var filtered = new Oscillator(engine, Format) { Frequency = 330f, Type = Oscillator.WaveformType.Square };
+            filtered.AddModifier(new LowPassModifier(Format, 1200f));
+            sub.AddComponent(filtered);
+
+            var nested = new Mixer(engine, Format) { Pan = 0.8f };
+            var tone = new Oscillator(engine, Format) { Frequency = 440f, Type = Oscillator.WaveformType.Triangle };
+            tone.Volume = 0.5f;
+            nested.AddComponent(tone);
+            nested.AddModifier(new DelayModifier(Format, 700, 0.4f));
+            sub.AddComponent(nested);
+
+            master.AddComponent(sub);
+            master.AddModifier(new DelayModifier(Format, 1500, 0.3f));
+            master.CompiledRendering = compiled;
+            return device;
+        }
+
+        private static void AssertSame(float[] expected, float[] actual, string context)
+        {
+            var peak = 0f;
+            for (var i = 0; i < expected.Length; i++)
+            {
+                Assert.Equal(expected[i], actual[i], $"{context}, sample {i}");
+                peak = Math.Max(peak, Math.Abs(expected[i]));
+            }
+
+            Assert.True(peak > 0.1f, $"{context}: the graph renders audio");
+        }
+    }
+}
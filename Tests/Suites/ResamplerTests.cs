@@ -0,0 +1,134 @@
+using SoundFlow.Components;
+using SoundFlow.Enums;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// Frequency response of the <see cref="Resampler"/>: tones below the output Nyquist pass at unity gain, tones
+    /// above it are removed rather than aliased, and the result does not depend on how the input is split up.
+    /// </summary>
+    internal static class ResamplerTests
+    {
+        private const int Channels = 2;
+        private const int Frames = 48000;
+
+        // Frames skipped at both ends of the output, past the filter's start-up and flush transients.
+        private const int Margin = 1000;
+
+        public static IEnumerable<TestCase> Cases()
+        {
+            // The passband edge and stopband rejection follow each quality's filter rolloff and length.
+            foreach (var (quality, passbandEdge, rejectionDb) in new[]
+                     { (ResamplerQuality.Medium, 0.6, 65.0), (ResamplerQuality.High, 0.8, 95.0) })
+            {
+                yield return Passband(quality, 44100, 48000, passbandEdge);
+                yield return Passband(quality, 48000, 44100, passbandEdge);
+                yield return Passband(quality, 48000, 24000, passbandEdge);
+                yield return Stopband(quality, 48000, 24000, rejectionDb);
+                yield return Stopband(quality, 96000, 44100, rejectionDb);
+            }
+
+            yield return new TestCase("Resampler/chunking independent", ChunkingIndependent);
+        }
+
+        /// <summary>
+        /// Tones up to <paramref name="edge"/> times the lower Nyquist frequency keep their amplitude within 0.1 dB.
+        /// </summary>
+        private static TestCase Passband(ResamplerQuality quality, int inputRate, int outputRate, double edge) =>
+            new($"Resampler/passband {quality} {inputRate}->{outputRate}", () =>
+            {
+                var nyquist = Math.Min(inputRate, outputRate) / 2.0;
+                foreach (var fraction in new[] { 0.01, 0.1, 0.3, 0.5, edge })
+                {
+                    var frequency = fraction * nyquist;
+                    var output = Convert(quality, inputRate, outputRate, TestSignals.Sine(Frames, Channels, frequency, inputRate));
+                    var frames = output.Length / Channels;
+
+                    for (var c = 0; c < Channels; c++)
+                    {
+                        var amplitude = TestSignals.ToneAmplitude(output, Channels, c, Margin, frames - 2 * Margin,
+                            frequency, outputRate);
+                        Assert.Near(0, TestSignals.ToDb(amplitude / 0.5), 0.1,
+                            $"gain in dB at {Hz(frequency)}, channel {c}");
+                    }
+                }
+            });
+
+        /// <summary>
+        /// Tones between 120% of the output Nyquist frequency and the input Nyquist frequency are attenuated by at
+        /// least <paramref name="rejectionDb"/> in total, wherever they would alias to.
+        /// </summary>
+        private static TestCase Stopband(ResamplerQuality quality, int inputRate, int outputRate, double rejectionDb) =>
+            new($"Resampler/stopband {quality} {inputRate}->{outputRate}", () =>
+            {
+                var outputNyquist = outputRate / 2.0;
+                var inputNyquist = inputRate / 2.0;
+                foreach (var fraction in new[] { 0.0, 0.5, 0.9 })
+                {
+                    var frequency = outputNyquist * 1.2 + fraction * (inputNyquist - outputNyquist * 1.2);
+                    var output = Convert(quality, inputRate, outputRate, TestSignals.Sine(Frames, Channels, frequency, inputRate));
+                    var frames = output.Length / Channels;
+
+                    var power = TestSignals.Power(output, Channels, 0, Margin, frames - 2 * Margin);
+                    var attenuationDb = -10 * Math.Log10(Math.Max(power, 1e-30) / 0.125);
+                    Assert.True(attenuationDb >= rejectionDb,
+                        $"{Hz(frequency)} attenuated by {attenuationDb:F1} dB, expected at least {rejectionDb:F0} dB");
+                }
+            });
+
+        private static void ChunkingIndependent()
+        {
+            var input = TestSignals.Sine(Frames, Channels, 1000, 44100);
+            var whole = Convert(ResamplerQuality.High, 44100, 48000, input);
+
+            var random = new Random(7);
+            var resampler = new Resampler(Channels, ResamplerQuality.High, 44100.0 / 48000);
+            var output = new float[whole.Length + 64 * Channels];
+            int read = 0, written = 0;
+            while (read < input.Length)
+            {
+                var inputCount = Math.Min(input.Length - read, random.Next(1, 300) * Channels);
+                var outputCount = Math.Min(output.Length - written, random.Next(1, 300) * Channels);
+                written += resampler.Process(input.AsSpan(read, inputCount), output.AsSpan(written, outputCount), out var consumed);
+                read += consumed;
+            }
+
+            int flushed;
+            while ((flushed = resampler.Flush(output.AsSpan(written))) > 0)
+                written += flushed;
+
+            Assert.Equal(whole.Length, written, "output length");
+            for (var i = 0; i < whole.Length; i++)
+                Assert.Near(whole[i], output[i], 1e-6, $"sample {i}");
+        }
+
+        /// <summary>
+        /// Converts a whole signal in 512-frame blocks, as playback does, and flushes the filter at the end.
+        /// </summary>
+        private static float[] Convert(ResamplerQuality quality, int inputRate, int outputRate, float[] input)
+        {
+            var resampler = new Resampler(Channels, quality, (double)inputRate / outputRate);
+            var output = new float[(int)((long)input.Length * outputRate / inputRate) + 256 * Channels];
+            var block = 512 * Channels;
+            int read = 0, written = 0;
+            while (read < input.Length)
+            {
+                written += resampler.Process(input.AsSpan(read, Math.Min(block, input.Length - read)),
+                    output.AsSpan(written, Math.Min(block, output.Length - written)), out var consumed);
+                read += consumed;
+            }
+
+            int flushed;
+            while ((flushed = resampler.Flush(output.AsSpan(written))) > 0)
+                written += flushed;
+
+            Array.Resize(ref output, written);
+            return output;
+        }
+
+        private static string Hz(double frequency) => frequency.ToString("0 Hz", CultureInfo.InvariantCulture);
+    }
+}
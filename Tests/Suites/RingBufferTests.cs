@@ -0,0 +1,148 @@
+using SoundFlow.Utils;
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// <see cref="SpscRingBuffer"/> keeps samples in order across the wrap point, through both the copying and the
+    /// in-place members, and between a real producer and consumer thread.
+    /// </summary>
+    internal static class RingBufferTests
+    {
+        public static IEnumerable<TestCase> Cases()
+        {
+            yield return new TestCase("SpscRingBuffer/capacity", Capacity);
+            yield return new TestCase("SpscRingBuffer/wraparound", Wraparound);
+            yield return new TestCase("SpscRingBuffer/segments across the wrap", SegmentsAcrossWrap);
+            yield return new TestCase("SpscRingBuffer/full and empty", FullAndEmpty);
+            yield return new TestCase("SpscRingBuffer/two threads", TwoThreads);
+        }
+
+        private static void Capacity()
+        {
+            Assert.Equal(1, new SpscRingBuffer(1).Capacity, "capacity of 1");
+            Assert.Equal(16, new SpscRingBuffer(16).Capacity, "capacity of 16");
+            Assert.Equal(32, new SpscRingBuffer(17).Capacity, "capacity of 17");
+        }
+
+        /// <summary>
+        /// Odd write and read sizes against a small buffer move the wrap point through every offset many times over.
+        /// </summary>
+        private static void Wraparound()
+        {
+            var ring = new SpscRingBuffer(16);
+            var input = new float[7];
+            var output = new float[16];
+            float next = 0, expected = 0;
+
+            for (var round = 0; round < 10000; round++)
+            {
+                var writeCount = 1 + round % 7;
+                for (var i = 0; i < writeCount; i++)
+                    input[i] = next + i;
+                var written = ring.Write(input.AsSpan(0, writeCount));
+                next += written;
+
+                var read = ring.Read(output.AsSpan(0, 1 + round * 5 % 11));
+                for (var i = 0; i < read; i++)
+                {
+                    if (output[i] != expected)
+                        Assert.Equal(expected, output[i], $"sample {expected:F0}, round {round}");
+                    expected++;
+                }
+
+                Assert.Equal(ring.TotalWritten - ring.TotalRead, (long)ring.Count, "count");
+                Assert.True(ring.Count <= ring.Capacity, "count within capacity");
+            }
+
+            Assert.True(ring.TotalWritten > 10 * ring.Capacity, "the write index wrapped many times");
+        }
+
+        private static void SegmentsAcrossWrap()
+        {
+            var ring = new SpscRingBuffer(8);
+            ring.Write(new float[6]);
+            ring.AdvanceRead(6);
+
+            // Write position 6: two samples fit before the wrap point and six after it.
+            ring.GetWriteSegments(out var first, out var second);
+            Assert.Equal(2, first.Length, "free before the wrap");
+            Assert.Equal(6, second.Length, "free after the wrap");
+            for (var i = 0; i < first.Length; i++) first[i] = i;
+            for (var i = 0; i < 3; i++) second[i] = first.Length + i;
+            ring.AdvanceWrite(first.Length + 3);
+
+            ring.GetReadSegments(out var readFirst, out var readSecond);
+            Assert.Equal(2, readFirst.Length, "readable before the wrap");
+            Assert.Equal(3, readSecond.Length, "readable after the wrap");
+
+            var output = new float[5];
+            Assert.True(ring.TryRead(output), "read of everything written");
+            for (var i = 0; i < output.Length; i++)
+                Assert.Equal((float)i, output[i], $"sample {i}");
+        }
+
+        private static void FullAndEmpty()
+        {
+            var ring = new SpscRingBuffer(8);
+            Assert.Equal(8, ring.Write(new float[12]), "write clipped to the capacity");
+            Assert.Equal(0, ring.FreeSpace, "no free space when full");
+            Assert.True(!ring.TryWrite(new float[1]), "all-or-nothing write refused when full");
+
+            Assert.True(!ring.TryRead(new float[9]), "all-or-nothing read refused beyond the count");
+            Assert.Equal(8, ring.Read(new float[9]), "read clipped to the count");
+            Assert.Equal(0, ring.Read(new float[1]), "nothing to read when empty");
+
+            ring.Write(new float[5]);
+            ring.Clear();
+            Assert.Equal(0, ring.Count, "count after clear");
+            Assert.Equal(ring.TotalWritten, ring.TotalRead, "clear skips everything written");
+        }
+
+        private static void TwoThreads()
+        {
+            const int total = 1 << 21;
+            var ring = new SpscRingBuffer(1024);
+            string? failure = null;
+
+            var producer = new Thread(() =>
+            {
+                var block = new float[97];
+                var next = 0;
+                while (next < total && Volatile.Read(ref failure) == null)
+                {
+                    var count = Math.Min(block.Length, total - next);
+                    for (var i = 0; i < count; i++)
+                        block[i] = (next + i) & 0xFFFFF;
+                    var written = ring.Write(block.AsSpan(0, count));
+                    if (written == 0) Thread.Yield();
+                    next += written;
+                }
+            });
+
+            producer.Start();
+            var output = new float[61];
+            var expected = 0;
+            var deadline = Environment.TickCount64 + 30000;
+            while (expected < total && failure == null && Environment.TickCount64 < deadline)
+            {
+                var read = ring.Read(output);
+                if (read == 0) Thread.Yield();
+                for (var i = 0; i < read && failure == null; i++, expected++)
+                {
+                    if (output[i] != (expected & 0xFFFFF))
+                        Volatile.Write(ref failure, $"sample {expected}: expected {expected & 0xFFFFF}, got {output[i]}");
+                }
+            }
+
+            if (failure == null && expected < total)
+                Volatile.Write(ref failure, $"timed out after {expected} samples");
+
+            producer.Join();
+            Assert.True(failure == null, failure ?? string.Empty);
+            Assert.Equal(total, expected, "samples received");
+        }
+    }
+}
@@ -0,0 +1,103 @@
+using SoundFlow.Abstracts;
+using System;
+using System.Collections.Generic;
+
+namespace SoundFlow.Tests.Suites
+{
+    /// <summary>
+    /// The FFT search of <see cref="WsolaTimeStretcher"/> against a direct normalized cross-correlation computed in
+    /// double for every lag of the search radius.
+    /// </summary>
+    /// <remarks>
+    /// The signals are quiet tones with a little noise, as a real overlap tail would be, with and without a DC
+    /// offset 400 times their amplitude; the offset must not cost the scores their precision. Shorter regions check
+    /// that lags whose candidate runs past the input are left unscored.
+    /// </remarks>
+    internal static class WsolaTests
+    {
+        private const double Tolerance = 1e-4;
+
+        public static IEnumerable<TestCase> Cases()
+        {
+            foreach (var channels in new[] { 1, 2, 3 })
+            foreach (var offset in new[] { 0f, 4f })
+                yield return new TestCase($"Wsola/scores match direct correlation, {channels} ch, DC {offset}",
+                    () => MatchesDirect(channels, offset));
+        }
+
+        private static void MatchesDirect(int channels, float offset)
+        {
+            var radius = WsolaTimeStretcher.SearchRadiusFrames;
+            var stretcher = new WsolaTimeStretcher(channels);
+            var random = new Random(channels);
+            var scores = new double[2 * radius + 1];
+
+            foreach (var compareFrames in new[] { 768, 300, 40 })
+            foreach (var missingFrames in new[] { 0, radius / 2 })
+            {
+                var regionFrames = 2 * radius + compareFrames - missingFrames;
+                var region = Signal(regionFrames, channels, offset, random);
+
+                // A tail that resembles the region at a known lag, so the scores span a real peak.
+                var tail = new float[compareFrames * channels];
+                var peakLag = radius / 3;
+                for (var i = 0; i < tail.Length; i++)
+                    tail[i] = region[peakLag * channels + i] * 0.8f + (float)(random.NextDouble() - 0.5) * 0.002f;
+
+                var scored = stretcher.ScoreCandidates(tail, region, scores);
+                var context = $"{compareFrames} frames compared, {missingFrames} missing";
+                Assert.Equal(2 * radius + 1 - missingFrames, scored, $"{context}: lags scored");
+
+                var worst = 0.0;
+                for (var lag = 0; lag < scored; lag++)
+                    worst = Math.Max(worst, Math.Abs(scores[lag] - Direct(tail, region, lag, channels)));
+                Assert.Below(Tolerance, worst, $"{context}: score error");
+                Assert.True(scores[peakLag] > 0.85, $"{context}: score {scores[peakLag]:G4} at the matching lag");
+            }
+        }
+
+        /// <summary>
+        /// The normalized cross-correlation of the tail and the candidate at <paramref name="lag"/> frames, in double.
+        /// </summary>
+        private static double Direct(float[] tail, float[] region, int lag, int channels)
+        {
+            var start = lag * channels;
+            double meanA = 0, meanB = 0;
+            for (var i = 0; i < tail.Length; i++)
+            {
+                meanA += tail[i];
+                meanB += region[start + i];
+            }
+
+            meanA /= tail.Length;
+            meanB /= tail.Length;
+
+            double cross = 0, energyA = 0, energyB = 0;
+            for (var i = 0; i < tail.Length; i++)
+            {
+                var a = tail[i] - meanA;
+                var b = region[start + i] - meanB;
+                cross += a * b;
+                energyA += a * a;
+                energyB += b * b;
+            }
+
+            return cross / Math.Sqrt(energyA * energyB);
+        }
+
+        private static float[] Signal(int frames, int channels, float offset, Random random)
+        {
+            var signal = new float[frames * channels];
+            for (var f = 0; f < frames; f++)
+            {
+                var t = f / 48000.0;
+                var tone = 0.01 * Math.Sin(2 * Math.PI * 220 * t) + 0.005 * Math.Sin(2 * Math.PI * 331 * t);
+                for (var ch = 0; ch < channels; ch++)
+                    signal[f * channels + ch] =
+                        offset + (float)(tone * (1 - 0.2 * ch) + (random.NextDouble() - 0.5) * 0.001);
+            }
+
+            return signal;
+        }
+    }
+}
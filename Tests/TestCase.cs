@@ -0,0 +1,70 @@
+using System;
+
+namespace SoundFlow.Tests
+{
+    /// <summary>
+    /// A named test: an action that returns normally on success and throws on failure.
+    /// </summary>
+    internal sealed class TestCase
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TestCase"/> class.
+        /// </summary>
+        /// <param name="name">The test name, as <c>Group/Case</c>.</param>
+        /// <param name="run">The test body.</param>
+        public TestCase(string name, Action run)
+        {
+            Name = name;
+            Run = run ?? throw new ArgumentNullException(nameof(run));
+        }
+
+        /// <summary>
+        /// Gets the test name.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets the test body.
+        /// </summary>
+        public Action Run { get; }
+    }
+
+    /// <summary>
+    /// Thrown by <see cref="Assert"/> when a check fails, so the runner reports the message without a stack trace.
+    /// </summary>
+    internal sealed class AssertionException : Exception
+    {
+        public AssertionException(string message) : base(message)
+        {
+        }
+    }
+
+    /// <summary>
+    /// The checks used by the tests.
+    /// </summary>
+    internal static class Assert
+    {
+        public static void True(bool condition, string message)
+        {
+            if (!condition) throw new AssertionException(message);
+        }
+
+        public static void Equal<T>(T expected, T actual, string message) where T : IEquatable<T>
+        {
+            if (!expected.Equals(actual))
+                throw new AssertionException($"{message}: expected {expected}, got {actual}.");
+        }
+
+        public static void Near(double expected, double actual, double tolerance, string message)
+        {
+            if (!(Math.Abs(expected - actual) <= tolerance))
+                throw new AssertionException($"{message}: expected {expected:G6} ± {tolerance:G3}, got {actual:G6}.");
+        }
+
+        public static void Below(double limit, double actual, string message)
+        {
+            if (!(actual < limit))
+                throw new AssertionException($"{message}: expected below {limit:G6}, got {actual:G6}.");
+        }
+    }
+}
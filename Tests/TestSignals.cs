@@ -0,0 +1,61 @@
+using System;
+
+namespace SoundFlow.Tests
+{
+    /// <summary>
+    /// Test signals and the measurements made on them.
+    /// </summary>
+    internal static class TestSignals
+    {
+        /// <summary>
+        /// Generates an interleaved sine with the same frequency on every channel and a different phase per channel.
+        /// </summary>
+        public static float[] Sine(int frames, int channels, double frequency, double sampleRate, double amplitude = 0.5)
+        {
+            var samples = new float[frames * channels];
+            for (var f = 0; f < frames; f++)
+            for (var c = 0; c < channels; c++)
+                samples[f * channels + c] = (float)(amplitude * Math.Sin(2 * Math.PI * frequency * f / sampleRate + c));
+            return samples;
+        }
+
+        /// <summary>
+        /// Measures the amplitude of one channel at one frequency by correlating it with a sine and cosine over the
+        /// given frames. Exact for a steady tone over a whole number of periods, and close over many periods.
+        /// </summary>
+        public static double ToneAmplitude(ReadOnlySpan<float> samples, int channels, int channel, int firstFrame,
+            int frameCount, double frequency, double sampleRate)
+        {
+            double sine = 0, cosine = 0;
+            for (var f = firstFrame; f < firstFrame + frameCount; f++)
+            {
+                var phase = 2 * Math.PI * frequency * f / sampleRate;
+                var value = samples[f * channels + channel];
+                sine += value * Math.Sin(phase);
+                cosine += value * Math.Cos(phase);
+            }
+
+            return 2 * Math.Sqrt(sine * sine + cosine * cosine) / frameCount;
+        }
+
+        /// <summary>
+        /// Gets the mean power of the given frames of one channel.
+        /// </summary>
+        public static double Power(ReadOnlySpan<float> samples, int channels, int channel, int firstFrame, int frameCount)
+        {
+            double sum = 0;
+            for (var f = firstFrame; f < firstFrame + frameCount; f++)
+            {
+                var value = samples[f * channels + channel];
+                sum += value * value;
+            }
+
+            return sum / frameCount;
+        }
+
+        /// <summary>
+        /// Converts a linear ratio to decibels.
+        /// </summary>
+        public static double ToDb(double linear) => 20 * Math.Log10(linear);
+    }
+}